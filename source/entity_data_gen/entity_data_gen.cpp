@@ -0,0 +1,114 @@
+// Converts res/entities.json and res/textures.json into constexpr tables that are compiled into playlunky64.dll
+// Usage: entity_data_gen <entities.json> <textures.json> <output.inl>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using namespace nlohmann;
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::fprintf(stderr, "Usage: %s <entities.json> <textures.json> <output.inl>\n", argv[0]);
+        return 1;
+    }
+
+    json entities;
+    json textures;
+    try
+    {
+        std::ifstream entities_file{ argv[1] };
+        entities = json::parse(entities_file);
+        std::ifstream textures_file{ argv[2] };
+        textures = json::parse(textures_file);
+    }
+    catch (const json::exception& e)
+    {
+        std::fprintf(stderr, "Failed parsing input: %s\n", e.what());
+        return 1;
+    }
+
+    std::ofstream out{ argv[3], std::ios::trunc };
+    if (!out)
+    {
+        std::fprintf(stderr, "Failed opening %s for writing\n", argv[3]);
+        return 1;
+    }
+
+    out << "// Generated by entity_data_gen, do not edit\n\n";
+
+    try
+    {
+        // nlohmann::json objects iterate their keys in sorted order already
+        std::string entities_table;
+        std::string animations_table;
+        std::uint32_t num_animations{ 0 };
+        for (const auto& [name, entity] : entities.items())
+        {
+            std::map<int, const json*> animations;
+            for (const auto& [id_str, animation] : entity["animations"].items())
+            {
+                const int id = std::stoi(id_str);
+                if (id < 0 || id > 255)
+                {
+                    std::fprintf(stderr, "Animation id %d of entity %s does not fit into a byte\n", id, name.c_str());
+                    return 1;
+                }
+                animations[id] = &animation;
+            }
+
+            const std::uint32_t first_animation = num_animations;
+            for (const auto& [id, animation] : animations)
+            {
+                animations_table += "    EntityAnimationData{ " + std::to_string(id) + ", " + std::to_string((*animation)["texture"].get<std::int32_t>()) + ", " + std::to_string((*animation)["count"].get<std::int32_t>()) + " },\n";
+                num_animations++;
+            }
+
+            const std::int32_t tile_x = entity.contains("tile_x") ? entity["tile_x"].get<std::int32_t>() : -1;
+            const std::int32_t tile_y = entity.contains("tile_y") ? entity["tile_y"].get<std::int32_t>() : -1;
+            entities_table += "    EntityData{ \"" + name + "\", " + std::to_string(entity["id"].get<std::uint16_t>()) + ", " + std::to_string(entity["texture"].get<std::int32_t>()) + ", " + std::to_string(tile_x) + ", " + std::to_string(tile_y) + ", " + std::to_string(first_animation) + ", " + std::to_string(animations.size()) + " },\n";
+        }
+
+        // Texture keys are ids, which would sort as strings otherwise
+        std::map<std::int32_t, const json*> sorted_textures;
+        for (const auto& [id_str, texture] : textures.items())
+        {
+            sorted_textures[std::stoi(id_str)] = &texture;
+        }
+
+        std::string textures_table;
+        for (const auto& [id, texture_ptr] : sorted_textures)
+        {
+            const json& texture = *texture_ptr;
+            textures_table += "    TextureData{ " + std::to_string(id) + ", " + std::to_string(texture["num_tiles"]["width"].get<std::uint32_t>()) + ", " + std::to_string(texture["tile_width"].get<std::uint32_t>()) + ", " + std::to_string(texture["tile_height"].get<std::uint32_t>()) + ", " + std::to_string(texture["offset"]["width"].get<std::uint32_t>()) + ", " + std::to_string(texture["offset"]["height"].get<std::uint32_t>()) + " },\n";
+        }
+
+        // Empty arrays are ill-formed, so always emit a dummy animation
+        if (animations_table.empty())
+        {
+            animations_table = "    EntityAnimationData{},\n";
+        }
+
+        out << "static constexpr EntityAnimationData s_EntityAnimations[]{\n"
+            << animations_table << "};\n\n";
+        out << "static constexpr EntityData s_Entities[]{\n"
+            << entities_table << "};\n\n";
+        out << "static constexpr TextureData s_Textures[]{\n"
+            << textures_table << "};\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "Failed converting input: %s\n", e.what());
+        return 1;
+    }
+
+    return out ? 0 : 1;
+}
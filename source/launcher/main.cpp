@@ -1,4 +1,5 @@
 #include "util/format.h"
+#include "util/mod_pack.h"
 
 #include <Windows.h>
 #include <array>
@@ -17,6 +18,7 @@ enum ReturnReason
     FAILED_SETTING_READ_PIPE_PROPERTIES,
     FAILED_CREATING_CONSOLE,
     FAILED_DESTROYING_CONSOLE,
+    FAILED_PACKING_MOD,
 };
 
 struct CommandLineOptions
@@ -24,8 +26,11 @@ struct CommandLineOptions
     std::optional<std::string> exe_dir;
     std::optional<bool> console = false;
     std::optional<bool> overlunky = false;
+    std::optional<std::string> pack_mod;
+    std::optional<std::string> pack_output;
+    std::optional<bool> pack_uncompressed = false;
 };
-VISITABLE_STRUCT(CommandLineOptions, exe_dir, console, overlunky);
+VISITABLE_STRUCT(CommandLineOptions, exe_dir, console, overlunky, pack_mod, pack_output, pack_uncompressed);
 
 static HANDLE s_Process = NULL;
 static FILE* s_ConsoleStdOut = NULL;
@@ -101,6 +106,55 @@ int WinMain(
     {
         auto options = structopt::app("playlunky_launcher").parse<CommandLineOptions>(__argc, __argv);
 
+        // Pack a mod folder into a single file instead of launching the game, by default into the working directory
+        if (options.pack_mod.has_value())
+        {
+            namespace fs = std::filesystem;
+
+            fs::path mod_folder = fs::path{ options.pack_mod.value() }.lexically_normal();
+            if (!mod_folder.has_filename())
+            {
+                mod_folder = mod_folder.parent_path();
+            }
+
+            fs::path pack_file = options.pack_output.has_value()
+                                     ? fs::path{ options.pack_output.value() }
+                                     : fs::current_path() / mod_folder.filename();
+            if (pack_file.extension() != ".plpack")
+            {
+                pack_file += ".plpack";
+            }
+
+            // Playlunky ignores packs that have the same name as a mod folder
+            {
+                std::error_code error;
+                const fs::path colliding_folder = fs::path{ pack_file }.replace_extension();
+                if (fs::is_directory(colliding_folder, error))
+                {
+                    fmt::print("Can not write pack {}, it would be ignored because of the folder {}, pass a different --pack_output...\n", pack_file.string(), colliding_folder.string());
+                    return FAILED_PACKING_MOD;
+                }
+            }
+
+            // Converted images are taken from the output of preprocessing, which is in the .db folder next to the mods
+            const fs::path preprocessed_folder = fs::absolute(mod_folder).parent_path() / ".db" / "Mods" / mod_folder.filename();
+            const bool compress = !options.pack_uncompressed.value_or(false);
+
+            std::vector<ModPackRejectedFile> rejected_files;
+            if (!WriteModPack(mod_folder, preprocessed_folder, pack_file, compress, rejected_files))
+            {
+                for (const ModPackRejectedFile& rejected_file : rejected_files)
+                {
+                    fmt::print("Can not pack {}, {}...\n", rejected_file.Path.string(), rejected_file.Reason);
+                }
+                fmt::print("Failed packing mod {}...\n", mod_folder.string());
+                return FAILED_PACKING_MOD;
+            }
+
+            fmt::print("Packed mod {} into {}...\n", mod_folder.string(), pack_file.string());
+            return SUCCESS;
+        }
+
         char dir_path[MAX_PATH] = {};
         GetCurrentDirectoryA(MAX_PATH, dir_path);
 
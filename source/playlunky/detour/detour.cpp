@@ -4,6 +4,8 @@
 #include "detour_entry.h"
 #include "fmod_crap.h"
 #include "logger.h"
+#include "pattern_scan.h"
+#include "signature_cache.h"
 #include "sigscan.h"
 #include "util/format.h"
 #include "version.h"
@@ -11,11 +13,17 @@
 
 #include <Windows.h>
 #include <detours.h>
+#include <filesystem>
 #include <fmt/core.h>
 #include <span>
+#include <string_view>
+#include <unordered_map>
 
 #define DLL_NAME "playlunky" DETOURS_STRINGIFY(DETOURS_BITS) ".dll"
 
+inline constexpr std::string_view c_PacksFolder{ "Mods/Packs" };
+inline constexpr std::string_view c_SignatureCachePath{ "Mods/Packs/.db/signatures.cache" };
+
 struct ByteStr
 {
     std::string_view Str;
@@ -84,22 +92,97 @@ std::vector<DetourEntry> CollectDetourEntries(const PlaylunkySettings& settings)
     return detour_entries;
 }
 
+// Finds all signatures of the detours, signatures that were found in the same build of their module before are taken from the cache
+// Offsets from the cache are verified before they are used, so a stale cache can never detour the wrong function
+static std::vector<void*> FindDetourSignatures(std::span<const DetourEntry> detour_entries)
+{
+    SignatureCache cache = SignatureCache::ReadFromFile(c_SignatureCachePath);
+    bool cache_changed{ false };
+
+    std::vector<void*> addresses(detour_entries.size(), nullptr);
+
+    std::unordered_map<std::string_view, std::vector<std::size_t>> entries_per_module;
+    for (std::size_t i = 0; i < detour_entries.size(); i++)
+    {
+        const DetourEntry& entry = detour_entries[i];
+        if (entry.Signature != nullptr && !entry.Signature->empty() && entry.Module != nullptr)
+        {
+            entries_per_module[entry.Module].push_back(i);
+        }
+    }
+
+    for (const auto& [module_name, entry_indices] : entries_per_module)
+    {
+        const char* module = detour_entries[entry_indices.front()].Module;
+        const std::optional<SigScan::ModuleIdentity> module_identity = SigScan::GetModuleIdentity(module);
+
+        std::vector<std::size_t> scan_indices;
+        std::vector<std::string_view> scan_signatures;
+        for (std::size_t i : entry_indices)
+        {
+            const std::string_view signature = *detour_entries[i].Signature;
+            if (module_identity.has_value())
+            {
+                if (const std::optional<std::size_t> offset = cache.Find(module_identity.value(), signature))
+                {
+                    void* address = SigScan::GetFromOffset(module, offset.value());
+                    if (address != nullptr && SigScan::MatchesPattern(address, signature))
+                    {
+                        addresses[i] = address;
+                        continue;
+                    }
+                }
+            }
+
+            scan_indices.push_back(i);
+            scan_signatures.push_back(signature);
+        }
+
+        if (scan_signatures.empty())
+        {
+            continue;
+        }
+
+        const std::vector<void*> scan_addresses = SigScan::FindPatterns(module, scan_signatures, true);
+        for (std::size_t j = 0; j < scan_indices.size(); j++)
+        {
+            addresses[scan_indices[j]] = scan_addresses[j];
+            if (module_identity.has_value() && scan_addresses[j] != nullptr)
+            {
+                const std::size_t offset = static_cast<std::size_t>(SigScan::GetOffset(module, scan_addresses[j]));
+                cache.Store(module_identity.value(), scan_signatures[j], offset);
+                cache_changed = true;
+            }
+        }
+    }
+
+    // Attaching happens before the mod manager checks that the Mods/Packs folder exists, so it must not be created here
+    if (cache_changed && std::filesystem::exists(c_PacksFolder) && !cache.WriteToFile(c_SignatureCachePath))
+    {
+        fmt::print("Failed writing signature cache to {}...\n", c_SignatureCachePath);
+    }
+
+    return addresses;
+}
+
 void Attach(const PlaylunkySettings& settings)
 {
     fmt::print(DLL_NAME "-{}: Attaching...\n", playlunky_version());
 
     std::vector<DetourEntry> detour_entries = CollectDetourEntries(settings);
+    const std::vector<void*> signature_addresses = FindDetourSignatures(detour_entries);
 
     DetourRestoreAfterWith();
 
     DetourTransactionBegin();
     DetourUpdateThread(GetCurrentThread());
 
-    for (auto [trampoline, detour, signature, search_fun_start, proc_name, module, function_name] : detour_entries)
+    for (std::size_t i = 0; i < detour_entries.size(); i++)
     {
+        auto [trampoline, detour, signature, search_fun_start, proc_name, module, function_name] = detour_entries[i];
         if (signature != nullptr && !signature->empty())
         {
-            *trampoline = SigScan::FindPattern(module, *signature, true);
+            *trampoline = signature_addresses[i];
             if (*trampoline != nullptr)
             {
                 if (search_fun_start)
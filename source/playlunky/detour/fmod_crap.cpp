@@ -3,17 +3,27 @@
 #include "detour_entry.h"
 #include "detour_helper.h"
 #include "log.h"
+#include "mod/audio_cache.h"
 #include "mod/cache_audio_file.h"
+#include "mod/fsb_parser.h"
 #include "mod/virtual_filesystem.h"
 #include "playlunky.h"
 #include "playlunky_settings.h"
 #include "sigscan.h"
+#include "util/algorithms.h"
 #include "util/on_scope_exit.h"
+#include "util/thread_pool.h"
 
 #include <cassert>
 #include <cstdint>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 static VirtualFilesystem* s_FmodVfs{ nullptr };
+static AudioCache* s_FmodAudioCache{ nullptr };
 
 namespace FMOD
 {
@@ -267,14 +277,6 @@ using Bank = void;
 using Sound = void;
 } // namespace FMOD
 
-template<class T>
-[[nodiscard]] inline auto ReadFromBuffer(const char*& buffer)
-{
-    const T* ret = reinterpret_cast<const T*>(buffer);
-    buffer += sizeof(T);
-    return *ret;
-};
-
 inline FMOD::FMOD_RESULT CreateSound(FMOD::System* fmod_system, const char* filename_or_data, FMOD::FMOD_MODE mode, FMOD::CREATESOUNDEXINFO* exinfo, FMOD::Sound** sound);
 inline FMOD::FMOD_RESULT ReleaseSound(FMOD::Sound* sound);
 
@@ -333,145 +335,22 @@ struct DetourFmodSystemLoadBankMemory
         std::size_t num_samples{ 0 };
         if (buffer != nullptr && length != 0)
         {
-            const char* current_buffer_pos = buffer;
-            [[maybe_unused]] const char* first_data = buffer + 0x283340;
-            const char* buffer_end = buffer + length;
-
-            while (const char* fsb_data = (const char*)SigScan::FindPattern("FSB5"_sig, (void*)current_buffer_pos, (void*)buffer_end))
+            for (FsbHeader& fsb_header : ParseFsbFiles({ buffer, static_cast<std::size_t>(length) }))
             {
-                const char* fsb_begin = fsb_data;
-
-                (void)ReadFromBuffer<char[4]>(fsb_data);
-                const auto version = ReadFromBuffer<std::uint32_t>(fsb_data);
-                if (version == 1)
+                std::vector<FsbFile::Sample> samples;
+                samples.reserve(fsb_header.Samples.size());
+                for (FsbSampleHeader& sample_header : fsb_header.Samples)
                 {
-                    const auto num_samples_in_fsb = ReadFromBuffer<std::uint32_t>(fsb_data);
-                    const auto sample_headers_size = ReadFromBuffer<std::uint32_t>(fsb_data);
-                    const auto sample_names_size = ReadFromBuffer<std::uint32_t>(fsb_data);
-                    [[maybe_unused]] const auto sample_datas_size = ReadFromBuffer<std::uint32_t>(fsb_data);
-                    [[maybe_unused]] const auto bank_flags = ReadFromBuffer<std::uint32_t>(fsb_data);
-                    (void)ReadFromBuffer<char[32]>(fsb_data);
-
-                    const auto header_size = fsb_data - fsb_begin;
-                    [[maybe_unused]] const auto sample_headers_offset = header_size;
-                    assert(header_size == sample_headers_offset);
-                    const auto sample_names_offset = header_size + sample_headers_size;
-                    const auto sample_datas_offset = header_size + sample_headers_size + sample_names_size;
-
-                    std::vector<FsbFile::Sample> samples;
-                    samples.reserve(num_samples_in_fsb);
-
-                    for (std::uint32_t i = 0; i < num_samples_in_fsb; i++)
-                    {
-                        auto read_uint64_but_offset_32 = [](const char*& buffer)
-                        {
-                            const auto ret = ReadFromBuffer<std::uint64_t>(buffer);
-                            buffer -= 4;
-                            return ret;
-                        };
-
-                        char this_sample_name[256 + 32 + 1024]{};
-
-                        auto offset = read_uint64_but_offset_32(fsb_data);
-                        auto next_header_type = offset & ((1 << 7) - 1);
-
-                        (void)ReadFromBuffer<std::uint32_t>(fsb_data);
-
-#define GET_FSB5_OFFSET(X) ((((X) >> (std::uint64_t)7) << (std::uint64_t)5) & (((std::uint64_t)1 << (std::uint64_t)32) - 1))
-                        offset = GET_FSB5_OFFSET(offset);
-#undef GET_FSB5_OFFSET
-
-                        while (next_header_type & 1)
-                        {
-                            auto this_header_type = ReadFromBuffer<std::uint32_t>(fsb_data);
-                            next_header_type = this_header_type & 1;
-                            const auto header_length = (this_header_type & 0xffffff) >> 1;
-                            this_header_type >>= 24;
-
-                            const char* current_fsb_data = fsb_data;
-
-                            switch (this_header_type)
-                            {
-                            case 0x2:
-                                (void)ReadFromBuffer<std::uint8_t>(fsb_data);
-                                break;
-                            case 0x4:
-                                (void)ReadFromBuffer<std::uint32_t>(fsb_data);
-                                break;
-                            case 0x6:
-                                (void)ReadFromBuffer<std::uint64_t>(fsb_data);
-                                break;
-                            case 0x8:
-                            {
-                                (void)ReadFromBuffer<std::uint8_t>(fsb_data);
-                                memcpy(this_sample_name, fsb_data, 256);
-                                fsb_data += 256;
-                                break;
-                            }
-                            case 0xc:  // xma seek
-                            case 0xe:  // dsp coeff
-                            case 0x14: // xwma data
-                            {
-                                fsb_data += header_length;
-                                break;
-                            }
-                            case 0xa:
-                                header_length == 1
-                                    ? (void)ReadFromBuffer<std::uint8_t>(fsb_data)
-                                    : (void)ReadFromBuffer<std::uint32_t>(fsb_data);
-                                break; // seen only once
-                            case 0x10: /*nothing?*/
-                                break;
-                            case 0x1a:
-                                (void)ReadFromBuffer<std::uint32_t>(fsb_data);
-                                break; // timestamp?
-                            default:
-                                break;
-                            }
-
-                            fsb_data = current_fsb_data + header_length;
-                        }
-
-                        // Compute size of data?
-
-                        if (sample_names_size != 0)
-                        {
-                            const char* sample_names_data = fsb_begin + sample_names_offset;
-                            const char* this_sample_name_offset_address = sample_names_data + i * 4;
-                            const auto name_offset = ReadFromBuffer<std::uint32_t>(this_sample_name_offset_address);
-                            const char* this_sample_name_address = sample_names_data + name_offset;
-                            for (size_t j = 0; j < sizeof(this_sample_name); j++)
-                            {
-                                this_sample_name[j] = ReadFromBuffer<char>(this_sample_name_address);
-                                if (this_sample_name[j] == '\0')
-                                {
-                                    break;
-                                }
-                            }
-                        }
-                        // This should not happen to us?
-                        else if (!this_sample_name[0])
-                        {
-                            fmt::format_to(this_sample_name, "{}", i);
-                        }
-
-                        const std::size_t data_offset = sample_datas_offset + offset;
-                        samples.push_back(FsbFile::Sample{
-                            .Name = this_sample_name,
-                            .Offset = (std::uint32_t)data_offset });
-                        num_samples++;
-                    }
-
-                    std::sort(samples.begin(), samples.end(), [](const FsbFile::Sample& lhs, const FsbFile::Sample& rhs)
-                              { return lhs.Offset < rhs.Offset; });
-
-                    s_FsbFiles.push_back(FsbFile{
-                        .Offset{ (std::uint32_t)(fsb_begin - buffer) },
-                        .Samples{ std::move(samples) },
-                        .Bank{ nullptr } });
+                    samples.push_back(FsbFile::Sample{
+                        .Name = std::move(sample_header.Name),
+                        .Offset = sample_header.Offset });
                 }
+                num_samples += samples.size();
 
-                current_buffer_pos = fsb_data;
+                s_FsbFiles.push_back(FsbFile{
+                    .Offset{ fsb_header.Offset },
+                    .Samples{ std::move(samples) },
+                    .Bank{ nullptr } });
             }
         }
 
@@ -485,7 +364,10 @@ struct DetourFmodSystemLoadBankMemory
 
         LogInfo("Preloading any modded samples...");
 
-        std::size_t num_samples{ 0 };
+        // Only samples that have a file with a matching name somewhere in the vfs are looked up
+        const auto modded_sample_names = GetModdedSampleNames();
+
+        std::vector<ModdedSample> modded_samples;
         for (FsbFile& fsb_file : s_FsbFiles)
         {
             if (fsb_file.Bank == nullptr)
@@ -494,57 +376,16 @@ struct DetourFmodSystemLoadBankMemory
 
                 for (FsbFile::Sample& sample : fsb_file.Samples)
                 {
-                    if (s_CacheDecodedFiles)
+                    if (modded_sample_names.has_value() && !modded_sample_names->contains(algo::to_lower(sample.Name)))
                     {
-                        const auto modded_sample = s_FmodVfs->GetFilePath(fmt::format("raw_audio/{}.raw", sample.Name));
-                        if (modded_sample.has_value() && std::filesystem::exists(modded_sample.value()))
-                        {
-                            Playlunky::Get().RegisterModType(ModType::Sound);
-                            sample.Buffer = LoadCachedAudioFile(modded_sample.value());
-                            num_samples++;
-                        }
+                        continue;
                     }
-                    else
+
+                    if (auto modded_sample = FindModdedSample(sample.Name))
                     {
-                        const auto modded_sample = [](const std::string& file_name)
-                        {
-                            auto file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/wav/{}.wav", file_name));
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/ogg/{}.ogg", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/mp3/{}.mp3", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/wv/{}.wv", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/opus/{}.opus", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/flac/{}.flac", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/mpc/{}.mpc", file_name));
-                            }
-                            if (!file_path.has_value())
-                            {
-                                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/mpp/{}.mpp", file_name));
-                            }
-                            return file_path;
-                        }(sample.Name);
-                        if (modded_sample.has_value() && std::filesystem::exists(modded_sample.value()))
-                        {
-                            Playlunky::Get().RegisterModType(ModType::Sound);
-                            sample.Buffer = DecodeAudioFile(modded_sample.value());
-                            num_samples++;
-                        }
+                        modded_samples.push_back(ModdedSample{
+                            .Sample{ &sample },
+                            .FilePath{ std::move(modded_sample).value() } });
                     }
 
                     // BOOKMARK-POSSIBLE-OPT
@@ -622,7 +463,75 @@ struct DetourFmodSystemLoadBankMemory
             }
         }
 
-        LogInfo("Preloaded {} modded samples...", num_samples);
+        if (!modded_samples.empty())
+        {
+            Playlunky::Get().RegisterModType(ModType::Sound);
+
+            // Samples are decoded when they are first used instead
+            if (s_FmodAudioCache != nullptr)
+            {
+                for (const ModdedSample& modded_sample : modded_samples)
+                {
+                    modded_sample.Sample->FilePath = modded_sample.FilePath;
+                }
+
+                LogInfo("Found {} modded samples, they will be loaded on demand...", modded_samples.size());
+                return;
+            }
+
+            ThreadPool thread_pool;
+            thread_pool.ForEach(modded_samples.size(), [&](std::size_t i)
+                                {
+                                    const ModdedSample& modded_sample = modded_samples[i];
+                                    modded_sample.Sample->Buffer = std::make_shared<const DecodedAudioBuffer>(s_CacheDecodedFiles
+                                                                                                                  ? LoadCachedAudioFile(modded_sample.FilePath)
+                                                                                                                  : DecodeAudioFile(modded_sample.FilePath)); });
+        }
+
+        LogInfo("Preloaded {} modded samples...", modded_samples.size());
+    }
+
+    // Lowercase names of all files that could be a modded sample, nullopt if the vfs can not list all files
+    static std::optional<std::unordered_set<std::string>> GetModdedSampleNames()
+    {
+        const auto file_paths = s_FmodVfs->GetIndexedFilePaths(s_CacheDecodedFiles ? "raw_audio" : "soundbank");
+        if (!file_paths.has_value())
+        {
+            return std::nullopt;
+        }
+
+        std::unordered_set<std::string> sample_names;
+        for (const std::string& file_path : file_paths.value())
+        {
+            sample_names.insert(std::filesystem::path{ file_path }.stem().string());
+        }
+        return sample_names;
+    }
+
+    static std::optional<std::filesystem::path> FindModdedSample(const std::string& sample_name)
+    {
+        std::optional<std::filesystem::path> file_path;
+        if (s_CacheDecodedFiles)
+        {
+            file_path = s_FmodVfs->GetFilePath(fmt::format("raw_audio/{}.raw", sample_name));
+        }
+        else
+        {
+            for (std::string_view extension : c_LooseAudioExtensions)
+            {
+                file_path = s_FmodVfs->GetFilePath(fmt::format("soundbank/{0}/{1}.{0}", extension, sample_name));
+                if (file_path.has_value())
+                {
+                    break;
+                }
+            }
+        }
+
+        if (file_path.has_value() && std::filesystem::exists(file_path.value()))
+        {
+            return file_path;
+        }
+        return std::nullopt;
     }
 
     static FMOD::FMOD_RESULT DoLastLoad(FMOD::System* fmod_system, FMOD::Sound** bank)
@@ -659,7 +568,10 @@ struct DetourFmodSystemLoadBankMemory
             std::string Name;
             std::uint32_t Offset;
             FMOD::Sound* Sound;
-            DecodedAudioBuffer Buffer;
+            std::shared_ptr<const DecodedAudioBuffer> Buffer;
+
+            // Only set if the sample is loaded on demand through the audio cache
+            std::filesystem::path FilePath;
 
             std::unique_ptr<std::byte[]> Data;
             std::uint32_t DataSize;
@@ -670,6 +582,12 @@ struct DetourFmodSystemLoadBankMemory
         FMOD::Bank* Bank;
     };
     static inline std::vector<FsbFile> s_FsbFiles;
+
+    struct ModdedSample
+    {
+        FsbFile::Sample* Sample;
+        std::filesystem::path FilePath;
+    };
     inline static bool s_EnableLooseFiles{ true };
     inline static bool s_CacheDecodedFiles{ true };
 };
@@ -759,7 +677,8 @@ struct DetourFmodSystemCreateSound
                 //}
 
                 const auto& sample = fsb_file.Samples[sample_index];
-                if (sample.Buffer.DataSize > 0)
+                const std::shared_ptr<const DecodedAudioBuffer> buffer = GetSampleBuffer(fsb_file, sample);
+                if (buffer != nullptr && buffer->DataSize > 0)
                 {
                     static char empty_wav[]{
                         "\x52\x49\x46\x46\x25\x00\x00\x00\x57\x41\x56\x45\x66\x6D\x74\x20"
@@ -802,9 +721,9 @@ struct DetourFmodSystemCreateSound
 
                             FMOD::CREATESOUNDEXINFO loose_subsound_exinfo{
                                 .cbsize = sizeof(loose_subsound_exinfo),
-                                .length = (std::uint32_t)sample.Buffer.DataSize - 32,
-                                .numchannels = sample.Buffer.NumChannels,
-                                .defaultfrequency = sample.Buffer.Frequency,
+                                .length = (std::uint32_t)buffer->DataSize - 32,
+                                .numchannels = buffer->NumChannels,
+                                .defaultfrequency = buffer->Frequency,
                                 .format = [&sample](SoundFormat format)
                                 {
                                     switch (format)
@@ -823,14 +742,20 @@ struct DetourFmodSystemCreateSound
                                     case SoundFormat::PCM_FLOAT:
                                         return FMOD::SOUND_FORMAT::PCMFLOAT;
                                     }
-                                }(sample.Buffer.Format),
+                                }(buffer->Format),
                                 .numsubsounds = 0
                             };
 
-                            auto data = (const char*)sample.Buffer.Data.get() + 16; // 16 bytes padding in front
+                            auto data = (const char*)buffer->Data.get() + 16; // 16 bytes padding in front
                             const auto create_sub_sound_res = Trampoline(fmod_system, data, loose_sub_sound_mode, &loose_subsound_exinfo, sub_sound);
                             if (create_sub_sound_res == FMOD::OK)
                             {
+                                // FMOD does not copy the data, so keep it alive until the sound is released even if the cache evicts it
+                                if (!sample.FilePath.empty())
+                                {
+                                    std::lock_guard lock{ s_LazyLoadMutex };
+                                    s_SoundBuffers[*sound] = buffer;
+                                }
                                 return FMOD::OK;
                             }
 
@@ -845,6 +770,43 @@ struct DetourFmodSystemCreateSound
 
         return Trampoline(fmod_system, file_name_or_data, mode, exinfo, sound);
     }
+
+    static std::shared_ptr<const DecodedAudioBuffer> GetSampleBuffer(const DetourFmodSystemLoadBankMemory::FsbFile& fsb_file, const DetourFmodSystemLoadBankMemory::FsbFile::Sample& sample)
+    {
+        if (sample.FilePath.empty() || s_FmodAudioCache == nullptr)
+        {
+            return sample.Buffer;
+        }
+
+        // Samples of one sound bank tend to be used together, e.g. all sounds of a theme, so prefetch the others when the first one is used
+        {
+            std::lock_guard lock{ s_LazyLoadMutex };
+            if (s_PrefetchedFsbFiles.insert({ fsb_file.Bank, fsb_file.Offset }).second)
+            {
+                std::vector<std::filesystem::path> file_paths;
+                for (const auto& other_sample : fsb_file.Samples)
+                {
+                    if (&other_sample != &sample && !other_sample.FilePath.empty())
+                    {
+                        file_paths.push_back(other_sample.FilePath);
+                    }
+                }
+                s_FmodAudioCache->Prefetch(std::move(file_paths));
+            }
+        }
+
+        return s_FmodAudioCache->GetAudio(sample.FilePath);
+    }
+
+    static void ReleaseSoundBuffer(FMOD::Sound* sound)
+    {
+        std::lock_guard lock{ s_LazyLoadMutex };
+        s_SoundBuffers.erase(sound);
+    }
+
+    static inline std::mutex s_LazyLoadMutex;
+    static inline std::unordered_map<FMOD::Sound*, std::shared_ptr<const DecodedAudioBuffer>> s_SoundBuffers;
+    static inline std::set<std::pair<FMOD::Bank*, std::uint32_t>> s_PrefetchedFsbFiles;
 };
 
 struct DetourFmodSystemCreateStream
@@ -877,7 +839,12 @@ struct DetourFmodSystemReleaseSound
         //	return FMOD::OK;
         //}
 
-        return Trampoline(sound);
+        const FMOD::FMOD_RESULT result = Trampoline(sound);
+        if (result == FMOD::OK && s_FmodAudioCache != nullptr)
+        {
+            DetourFmodSystemCreateSound::ReleaseSoundBuffer(sound);
+        }
+        return result;
     }
 };
 
@@ -926,3 +893,7 @@ void SetFmodVfs(VirtualFilesystem* vfs)
 {
     s_FmodVfs = vfs;
 }
+void SetFmodAudioCache(AudioCache* audio_cache)
+{
+    s_FmodAudioCache = audio_cache;
+}
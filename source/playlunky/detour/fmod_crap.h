@@ -5,3 +5,5 @@
 std::vector<struct DetourEntry> GetFmodDetours(const class PlaylunkySettings& settings);
 
 void SetFmodVfs(class VirtualFilesystem* vfs);
+// Enables decoding modded sounds on first use instead of when their bank is loaded, has to be set before banks are loaded
+void SetFmodAudioCache(class AudioCache* audio_cache);
@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 struct DetourDoLog
 {
@@ -62,6 +63,10 @@ std::vector<DetourEntry> GetLogDetours()
 
 void Log(std::string message, LogLevel log_level)
 {
+    // Mods are partially processed on worker threads, neither the game log nor the message list are thread-safe
+    static std::mutex s_LogMutex;
+    std::lock_guard lock{ s_LogMutex };
+
     LogLevel spelunky_log_level = static_cast<int>(log_level) > static_cast<int>(LogLevel::Fatal) ? LogLevel::Info : log_level;
     DetourDoLog::Log(message.c_str(), spelunky_log_level);
     if (log_level == LogLevel::Error)
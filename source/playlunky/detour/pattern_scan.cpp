@@ -0,0 +1,294 @@
+#include "pattern_scan.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define PATTERN_SCAN_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace SigScan
+{
+// Up to this many signatures a vectorized pass per signature, each stopping at its first match, is faster than one pass looking up each byte pair
+inline constexpr std::size_t c_MaxSignaturesForSeparatePasses{ 16 };
+
+// Bytes that are very frequent in x64 code, anchoring on them would produce too many false candidates
+static bool IsCommonByte(std::uint8_t byte)
+{
+    switch (byte)
+    {
+    case 0x00:
+    case 0x01:
+    case 0x0f:
+    case 0x24:
+    case 0x44:
+    case 0x48:
+    case 0x4c:
+    case 0x89:
+    case 0x8b:
+    case 0xc0:
+    case 0xcc:
+    case 0xe8:
+    case 0xff:
+        return true;
+    default:
+        return false;
+    }
+}
+static bool IsWildcard(char c)
+{
+    return c == '*';
+}
+
+// Runs of bytes without wildcards, compared with memcmp when verifying candidates
+struct PatternLiteral
+{
+    std::uint32_t Offset;
+    std::uint32_t Size;
+};
+struct CompiledPattern
+{
+    std::string_view Signature;
+    std::vector<PatternLiteral> Literals;
+
+    // Every match has this byte at the anchor offset, followed by the second anchor byte unless the anchor is a single byte
+    std::size_t Anchor;
+    std::uint8_t FirstAnchorByte;
+    std::uint8_t SecondAnchorByte;
+    bool SingleByteAnchor;
+};
+
+static CompiledPattern CompilePattern(std::string_view signature)
+{
+    CompiledPattern pattern{
+        .Signature{ signature },
+        .Literals{},
+        .Anchor{ 0 },
+        .FirstAnchorByte{ 0 },
+        .SecondAnchorByte{ 0 },
+        .SingleByteAnchor{ true },
+    };
+
+    for (std::size_t i = 0; i < signature.size();)
+    {
+        if (IsWildcard(signature[i]))
+        {
+            i++;
+            continue;
+        }
+
+        const std::size_t begin = i;
+        while (i < signature.size() && !IsWildcard(signature[i]))
+        {
+            i++;
+        }
+        pattern.Literals.push_back(PatternLiteral{
+            .Offset{ static_cast<std::uint32_t>(begin) },
+            .Size{ static_cast<std::uint32_t>(i - begin) },
+        });
+    }
+
+    // Prefer a pair of adjacent bytes where neither is common, fall back to a single byte for signatures without adjacent bytes
+    int best_score{ -1 };
+    for (const PatternLiteral& literal : pattern.Literals)
+    {
+        for (std::size_t i = literal.Offset; i < literal.Offset + literal.Size; i++)
+        {
+            const std::uint8_t first = static_cast<std::uint8_t>(signature[i]);
+            const bool has_second = i + 1 < literal.Offset + literal.Size;
+            const std::uint8_t second = has_second ? static_cast<std::uint8_t>(signature[i + 1]) : 0;
+            const int score = (IsCommonByte(first) ? 0 : 1) + (has_second ? (IsCommonByte(second) ? 1 : 2) : 0);
+            if (score > best_score)
+            {
+                best_score = score;
+                pattern.Anchor = i;
+                pattern.FirstAnchorByte = first;
+                pattern.SecondAnchorByte = second;
+                pattern.SingleByteAnchor = !has_second;
+            }
+        }
+    }
+
+    return pattern;
+}
+
+static bool VerifyPattern(std::span<const std::uint8_t> data, std::size_t offset, const CompiledPattern& pattern)
+{
+    if (offset > data.size() || data.size() - offset < pattern.Signature.size())
+    {
+        return false;
+    }
+
+    const std::uint8_t* match = data.data() + offset;
+    return std::all_of(pattern.Literals.begin(), pattern.Literals.end(), [&](const PatternLiteral& literal)
+                       { return std::memcmp(match + literal.Offset, pattern.Signature.data() + literal.Offset, literal.Size) == 0; });
+}
+
+static std::size_t FindCompiledPattern(std::span<const std::uint8_t> data, const CompiledPattern& pattern)
+{
+    if (data.size() < pattern.Signature.size())
+    {
+        return c_PatternNotFound;
+    }
+    if (pattern.Literals.empty())
+    {
+        return 0;
+    }
+
+    // Candidates are positions of the anchor, the match starts pattern.Anchor bytes earlier
+    const std::size_t first_candidate = pattern.Anchor;
+    const std::size_t end_candidate = data.size() - pattern.Signature.size() + pattern.Anchor + 1;
+    std::size_t candidate = first_candidate;
+
+#ifdef PATTERN_SCAN_USE_SSE2
+    {
+        const __m128i first_byte = _mm_set1_epi8(static_cast<char>(pattern.FirstAnchorByte));
+        const __m128i second_byte = _mm_set1_epi8(static_cast<char>(pattern.SecondAnchorByte));
+
+        // The second anchor byte of the last candidate is inside the signature, so reading one byte past the candidates is safe
+        for (; candidate + 16 <= end_candidate; candidate += 16)
+        {
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + candidate));
+            __m128i matches = _mm_cmpeq_epi8(first, first_byte);
+            if (!pattern.SingleByteAnchor)
+            {
+                const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + candidate + 1));
+                matches = _mm_and_si128(matches, _mm_cmpeq_epi8(second, second_byte));
+            }
+
+            std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+            while (mask != 0)
+            {
+                const std::size_t offset = candidate + std::countr_zero(mask) - pattern.Anchor;
+                if (VerifyPattern(data, offset, pattern))
+                {
+                    return offset;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; candidate < end_candidate; candidate++)
+    {
+        if (data[candidate] == pattern.FirstAnchorByte && (pattern.SingleByteAnchor || data[candidate + 1] == pattern.SecondAnchorByte))
+        {
+            const std::size_t offset = candidate - pattern.Anchor;
+            if (VerifyPattern(data, offset, pattern))
+            {
+                return offset;
+            }
+        }
+    }
+
+    return c_PatternNotFound;
+}
+
+std::size_t FindPatternOffset(std::span<const std::uint8_t> data, std::string_view signature)
+{
+    return FindCompiledPattern(data, CompilePattern(signature));
+}
+
+std::vector<std::size_t> FindPatternOffsets(std::span<const std::uint8_t> data, std::span<const std::string_view> signatures)
+{
+    std::vector<std::size_t> offsets(signatures.size(), c_PatternNotFound);
+
+    std::vector<CompiledPattern> patterns;
+    patterns.reserve(signatures.size());
+    for (std::string_view signature : signatures)
+    {
+        patterns.push_back(CompilePattern(signature));
+    }
+
+    if (signatures.size() <= c_MaxSignaturesForSeparatePasses)
+    {
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            offsets[i] = FindCompiledPattern(data, patterns[i]);
+        }
+        return offsets;
+    }
+
+    // Maps pairs of adjacent bytes, first byte in the low bits, to the patterns anchored on them
+    // A bitset of all anchor pairs filters candidates before the sorted list of anchors is searched
+    std::vector<std::pair<std::uint16_t, std::uint32_t>> anchors;
+    std::size_t num_unresolved{ 0 };
+    for (std::uint32_t i = 0; i < patterns.size(); i++)
+    {
+        const CompiledPattern& pattern = patterns[i];
+        if (data.size() < pattern.Signature.size())
+        {
+            continue;
+        }
+        if (pattern.Literals.empty())
+        {
+            offsets[i] = 0;
+            continue;
+        }
+
+        if (pattern.SingleByteAnchor)
+        {
+            for (std::uint32_t second = 0; second < 256; second++)
+            {
+                anchors.push_back({ static_cast<std::uint16_t>(pattern.FirstAnchorByte | (second << 8)), i });
+            }
+        }
+        else
+        {
+            anchors.push_back({ static_cast<std::uint16_t>(pattern.FirstAnchorByte | (pattern.SecondAnchorByte << 8)), i });
+        }
+        num_unresolved++;
+    }
+    std::sort(anchors.begin(), anchors.end());
+
+    std::array<std::uint64_t, 65536 / 64> anchor_bits{};
+    for (const auto& [anchor, pattern_index] : anchors)
+    {
+        anchor_bits[anchor / 64] |= 1ull << (anchor % 64);
+    }
+
+    auto check_candidates = [&](std::size_t position, std::uint16_t anchor)
+    {
+        auto it = std::lower_bound(anchors.begin(), anchors.end(), std::pair<std::uint16_t, std::uint32_t>{ anchor, 0 });
+        for (; it != anchors.end() && it->first == anchor; ++it)
+        {
+            const std::uint32_t pattern_index = it->second;
+            const CompiledPattern& pattern = patterns[pattern_index];
+            if (offsets[pattern_index] == c_PatternNotFound && position >= pattern.Anchor && VerifyPattern(data, position - pattern.Anchor, pattern))
+            {
+                offsets[pattern_index] = position - pattern.Anchor;
+                num_unresolved--;
+            }
+        }
+    };
+
+    const std::uint8_t* bytes = data.data();
+    for (std::size_t position = 0; position + 1 < data.size() && num_unresolved > 0; position++)
+    {
+        std::uint16_t anchor;
+        std::memcpy(&anchor, bytes + position, sizeof(anchor));
+        if ((anchor_bits[anchor / 64] >> (anchor % 64)) & 1)
+        {
+            check_candidates(position, anchor);
+        }
+    }
+
+    // Only single byte anchors can be at the last byte, they are registered for every second byte
+    if (num_unresolved > 0 && !data.empty())
+    {
+        check_candidates(data.size() - 1, bytes[data.size() - 1]);
+    }
+
+    return offsets;
+}
+
+bool MatchesPattern(std::span<const std::uint8_t> data, std::size_t offset, std::string_view signature)
+{
+    return VerifyPattern(data, offset, CompilePattern(signature));
+}
+}; // namespace SigScan
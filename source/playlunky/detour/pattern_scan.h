@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Platform independent core of the signature scanner, signatures are raw bytes in which '*' matches any byte
+// All offsets are relative to the start of the scanned data
+namespace SigScan
+{
+inline constexpr std::size_t c_PatternNotFound{ std::numeric_limits<std::size_t>::max() };
+
+// Offset of the first match of the signature, c_PatternNotFound if there is none
+std::size_t FindPatternOffset(std::span<const std::uint8_t> data, std::string_view signature);
+// Offsets of the first match of each signature, the same as calling FindPatternOffset for each signature but reads the data only once
+std::vector<std::size_t> FindPatternOffsets(std::span<const std::uint8_t> data, std::span<const std::string_view> signatures);
+
+bool MatchesPattern(std::span<const std::uint8_t> data, std::size_t offset, std::string_view signature);
+}; // namespace SigScan
@@ -0,0 +1,156 @@
+#include "signature_cache.h"
+
+#include "pattern_scan.h"
+#include "util/content_hash.h"
+
+#include <array>
+#include <fstream>
+#include <span>
+
+static constexpr std::array<char, 4> s_SignatureCacheMagic{ 'P', 'L', 'S', 'C' };
+static constexpr std::uint32_t s_SignatureCacheVersion{ 1 };
+
+struct SignatureCacheHeader
+{
+    std::array<char, 4> Magic;
+    std::uint32_t Version;
+    std::uint64_t NumEntries;
+};
+static_assert(sizeof(SignatureCacheHeader) == 16);
+
+struct SignatureCacheFileEntry
+{
+    std::uint64_t ModuleFileSize;
+    std::uint64_t ModuleHeaderHash;
+    std::uint64_t SignatureHash;
+    std::uint64_t Offset;
+};
+static_assert(sizeof(SignatureCacheFileEntry) == 32);
+
+static std::uint64_t HashSignature(std::string_view signature)
+{
+    return HashContent({ reinterpret_cast<const std::uint8_t*>(signature.data()), signature.size() });
+}
+
+SignatureCache SignatureCache::ReadFromFile(const std::filesystem::path& cache_path)
+{
+    SignatureCache cache;
+
+    std::ifstream cache_file(cache_path, std::ios::binary);
+    if (!cache_file)
+    {
+        return cache;
+    }
+
+    SignatureCacheHeader header{};
+    cache_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!cache_file || header.Magic != s_SignatureCacheMagic || header.Version != s_SignatureCacheVersion)
+    {
+        return cache;
+    }
+
+    for (std::uint64_t i = 0; i < header.NumEntries; i++)
+    {
+        SignatureCacheFileEntry entry{};
+        cache_file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        if (!cache_file)
+        {
+            return SignatureCache{};
+        }
+
+        const SigScan::ModuleIdentity module{
+            .FileSize{ entry.ModuleFileSize },
+            .HeaderHash{ entry.ModuleHeaderHash },
+        };
+        cache.m_Entries[GetKey(module, entry.SignatureHash)] = CacheEntry{
+            .Module{ module },
+            .SignatureHash{ entry.SignatureHash },
+            .Offset{ entry.Offset },
+            .Used{ false },
+        };
+    }
+
+    return cache;
+}
+
+bool SignatureCache::WriteToFile(const std::filesystem::path& cache_path) const
+{
+    namespace fs = std::filesystem;
+    {
+        const auto parent_path = cache_path.parent_path();
+        std::error_code ec;
+        if (!parent_path.empty() && !fs::exists(parent_path) && !fs::create_directory(parent_path, ec))
+        {
+            return false;
+        }
+    }
+
+    std::ofstream cache_file(cache_path, std::ios::binary | std::ios::trunc);
+    if (!cache_file)
+    {
+        return false;
+    }
+
+    std::uint64_t num_used_entries{ 0 };
+    for (const auto& [key, entry] : m_Entries)
+    {
+        num_used_entries += entry.Used ? 1 : 0;
+    }
+
+    const SignatureCacheHeader header{
+        .Magic{ s_SignatureCacheMagic },
+        .Version{ s_SignatureCacheVersion },
+        .NumEntries{ num_used_entries },
+    };
+    cache_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& [key, entry] : m_Entries)
+    {
+        if (entry.Used)
+        {
+            const SignatureCacheFileEntry file_entry{
+                .ModuleFileSize{ entry.Module.FileSize },
+                .ModuleHeaderHash{ entry.Module.HeaderHash },
+                .SignatureHash{ entry.SignatureHash },
+                .Offset{ entry.Offset },
+            };
+            cache_file.write(reinterpret_cast<const char*>(&file_entry), sizeof(file_entry));
+        }
+    }
+
+    return static_cast<bool>(cache_file);
+}
+
+std::optional<std::size_t> SignatureCache::Find(const SigScan::ModuleIdentity& module, std::string_view signature)
+{
+    const std::uint64_t signature_hash = HashSignature(signature);
+    const auto it = m_Entries.find(GetKey(module, signature_hash));
+    if (it == m_Entries.end() || it->second.Module != module || it->second.SignatureHash != signature_hash || it->second.Offset == SigScan::c_PatternNotFound)
+    {
+        return std::nullopt;
+    }
+
+    it->second.Used = true;
+    return static_cast<std::size_t>(it->second.Offset);
+}
+void SignatureCache::Store(const SigScan::ModuleIdentity& module, std::string_view signature, std::size_t offset)
+{
+    if (offset == SigScan::c_PatternNotFound)
+    {
+        return;
+    }
+
+    const std::uint64_t signature_hash = HashSignature(signature);
+    m_Entries[GetKey(module, signature_hash)] = CacheEntry{
+        .Module{ module },
+        .SignatureHash{ signature_hash },
+        .Offset{ static_cast<std::uint64_t>(offset) },
+        .Used{ true },
+    };
+}
+
+std::uint64_t SignatureCache::GetKey(const SigScan::ModuleIdentity& module, std::uint64_t signature_hash)
+{
+    const std::array<std::uint64_t, 3> key_data{ module.FileSize, module.HeaderHash, signature_hash };
+    return HashContent({ reinterpret_cast<const std::uint8_t*>(key_data.data()), sizeof(key_data) });
+}
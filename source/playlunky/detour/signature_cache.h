@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sigscan.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+// Offsets of signatures found in earlier runs, relative to the base of their module and only valid for the same build of the module
+class SignatureCache
+{
+  public:
+    // Returns an empty cache if the file does not exist or is corrupt
+    static SignatureCache ReadFromFile(const std::filesystem::path& cache_path);
+    // Only writes entries that were looked up or stored since reading, so entries of outdated builds are dropped
+    // Creates the folder of the cache file but never its parents, so the cache can not create the Mods folders
+    bool WriteToFile(const std::filesystem::path& cache_path) const;
+
+    // Returns nullopt if the signature was not found in this build yet, misses are not cached since a scan could find them later
+    std::optional<std::size_t> Find(const SigScan::ModuleIdentity& module, std::string_view signature);
+    void Store(const SigScan::ModuleIdentity& module, std::string_view signature, std::size_t offset);
+
+  private:
+    struct CacheEntry
+    {
+        SigScan::ModuleIdentity Module;
+        std::uint64_t SignatureHash;
+        std::uint64_t Offset;
+        bool Used;
+    };
+    static std::uint64_t GetKey(const SigScan::ModuleIdentity& module, std::uint64_t signature_hash);
+
+    std::unordered_map<std::uint64_t, CacheEntry> m_Entries;
+};
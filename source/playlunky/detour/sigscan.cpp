@@ -1,5 +1,8 @@
 #include "sigscan.h"
 
+#include "pattern_scan.h"
+#include "util/content_hash.h"
+
 // clang-format off
 #include <Windows.h>
 #include <winnt.h>
@@ -7,6 +10,7 @@
 // clang-format on
 
 #include <cstdint>
+#include <filesystem>
 #include <span>
 
 namespace SigScan
@@ -24,24 +28,9 @@ void* FindFunctionStart(void* in_function_body)
 
 void* FindPattern(std::string_view signature, void* from, void* to)
 {
-    const std::size_t size = (char*)to - (char*)from;
-    const std::size_t sig_length = signature.size();
-
-    for (std::size_t j = 0; j < size - sig_length; j++)
-    {
-        bool found = true;
-        for (std::size_t k = 0; k < sig_length && found; k++)
-        {
-            found = signature[k] == '*' || signature[k] == *((char*)from + j + k);
-        }
-
-        if (found)
-        {
-            return (char*)from + j;
-        }
-    }
-
-    return nullptr;
+    const std::span<const std::uint8_t> data{ (const std::uint8_t*)from, (std::size_t)((char*)to - (char*)from) };
+    const std::size_t offset = FindPatternOffset(data, signature);
+    return offset != c_PatternNotFound ? (char*)from + offset : nullptr;
 }
 
 MODULEINFO GetModuleInfo(HMODULE module)
@@ -86,11 +75,10 @@ std::size_t GetDataBundleSize(std::size_t bundle_start)
     return bundle_size;
 }
 
-void* FindPattern(const char* module_name, std::string_view signature, bool code_only)
+// The sections of the module that are searched for signatures, in the order they are searched
+std::vector<std::span<const std::uint8_t>> GetScanSections(const char* module_name, bool code_only)
 {
-    if (module_name == nullptr || signature.empty())
-        return nullptr;
-
+    std::vector<std::span<const std::uint8_t>> sections;
     if (HMODULE module = GetModuleHandleA(module_name))
     {
         MODULEINFO module_info = GetModuleInfo(module);
@@ -113,15 +101,101 @@ void* FindPattern(const char* module_name, std::string_view signature, bool code
                     section_start += GetDataBundleSize(section_base);
                 }
 
-                if (void* res = FindPattern(signature, (void*)(section_base + section_start), (void*)(section_base + size)))
-                {
-                    return res;
-                }
+                sections.push_back({ (const std::uint8_t*)(section_base + section_start), size - section_start });
             }
         }
     }
+    return sections;
+}
 
-    return nullptr;
+void* FindPattern(const char* module_name, std::string_view signature, bool code_only)
+{
+    return FindPatterns(module_name, std::span{ &signature, 1 }, code_only).front();
+}
+
+std::vector<void*> FindPatterns(const char* module_name, std::span<const std::string_view> signatures, bool code_only)
+{
+    std::vector<void*> results(signatures.size(), nullptr);
+    if (module_name == nullptr)
+        return results;
+
+    std::vector<std::size_t> pending_indices;
+    for (std::size_t i = 0; i < signatures.size(); i++)
+    {
+        if (!signatures[i].empty())
+        {
+            pending_indices.push_back(i);
+        }
+    }
+
+    for (std::span<const std::uint8_t> section : GetScanSections(module_name, code_only))
+    {
+        if (pending_indices.empty())
+        {
+            break;
+        }
+
+        std::vector<std::string_view> pending_signatures;
+        for (std::size_t i : pending_indices)
+        {
+            pending_signatures.push_back(signatures[i]);
+        }
+
+        const std::vector<std::size_t> offsets = FindPatternOffsets(section, pending_signatures);
+
+        std::vector<std::size_t> still_pending_indices;
+        for (std::size_t j = 0; j < pending_indices.size(); j++)
+        {
+            if (offsets[j] != c_PatternNotFound)
+            {
+                results[pending_indices[j]] = (void*)(section.data() + offsets[j]);
+            }
+            else
+            {
+                still_pending_indices.push_back(pending_indices[j]);
+            }
+        }
+        pending_indices = std::move(still_pending_indices);
+    }
+
+    return results;
+}
+
+bool MatchesPattern(const void* address, std::string_view signature)
+{
+    return SigScan::MatchesPattern({ (const std::uint8_t*)address, signature.size() }, 0, signature);
+}
+
+std::optional<ModuleIdentity> GetModuleIdentity(const char* module_name)
+{
+    if (module_name == nullptr)
+        return std::nullopt;
+
+    if (HMODULE module = GetModuleHandleA(module_name))
+    {
+        wchar_t module_path[MAX_PATH];
+        if (GetModuleFileNameW(module, module_path, MAX_PATH) == 0)
+        {
+            return std::nullopt;
+        }
+
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(module_path, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+
+        // The headers hold the link timestamp, checksum and layout of all sections, so they change with every build
+        PIMAGE_NT_HEADERS64 nt_headers = RtlImageNtHeader(module);
+        const std::span<const std::uint8_t> headers{ (const std::uint8_t*)module, (std::size_t)nt_headers->OptionalHeader.SizeOfHeaders };
+        return ModuleIdentity{
+            .FileSize{ file_size },
+            .HeaderHash{ HashContent(headers) },
+        };
+    }
+
+    return std::nullopt;
 }
 
 void* GetFromOffset(const char* module_name, std::size_t offset)
@@ -160,9 +234,9 @@ std::ptrdiff_t GetOffset(const void* address)
     return GetOffset(module_name, address);
 }
 
-void* GetDataSection()
+std::span<const std::uint8_t> GetDataSection()
 {
-    static void* const data_bundle_section = []() -> void*
+    static const std::span<const std::uint8_t> data_bundle_section = []() -> std::span<const std::uint8_t>
     {
         char module_name[MAX_PATH];
         GetModuleFileNameA(0, module_name, MAX_PATH);
@@ -177,12 +251,12 @@ void* GetDataSection()
                 if (strcmp((const char*)section.Name, ".text") == 0)
                 {
                     std::size_t section_base = base + (std::size_t)section.VirtualAddress;
-                    return (void*)section_base;
+                    return { (const std::uint8_t*)section_base, (std::size_t)section.Misc.VirtualSize };
                 }
             }
         }
 
-        return nullptr;
+        return {};
     }();
     return data_bundle_section;
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace SigScan
 {
@@ -8,6 +12,19 @@ void* FindFunctionStart(void* in_function_body);
 
 void* FindPattern(std::string_view signature, void* from, void* to);
 void* FindPattern(const char* module_name, std::string_view signature, bool code_only);
+// Same as calling FindPattern for each signature, but scans each section of the module only once
+std::vector<void*> FindPatterns(const char* module_name, std::span<const std::string_view> signatures, bool code_only);
+bool MatchesPattern(const void* address, std::string_view signature);
+
+// Identifies the build of a module, offsets found in one build are only valid in modules of the same identity
+struct ModuleIdentity
+{
+    std::uint64_t FileSize;
+    std::uint64_t HeaderHash;
+
+    bool operator==(const ModuleIdentity&) const = default;
+};
+std::optional<ModuleIdentity> GetModuleIdentity(const char* module_name);
 
 void* GetFromOffset(const char* module_name, std::size_t offset);
 
@@ -15,5 +32,6 @@ using ptrdiff_t = decltype((char*)nullptr - (char*)nullptr);
 ptrdiff_t GetOffset(const char* module_name, const void* address);
 ptrdiff_t GetOffset(const void* address);
 
-void* GetDataSection();
+// The section of Spel2.exe that contains the bundled game assets
+std::span<const std::uint8_t> GetDataSection();
 }; // namespace SigScan
\ No newline at end of file
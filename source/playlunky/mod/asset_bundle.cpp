@@ -0,0 +1,237 @@
+#include "asset_bundle.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+static constexpr std::array<char, 4> s_AssetBundleIndexMagic{ 'P', 'L', 'B', 'I' };
+static constexpr std::uint32_t s_AssetBundleIndexVersion{ 1 };
+
+struct AssetBundleIndexHeader
+{
+    std::array<char, 4> Magic;
+    std::uint32_t Version;
+    std::uint64_t SourceFileSize;
+    std::int64_t SourceWriteTime;
+    std::uint64_t Key;
+    std::uint64_t NumAssets;
+};
+static_assert(sizeof(AssetBundleIndexHeader) == 40);
+
+struct AssetBundleIndexEntry
+{
+    std::uint64_t Offset;
+    std::uint64_t Size;
+    std::uint32_t NameHashSize;
+    std::uint32_t Encrypted;
+};
+static_assert(sizeof(AssetBundleIndexEntry) == 24);
+
+AssetBundleIndex::AssetBundleIndex(std::uint64_t key, std::vector<AssetBundleEntry> assets)
+    : m_Key{ key }
+    , m_Assets{ std::move(assets) }
+{
+    BuildLookup();
+}
+
+std::optional<AssetBundleIndex> AssetBundleIndex::Parse(std::span<const std::uint8_t> bundle_data)
+{
+    std::size_t offset{ 0 };
+    auto read = [&](void* destination, std::size_t size)
+    {
+        if (bundle_data.size() - offset < size)
+        {
+            return false;
+        }
+        std::memcpy(destination, bundle_data.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    ChaCha::Key key;
+    std::vector<AssetBundleEntry> assets;
+    while (true)
+    {
+        std::uint32_t asset_len;
+        std::uint32_t asset_name_len;
+        if (!read(&asset_len, sizeof(asset_len)) || !read(&asset_name_len, sizeof(asset_name_len)))
+        {
+            return std::nullopt;
+        }
+
+        if (asset_len == 0 && asset_name_len == 0)
+        {
+            break;
+        }
+
+        ChaCha::bytes_t asset_name_hash(asset_name_len);
+        char encrypted;
+        if (asset_len == 0 || !read(asset_name_hash.data(), asset_name_len) || !read(&encrypted, sizeof(encrypted)))
+        {
+            return std::nullopt;
+        }
+
+        // The asset length includes the encryption flag
+        const std::size_t data_size = asset_len - 1;
+        if (bundle_data.size() - offset < data_size)
+        {
+            return std::nullopt;
+        }
+
+        assets.push_back(AssetBundleEntry{
+            .Offset{ offset },
+            .Size{ data_size },
+            .Encrypted{ encrypted == '\x01' },
+            .NameHash{ std::move(asset_name_hash) } });
+        offset += data_size;
+
+        key.update(asset_len);
+    }
+
+    return AssetBundleIndex{ key.Current, std::move(assets) };
+}
+
+std::optional<AssetBundleIndex> AssetBundleIndex::ReadFromFile(const std::filesystem::path& index_path, const AssetBundleSource& source, std::uint64_t bundle_size)
+{
+    std::ifstream index_file(index_path, std::ios::binary);
+    if (!index_file)
+    {
+        return std::nullopt;
+    }
+
+    AssetBundleIndexHeader header{};
+    index_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!index_file || header.Magic != s_AssetBundleIndexMagic || header.Version != s_AssetBundleIndexVersion)
+    {
+        return std::nullopt;
+    }
+
+    if (AssetBundleSource{ header.SourceFileSize, header.SourceWriteTime } != source)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<AssetBundleEntry> assets;
+    for (std::uint64_t i = 0; i < header.NumAssets; i++)
+    {
+        AssetBundleIndexEntry entry{};
+        index_file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        if (!index_file || entry.NameHashSize > 1024)
+        {
+            return std::nullopt;
+        }
+
+        // Assets are read straight from the bundle, so an entry outside of it must never be trusted
+        if (entry.Offset > bundle_size || entry.Size > bundle_size - entry.Offset)
+        {
+            return std::nullopt;
+        }
+
+        ChaCha::bytes_t name_hash(entry.NameHashSize);
+        index_file.read(reinterpret_cast<char*>(name_hash.data()), name_hash.size());
+        if (!index_file)
+        {
+            return std::nullopt;
+        }
+
+        assets.push_back(AssetBundleEntry{
+            .Offset{ entry.Offset },
+            .Size{ entry.Size },
+            .Encrypted{ entry.Encrypted != 0 },
+            .NameHash{ std::move(name_hash) } });
+    }
+
+    return AssetBundleIndex{ header.Key, std::move(assets) };
+}
+
+bool AssetBundleIndex::WriteToFile(const std::filesystem::path& index_path, const AssetBundleSource& source) const
+{
+    namespace fs = std::filesystem;
+    {
+        const auto parent_path = index_path.parent_path();
+        if (!parent_path.empty() && !fs::exists(parent_path) && !fs::create_directories(parent_path))
+        {
+            return false;
+        }
+    }
+
+    std::ofstream index_file(index_path, std::ios::binary | std::ios::trunc);
+    if (!index_file)
+    {
+        return false;
+    }
+
+    const AssetBundleIndexHeader header{
+        .Magic{ s_AssetBundleIndexMagic },
+        .Version{ s_AssetBundleIndexVersion },
+        .SourceFileSize{ source.FileSize },
+        .SourceWriteTime{ source.WriteTime },
+        .Key{ m_Key },
+        .NumAssets{ m_Assets.size() },
+    };
+    index_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const AssetBundleEntry& asset : m_Assets)
+    {
+        const AssetBundleIndexEntry entry{
+            .Offset{ asset.Offset },
+            .Size{ asset.Size },
+            .NameHashSize{ static_cast<std::uint32_t>(asset.NameHash.size()) },
+            .Encrypted{ asset.Encrypted ? 1u : 0u },
+        };
+        index_file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        index_file.write(reinterpret_cast<const char*>(asset.NameHash.data()), asset.NameHash.size());
+    }
+
+    return static_cast<bool>(index_file);
+}
+
+const AssetBundleEntry* AssetBundleIndex::FindAsset(std::string_view file_path) const
+{
+    const ChaCha::bytes_t hash = ChaCha::hash_filepath(file_path, m_Key);
+    if (hash.size() < m_LookupHashSize)
+    {
+        return nullptr;
+    }
+
+    // Names match if one hash is a prefix of the other, same as when walking the bundle
+    const std::string lookup_key{ reinterpret_cast<const char*>(hash.data()), m_LookupHashSize };
+    const auto [begin, end] = m_Lookup.equal_range(lookup_key);
+
+    const AssetBundleEntry* found_asset{ nullptr };
+    for (auto it = begin; it != end; ++it)
+    {
+        const AssetBundleEntry& asset = m_Assets[it->second];
+        const std::size_t min_size = std::min(hash.size(), asset.NameHash.size());
+        if (std::equal(hash.begin(), hash.begin() + min_size, asset.NameHash.begin()))
+        {
+            // Prefer the first asset in the bundle
+            if (found_asset == nullptr || asset.Offset < found_asset->Offset)
+            {
+                found_asset = &asset;
+            }
+        }
+    }
+    return found_asset;
+}
+
+void AssetBundleIndex::BuildLookup()
+{
+    m_Lookup.clear();
+    if (m_Assets.empty())
+    {
+        m_LookupHashSize = 0;
+        return;
+    }
+
+    m_LookupHashSize = std::min_element(m_Assets.begin(), m_Assets.end(), [](const AssetBundleEntry& lhs, const AssetBundleEntry& rhs)
+                                        { return lhs.NameHash.size() < rhs.NameHash.size(); })
+                           ->NameHash.size();
+    m_Lookup.reserve(m_Assets.size());
+    for (std::size_t i = 0; i < m_Assets.size(); i++)
+    {
+        const ChaCha::bytes_t& name_hash = m_Assets[i].NameHash;
+        m_Lookup.emplace(std::string{ reinterpret_cast<const char*>(name_hash.data()), m_LookupHashSize }, i);
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "chacha.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct AssetBundleEntry
+{
+    std::uint64_t Offset; // Relative to the start of the bundle
+    std::uint64_t Size;
+    bool Encrypted;
+    ChaCha::bytes_t NameHash;
+};
+
+// Identifies the exe an index was created from, indices of other exes are stale
+struct AssetBundleSource
+{
+    std::uint64_t FileSize;
+    std::int64_t WriteTime;
+
+    bool operator==(const AssetBundleSource&) const = default;
+};
+
+// Table of contents of the asset bundle in Spel2.exe, so assets can be looked up without walking the whole bundle
+class AssetBundleIndex
+{
+  public:
+    AssetBundleIndex(std::uint64_t key, std::vector<AssetBundleEntry> assets);
+    AssetBundleIndex(const AssetBundleIndex&) = delete;
+    AssetBundleIndex(AssetBundleIndex&&) = default;
+    AssetBundleIndex& operator=(const AssetBundleIndex&) = delete;
+    AssetBundleIndex& operator=(AssetBundleIndex&&) = default;
+    ~AssetBundleIndex() = default;
+
+    // Walks the bundle up to its terminating empty entry, returns nullopt if the bundle runs past the end of the data
+    static std::optional<AssetBundleIndex> Parse(std::span<const std::uint8_t> bundle_data);
+
+    // Returns nullopt if the file does not exist, is corrupt, was written for a different source or has assets outside of the bundle
+    static std::optional<AssetBundleIndex> ReadFromFile(const std::filesystem::path& index_path, const AssetBundleSource& source, std::uint64_t bundle_size);
+    bool WriteToFile(const std::filesystem::path& index_path, const AssetBundleSource& source) const;
+
+    // The key after walking all assets, used to hash asset names and decrypt assets
+    std::uint64_t GetKey() const
+    {
+        return m_Key;
+    }
+    std::size_t GetNumAssets() const
+    {
+        return m_Assets.size();
+    }
+
+    // Expects forward slashes in the path, e.g. "Data/Textures/char_yellow.DDS"
+    const AssetBundleEntry* FindAsset(std::string_view file_path) const;
+
+  private:
+    void BuildLookup();
+
+    std::uint64_t m_Key;
+    std::vector<AssetBundleEntry> m_Assets;
+
+    // Asset indices keyed by a prefix of their name hash, as long as the shortest name hash
+    std::size_t m_LookupHashSize{ 0 };
+    std::unordered_multimap<std::string, std::size_t> m_Lookup;
+};
@@ -0,0 +1,65 @@
+#include "audio_cache.h"
+
+#include "cache_audio_file.h"
+#include "log.h"
+#include "util/algorithms.h"
+
+static std::string GetCacheKey(const std::filesystem::path& file_path)
+{
+    return algo::to_lower(algo::path_string(file_path.lexically_normal()));
+}
+
+static LruCache<DecodedAudioBuffer>::LoadResult LoadAudio(const std::filesystem::path& file_path)
+{
+    DecodedAudioBuffer buffer{};
+    try
+    {
+        buffer = algo::is_same_path(file_path.extension(), ".raw")
+                     ? LoadCachedAudioFile(file_path)
+                     : DecodeAudioFile(file_path);
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Failed decoding audio file {}: {}", file_path.string(), e.what());
+    }
+
+    if (buffer.Data == nullptr || buffer.DataSize == 0)
+    {
+        return {};
+    }
+
+    const std::size_t buffer_size = buffer.DataSize;
+    return { std::make_shared<const DecodedAudioBuffer>(std::move(buffer)), buffer_size, true };
+}
+
+AudioCache::AudioCache(std::size_t budget_bytes)
+    : mBuffers{ budget_bytes }
+{
+}
+AudioCache::~AudioCache()
+{
+    // Pending prefetches are still run by the pool before it stops, make them return early
+    mStopPrefetching = true;
+}
+
+std::shared_ptr<const DecodedAudioBuffer> AudioCache::GetAudio(const std::filesystem::path& file_path)
+{
+    return mBuffers.Get(GetCacheKey(file_path), {}, [&]()
+                        { return LoadAudio(file_path); });
+}
+
+void AudioCache::Prefetch(std::vector<std::filesystem::path> file_paths)
+{
+    for (std::filesystem::path& file_path : file_paths)
+    {
+        mPrefetchPool.Submit([this, file_path = std::move(file_path)]()
+                             {
+                                 if (mStopPrefetching || mBuffers.IsFull())
+                                 {
+                                     return;
+                                 }
+
+                                 mBuffers.Prefetch(GetCacheKey(file_path), {}, [&]()
+                                                   { return LoadAudio(file_path); }); });
+    }
+}
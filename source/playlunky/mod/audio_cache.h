@@ -0,0 +1,35 @@
+#pragma once
+
+#include "decode_audio_file.h"
+#include "util/lru_cache.h"
+#include "util/thread_pool.h"
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Cache of decoded audio files for playback, .raw files written by CacheAudioFile are loaded instead of decoded
+class AudioCache
+{
+  public:
+    explicit AudioCache(std::size_t budget_bytes);
+    AudioCache(const AudioCache&) = delete;
+    AudioCache(AudioCache&&) = delete;
+    AudioCache& operator=(const AudioCache&) = delete;
+    AudioCache& operator=(AudioCache&&) = delete;
+    ~AudioCache();
+
+    // Returns nullptr if the file fails to load
+    std::shared_ptr<const DecodedAudioBuffer> GetAudio(const std::filesystem::path& file_path);
+
+    // Loads the files on a background thread, a file is only kept if it fits into the remaining budget
+    void Prefetch(std::vector<std::filesystem::path> file_paths);
+
+  private:
+    LruCache<DecodedAudioBuffer> mBuffers;
+
+    std::atomic_bool mStopPrefetching{ false };
+    // Declared last so that pending prefetches finish before the cache is destroyed
+    ThreadPool mPrefetchPool{ 1 };
+};
@@ -166,6 +166,7 @@ void BugFixesMount(VirtualFilesystem& vfs,
     vfs.MountFolder(bug_fixes_folder.string(), std::numeric_limits<int64_t>::max(), VfsType::Backend);
 }
 bool BugFixesInit(const PlaylunkySettings& settings,
+                  VirtualFilesystem& vfs,
                   const std::filesystem::path& db_folder,
                   const std::filesystem::path& original_data_folder)
 {
@@ -193,6 +194,7 @@ bool BugFixesInit(const PlaylunkySettings& settings,
             {
                 return false;
             }
+            vfs.RegisterNewFile(extra_thorns_dds_path);
         }
 
         Spelunky_TextureDefinition extra_thorns_texture_def{
@@ -235,6 +237,7 @@ bool BugFixesInit(const PlaylunkySettings& settings,
             {
                 return false;
             }
+            vfs.RegisterNewFile(extra_pipes_dds_path);
         }
 
         Spelunky_TextureDefinition extra_pipes_texture_def{
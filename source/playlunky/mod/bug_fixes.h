@@ -9,6 +9,7 @@ class VirtualFilesystem;
 void BugFixesMount(VirtualFilesystem& vfs,
                    const std::filesystem::path& db_folder);
 bool BugFixesInit(const PlaylunkySettings& settings,
+                  VirtualFilesystem& vfs,
                   const std::filesystem::path& db_folder,
                   const std::filesystem::path& original_data_folder);
 void BugFixesCleanup();
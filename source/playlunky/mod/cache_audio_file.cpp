@@ -2,29 +2,184 @@
 
 #include "decode_audio_file.h"
 #include "util/algorithms.h"
+#include "util/mapped_file.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include <zstd.h>
 
-#pragma warning(push, 0)
-#include <libnyquist/Decoders.h>
-#pragma warning(pop)
+// A cached audio file consists of the header, the path of the source file, the chunk table and the chunks
+// Each chunk is either zstd compressed or stored as is, which is the case if its stored size equals its size
+static constexpr std::array<char, 4> s_AudioCacheMagic{ 'P', 'L', 'A', 'C' };
+static constexpr std::uint32_t s_AudioCacheVersion{ 1 };
+static constexpr std::size_t s_AudioCacheChunkSize{ 256 * 1024 };
+static constexpr int s_AudioCacheCompressionLevel{ 3 };
+
+struct AudioCacheHeader
+{
+    std::array<char, 4> Magic;
+    std::uint32_t Version;
+    std::int32_t NumChannels;
+    std::int32_t Frequency;
+    std::int32_t Format;
+    std::uint32_t NumChunks;
+    std::uint64_t DataSize;
+    std::int64_t SourceWriteTime;
+    std::uint64_t SourceFileSize;
+    std::uint32_t SourcePathSize;
+    std::uint32_t Reserved;
+};
+static_assert(sizeof(AudioCacheHeader) == 56);
+
+struct AudioCacheChunk
+{
+    std::uint64_t StoredSize;
+    std::uint64_t Size;
+};
+static_assert(sizeof(AudioCacheChunk) == 16);
+
+struct AudioCacheSource
+{
+    std::string Path;
+    std::int64_t WriteTime;
+    std::uint64_t FileSize;
+};
 
 inline auto GetCachedAudioFilePath(const std::filesystem::path& file_path, const std::filesystem::path& output_path)
 {
     return output_path / "raw_audio" / file_path.filename().replace_extension(".raw");
 }
 
-bool IsSupportedAudioFile(const std::filesystem::path& file_path)
+static std::optional<AudioCacheSource> GetAudioCacheSource(const std::filesystem::path& file_path)
 {
-    static nqr::NyquistIO s_Loader;
-    return s_Loader.IsFileSupported(algo::to_lower(file_path.extension().string()));
+    std::error_code error_code;
+    const auto write_time = std::filesystem::last_write_time(file_path, error_code);
+    if (error_code)
+    {
+        return std::nullopt;
+    }
+    const auto file_size = std::filesystem::file_size(file_path, error_code);
+    if (error_code)
+    {
+        return std::nullopt;
+    }
+    return AudioCacheSource{
+        .Path{ algo::path_string(file_path) },
+        .WriteTime{ static_cast<std::int64_t>(write_time.time_since_epoch().count()) },
+        .FileSize{ file_size },
+    };
 }
-bool HasCachedAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path)
+
+// Returns the source a cached file was created from, nullopt if the file is not a valid cache of this version
+static std::optional<AudioCacheSource> ReadCachedAudioSource(const std::filesystem::path& cached_file_path)
+{
+    std::ifstream cached_file(cached_file_path, std::ios::binary);
+    if (!cached_file)
+    {
+        return std::nullopt;
+    }
+
+    AudioCacheHeader header{};
+    cached_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!cached_file || header.Magic != s_AudioCacheMagic || header.Version != s_AudioCacheVersion)
+    {
+        return std::nullopt;
+    }
+
+    std::string source_path(header.SourcePathSize, '\0');
+    cached_file.read(source_path.data(), source_path.size());
+    if (!cached_file)
+    {
+        return std::nullopt;
+    }
+
+    return AudioCacheSource{
+        .Path{ std::move(source_path) },
+        .WriteTime{ header.SourceWriteTime },
+        .FileSize{ header.SourceFileSize },
+    };
+}
+
+// Files with the same name share a cache file, so when a mod has multiple of those the one that would be found first
+// when loading loose audio files owns the cache, lower is preferred
+static std::size_t GetAudioSourcePriority(const std::filesystem::path& file_path)
+{
+    const std::filesystem::path parent_path = file_path.parent_path();
+    if (algo::is_same_path(parent_path.parent_path().filename(), "soundbank"))
+    {
+        const std::string folder = algo::to_lower(parent_path.filename().string());
+        const std::string extension = algo::to_lower(file_path.extension().string());
+        for (std::size_t i = 0; i < std::size(c_LooseAudioExtensions); i++)
+        {
+            if (folder == c_LooseAudioExtensions[i] && extension.substr(1) == c_LooseAudioExtensions[i])
+            {
+                return i;
+            }
+        }
+    }
+    return std::size(c_LooseAudioExtensions);
+}
+
+// Float samples are stored as 16 bit if they don't clip, the difference is inaudible and halves the size
+static bool ConvertToPcm16(DecodedAudioBuffer& buffer)
+{
+    if (buffer.Format != SoundFormat::PCM_FLOAT)
+    {
+        return false;
+    }
+
+    const std::size_t num_samples = buffer.DataSize / sizeof(float);
+    const float* samples = reinterpret_cast<const float*>(buffer.Data.get() + 16);
+    if (std::any_of(samples, samples + num_samples, [](float sample)
+                    { return !(std::abs(sample) <= 1.0f); }))
+    {
+        return false;
+    }
+
+    const std::size_t data_size = num_samples * sizeof(std::int16_t);
+    auto data = std::make_unique<std::byte[]>(data_size + 32); // 16 bytes padding front and back
+    std::int16_t* converted_samples = reinterpret_cast<std::int16_t*>(data.get() + 16);
+    for (std::size_t i = 0; i < num_samples; i++)
+    {
+        converted_samples[i] = static_cast<std::int16_t>(std::lround(samples[i] * 32767.0f));
+    }
+
+    buffer.Format = SoundFormat::PCM_16;
+    buffer.Data = std::move(data);
+    buffer.DataSize = data_size;
+    return true;
+}
+
+// Whether the cache belongs to another file with the same name that still exists and is preferred over file_path
+static bool IsCachedFromPreferredFile(const AudioCacheSource& cached_source, const std::filesystem::path& file_path)
 {
     namespace fs = std::filesystem;
-    const fs::path output_file_path = GetCachedAudioFilePath(file_path, output_path);
-    return fs::exists(output_file_path);
+    const fs::path cached_file_path{ cached_source.Path };
+    return !algo::is_same_path(cached_file_path, file_path) && fs::exists(cached_file_path) && GetAudioSourcePriority(cached_file_path) <= GetAudioSourcePriority(file_path);
+}
+
+bool HasCachedAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path)
+{
+    const auto cached_source = ReadCachedAudioSource(GetCachedAudioFilePath(file_path, output_path));
+    if (!cached_source.has_value())
+    {
+        return false;
+    }
+
+    if (algo::is_same_path(cached_source->Path, file_path))
+    {
+        const auto source = GetAudioCacheSource(file_path);
+        return source.has_value() && source->WriteTime == cached_source->WriteTime && source->FileSize == cached_source->FileSize;
+    }
+
+    return IsCachedFromPreferredFile(cached_source.value(), file_path);
 }
 void DeleteCachedAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path)
 {
@@ -32,6 +187,12 @@ void DeleteCachedAudioFile(const std::filesystem::path& file_path, const std::fi
     const fs::path output_file_path = GetCachedAudioFilePath(file_path, output_path);
     if (fs::exists(output_file_path))
     {
+        // Don't delete the cache of another file with the same name
+        const auto cached_source = ReadCachedAudioSource(output_file_path);
+        if (cached_source.has_value() && !algo::is_same_path(cached_source->Path, file_path))
+        {
+            return;
+        }
         fs::remove(output_file_path);
     }
 }
@@ -40,9 +201,28 @@ bool CacheAudioFile(const std::filesystem::path& file_path, const std::filesyste
     namespace fs = std::filesystem;
     const fs::path output_file_path = GetCachedAudioFilePath(file_path, output_path);
 
-    if (force || !fs::exists(output_file_path))
+    bool needs_caching{ false };
+    if (force)
+    {
+        // Even when forced, never overwrite the cache of a preferred file with the same name
+        const auto cached_source = ReadCachedAudioSource(output_file_path);
+        needs_caching = !cached_source.has_value() || !IsCachedFromPreferredFile(cached_source.value(), file_path);
+    }
+    else
+    {
+        needs_caching = !HasCachedAudioFile(file_path, output_path);
+    }
+
+    if (needs_caching)
     {
+        const auto source = GetAudioCacheSource(file_path);
+        if (!source.has_value())
+        {
+            return false;
+        }
+
         DecodedAudioBuffer buffer = DecodeAudioFile(file_path);
+        ConvertToPcm16(buffer);
 
         {
             const auto parent_path = output_file_path.parent_path();
@@ -54,12 +234,85 @@ bool CacheAudioFile(const std::filesystem::path& file_path, const std::filesyste
 
         if (buffer.DataSize > 0)
         {
-            std::ofstream output_file(output_file_path, std::ios::binary);
-            output_file.write(reinterpret_cast<const char*>(&buffer.NumChannels), sizeof(buffer.NumChannels));
-            output_file.write(reinterpret_cast<const char*>(&buffer.Frequency), sizeof(buffer.Frequency));
-            output_file.write(reinterpret_cast<const char*>(&buffer.Format), sizeof(buffer.Format));
-            output_file.write(reinterpret_cast<const char*>(&buffer.DataSize), sizeof(buffer.DataSize));
-            output_file.write(reinterpret_cast<const char*>(buffer.Data.get()), buffer.DataSize);
+            const std::byte* data = buffer.Data.get() + 16;
+            const std::size_t num_chunks = (buffer.DataSize + s_AudioCacheChunkSize - 1) / s_AudioCacheChunkSize;
+
+            std::vector<AudioCacheChunk> chunks(num_chunks);
+            std::vector<std::vector<char>> compressed_chunks(num_chunks);
+            for (std::size_t i = 0; i < num_chunks; i++)
+            {
+                const std::size_t chunk_offset = i * s_AudioCacheChunkSize;
+                const std::size_t chunk_size = std::min(s_AudioCacheChunkSize, buffer.DataSize - chunk_offset);
+
+                std::vector<char>& compressed_chunk = compressed_chunks[i];
+                compressed_chunk.resize(ZSTD_compressBound(chunk_size));
+                const std::size_t compressed_size = ZSTD_compress(compressed_chunk.data(), compressed_chunk.size(), data + chunk_offset, chunk_size, s_AudioCacheCompressionLevel);
+                if (!ZSTD_isError(compressed_size) && compressed_size < chunk_size)
+                {
+                    compressed_chunk.resize(compressed_size);
+                }
+                else
+                {
+                    compressed_chunk.clear();
+                }
+
+                chunks[i] = AudioCacheChunk{
+                    .StoredSize{ compressed_chunk.empty() ? chunk_size : compressed_chunk.size() },
+                    .Size{ chunk_size },
+                };
+            }
+
+            const AudioCacheHeader header{
+                .Magic{ s_AudioCacheMagic },
+                .Version{ s_AudioCacheVersion },
+                .NumChannels{ buffer.NumChannels },
+                .Frequency{ buffer.Frequency },
+                .Format{ static_cast<std::int32_t>(buffer.Format) },
+                .NumChunks{ static_cast<std::uint32_t>(num_chunks) },
+                .DataSize{ buffer.DataSize },
+                .SourceWriteTime{ source->WriteTime },
+                .SourceFileSize{ source->FileSize },
+                .SourcePathSize{ static_cast<std::uint32_t>(source->Path.size()) },
+                .Reserved{ 0 },
+            };
+
+            // Write to a temporary file first, a partially written cache would otherwise look up to date forever
+            fs::path temp_file_path = output_file_path;
+            temp_file_path += ".tmp";
+            {
+                std::ofstream output_file(temp_file_path, std::ios::binary | std::ios::trunc);
+                output_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                output_file.write(source->Path.data(), source->Path.size());
+                output_file.write(reinterpret_cast<const char*>(chunks.data()), chunks.size() * sizeof(AudioCacheChunk));
+                for (std::size_t i = 0; i < num_chunks; i++)
+                {
+                    if (compressed_chunks[i].empty())
+                    {
+                        output_file.write(reinterpret_cast<const char*>(data + i * s_AudioCacheChunkSize), chunks[i].Size);
+                    }
+                    else
+                    {
+                        output_file.write(compressed_chunks[i].data(), compressed_chunks[i].size());
+                    }
+                }
+                output_file.close();
+
+                if (!output_file)
+                {
+                    std::error_code ec;
+                    fs::remove(temp_file_path, ec);
+                    return false;
+                }
+            }
+
+            std::error_code ec;
+            fs::rename(temp_file_path, output_file_path, ec);
+            if (ec)
+            {
+                fs::remove(temp_file_path, ec);
+                return false;
+            }
+            return true;
         }
         else
         {
@@ -71,18 +324,77 @@ bool CacheAudioFile(const std::filesystem::path& file_path, const std::filesyste
 }
 DecodedAudioBuffer LoadCachedAudioFile(const std::filesystem::path& file_path)
 {
-    DecodedAudioBuffer buffer{};
+    const MappedFile cached_file{ file_path };
+    if (!cached_file.IsValid())
+    {
+        return {};
+    }
+
+    const std::span<const std::uint8_t> file_data = cached_file.GetData();
+    if (file_data.size() < sizeof(AudioCacheHeader))
+    {
+        return {};
+    }
+
+    AudioCacheHeader header;
+    std::memcpy(&header, file_data.data(), sizeof(header));
+    if (header.Magic != s_AudioCacheMagic || header.Version != s_AudioCacheVersion)
+    {
+        return {};
+    }
+
+    if (header.DataSize > std::uint64_t{ header.NumChunks } * s_AudioCacheChunkSize)
+    {
+        return {};
+    }
+
+    const std::size_t chunks_offset = sizeof(header) + header.SourcePathSize;
+    std::size_t stored_data_offset = chunks_offset + header.NumChunks * sizeof(AudioCacheChunk);
+    if (stored_data_offset > file_data.size())
+    {
+        return {};
+    }
+
+    auto data = std::make_unique<std::byte[]>(header.DataSize + 32); // 16 bytes padding front and back
+    std::size_t data_offset{ 0 };
+    for (std::uint32_t i = 0; i < header.NumChunks; i++)
+    {
+        AudioCacheChunk chunk;
+        std::memcpy(&chunk, file_data.data() + chunks_offset + i * sizeof(AudioCacheChunk), sizeof(chunk));
+        if (chunk.StoredSize > file_data.size() - stored_data_offset || chunk.Size > header.DataSize - data_offset)
+        {
+            return {};
+        }
+
+        const std::uint8_t* stored_data = file_data.data() + stored_data_offset;
+        std::byte* destination = data.get() + 16 + data_offset;
+        if (chunk.StoredSize == chunk.Size)
+        {
+            std::memcpy(destination, stored_data, chunk.Size);
+        }
+        else
+        {
+            const std::size_t decompressed_size = ZSTD_decompress(destination, chunk.Size, stored_data, chunk.StoredSize);
+            if (ZSTD_isError(decompressed_size) || decompressed_size != chunk.Size)
+            {
+                return {};
+            }
+        }
+
+        stored_data_offset += chunk.StoredSize;
+        data_offset += chunk.Size;
+    }
 
-    if (std::ifstream input_file = std::ifstream(file_path, std::ios::binary))
+    if (data_offset != header.DataSize)
     {
-        input_file.read(reinterpret_cast<char*>(&buffer.NumChannels), sizeof(buffer.NumChannels));
-        input_file.read(reinterpret_cast<char*>(&buffer.Frequency), sizeof(buffer.Frequency));
-        input_file.read(reinterpret_cast<char*>(&buffer.Format), sizeof(buffer.Format));
-        input_file.read(reinterpret_cast<char*>(&buffer.DataSize), sizeof(buffer.DataSize));
-        auto data = std::make_unique<std::byte[]>(buffer.DataSize + 32); // 16 bytes padding front and back
-        input_file.read(reinterpret_cast<char*>(data.get() + 16), buffer.DataSize);
-        buffer.Data = std::move(data);
+        return {};
     }
 
-    return buffer;
+    return DecodedAudioBuffer{
+        .NumChannels = header.NumChannels,
+        .Frequency = header.Frequency,
+        .Format = static_cast<SoundFormat>(header.Format),
+        .Data = std::move(data),
+        .DataSize = header.DataSize,
+    };
 }
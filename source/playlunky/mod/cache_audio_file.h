@@ -3,8 +3,13 @@
 #include "decode_audio_file.h"
 
 #include <filesystem>
+#include <string_view>
 
-bool IsSupportedAudioFile(const std::filesystem::path& file_path);
+// Loose audio files are looked up as soundbank/<ext>/<name>.<ext>, trying the extensions in this order
+inline constexpr std::string_view c_LooseAudioExtensions[]{ "wav", "ogg", "mp3", "wv", "opus", "flac", "mpc", "mpp" };
+
+// Cached files are named after the source file and store its path and last write time, they are only
+// up to date if those still match or if they were created from a preferred file with the same name
 bool HasCachedAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path);
 void DeleteCachedAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path);
 bool CacheAudioFile(const std::filesystem::path& file_path, const std::filesystem::path& output_path, bool force);
@@ -2,39 +2,50 @@
 
 #include <array>
 #include <cassert>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define CHACHA_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace ChaCha
 {
 // This implementation is a direct translation of Modlunky's chacha source
 // For reference see: https://github.com/spelunky-fyi/modlunky2/blob/1dd9acf7ae779d7ead82e7d74e2319dd46fef909/src/modlunky2/assets/chacha.py
 
-using words_t = std::vector<std::uint32_t>;
-using qwords_t = std::vector<std::uint64_t>;
-
-using s_bytes_t = std::array<uint8_t, 64>;
+// The 64 byte state, depending on the step it is treated as 16 words, 8 qwords or 64 bytes
+using state_t = std::array<std::uint32_t, 16>;
+static_assert(sizeof(state_t) == 64);
 
-using s_t = std::span<std::uint8_t, 64>;
-using w_t = std::span<std::uint32_t, 16>;
-using q_t = std::span<std::uint64_t, 8>;
+static constexpr std::size_t c_BlockSize{ 0x40 };
 
-w_t s_to_w(s_t s)
+std::uint8_t* state_bytes(state_t& s)
 {
-    return w_t{ reinterpret_cast<std::uint32_t*>(s.data()), s.size() / 4 };
+    return reinterpret_cast<std::uint8_t*>(s.data());
 }
-
-s_t w_to_s(w_t w)
+const std::uint8_t* state_bytes(const state_t& s)
 {
-    return s_t{ reinterpret_cast<std::uint8_t*>(w.data()), w.size() * 4 };
+    return reinterpret_cast<const std::uint8_t*>(s.data());
 }
 
-q_t s_to_q(s_t s)
+std::uint64_t get_qword(const state_t& s, std::size_t i)
+{
+    std::uint64_t qword;
+    std::memcpy(&qword, state_bytes(s) + i * 8, 8);
+    return qword;
+}
+void set_qword(state_t& s, std::size_t i, std::uint64_t qword)
 {
-    return q_t{ reinterpret_cast<std::uint64_t*>(s.data()), s.size() / 8 };
+    std::memcpy(state_bytes(s) + i * 8, &qword, 8);
 }
 
-s_t q_to_s(q_t q)
+state_t make_state(std::uint64_t q0, std::uint64_t q1)
 {
-    return s_t{ reinterpret_cast<std::uint8_t*>(q.data()), q.size() * 8 };
+    state_t s{};
+    set_qword(s, 0, q0);
+    set_qword(s, 1, q1);
+    return s;
 }
 
 template<class T>
@@ -46,7 +57,57 @@ T rotate_left(T a, int b)
     return (a << b) | (a >> (bits - b));
 }
 
-void quarter_round(w_t w, std::size_t a, std::size_t b, std::size_t c, std::size_t d)
+#ifdef CHACHA_USE_SSE2
+template<int B>
+__m128i rotate_left(__m128i a)
+{
+    return _mm_or_si128(_mm_slli_epi32(a, B), _mm_srli_epi32(a, 32 - B));
+}
+
+// Runs the quarter round on all four columns at once, each register holds one row of the state
+void quarter_round(__m128i& a, __m128i& b, __m128i& c, __m128i& d)
+{
+    a = _mm_add_epi32(a, b);
+    d = _mm_xor_si128(d, a);
+    d = rotate_left<16>(d);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = rotate_left<12>(b);
+    a = _mm_add_epi32(a, b);
+    d = _mm_xor_si128(d, a);
+    d = rotate_left<8>(d);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = rotate_left<7>(b);
+}
+
+void round_pairs(state_t& s, int num_round_pairs)
+{
+    __m128i* rows = reinterpret_cast<__m128i*>(s.data());
+    __m128i a = _mm_loadu_si128(rows + 0);
+    __m128i b = _mm_loadu_si128(rows + 1);
+    __m128i c = _mm_loadu_si128(rows + 2);
+    __m128i d = _mm_loadu_si128(rows + 3);
+    for (int i = 0; i < num_round_pairs; i++)
+    {
+        quarter_round(a, b, c, d);
+
+        // Rotate the rows so that the diagonals line up in columns
+        b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1));
+        c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3));
+        quarter_round(a, b, c, d);
+        b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3));
+        c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1));
+    }
+    _mm_storeu_si128(rows + 0, a);
+    _mm_storeu_si128(rows + 1, b);
+    _mm_storeu_si128(rows + 2, c);
+    _mm_storeu_si128(rows + 3, d);
+}
+#else
+void quarter_round(state_t& w, std::size_t a, std::size_t b, std::size_t c, std::size_t d)
 {
     w[a] += w[b];
     w[d] ^= w[a];
@@ -62,233 +123,193 @@ void quarter_round(w_t w, std::size_t a, std::size_t b, std::size_t c, std::size
     w[b] = rotate_left(w[b], 7);
 }
 
-void round_pair(w_t w)
-{
-    quarter_round(w, 0, 4, 8, 12);
-    quarter_round(w, 1, 5, 9, 13);
-    quarter_round(w, 2, 6, 10, 14);
-    quarter_round(w, 3, 7, 11, 15);
-    quarter_round(w, 0, 5, 10, 15);
-    quarter_round(w, 1, 6, 11, 12);
-    quarter_round(w, 2, 7, 8, 13);
-    quarter_round(w, 3, 4, 9, 14);
-}
-
-s_t two_rounds(s_t s)
+void round_pairs(state_t& s, int num_round_pairs)
 {
-    w_t w = s_to_w(s);
-    round_pair(w);
-    round_pair(w);
-    return w_to_s(w);
+    for (int i = 0; i < num_round_pairs; i++)
+    {
+        quarter_round(s, 0, 4, 8, 12);
+        quarter_round(s, 1, 5, 9, 13);
+        quarter_round(s, 2, 6, 10, 14);
+        quarter_round(s, 3, 7, 11, 15);
+        quarter_round(s, 0, 5, 10, 15);
+        quarter_round(s, 1, 6, 11, 12);
+        quarter_round(s, 2, 7, 8, 13);
+        quarter_round(s, 3, 4, 9, 14);
+    }
 }
+#endif
 
-s_t quad_rounds(s_t s)
+void two_rounds(state_t& s)
 {
-    w_t w = s_to_w(s);
-    round_pair(w);
-    round_pair(w);
-    round_pair(w);
-    round_pair(w);
-    return w_to_s(w);
+    round_pairs(s, 2);
 }
 
-bytes_t sxor(std::span<const std::uint8_t> x, std::span<const std::uint8_t> y)
+void quad_rounds(state_t& s)
 {
-    assert(x.size() == y.size());
-
-    bytes_t bytes(x.size());
-    for (size_t i = 0; i < bytes.size(); i++)
-    {
-        bytes[i] = x[i] ^ y[y.size() - 1 - i];
-    }
-    return bytes;
+    round_pairs(s, 4);
 }
 
-s_bytes_t add_qwords(s_t s0, s_t s1)
+// Adds the state advanced by four round pairs to itself
+void add_quad_rounds(state_t& s)
 {
-    q_t q0 = s_to_q(s0);
-    q_t q1 = s_to_q(s1);
-    qwords_t qwords(q0.size());
-    for (size_t i = 0; i < qwords.size(); i++)
+    state_t advanced = s;
+    quad_rounds(advanced);
+    for (std::size_t i = 0; i < 8; i++)
     {
-        qwords[i] = q0[i] + q1[i];
+        set_qword(s, i, get_qword(s, i) + get_qword(advanced, i));
     }
-    s_bytes_t bytes;
-    memcpy(bytes.data(), qwords.data(), qwords.size() * 8);
-    return bytes;
 }
 
-s_t mix_in(s_t h, std::string_view s)
+void mix_in(state_t& h, std::string_view s)
 {
-    auto mix_partial = [](s_t h, std::string_view partial) -> s_t
+    std::uint8_t* h_bytes = state_bytes(h);
+    while (!s.empty())
     {
-        assert(partial.size() <= h.size());
+        const std::string_view partial = s.substr(0, c_BlockSize);
         for (size_t i = 0; i < partial.size(); i++)
         {
             const auto inverse_i = partial.size() - 1 - i;
-            h[i] ^= static_cast<int>(partial[inverse_i]);
+            h_bytes[i] ^= static_cast<std::uint8_t>(partial[inverse_i]);
         }
-        return quad_rounds(h);
-    };
-
-    while (!s.empty())
-    {
-        h = mix_partial(h, s.substr(0, 0x40));
-        s = s.substr(std::min(s.size(), (std::size_t)0x40));
+        quad_rounds(h);
+        s = s.substr(partial.size());
     }
-
-    return h;
 }
 
-bytes_t keyed_hashing(std::string_view filepath, s_t key)
+// Xors each block of the source with the reversed key, or the reversed start of the key for a trailing partial block
+// NOTE: This appears to be an implementation mistake on the Spelunky 2 dev's part
+// They generate a quad_round advanced version of (nonce'd key), but then they
+// xor with the untweaked key instead of the tweaked key...
+void xor_reversed_key(const std::uint8_t* source, std::uint8_t* destination, std::size_t size, const state_t& key)
 {
-    // Do keyed hashing
-    // NOTE: This appears to be an implementation mistake on the Spelunky 2 dev's part
-    // They generate a quad_round advanced version of (nonce'd key), but then they
-    // xor with the untweaked key instead of the tweaked key...
+    const std::uint8_t* key_bytes = state_bytes(key);
 
-    bytes_t h;
-    for (std::size_t i = 0; i < filepath.size(); i += 0x40)
+    std::array<std::uint8_t, c_BlockSize> reversed_key;
+    for (std::size_t i = 0; i < c_BlockSize; i++)
     {
-        std::string_view partial = filepath.substr(i, i + 0x40);
-        std::string partial_mutable{ partial.begin(), partial.end() };
-        std::span<std::uint8_t> s_partial{ reinterpret_cast<std::uint8_t*>(partial_mutable.data()), reinterpret_cast<std::uint8_t*>(partial_mutable.data()) + partial_mutable.size() };
-        bytes_t bytes = sxor(s_partial, key.subspan(0, partial.size()));
-        h.insert(h.end(), bytes.begin(), bytes.end());
+        reversed_key[i] = key_bytes[c_BlockSize - 1 - i];
+    }
+
+    const std::size_t num_full_blocks = size / c_BlockSize;
+#ifdef CHACHA_USE_SSE2
+    const __m128i* reversed_key_rows = reinterpret_cast<const __m128i*>(reversed_key.data());
+    const __m128i k0 = _mm_loadu_si128(reversed_key_rows + 0);
+    const __m128i k1 = _mm_loadu_si128(reversed_key_rows + 1);
+    const __m128i k2 = _mm_loadu_si128(reversed_key_rows + 2);
+    const __m128i k3 = _mm_loadu_si128(reversed_key_rows + 3);
+    for (std::size_t i = 0; i < num_full_blocks; i++)
+    {
+        const __m128i* source_rows = reinterpret_cast<const __m128i*>(source + i * c_BlockSize);
+        __m128i* destination_rows = reinterpret_cast<__m128i*>(destination + i * c_BlockSize);
+        _mm_storeu_si128(destination_rows + 0, _mm_xor_si128(_mm_loadu_si128(source_rows + 0), k0));
+        _mm_storeu_si128(destination_rows + 1, _mm_xor_si128(_mm_loadu_si128(source_rows + 1), k1));
+        _mm_storeu_si128(destination_rows + 2, _mm_xor_si128(_mm_loadu_si128(source_rows + 2), k2));
+        _mm_storeu_si128(destination_rows + 3, _mm_xor_si128(_mm_loadu_si128(source_rows + 3), k3));
+    }
+#else
+    for (std::size_t i = 0; i < num_full_blocks * c_BlockSize; i++)
+    {
+        destination[i] = source[i] ^ reversed_key[i % c_BlockSize];
+    }
+#endif
+
+    const std::size_t tail_offset = num_full_blocks * c_BlockSize;
+    const std::size_t tail_size = size - tail_offset;
+    for (std::size_t i = 0; i < tail_size; i++)
+    {
+        destination[tail_offset + i] = source[tail_offset + i] ^ key_bytes[tail_size - 1 - i];
     }
-    return h;
 }
 
-bytes_t hash_filepath_v1(std::string_view filepath)
+state_t hash_key_v1(std::string_view filepath)
 {
     // Generate initial hash from the string
-    bytes_t bytes(16, 0);
-    const s_t h0{ bytes };
-    const s_t h1 = mix_in(h0, filepath);
+    state_t h{};
+    mix_in(h, filepath);
 
-    // Advance h1 by four round pairs to get h2
-    const s_t h2 = quad_rounds(h1);
-    // Add the two together, and advance by four round pairs.
-    s_bytes_t added_bytes = add_qwords(h1, h2);
-    const s_t h3{ added_bytes };
-    s_t key = quad_rounds(h3);
-
-    return keyed_hashing(filepath, key);
+    // Add h and its advancement by four round pairs, then advance by four round pairs.
+    add_quad_rounds(h);
+    quad_rounds(h);
+    return h;
 }
 
-bytes_t hash_filepath_v2(std::string_view filepath, std::uint64_t key)
+state_t hash_key_v2(std::string_view filepath, std::uint64_t key)
 {
     // Generate initial hash from the string
-    qwords_t qwords{ key, filepath.size(), 0, 0, 0, 0, 0, 0 };
-    assert(qwords.size() == 8);
-    s_t h = two_rounds(q_to_s(q_t{ qwords }));
-    h = mix_in(h, filepath);
+    state_t h = make_state(key, filepath.size());
+    two_rounds(h);
+    mix_in(h, filepath);
 
     // Add the two together, and advance by four round pairs.
-    s_bytes_t h_copy;
-    memcpy(h_copy.data(), h.data(), h.size());
-    s_bytes_t tmp_s = add_qwords(h, quad_rounds(s_t{ h_copy }));
-    q_t tmp_q = s_to_q(s_t{ tmp_s });
-    tmp_q[0] ^= filepath.size();
-    s_t key_s = quad_rounds(q_to_s(tmp_q));
-
-    return keyed_hashing(filepath, key_s);
+    add_quad_rounds(h);
+    set_qword(h, 0, get_qword(h, 0) ^ filepath.size());
+    quad_rounds(h);
+    return h;
 }
 
-bytes_t hash_filepath(std::string_view filepath, std::uint64_t key, Version version)
+void hash_filepath(std::string_view filepath, std::span<std::uint8_t> hash, std::uint64_t key, Version version)
 {
-    if (version == Version::V1)
-    {
-        return hash_filepath_v1(filepath);
-    }
-    else
-    {
-        return hash_filepath_v2(filepath, key);
-    }
-}
+    assert(hash.size() == filepath.size());
 
-s_t mix_in_filepath(std::string_view filepath, s_t h)
-{
-    // Mix the filename in to tweak the key
-    for (std::size_t i = 0; i < filepath.size(); i += 0x40)
-    {
-        std::string_view partial = filepath.substr(i, i + 0x40);
-        std::string partial_mutable{ partial.begin(), partial.end() };
-        std::span<std::uint8_t> s_partial{ reinterpret_cast<std::uint8_t*>(partial_mutable.data()), reinterpret_cast<std::uint8_t*>(partial_mutable.data()) + partial_mutable.size() };
-        bytes_t bytes = sxor(h.subspan(0, partial.size()), s_partial);
-        for (size_t j = 0; j < bytes.size(); j++)
-        {
-            h[j] = bytes[j];
-        }
-        h = quad_rounds(h);
-    }
-    return h;
+    const state_t key_s = version == Version::V1
+                              ? hash_key_v1(filepath)
+                              : hash_key_v2(filepath, key);
+    xor_reversed_key(reinterpret_cast<const std::uint8_t*>(filepath.data()), hash.data(), filepath.size(), key_s);
 }
 
-bytes_t chacha_rest(std::span<const std::uint8_t> data, s_t key)
+bytes_t hash_filepath(std::string_view filepath, std::uint64_t key, Version version)
 {
-    // NOTE: This appears to be an implementation mistake on the Spelunky 2 dev's part
-    // They generate a quad_round advanced version of (nonce'd key), but then they
-    // xor with the untweaked key instead of the tweaked key...
-    bytes_t out;
-    for (std::size_t i = 0; i < data.size(); i += 0x40)
-    {
-        std::span<const std::uint8_t> partial = data.subspan(i, std::min((std::size_t)0x40, data.size() - i));
-        bytes_t bytes = sxor(partial, key.subspan(0, partial.size()));
-        out.insert(out.end(), bytes.begin(), bytes.end());
-    }
-    return out;
+    bytes_t hash(filepath.size());
+    hash_filepath(filepath, hash, key, version);
+    return hash;
 }
 
-bytes_t chacha_v1(std::string_view filepath, std::span<const std::uint8_t> data)
+state_t chacha_key_v1(std::string_view filepath)
 {
     // Untweaked key begins as half - advanced "0xBABE"
-    qwords_t qwords{ 0xBABE, 0, 0, 0, 0, 0, 0, 0 };
-    assert(qwords.size() == 8);
-    s_t h = two_rounds(q_to_s(q_t{ qwords }));
+    state_t h = make_state(0xBABE, 0);
+    two_rounds(h);
 
-    h = mix_in_filepath(filepath, h);
+    // Mix the filename in to tweak the key
+    mix_in(h, filepath);
 
     // Add the tweaked key and its advancement, then advance by four round pairs.
-    s_bytes_t h_copy;
-    memcpy(h_copy.data(), h.data(), h.size());
-    s_bytes_t bytes = add_qwords(h, quad_rounds(s_t{ h_copy }));
-    s_t key = quad_rounds(s_t{ bytes });
-
-    return chacha_rest(data, key);
+    add_quad_rounds(h);
+    quad_rounds(h);
+    return h;
 }
 
-bytes_t chacha_v2(std::string_view filepath, std::span<const std::uint8_t> data, std::uint64_t key)
+state_t chacha_key_v2(std::string_view filepath, std::size_t data_size, std::uint64_t key)
 {
     // Untweaked key begins as half - advanced `key`
-    qwords_t qwords{ key, filepath.size(), 0, 0, 0, 0, 0, 0 };
-    assert(qwords.size() == 8);
-    s_t h = two_rounds(q_to_s(q_t{ qwords }));
+    state_t h = make_state(key, filepath.size());
+    two_rounds(h);
 
-    h = mix_in_filepath(filepath, h);
+    // Mix the filename in to tweak the key
+    mix_in(h, filepath);
 
     // Add the tweaked key and its advancement, then advance by four round pairs.
-    s_bytes_t h_copy;
-    memcpy(h_copy.data(), h.data(), h.size());
-    s_bytes_t tmp = add_qwords(h, quad_rounds(s_t{ h_copy }));
-    q_t q_tmp = s_to_q(s_t{ tmp });
-    q_tmp[0] = q_tmp[0] ^ key + data.size();
+    add_quad_rounds(h);
+    set_qword(h, 0, get_qword(h, 0) ^ (key + data_size));
+    quad_rounds(h);
+    return h;
+}
 
-    s_t key_s = quad_rounds(q_to_s(q_tmp));
+void chacha(std::string_view filepath, std::span<const std::uint8_t> data, std::span<std::uint8_t> out, std::uint64_t key, Version version)
+{
+    assert(out.size() == data.size());
 
-    return chacha_rest(data, key_s);
+    const state_t key_s = version == Version::V1
+                              ? chacha_key_v1(filepath)
+                              : chacha_key_v2(filepath, data.size(), key);
+    xor_reversed_key(data.data(), out.data(), data.size(), key_s);
 }
 
 bytes_t chacha(std::string_view filepath, std::span<const std::uint8_t> data, std::uint64_t key, Version version)
 {
-    if (version == Version::V1)
-    {
-        return chacha_v1(filepath, data);
-    }
-    else
-    {
-        return chacha_v2(filepath, data, key);
-    }
+    bytes_t out(data.size());
+    chacha(filepath, data, out, key, version);
+    return out;
 }
 
 void Key::update(std::uint64_t asset_len)
@@ -297,4 +318,4 @@ void Key::update(std::uint64_t asset_len)
     const auto v4 = 0x9E6D62D06F6A9A9B * (v3 ^ ((v3 ^ (v3 >> 28)) >> 23));
     Current ^= v4 ^ ((v4 ^ (v4 >> 28)) >> 23);
 }
-} // namespace ChaCha
\ No newline at end of file
+} // namespace ChaCha
@@ -20,6 +20,10 @@ enum class Version
 bytes_t hash_filepath(std::string_view filepath, std::uint64_t key, Version version = Version::V2);
 bytes_t chacha(std::string_view filepath, std::span<const std::uint8_t> data, std::uint64_t key, Version version = Version::V2);
 
+// Same as above but write into a caller provided buffer of the same size as filepath or data, out may alias data
+void hash_filepath(std::string_view filepath, std::span<std::uint8_t> hash, std::uint64_t key, Version version = Version::V2);
+void chacha(std::string_view filepath, std::span<const std::uint8_t> data, std::span<std::uint8_t> out, std::uint64_t key, Version version = Version::V2);
+
 struct Key
 {
     std::uint64_t Current{ 0 };
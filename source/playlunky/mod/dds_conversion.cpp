@@ -1,16 +1,26 @@
 #include "dds_conversion.h"
 
+#include "dds_format.h"
 #include "log.h"
 #include "util/algorithms.h"
-#include "util/color.h"
+#include "util/block_compression.h"
 #include "util/image.h"
 #include "util/on_scope_exit.h"
-#include "util/span_util.h"
 
-#include <cassert>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <optional>
 #include <span>
 
+static std::atomic_bool s_DdsBlockCompression{ false };
+
+void SetDdsBlockCompression(bool block_compression)
+{
+    s_DdsBlockCompression = block_compression;
+}
+
 bool IsSupportedFileType(const std::filesystem::path& extension)
 {
     using namespace std::string_view_literals;
@@ -47,59 +57,102 @@ bool ConvertRBGAToDds(std::span<const std::uint8_t> source, std::uint32_t width,
         }
     } // namespace std::filesystem;
 
+    // Compress before opening the file, so it is not left empty for long
+    const bool block_compression = s_DdsBlockCompression;
+    std::vector<std::uint8_t> compressed_source;
+    if (block_compression)
+    {
+        compressed_source.resize(GetBC3CompressedSize(width, height));
+        CompressBC3(source, width, height, compressed_source);
+        source = compressed_source;
+    }
+
     if (auto dest_file = std::ofstream{ destination, std::ios::trunc | std::ios::binary })
     {
-        // https://docs.microsoft.com/en-us/windows/win32/direct3ddds/dds-header
-        const std::uint32_t header_size = 124;  // hardcoded
-        const std::uint32_t flags = 0x0002100F; // required flags + pitch + mipmapped
+        const auto header = MakeDdsHeader(width, height, block_compression);
+        dest_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        dest_file.write(reinterpret_cast<const char*>(source.data()), source.size());
 
-        const std::uint32_t pitch = width * 4; // aka bytes per line
-        const std::uint32_t depth = 1;
-        const std::uint32_t mipmaps = 1;
+        dest_file.flush();
+        return true;
+    }
 
-        const std::uint32_t reserverd1[11]{};
+    return false;
+}
 
-        // pixel format sub structure
-        const std::uint32_t pfsize = 32;    // size of pixel format structure, constant
-        const std::uint32_t pfflags = 0x41; // uncompressed RGB with alpha channel
-        const std::uint32_t fourcc = 0;     // compression mode (not used for uncompressed data)
-        const std::uint32_t bitcount = 32;
+static std::optional<ImageSize> ReadRBGADdsHeader(std::istream& stream)
+{
+    std::array<char, c_DdsHeaderSize> header;
+    if (!stream.read(header.data(), header.size()))
+    {
+        return std::nullopt;
+    }
 
-        // bit masks for each channel, here for RGBA
-        const std::uint32_t rmask = 0x000000FF;
-        const std::uint32_t gmask = 0x0000FF00;
-        const std::uint32_t bmask = 0x00FF0000;
-        const std::uint32_t amask = 0xFF000000;
+    auto read_u32 = [&header](std::size_t offset)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, header.data() + offset, sizeof(value));
+        return value;
+    };
 
-        const std::uint32_t caps = 0x1000; // simple texture with only one surface and no mipmaps
-        const std::uint32_t caps2 = 0;     // additional surface data, unused
-        const std::uint32_t caps3 = 0;     // unused
-        const std::uint32_t caps4 = 0;     // unused
+    const bool is_rgba_dds = std::string_view{ header.data(), 4 } == "DDS " &&
+                             read_u32(4) == 124 &&        // header_size
+                             read_u32(80) == 0x41 &&      // pfflags
+                             read_u32(88) == 32 &&        // bitcount
+                             read_u32(92) == 0x000000FF && // rmask
+                             read_u32(96) == 0x0000FF00 && // gmask
+                             read_u32(100) == 0x00FF0000 && // bmask
+                             read_u32(104) == 0xFF000000;   // amask
+    if (!is_rgba_dds)
+    {
+        return std::nullopt;
+    }
+
+    return ImageSize{ .x{ read_u32(16) }, .y{ read_u32(12) } };
+}
 
-        const std::uint32_t reserved2 = 0;
+bool ReadRBGAFromDds(const std::filesystem::path& source, std::vector<std::uint8_t>& data, std::uint32_t& width, std::uint32_t& height)
+{
+    if (auto source_file = std::ifstream{ source, std::ios::binary })
+    {
+        if (const auto size = ReadRBGADdsHeader(source_file))
+        {
+            data.resize(static_cast<std::size_t>(size->x) * size->y * 4);
+            if (source_file.read(reinterpret_cast<char*>(data.data()), data.size()))
+            {
+                width = size->x;
+                height = size->y;
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-        auto write_as_bytes = [](auto& stream, auto... datas)
+bool UpdateRBGAInDds(std::span<const std::uint8_t> source, std::uint32_t width, std::uint32_t height, std::span<const ImageSubRegion> regions, const std::filesystem::path& destination)
+{
+    if (auto dest_file = std::fstream{ destination, std::ios::in | std::ios::out | std::ios::binary })
+    {
+        const auto size = ReadRBGADdsHeader(dest_file);
+        if (!size || size->x != width || size->y != height)
         {
-            (
-                stream.write(reinterpret_cast<const char*>(&datas), sizeof(datas)),
-                ...);
-        };
-
-        dest_file << "DDS "; // magic bytes
-        write_as_bytes(dest_file, header_size, flags);
-        write_as_bytes(dest_file, height, width, pitch, depth, mipmaps);
-        dest_file.write(reinterpret_cast<const char*>(reserverd1), sizeof(reserverd1));
-        write_as_bytes(dest_file, pfsize, pfflags, fourcc, bitcount);
-        write_as_bytes(dest_file, rmask, gmask, bmask, amask);
-        write_as_bytes(dest_file, caps, caps2, caps3, caps4);
-        write_as_bytes(dest_file, reserved2);
+            return false;
+        }
 
-        dest_file.write(reinterpret_cast<const char*>(source.data()), source.size());
+        const std::size_t pitch = static_cast<std::size_t>(width) * 4;
+        for (const ImageSubRegion& region : regions)
+        {
+            for (std::uint32_t y = 0; y < region.height; y++)
+            {
+                const std::size_t offset = (static_cast<std::size_t>(region.y) + y) * pitch + static_cast<std::size_t>(region.x) * 4;
+                dest_file.seekp(c_DdsHeaderSize + offset);
+                dest_file.write(reinterpret_cast<const char*>(source.data() + offset), static_cast<std::streamsize>(region.width) * 4);
+            }
+        }
 
         dest_file.flush();
-        return true;
+        return static_cast<bool>(dest_file);
     }
-
     return false;
 }
 
@@ -122,61 +175,12 @@ bool ConvertDdsToPng(std::span<const std::uint8_t> source, const std::filesystem
         fs::create_directories(destination.parent_path());
     }
 
-    const auto orig_source = source;
-
+    std::vector<std::uint8_t> image_buffer;
+    std::uint32_t width{ 0 };
+    std::uint32_t height{ 0 };
+    if (!DecodeDdsToRBGA(source, image_buffer, width, height))
     {
-        const auto magic_bytes = std::string_view{ reinterpret_cast<const char*>(source.data()), 4 };
-        assert(magic_bytes == "DDS ");
-        source = source.subspan(4);
-
-        assert(*reinterpret_cast<const std::uint32_t*>(source.data()) == 124);
-        source = source.subspan(4); // header_size
-        source = source.subspan(4); // flags
-    }
-
-    const auto height = *reinterpret_cast<const std::uint32_t*>(source.data());
-    source = source.subspan(4); // height
-    const auto width = *reinterpret_cast<const std::uint32_t*>(source.data());
-    source = source.subspan(4 * (8 + 11)); // width until bitcount
-
-    const auto rmask = *reinterpret_cast<const std::uint32_t*>(source.data());
-    source = source.subspan(4); // rmask
-    const auto gmask = *reinterpret_cast<const std::uint32_t*>(source.data());
-    source = source.subspan(4); // gmask
-    const auto bmask = *reinterpret_cast<const std::uint32_t*>(source.data());
-    source = source.subspan(4); // bmask
-    const auto amask = *reinterpret_cast<const std::uint32_t*>(source.data());
-
-    auto get_lowest_bit = [](std::uint32_t mask) -> std::uint8_t
-    {
-        for (std::uint8_t i = 0; i < 32; i++)
-        {
-            const std::uint32_t bit = 1 << (31 - i);
-            const std::uint32_t masked = mask & bit;
-            if (masked != 0)
-            {
-                return i;
-            }
-        }
-        return 32;
-    };
-    const auto rshift = 32 - 8 - get_lowest_bit(rmask);
-    const auto gshift = 32 - 8 - get_lowest_bit(gmask);
-    const auto bshift = 32 - 8 - get_lowest_bit(bmask);
-    const auto ashift = 32 - 8 - get_lowest_bit(amask);
-
-    source = orig_source;             // back to beginning
-    source = source.subspan(4 + 124); // magic bytes and whole header
-
-    std::vector<std::uint8_t> image_buffer{ source.begin(), source.end() };
-    auto image = span::bit_cast<ColorRGBA8>(image_buffer);
-    for (auto& pixel : image)
-    {
-        std::uint32_t original_pixel = *reinterpret_cast<std::uint32_t*>(&pixel);
-        pixel.r = static_cast<std::uint8_t>(original_pixel >> rshift);
-        pixel.g = static_cast<std::uint8_t>(original_pixel >> gshift);
-        pixel.b = static_cast<std::uint8_t>(original_pixel >> bshift);
-        pixel.a = static_cast<std::uint8_t>(original_pixel >> ashift);
+        return false;
     }
 
     Image image_file;
@@ -199,8 +203,12 @@ bool ConvertDdsToPng(const std::filesystem::path& source, const std::filesystem:
 
         if (auto data = std::make_unique<std::uint8_t[]>(file_size))
         {
-            [[maybe_unused]] const auto size_read = fread(data.get(), 1, file_size, file);
-            // TODO: Verify!
+            const auto size_read = fread(data.get(), 1, file_size, file);
+            if (size_read != file_size)
+            {
+                LogError("Could not read file {}...", source.string());
+                return false;
+            }
             return ConvertDdsToPng({ data.get(), file_size }, destination);
         }
     }
@@ -3,10 +3,19 @@
 #include <cstdint>
 #include <filesystem>
 #include <span>
+#include <vector>
+
+struct ImageSubRegion;
+
+// Write BC3 compressed instead of uncompressed dds files from now on
+void SetDdsBlockCompression(bool block_compression);
 
 bool IsSupportedFileType(const std::filesystem::path& extension);
 
 bool ConvertRBGAToDds(std::span<const std::uint8_t> source, std::uint32_t width, std::uint32_t height, const std::filesystem::path& destination);
+// Read back or partially overwrite the pixels of a dds written by ConvertRBGAToDds, fail for any other dds
+bool ReadRBGAFromDds(const std::filesystem::path& source, std::vector<std::uint8_t>& data, std::uint32_t& width, std::uint32_t& height);
+bool UpdateRBGAInDds(std::span<const std::uint8_t> source, std::uint32_t width, std::uint32_t height, std::span<const ImageSubRegion> regions, const std::filesystem::path& destination);
 bool ConvertImageToDds(const std::filesystem::path& source, const std::filesystem::path& destination);
 bool ConvertDdsToPng(std::span<const std::uint8_t> source, const std::filesystem::path& destination);
 bool ConvertDdsToPng(const std::filesystem::path& source, const std::filesystem::path& destination);
@@ -0,0 +1,159 @@
+#include "dds_format.h"
+
+#include "log.h"
+#include "util/block_compression.h"
+
+#include <cstring>
+#include <string_view>
+
+// DXT5 as four character code
+inline constexpr std::uint32_t c_BC3FourCC{ 0x35545844 };
+
+std::array<std::uint8_t, c_DdsHeaderSize> MakeDdsHeader(std::uint32_t width, std::uint32_t height, bool block_compression)
+{
+    // https://docs.microsoft.com/en-us/windows/win32/direct3ddds/dds-header
+    const std::uint32_t header_size = 124; // hardcoded
+    const std::uint32_t flags = block_compression
+                                    ? 0x000A1007  // required flags + linear size + mipmapped
+                                    : 0x0002100F; // required flags + pitch + mipmapped
+
+    const std::uint32_t pitch = block_compression
+                                    ? static_cast<std::uint32_t>(GetBC3CompressedSize(width, height)) // aka size of the whole surface
+                                    : width * 4;                                                       // aka bytes per line
+    const std::uint32_t depth = 1;
+    const std::uint32_t mipmaps = 1;
+
+    const std::uint32_t reserverd1[11]{};
+
+    // pixel format sub structure
+    const std::uint32_t pfsize = 32;                                  // size of pixel format structure, constant
+    const std::uint32_t pfflags = block_compression ? 0x4 : 0x41;     // compressed with fourcc or uncompressed RGB with alpha channel
+    const std::uint32_t fourcc = block_compression ? c_BC3FourCC : 0; // compression mode (not used for uncompressed data)
+    const std::uint32_t bitcount = block_compression ? 0 : 32;
+
+    // bit masks for each channel, here for RGBA (not used for compressed data)
+    const std::uint32_t rmask = block_compression ? 0 : 0x000000FF;
+    const std::uint32_t gmask = block_compression ? 0 : 0x0000FF00;
+    const std::uint32_t bmask = block_compression ? 0 : 0x00FF0000;
+    const std::uint32_t amask = block_compression ? 0 : 0xFF000000;
+
+    const std::uint32_t caps = 0x1000; // simple texture with only one surface and no mipmaps
+    const std::uint32_t caps2 = 0;     // additional surface data, unused
+    const std::uint32_t caps3 = 0;     // unused
+    const std::uint32_t caps4 = 0;     // unused
+
+    const std::uint32_t reserved2 = 0;
+
+    std::array<std::uint8_t, c_DdsHeaderSize> header{};
+    std::memcpy(header.data(), "DDS ", 4); // magic bytes
+
+    std::size_t offset{ 4 };
+    auto write_as_bytes = [&](const auto&... datas)
+    {
+        (
+            (std::memcpy(header.data() + offset, &datas, sizeof(datas)), offset += sizeof(datas)),
+            ...);
+    };
+
+    write_as_bytes(header_size, flags);
+    write_as_bytes(height, width, pitch, depth, mipmaps);
+    write_as_bytes(reserverd1);
+    write_as_bytes(pfsize, pfflags, fourcc, bitcount);
+    write_as_bytes(rmask, gmask, bmask, amask);
+    write_as_bytes(caps, caps2, caps3, caps4);
+    write_as_bytes(reserved2);
+
+    return header;
+}
+
+bool DecodeDdsToRBGA(std::span<const std::uint8_t> source, std::vector<std::uint8_t>& rgba, std::uint32_t& width, std::uint32_t& height)
+{
+    if (source.size() < c_DdsHeaderSize)
+    {
+        LogError("Can not convert truncated dds to png...");
+        return false;
+    }
+
+    auto read_u32 = [&source](std::size_t offset)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, source.data() + offset, sizeof(value));
+        return value;
+    };
+
+    const auto magic_bytes = std::string_view{ reinterpret_cast<const char*>(source.data()), 4 };
+    const auto header_size = read_u32(4);
+    if (magic_bytes != "DDS " || header_size != 124)
+    {
+        LogError("Can not convert invalid dds to png...");
+        return false;
+    }
+
+    height = read_u32(12);
+    width = read_u32(16);
+
+    const auto pixels = source.subspan(c_DdsHeaderSize);
+    const std::size_t rgba_size = static_cast<std::size_t>(width) * height * 4;
+
+    const auto pfflags = read_u32(80);
+    const auto fourcc = read_u32(84);
+    if ((pfflags & 0x4) != 0)
+    {
+        if (fourcc != c_BC3FourCC)
+        {
+            LogError("Can not convert dds with unsupported compression {:#x} to png...", fourcc);
+            return false;
+        }
+
+        if (pixels.size() < GetBC3CompressedSize(width, height))
+        {
+            LogError("Can not convert truncated dds to png...");
+            return false;
+        }
+
+        rgba.resize(rgba_size);
+        DecompressBC3(pixels, width, height, rgba);
+        return true;
+    }
+
+    const auto rmask = read_u32(92);
+    const auto gmask = read_u32(96);
+    const auto bmask = read_u32(100);
+    const auto amask = read_u32(104);
+
+    auto get_lowest_bit = [](std::uint32_t mask) -> std::uint8_t
+    {
+        for (std::uint8_t i = 0; i < 32; i++)
+        {
+            const std::uint32_t bit = 1 << (31 - i);
+            const std::uint32_t masked = mask & bit;
+            if (masked != 0)
+            {
+                return i;
+            }
+        }
+        return 32;
+    };
+    const auto rshift = 32 - 8 - get_lowest_bit(rmask);
+    const auto gshift = 32 - 8 - get_lowest_bit(gmask);
+    const auto bshift = 32 - 8 - get_lowest_bit(bmask);
+    const auto ashift = 32 - 8 - get_lowest_bit(amask);
+
+    if (pixels.size() < rgba_size)
+    {
+        LogError("Can not convert truncated dds to png...");
+        return false;
+    }
+
+    rgba.assign(pixels.begin(), pixels.begin() + rgba_size);
+    for (std::size_t i = 0; i < rgba_size; i += 4)
+    {
+        std::uint32_t original_pixel;
+        std::memcpy(&original_pixel, rgba.data() + i, sizeof(original_pixel));
+        rgba[i + 0] = static_cast<std::uint8_t>(original_pixel >> rshift);
+        rgba[i + 1] = static_cast<std::uint8_t>(original_pixel >> gshift);
+        rgba[i + 2] = static_cast<std::uint8_t>(original_pixel >> bshift);
+        rgba[i + 3] = static_cast<std::uint8_t>(original_pixel >> ashift);
+    }
+    return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Layout of the dds files written by Playlunky, independent of any image library so it can be tested on its own
+inline constexpr std::size_t c_DdsHeaderSize{ 4 + 124 }; // magic bytes and header
+
+// Header of a single surface dds without mipmaps, either uncompressed RGBA8 or BC3 compressed
+std::array<std::uint8_t, c_DdsHeaderSize> MakeDdsHeader(std::uint32_t width, std::uint32_t height, bool block_compression);
+
+// Decodes uncompressed dds with any 8 bit channel masks and BC3 compressed dds to RGBA8, logs and fails on invalid or truncated files
+bool DecodeDdsToRBGA(std::span<const std::uint8_t> source, std::vector<std::uint8_t>& rgba, std::uint32_t& width, std::uint32_t& height);
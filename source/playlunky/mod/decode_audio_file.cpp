@@ -1,6 +1,7 @@
 #include "decode_audio_file.h"
 
 #include "log.h"
+#include "util/algorithms.h"
 
 #include <cassert>
 
@@ -19,6 +20,12 @@
 #pragma warning(pop)
 #endif
 
+bool IsSupportedAudioFile(const std::filesystem::path& file_path)
+{
+    static nqr::NyquistIO s_Loader;
+    return s_Loader.IsFileSupported(algo::to_lower(file_path.extension().string()));
+}
+
 DecodedAudioBuffer DecodeAudioFile(const std::filesystem::path& file_path)
 {
     nqr::AudioData decoded_data;
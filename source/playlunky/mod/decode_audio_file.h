@@ -24,4 +24,5 @@ struct DecodedAudioBuffer
     std::size_t DataSize;
 };
 
+bool IsSupportedAudioFile(const std::filesystem::path& file_path);
 DecodedAudioBuffer DecodeAudioFile(const std::filesystem::path& file_path);
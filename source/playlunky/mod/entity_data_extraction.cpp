@@ -1,123 +1,12 @@
 #include "entity_data_extraction.h"
-#include "../../res/resource_playlunky64.h"
+#include "entity_data_table.h"
 #include "log.h"
 #include "util/algorithms.h"
-#include "util/on_scope_exit.h"
 
-#include <charconv>
-
-#include <Windows.h>
-#include <nlohmann/json.hpp>
-
-using namespace nlohmann;
-
-struct AnimationData
-{
-    std::int32_t FirstTileIndex;
-    std::int32_t NumTiles;
-};
-struct EntityData
-{
-    std::uint16_t Id;
-    std::map<std::uint8_t, AnimationData> Animations;
-    std::int32_t TextureId;
-    std::int32_t TileX{ -1 };
-    std::int32_t TileY{ -1 };
-};
-struct TextureData
-{
-    std::string Path;
-    std::uint32_t Width;
-    std::uint32_t Height;
-    std::uint32_t NumTilesWidth;
-    std::uint32_t NumTilesHeight;
-    std::uint32_t TileWidth;
-    std::uint32_t TileHeight;
-    std::uint32_t OffsetWidth;
-    std::uint32_t OffsetHeight;
-};
-
-void from_json(const nlohmann::json& j, AnimationData& anim)
-{
-    anim.FirstTileIndex = j["texture"];
-    anim.NumTiles = j["count"];
-}
-void from_json(const nlohmann::json& j, EntityData& ent)
-{
-    ent.Id = j["id"];
-    std::unordered_map<std::string, AnimationData> animations;
-    j["animations"].get_to(animations);
-    for (auto& [id_str, animation_data] : animations)
-    {
-        std::uint8_t id;
-        std::from_chars(id_str.c_str(), id_str.c_str() + id_str.size(), id);
-        ent.Animations[id] = animation_data;
-    }
-    ent.TextureId = j["texture"];
-    if (j.contains("tile_x"))
-    {
-        ent.TileX = j["tile_x"];
-        ent.TileY = j["tile_y"];
-    }
-}
-void from_json(const nlohmann::json& j, TextureData& tex)
-{
-    tex.Path = j["path"];
-    tex.Width = j["width"];
-    tex.Height = j["height"];
-    tex.NumTilesWidth = j["num_tiles"]["width"];
-    tex.NumTilesHeight = j["num_tiles"]["height"];
-    tex.TileWidth = j["tile_width"];
-    tex.TileHeight = j["tile_height"];
-    tex.OffsetWidth = j["offset"]["width"];
-    tex.OffsetHeight = j["offset"]["height"];
-}
+#include <cmath>
 
 void EntityDataExtractor::PreloadEntityMappings()
 {
-    const auto [entities, textures] = []()
-    {
-        std::unordered_map<std::string, EntityData> entities;
-        std::unordered_map<std::int32_t, TextureData> textures;
-
-        {
-            auto acquire_json_resource = [](LPSTR resource)
-            {
-                HMODULE this_module = GetModuleHandle("playlunky64.dll");
-                if (HRSRC entities_json_resource = FindResource(this_module, resource, MAKEINTRESOURCE(TEXT_FILE)))
-                {
-                    if (HGLOBAL entities_json_data = LoadResource(this_module, entities_json_resource))
-                    {
-                        DWORD entities_json_size = SizeofResource(this_module, entities_json_resource);
-                        return std::pair{ entities_json_data, std::string_view{ (const char*)LockResource(entities_json_data), entities_json_size } };
-                    }
-                }
-                return std::pair{ HGLOBAL{ NULL }, std::string_view{} };
-            };
-            auto [entities_res, entities_json] = acquire_json_resource(MAKEINTRESOURCE(ENTITIES_JSON));
-            auto [textures_res, textures_json] = acquire_json_resource(MAKEINTRESOURCE(TEXTURES_JSON));
-            OnScopeExit release_resources{ [entities_res, textures_res]
-                                           {
-                                               UnlockResource(entities_res);
-                                               UnlockResource(textures_res);
-                                           } };
-
-            json::parse(entities_json).get_to(entities);
-            {
-                std::unordered_map<std::string, TextureData> string_mapped_textures;
-                json::parse(textures_json).get_to(string_mapped_textures);
-                for (auto& [id_str, texture_data] : string_mapped_textures)
-                {
-                    std::int32_t id;
-                    std::from_chars(id_str.c_str(), id_str.c_str() + id_str.size(), id);
-                    textures[id] = std::move(texture_data);
-                }
-            }
-        }
-
-        return std::pair(std::move(entities), std::move(textures));
-    }();
-
     struct EntityMappingInfo
     {
         std::string_view EntityPath;
@@ -252,23 +141,21 @@ void EntityDataExtractor::PreloadEntityMappings()
 
         for (const std::string_view entity_name : mapping_info.EntityNames)
         {
-            if (entities.contains(std::string{ entity_name }))
+            if (const EntityData* entity_data = FindEntityData(entity_name))
             {
-                const EntityData& entity_data = entities.at(std::string{ entity_name });
-                if (textures.contains(entity_data.TextureId))
+                if (const TextureData* texture_data = FindTextureData(entity_data->TextureId))
                 {
-                    const TextureData& texture_data = textures.at(entity_data.TextureId);
-
-                    const std::uint32_t tile_width = texture_data.TileWidth;
-                    const std::uint32_t tile_height = texture_data.TileHeight;
-                    const std::uint32_t num_tiles_width = texture_data.NumTilesWidth;
-                    const std::uint32_t offset_width = texture_data.OffsetWidth;
-                    const std::uint32_t offset_height = texture_data.OffsetHeight;
-
-                    if (entity_data.Animations.empty())
+                    const std::uint32_t tile_width = texture_data->TileWidth;
+                    const std::uint32_t tile_height = texture_data->TileHeight;
+                    const std::uint32_t num_tiles_width = texture_data->NumTilesWidth;
+                    const std::uint32_t offset_width = texture_data->OffsetWidth;
+                    const std::uint32_t offset_height = texture_data->OffsetHeight;
+
+                    const std::span<const EntityAnimationData> animations = GetEntityAnimations(*entity_data);
+                    if (animations.empty())
                     {
-                        const std::int32_t tile_x = entity_data.TileX;
-                        const std::int32_t tile_y = entity_data.TileY;
+                        const std::int32_t tile_x = entity_data->TileX;
+                        const std::int32_t tile_y = entity_data->TileY;
                         const std::int32_t tile_index = tile_y * num_tiles_width + tile_x;
                         const std::int32_t real_tile_x = tile_index % num_tiles_width;
                         const std::int32_t real_tile_y = tile_index / num_tiles_width;
@@ -291,7 +178,7 @@ void EntityDataExtractor::PreloadEntityMappings()
                     else
                     {
                         std::vector<std::int32_t> unique_tile_indices;
-                        for (const auto& [animation_id, animation_data] : entity_data.Animations)
+                        for (const EntityAnimationData& animation_data : animations)
                         {
                             const std::int32_t first_tile = animation_data.FirstTileIndex;
                             for (std::int32_t i = 0; i < animation_data.NumTiles; i++)
@@ -338,7 +225,7 @@ void EntityDataExtractor::PreloadEntityMappings()
                 }
                 else
                 {
-                    LogError("Can't find texture {} for entity {}...", entity_data.TextureId, entity_name);
+                    LogError("Can't find texture {} for entity {}...", entity_data->TextureId, entity_name);
                 }
             }
             else
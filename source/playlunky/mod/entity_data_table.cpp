@@ -0,0 +1,33 @@
+#include "entity_data_table.h"
+
+#include <algorithm>
+
+// Defines s_EntityAnimations, s_Entities sorted by name and s_Textures sorted by id
+#include <entity_data_table.inl>
+
+static_assert(std::ranges::is_sorted(s_Entities, {}, &EntityData::Name));
+static_assert(std::ranges::is_sorted(s_Textures, {}, &TextureData::Id));
+
+const EntityData* FindEntityData(std::string_view entity_name)
+{
+    const auto it = std::ranges::lower_bound(s_Entities, entity_name, {}, &EntityData::Name);
+    if (it != std::ranges::end(s_Entities) && it->Name == entity_name)
+    {
+        return &*it;
+    }
+    return nullptr;
+}
+const TextureData* FindTextureData(std::int32_t texture_id)
+{
+    const auto it = std::ranges::lower_bound(s_Textures, texture_id, {}, &TextureData::Id);
+    if (it != std::ranges::end(s_Textures) && it->Id == texture_id)
+    {
+        return &*it;
+    }
+    return nullptr;
+}
+
+std::span<const EntityAnimationData> GetEntityAnimations(const EntityData& entity_data)
+{
+    return std::span{ s_EntityAnimations }.subspan(entity_data.FirstAnimation, entity_data.NumAnimations);
+}
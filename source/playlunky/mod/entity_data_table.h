@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Subset of res/entities.json and res/textures.json needed to build entity sheets
+// The tables are generated at build time by entity_data_gen, so nothing has to be parsed at runtime
+struct EntityAnimationData
+{
+    std::uint8_t Id;
+    std::int32_t FirstTileIndex;
+    std::int32_t NumTiles;
+};
+struct EntityData
+{
+    std::string_view Name;
+    std::uint16_t Id;
+    std::int32_t TextureId;
+    std::int32_t TileX;
+    std::int32_t TileY;
+    std::uint32_t FirstAnimation;
+    std::uint32_t NumAnimations;
+};
+struct TextureData
+{
+    std::int32_t Id;
+    std::uint32_t NumTilesWidth;
+    std::uint32_t TileWidth;
+    std::uint32_t TileHeight;
+    std::uint32_t OffsetWidth;
+    std::uint32_t OffsetHeight;
+};
+
+const EntityData* FindEntityData(std::string_view entity_name);
+const TextureData* FindTextureData(std::int32_t texture_id);
+
+// Sorted by animation id
+std::span<const EntityAnimationData> GetEntityAnimations(const EntityData& entity_data);
@@ -1,34 +1,89 @@
 #include "extract_game_assets.h"
 
+#include "asset_bundle.h"
 #include "chacha.h"
 #include "dds_conversion.h"
 #include "detour/sigscan.h"
 #include "log.h"
 #include "util/algorithms.h"
+#include "util/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <zstd.h>
 
-template<class T>
-T Read(void*& data)
+#include <Windows.h>
+
+static std::optional<AssetBundleSource> GetAssetBundleSource()
 {
-    T value = *(T*)data;
-    data = (void*)((char*)data + sizeof(T));
-    return value;
+    namespace fs = std::filesystem;
+
+    wchar_t exe_path[MAX_PATH];
+    if (GetModuleFileNameW(0, exe_path, MAX_PATH) == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    const auto file_size = fs::file_size(exe_path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    const auto write_time = fs::last_write_time(exe_path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    return AssetBundleSource{
+        .FileSize{ file_size },
+        .WriteTime{ static_cast<std::int64_t>(write_time.time_since_epoch().count()) }
+    };
 }
-template<class T>
-std::vector<T> Read(void*& data, std::size_t size)
+
+// The index is only built once per run, afterwards it is loaded from the destination folder until the exe changes
+static const AssetBundleIndex* GetAssetBundleIndex(std::span<const std::uint8_t> data_section, const std::filesystem::path& destination)
 {
-    std::vector<T> value(size);
-    std::memcpy(value.data(), data, size * sizeof(T));
-    data = (void*)((char*)data + size * sizeof(T));
-    return value;
+    static std::mutex s_IndexMutex;
+    static std::optional<AssetBundleIndex> s_Index;
+
+    std::lock_guard lock{ s_IndexMutex };
+    if (s_Index.has_value())
+    {
+        return &s_Index.value();
+    }
+
+    const std::filesystem::path index_path = destination / "asset_bundle.idx";
+    const std::optional<AssetBundleSource> source = GetAssetBundleSource();
+    if (source.has_value())
+    {
+        s_Index = AssetBundleIndex::ReadFromFile(index_path, source.value(), data_section.size());
+    }
+
+    if (!s_Index.has_value())
+    {
+        s_Index = AssetBundleIndex::Parse(data_section);
+        if (!s_Index.has_value())
+        {
+            LogError("Failed parsing the asset bundle in Spel2.exe...");
+            return nullptr;
+        }
+
+        if (source.has_value() && !s_Index->WriteToFile(index_path, source.value()))
+        {
+            LogInfo("Failed writing asset bundle index to {}...", index_path.string());
+        }
+    }
+
+    return &s_Index.value();
 }
 
-bool ExtractGameAssets(std::span<const std::filesystem::path> files, const std::filesystem::path& destination)
+bool ExtractGameAssets(std::span<const std::filesystem::path> files, const std::filesystem::path& destination, ThreadPool* thread_pool)
 {
     namespace fs = std::filesystem;
 
@@ -53,140 +108,112 @@ bool ExtractGameAssets(std::span<const std::filesystem::path> files, const std::
         return true;
     }
 
-    LogInfo("Extracting required game assets from Spel2.exe, this might take a few minutes...");
+    LogInfo("Extracting required game assets from Spel2.exe...");
+
+    const std::span<const std::uint8_t> data_section = SigScan::GetDataSection();
+    if (data_section.empty())
+    {
+        return false;
+    }
+
+    const AssetBundleIndex* index = GetAssetBundleIndex(data_section, destination);
+    if (index == nullptr)
+    {
+        return false;
+    }
 
-    if (void* data = SigScan::GetDataSection())
+    struct ExtractJob
+    {
+        std::string FilePath;
+        const AssetBundleEntry* Asset;
+        const fs::path* FullDestination;
+        bool ConvertToPng;
+    };
+    std::vector<ExtractJob> jobs;
+
+    bool extracted_all{ true };
+    for (std::size_t i = 0; i < files.size(); i++)
     {
-        struct Asset
+        const auto& full_destination = full_file_paths[i];
+        if (full_destination.empty())
         {
-            void* Data;
-            std::size_t DataSize;
-            ChaCha::bytes_t AssetNameHash;
-            bool Encrypted;
-        };
-        std::vector<Asset> assets;
-
-        ChaCha::Key key;
-        while (true)
+            continue;
+        }
+
+        std::string file_path = files[i].string();
+        std::replace(file_path.begin(), file_path.end(), '\\', '/');
+
+        const AssetBundleEntry* asset = index->FindAsset(file_path);
+        if (asset == nullptr)
         {
-            const auto asset_len = Read<std::uint32_t>(data);
-            const auto asset_name_len = Read<std::uint32_t>(data);
-            if (asset_len == 0 && asset_name_len == 0)
-            {
-                break;
-            }
+            LogInfo("Failed extracting asset {}, no asset in the exe bundle matched its name...", file_path);
+            extracted_all = false;
+            continue;
+        }
+
+        jobs.push_back(ExtractJob{
+            .FilePath{ std::move(file_path) },
+            .Asset{ asset },
+            .FullDestination{ &full_destination },
+            .ConvertToPng{ files[i].extension() == ".DDS" } });
+    }
 
-            const auto asset_name_hash = Read<std::uint8_t>(data, asset_name_len);
-            const auto encrypted = Read<char>(data) == '\x01';
+    // Every job runs all stages for one asset, so at most one decrypted and one decompressed asset is alive per worker
+    auto extract_asset = [&](std::size_t i)
+    {
+        const ExtractJob& job = jobs[i];
+        const AssetBundleEntry* asset = job.Asset;
 
-            const auto data_address = data;
-            const auto data_size = asset_len - 1;
+        ChaCha::bytes_t decryped_data;
+        // Both parsing and reading the index only accept assets that lie within the data section
+        std::span<const std::uint8_t> asset_data = data_section.subspan(asset->Offset, asset->Size);
+        if (asset->Encrypted)
+        {
+            decryped_data = ChaCha::chacha(job.FilePath, asset_data, index->GetKey());
 
-            (void)Read<char>(data, data_size);
+            const std::uint64_t decompressed_size = ZSTD_getFrameContentSize(decryped_data.data(), decryped_data.size());
+            assert(decompressed_size != ZSTD_CONTENTSIZE_ERROR);
+            assert(decompressed_size != ZSTD_CONTENTSIZE_UNKNOWN);
 
-            key.update(asset_len);
+            ChaCha::bytes_t decompressed_data(decompressed_size);
+            [[maybe_unused]] const std::size_t decompressed_read_size = ZSTD_decompress(decompressed_data.data(), decompressed_data.size(), decryped_data.data(), decryped_data.size());
 
-            assets.push_back(Asset{
-                .Data = data_address,
-                .DataSize = data_size,
-                .AssetNameHash = asset_name_hash,
-                .Encrypted = encrypted });
+            decryped_data = std::move(decompressed_data);
+            asset_data = decryped_data;
         }
 
-        const ChaCha::bytes_t empty_hash{ unsigned char('\xDE'), unsigned char('\xAD'), unsigned char('\xBE'), unsigned char('\xEF') };
+        const fs::path& full_destination = *job.FullDestination;
 
-        std::vector<std::string> file_path_strings(files.size());
-        std::vector<ChaCha::bytes_t> hashes(files.size());
-        for (std::size_t i = 0; i < files.size(); i++)
         {
-            if (full_file_paths[i].empty())
-            {
-                hashes[i] = empty_hash;
-            }
-            else
-            {
-                auto& file_string = file_path_strings[i];
-                file_string = files[i].string();
-                std::replace(file_string.begin(), file_string.end(), '\\', '/');
-                hashes[i] = ChaCha::hash_filepath(file_string, key.Current);
-            }
+            // Other jobs may be creating the same folder concurrently
+            std::error_code ec;
+            fs::create_directories(full_destination.parent_path(), ec);
         }
 
-        auto match_hash = [](const ChaCha::bytes_t& lhs, const ChaCha::bytes_t& rhs)
-        {
-            const auto min_size = std::min(lhs.size(), rhs.size());
-            return std::equal(lhs.begin(), lhs.begin() + min_size, rhs.begin());
-        };
-
-        for (const Asset& asset : assets)
+        if (auto out_file = std::ofstream{ full_destination, std::ios::binary | std::ios::trunc })
         {
-            for (std::size_t i = 0; i < hashes.size(); i++)
-            {
-                if (match_hash(hashes[i], asset.AssetNameHash))
-                {
-                    const auto& file_path = file_path_strings[i];
-                    ChaCha::bytes_t decryped_data;
-                    std::span<const std::uint8_t> asset_data{ (std::uint8_t*)asset.Data, asset.DataSize };
-                    if (asset.Encrypted)
-                    {
-                        decryped_data = ChaCha::chacha(file_path, asset_data, key.Current);
-
-                        const std::uint64_t decompressed_size = ZSTD_getFrameContentSize(decryped_data.data(), decryped_data.size());
-                        assert(decompressed_size != ZSTD_CONTENTSIZE_ERROR);
-                        assert(decompressed_size != ZSTD_CONTENTSIZE_UNKNOWN);
-
-                        ChaCha::bytes_t decompressed_data(decompressed_size);
-                        [[maybe_unused]] const std::size_t decompressed_read_size = ZSTD_decompress(decompressed_data.data(), decompressed_data.size(), decryped_data.data(), decryped_data.size());
-
-                        decryped_data = std::move(decompressed_data);
-                        asset_data = decryped_data;
-                    }
-
-                    const auto& full_destination = full_file_paths[i];
-
-                    {
-                        const auto full_destination_dir = full_destination.parent_path();
-                        if (!fs::exists(full_destination.parent_path()))
-                        {
-                            fs::create_directories(full_destination.parent_path());
-                        }
-                    }
-
-                    if (auto out_file = std::ofstream{ full_destination, std::ios::binary | std::ios::trunc })
-                    {
-                        out_file.write(reinterpret_cast<const char*>(asset_data.data()), asset_data.size());
-                    }
-
-                    const auto& file = files[i];
-                    if (file.extension() == ".DDS")
-                    {
-                        auto converted_file = full_destination;
-                        converted_file.replace_extension(".png");
-                        ConvertDdsToPng(asset_data, converted_file);
-                    }
-
-                    hashes[i] = empty_hash;
-                    break;
-                }
-            }
+            out_file.write(reinterpret_cast<const char*>(asset_data.data()), asset_data.size());
         }
 
-        for (std::size_t i = 0; i < files.size(); i++)
+        if (job.ConvertToPng)
         {
-            if (hashes[i] != empty_hash)
-            {
-                const auto file_string = files[i].string();
-                LogInfo("Failed extracting asset {}, no asset in the exe bundle matched its name...", file_string);
-            }
+            auto converted_file = full_destination;
+            converted_file.replace_extension(".png");
+            ConvertDdsToPng(asset_data, converted_file);
         }
+    };
 
-        if (algo::count(hashes, empty_hash) != hashes.size())
+    if (thread_pool != nullptr)
+    {
+        thread_pool->ForEach(jobs.size(), extract_asset);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < jobs.size(); i++)
         {
-            return false;
+            extract_asset(i);
         }
-
-        return true;
     }
 
-    return false;
+    return extracted_all;
 }
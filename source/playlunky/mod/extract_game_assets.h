@@ -4,10 +4,13 @@
 #include <filesystem>
 #include <span>
 
-bool ExtractGameAssets(std::span<const std::filesystem::path> files, const std::filesystem::path& destination);
+class ThreadPool;
+
+// Assets are extracted in parallel if a thread pool is passed
+bool ExtractGameAssets(std::span<const std::filesystem::path> files, const std::filesystem::path& destination, ThreadPool* thread_pool = nullptr);
 
 template<std::size_t N>
-bool ExtractGameAssets(const std::array<std::filesystem::path, N>& files, const std::filesystem::path& destination)
+bool ExtractGameAssets(const std::array<std::filesystem::path, N>& files, const std::filesystem::path& destination, ThreadPool* thread_pool = nullptr)
 {
-    return ExtractGameAssets(std::span{ files.data(), N }, destination);
+    return ExtractGameAssets(std::span{ files.data(), N }, destination, thread_pool);
 }
@@ -74,14 +74,14 @@ std::optional<std::filesystem::path> GetCorrectPath(const std::filesystem::path&
     }
     else if (ctre::match<s_ArenaLevelRule>(file_name) || ctre::match<s_ArenaLevelTokRule>(file_name))
     {
-        if (algo::contains(s_ArenaLevelFiles, file_stem))
+        if (s_ArenaLevelFileSet.Contains(file_stem))
         {
             return s_ArenaLevelTargetPath / file_name_path;
         }
     }
     else if (ctre::match<s_LevelRule>(file_name))
     {
-        if (algo::contains(s_LevelFiles, file_stem))
+        if (s_LevelFileSet.Contains(file_stem))
         {
             return s_LevelTargetPath / file_name_path;
         }
@@ -110,44 +110,44 @@ std::optional<std::filesystem::path> GetCorrectPath(const std::filesystem::path&
         {
             return s_FullTextureTargetPath / file_name_path;
         }
-        else if (algo::contains(s_PetsEntityFiles, file_stem))
+        else if (s_PetsEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Pets" / file_name_path);
         }
-        else if (algo::contains(s_MountsEntityFiles, file_stem))
+        else if (s_MountsEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Mounts" / file_name_path);
         }
-        else if (algo::contains(s_GhostEntityFiles, file_stem))
+        else if (s_GhostEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Ghost" / file_name_path);
         }
-        else if (algo::contains(s_CrittersEntityFiles, file_stem))
+        else if (s_CrittersEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Critters" / file_name_path);
         }
-        else if (algo::contains(s_MonstersEntityFiles, file_stem))
+        else if (s_MonstersEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Monsters" / file_name_path);
         }
-        else if (algo::contains(s_BigMonstersEntityFiles, file_stem))
+        else if (s_BigMonstersEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("BigMonsters" / file_name_path);
         }
-        else if (algo::contains(s_PeopleEntityFiles, file_stem))
+        else if (s_PeopleEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("People" / file_name_path);
         }
-        else if (algo::contains(s_DecorationsEntityFiles, file_stem))
+        else if (s_DecorationsEntityFileSet.Contains(file_stem))
         {
             return s_FullTextureTargetPath / ("Decorations" / file_name_path);
         }
-        else if (algo::contains(s_KnownTextureFiles, file_stem))
+        else if (s_KnownTextureFileSet.Contains(file_stem))
         {
             return s_TextureTargetPath / file_name_path;
         }
     }
-    else if (algo::contains(s_KnownAudioFiles, file_stem))
+    else if (s_KnownAudioFileSet.Contains(file_stem))
     {
         if (ctre::match<s_WavRule>(file_name))
         {
@@ -181,12 +181,12 @@ std::optional<std::filesystem::path> GetCorrectPath(const std::filesystem::path&
         {
             return s_MppTargetPath / file_name_path;
         }
-        else if (algo::contains(s_RestKnownFiles, file_name))
+        else if (s_RestKnownFileSet.Contains(file_name))
         {
             return file_name;
         }
     }
-    else if (algo::contains(s_RestKnownFiles, file_name))
+    else if (s_RestKnownFileSet.Contains(file_name))
     {
         return file_name;
     }
@@ -0,0 +1,197 @@
+#include "fsb_parser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+// Bounds checked reads from the bank data, reading past the end marks the reader as failed instead of crashing
+class FsbReader
+{
+  public:
+    FsbReader(const char* begin, const char* end)
+        : mBegin{ begin }
+        , mPos{ begin }
+        , mEnd{ end }
+    {
+    }
+
+    template<class T>
+    T Read()
+    {
+        T value{};
+        if (Available() < sizeof(T))
+        {
+            Fail();
+            return value;
+        }
+        std::memcpy(&value, mPos, sizeof(T));
+        mPos += sizeof(T);
+        return value;
+    }
+
+    void Skip(std::size_t num_bytes)
+    {
+        if (Available() < num_bytes)
+        {
+            Fail();
+            return;
+        }
+        mPos += num_bytes;
+    }
+
+    // Reads a null-terminated string of at most max_length characters
+    std::string ReadString(std::size_t max_length)
+    {
+        const std::size_t length = strnlen(mPos, std::min(max_length, Available()));
+        std::string ret{ mPos, length };
+        mPos += length;
+        return ret;
+    }
+
+    void Seek(const char* pos)
+    {
+        if (pos < mBegin || pos > mEnd)
+        {
+            Fail();
+            return;
+        }
+        mPos = pos;
+    }
+
+    const char* GetPos() const
+    {
+        return mPos;
+    }
+    bool HasFailed() const
+    {
+        return mFailed;
+    }
+
+  private:
+    std::size_t Available() const
+    {
+        return static_cast<std::size_t>(mEnd - mPos);
+    }
+    void Fail()
+    {
+        mPos = mEnd;
+        mFailed = true;
+    }
+
+    const char* mBegin;
+    const char* mPos;
+    const char* mEnd;
+    bool mFailed{ false };
+};
+
+static bool ParseFsbFile(const char* fsb_begin, const char* bank_end, std::vector<FsbSampleHeader>& samples)
+{
+    FsbReader reader{ fsb_begin, bank_end };
+
+    reader.Skip(4); // "FSB5"
+    const auto version = reader.Read<std::uint32_t>();
+    if (version != 1)
+    {
+        return false;
+    }
+
+    const auto num_samples = reader.Read<std::uint32_t>();
+    const auto sample_headers_size = reader.Read<std::uint32_t>();
+    const auto sample_names_size = reader.Read<std::uint32_t>();
+    [[maybe_unused]] const auto sample_datas_size = reader.Read<std::uint32_t>();
+    [[maybe_unused]] const auto bank_flags = reader.Read<std::uint32_t>();
+    reader.Skip(32);
+    if (reader.HasFailed())
+    {
+        return false;
+    }
+
+    const std::size_t header_size = reader.GetPos() - fsb_begin;
+    const std::size_t sample_names_offset = header_size + sample_headers_size;
+    const std::size_t sample_datas_offset = header_size + sample_headers_size + sample_names_size;
+    const std::size_t bank_size = bank_end - fsb_begin;
+    if (sample_names_offset > bank_size || num_samples > (bank_size - header_size) / 8)
+    {
+        return false;
+    }
+
+    samples.reserve(num_samples);
+    for (std::uint32_t i = 0; i < num_samples; i++)
+    {
+        std::string sample_name;
+
+        const auto sample_mode = reader.Read<std::uint64_t>();
+        auto next_header_type = sample_mode & ((1 << 7) - 1);
+        const std::uint64_t offset = ((sample_mode >> 7) << 5) & 0xffffffff;
+
+        while ((next_header_type & 1) && !reader.HasFailed())
+        {
+            auto this_header_type = reader.Read<std::uint32_t>();
+            next_header_type = this_header_type & 1;
+            const auto header_length = (this_header_type & 0xffffff) >> 1;
+            this_header_type >>= 24;
+
+            const char* header_data = reader.GetPos();
+            if (this_header_type == 0x8)
+            {
+                reader.Skip(1);
+                sample_name = reader.ReadString(256);
+            }
+            reader.Seek(header_data);
+            reader.Skip(header_length);
+        }
+
+        if (reader.HasFailed())
+        {
+            return false;
+        }
+
+        if (sample_names_size != 0)
+        {
+            const char* sample_names_data = fsb_begin + sample_names_offset;
+            FsbReader names_reader{ sample_names_data, bank_end };
+            names_reader.Skip(i * 4);
+            const auto name_offset = names_reader.Read<std::uint32_t>();
+            names_reader.Seek(sample_names_data);
+            names_reader.Skip(name_offset);
+            if (names_reader.HasFailed())
+            {
+                return false;
+            }
+            sample_name = names_reader.ReadString(256 + 32 + 1024);
+        }
+        // This should not happen to us?
+        else if (sample_name.empty())
+        {
+            sample_name = std::to_string(i);
+        }
+
+        samples.push_back(FsbSampleHeader{
+            .Name{ std::move(sample_name) },
+            .Offset{ static_cast<std::uint32_t>(sample_datas_offset + offset) } });
+    }
+
+    std::sort(samples.begin(), samples.end(), [](const FsbSampleHeader& lhs, const FsbSampleHeader& rhs)
+              { return lhs.Offset < rhs.Offset; });
+
+    return true;
+}
+
+std::vector<FsbHeader> ParseFsbFiles(std::span<const char> bank_data)
+{
+    std::vector<FsbHeader> fsb_files;
+
+    const std::string_view bank_view{ bank_data.data(), bank_data.size() };
+    for (std::size_t fsb_offset = bank_view.find("FSB5"); fsb_offset != std::string_view::npos; fsb_offset = bank_view.find("FSB5", fsb_offset + 4))
+    {
+        std::vector<FsbSampleHeader> samples;
+        if (ParseFsbFile(bank_data.data() + fsb_offset, bank_data.data() + bank_data.size(), samples))
+        {
+            fsb_files.push_back(FsbHeader{
+                .Offset{ static_cast<std::uint32_t>(fsb_offset) },
+                .Samples{ std::move(samples) } });
+        }
+    }
+
+    return fsb_files;
+}
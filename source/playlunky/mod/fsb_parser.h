@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+struct FsbSampleHeader
+{
+    std::string Name;
+    std::uint32_t Offset;
+};
+struct FsbHeader
+{
+    std::uint32_t Offset;
+    std::vector<FsbSampleHeader> Samples;
+};
+
+// Finds all FSB5 sound banks inside of the bank data, bank offsets are relative to the bank data and sample offsets relative to their bank
+// Samples are sorted by offset, malformed sound banks are skipped
+std::vector<FsbHeader> ParseFsbFiles(std::span<const char> bank_data);
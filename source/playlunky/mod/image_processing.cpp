@@ -4,6 +4,7 @@
 #include "util/algorithms.h"
 #include "util/format.h"
 #include "util/on_scope_exit.h"
+#include "util/pixel_blend.h"
 
 #include <Windows.h>
 
@@ -341,9 +342,24 @@ Image MakeCombinedMenuPetHeads(std::vector<std::pair<Image, std::filesystem::pat
     return std::move(monty);
 }
 
-Image AlphaBlend(Image lhs_image, Image rhs_image)
+// Runs the kernel on all rows of the images in parallel, the images have to be RGBA8 and of the same size
+template<class FunT>
+static void ForEachRow(const cv::Mat& image, FunT&& fun)
+{
+    cv::parallel_for_(cv::Range{ 0, image.rows }, [&](const cv::Range& rows)
+                      {
+                          for (int row = rows.start; row < rows.end; row++)
+                          {
+                              fun(row);
+                          } });
+}
+static std::span<std::uint8_t> GetRow(cv::Mat& image, int row)
 {
+    return { image.ptr<std::uint8_t>(row), image.cols * image.elemSize() };
+}
 
+Image AlphaBlend(Image lhs_image, Image rhs_image)
+{
     if (lhs_image.GetWidth() != rhs_image.GetWidth() || lhs_image.GetHeight() != rhs_image.GetHeight())
     {
         lhs_image.Resize(ImageSize{ rhs_image.GetWidth(), rhs_image.GetHeight() });
@@ -356,17 +372,8 @@ Image AlphaBlend(Image lhs_image, Image rhs_image)
 
     if (lhs_image_cv_image_ptr && rhs_image_cv_image_ptr)
     {
-        std::vector<cv::Mat> rhs_channels;
-        cv::split(**rhs_image_cv_image_ptr, rhs_channels);
-
-        cv::Mat& rhs_alpha_channel = rhs_channels[3];
-
-        cv::Mat rhs_alpha_mask;
-        cv::merge(std::vector<cv::Mat>{ rhs_alpha_channel, rhs_alpha_channel, rhs_alpha_channel, rhs_alpha_channel }, rhs_alpha_mask);
-        cv::multiply(cv::Scalar::all(1.0f / 255.0f), rhs_alpha_mask, rhs_alpha_mask);
-        cv::multiply(cv::Scalar::all(1.0f) - rhs_alpha_mask, **lhs_image_cv_image_ptr, **lhs_image_cv_image_ptr);
-        cv::multiply(rhs_alpha_mask, **rhs_image_cv_image_ptr, **rhs_image_cv_image_ptr);
-        cv::add(**lhs_image_cv_image_ptr, **rhs_image_cv_image_ptr, **lhs_image_cv_image_ptr);
+        ForEachRow(**lhs_image_cv_image_ptr, [&](int row)
+                   { AlphaBlendPixels(GetRow(**rhs_image_cv_image_ptr, row), GetRow(**lhs_image_cv_image_ptr, row)); });
 
         return lhs_image;
     }
@@ -386,20 +393,8 @@ Image ColorBlend(Image color_image, Image target_image)
 
     if (color_image_cv_image_ptr && target_image_cv_image_ptr)
     {
-        (*target_image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& pixel, const int position[])
-                                                         {
-                                                             const cv::Vec4b& color_pixel = (*color_image_cv_image_ptr)->at<cv::Vec4b>(position[0], position[1]);
-
-                                                             const float color = GetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f);
-                                                             const auto [fr, fg, fb] = SetLuminance(color_pixel[0] / 255.0f, color_pixel[1] / 255.0f, color_pixel[2] / 255.0f, color);
-                                                             const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
-                                                             const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
-                                                             const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
-
-                                                             const float color_alpha = color_pixel[3] / 255.0f;
-                                                             pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - color_alpha) + r * color_alpha);
-                                                             pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - color_alpha) + g * color_alpha);
-                                                             pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - color_alpha) + b * color_alpha); });
+        ForEachRow(**target_image_cv_image_ptr, [&](int row)
+                   { ColorBlendPixels(GetRow(**color_image_cv_image_ptr, row), GetRow(**target_image_cv_image_ptr, row)); });
 
         return target_image;
     }
@@ -419,19 +414,8 @@ Image LuminanceBlend(Image luminance_image, Image target_image)
 
     if (luminance_image_cv_image_ptr && target_image_cv_image_ptr)
     {
-        (*target_image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& pixel, const int position[])
-                                                         {
-                                                             const cv::Vec4b& luminance_pixel = (*luminance_image_cv_image_ptr)->at<cv::Vec4b>(position[0], position[1]);
-                                                             const float luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
-                                                             const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, luminance);
-                                                             const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
-                                                             const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
-                                                             const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
-
-                                                             const float luminance_alpha = luminance_pixel[3] / 255.0f;
-                                                             pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
-                                                             pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
-                                                             pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha); });
+        ForEachRow(**target_image_cv_image_ptr, [&](int row)
+                   { LuminanceBlendPixels(GetRow(**luminance_image_cv_image_ptr, row), GetRow(**target_image_cv_image_ptr, row)); });
 
         return target_image;
     }
@@ -451,21 +435,8 @@ Image LuminanceScale(Image luminance_scale_image, Image target_image)
 
     if (luminance_image_cv_image_ptr && target_image_cv_image_ptr)
     {
-        (*target_image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& pixel, const int position[])
-                                                         {
-                                                             const cv::Vec4b& luminance_pixel = (*luminance_image_cv_image_ptr)->at<cv::Vec4b>(position[0], position[1]);
-                                                             const auto luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
-                                                             const auto cur_lum = GetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f);
-                                                             const auto new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
-                                                             const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, new_lum);
-                                                             const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
-                                                             const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
-                                                             const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
-
-                                                             const float luminance_alpha = luminance_pixel[3] / 255.0f;
-                                                             pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
-                                                             pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
-                                                             pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha); });
+        ForEachRow(**target_image_cv_image_ptr, [&](int row)
+                   { LuminanceScalePixels(GetRow(**luminance_image_cv_image_ptr, row), GetRow(**target_image_cv_image_ptr, row)); });
 
         return target_image;
     }
@@ -491,25 +462,8 @@ Image LuminanceScale(Image luminance_scale_image, Image base_luminance_image, Im
 
     if (base_luminance_image_cv_image_ptr && luminance_image_cv_image_ptr && target_image_cv_image_ptr)
     {
-        (*target_image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& pixel, const int position[])
-                                                         {
-                                                             const cv::Vec4b& luminance_pixel = (*luminance_image_cv_image_ptr)->at<cv::Vec4b>(position[0], position[1]);
-                                                             if (luminance_pixel[3] == 255)
-                                                             {
-                                                                 const cv::Vec4b& base_pixel = (*base_luminance_image_cv_image_ptr)->at<cv::Vec4b>(position[0], position[1]);
-                                                                 const auto luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
-                                                                 const auto cur_lum = GetLuminance(base_pixel[0] / 255.0f, base_pixel[1] / 255.0f, base_pixel[2] / 255.0f);
-                                                                 const auto new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
-                                                                 const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, new_lum);
-                                                                 const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
-                                                                 const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
-                                                                 const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
-
-                                                                 const float luminance_alpha = luminance_pixel[3] / 255.0f;
-                                                                 pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
-                                                                 pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
-                                                                 pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha);
-                                                             } });
+        ForEachRow(**target_image_cv_image_ptr, [&](int row)
+                   { LuminanceScalePixels(GetRow(**luminance_image_cv_image_ptr, row), GetRow(**base_luminance_image_cv_image_ptr, row), GetRow(**target_image_cv_image_ptr, row)); });
 
         return target_image;
     }
@@ -523,13 +477,8 @@ Image ReplaceColor(Image input_image, ColorRGB8 source_color, ColorRGB8 target_c
 
     if (image_cv_image_ptr)
     {
-        (*image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& cv_pixel, [[maybe_unused]] const int position[])
-                                                  {
-                                                      ColorRGB8& pixel = reinterpret_cast<ColorRGB8&>(cv_pixel);
-                                                      if (pixel == source_color)
-                                                      {
-                                                          pixel = target_color;
-                                                      } });
+        ForEachRow(**image_cv_image_ptr, [&](int row)
+                   { ReplaceColorPixels(GetRow(**image_cv_image_ptr, row), source_color, target_color); });
     }
     return input_image;
 }
@@ -540,18 +489,8 @@ Image ReplaceColors(Image input_image, const std::vector<ColorRGB8>& source_colo
 
     if (image_cv_image_ptr)
     {
-        (*image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& cv_pixel, [[maybe_unused]] const int position[])
-                                                  {
-                                                      ColorRGB8& pixel = reinterpret_cast<ColorRGB8&>(cv_pixel);
-                                                      for (size_t i = 0; i < source_colors.size(); i++)
-                                                      {
-                                                          const ColorRGB8& source_color = source_colors[i];
-                                                          if (pixel == source_color)
-                                                          {
-                                                              pixel = target_colors[i];
-                                                              return;
-                                                          }
-                                                      } });
+        ForEachRow(**image_cv_image_ptr, [&](int row)
+                   { ReplaceColorsPixels(GetRow(**image_cv_image_ptr, row), source_colors, target_colors); });
     }
     return input_image;
 }
@@ -562,13 +501,8 @@ Image ExtractColor(Image input_image, ColorRGB8 color)
 
     if (image_cv_image_ptr)
     {
-        (*image_cv_image_ptr)->forEach<cv::Vec4b>([&](cv::Vec4b& cv_pixel, [[maybe_unused]] const int position[])
-                                                  {
-                                                      ColorRGB8& pixel = reinterpret_cast<ColorRGB8&>(cv_pixel);
-                                                      if (pixel != color)
-                                                      {
-                                                          cv_pixel = cv::Vec4b{ 0, 0, 0, 0 };
-                                                      } });
+        ForEachRow(**image_cv_image_ptr, [&](int row)
+                   { ExtractColorPixels(GetRow(**image_cv_image_ptr, row), color); });
     }
     return input_image;
 }
@@ -0,0 +1,18 @@
+#include "known_files.h"
+
+constinit const PerfectHashSet<std::string_view, std::size(s_ArenaLevelFiles), true> s_ArenaLevelFileSet{ s_ArenaLevelFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_LevelFiles), true> s_LevelFileSet{ s_LevelFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_PetsEntityFiles), true> s_PetsEntityFileSet{ s_PetsEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_MountsEntityFiles), true> s_MountsEntityFileSet{ s_MountsEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_GhostEntityFiles), true> s_GhostEntityFileSet{ s_GhostEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_CrittersEntityFiles), true> s_CrittersEntityFileSet{ s_CrittersEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_MonstersEntityFiles), true> s_MonstersEntityFileSet{ s_MonstersEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_BigMonstersEntityFiles), true> s_BigMonstersEntityFileSet{ s_BigMonstersEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_PeopleEntityFiles), true> s_PeopleEntityFileSet{ s_PeopleEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_DecorationsEntityFiles), true> s_DecorationsEntityFileSet{ s_DecorationsEntityFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_KnownCharFiles), true> s_KnownCharFileSet{ s_KnownCharFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_KnownTextureFiles), true> s_KnownTextureFileSet{ s_KnownTextureFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_KnownAudioFiles), true> s_KnownAudioFileSet{ s_KnownAudioFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_RestKnownFiles), true> s_RestKnownFileSet{ s_RestKnownFiles };
+constinit const PerfectHashSet<std::string_view, std::size(s_SpeedrunDbFiles)> s_SpeedrunDbFileSet{ s_SpeedrunDbFiles };
+constinit const PerfectHashSet<std::uint32_t, std::size(s_SpeedrunStringHashes)> s_SpeedrunStringHashSet{ s_SpeedrunStringHashes };
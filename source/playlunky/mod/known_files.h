@@ -1,6 +1,9 @@
 #pragma once
 
+#include "util/perfect_hash_set.h"
+
 #include <array>
+#include <cstdint>
 #include <string_view>
 
 inline constexpr std::string_view s_ArenaLevelFiles[]{
@@ -183,2715 +186,260 @@ inline constexpr std::string_view s_MonstersEntityFiles[]{
     "witch_doctor",
     "witch_doctor_skull",
     "yeti",
-    "tadpole"
-};
-inline constexpr std::string_view s_BigMonstersEntityFiles[]{
-    "alien_queen",
-    "ammit",
-    "crab_man",
-    "eggplant_minister",
-    "giant_clam",
-    "giant_fish",
-    "giant_fly",
-    "giant_frog",
-    "giant_spider",
-    "lamassu",
-    "lavamander",
-    "madame_tusk",
-    "mummy",
-    "olmec",
-    "osiris",
-    "queen_bee",
-    "quill_back",
-    "waddler",
-    "yeti_king",
-    "yeti_queen",
-};
-inline constexpr std::string_view s_PeopleEntityFiles[]{
-    "bodyguard",
-    "hunduns_servant",
-    "merchant",
-    "old_hunter",
-    "parmesan",
-    "parsley",
-    "parsnip",
-    "shopkeeper",
-    "thief",
-    "yang",
-};
-inline constexpr std::string_view s_DecorationsEntityFiles[]{
-    "udjat_wall_heads",
-};
-inline constexpr std::string_view s_KnownCharFiles[]{
-    "char_black",
-    "char_blue",
-    "char_cerulean",
-    "char_cinnabar",
-    "char_cyan",
-    "char_eggchild",
-    "char_gold",
-    "char_gray",
-    "char_green",
-    "char_hired",
-    "char_iris",
-    "char_khaki",
-    "char_lemon",
-    "char_lime",
-    "char_magenta",
-    "char_olive",
-    "char_orange",
-    "char_pink",
-    "char_red",
-    "char_violet",
-    "char_white",
-    "char_yellow",
-};
-inline constexpr std::string_view s_KnownTextureFiles[]{
-    "base_eggship",
-    "base_eggship2",
-    "base_eggship3",
-    "base_skynight",
-    "base_surface",
-    "base_surface2",
-    "bayer8",
-    "bg_babylon",
-    "bg_beehive",
-    "bg_cave",
-    "bg_duat",
-    "bg_duat2",
-    "bg_eggplant",
-    "bg_gold",
-    "bg_ice",
-    "bg_jungle",
-    "bg_mothership",
-    "bg_stone",
-    "bg_sunken",
-    "bg_temple",
-    "bg_tidepool",
-    "bg_vlad",
-    "bg_volcano",
-    "border_main",
-    "char_black",
-    "char_blue",
-    "char_cerulean",
-    "char_cinnabar",
-    "char_cyan",
-    "char_eggchild",
-    "char_gold",
-    "char_gray",
-    "char_green",
-    "char_hired",
-    "char_iris",
-    "char_khaki",
-    "char_lemon",
-    "char_lime",
-    "char_magenta",
-    "char_olive",
-    "char_orange",
-    "char_pink",
-    "char_red",
-    "char_violet",
-    "char_white",
-    "char_yellow",
-    "coffins",
-    "credits",
-    "deco_babylon",
-    "deco_basecamp",
-    "deco_cave",
-    "deco_cosmic",
-    "deco_eggplant",
-    "deco_extra",
-    "deco_gold",
-    "deco_ice",
-    "deco_jungle",
-    "deco_sunken",
-    "deco_temple",
-    "deco_tidepool",
-    "deco_tutorial",
-    "deco_volcano",
-    "floor_babylon",
-    "floor_cave",
-    "floor_eggplant",
-    "floor_ice",
-    "floor_jungle",
-    "floor_sunken",
-    "floor_surface",
-    "floor_temple",
-    "floor_tidepool",
-    "floor_volcano",
-    "floormisc",
-    "floorstyled_babylon",
-    "floorstyled_beehive",
-    "floorstyled_duat",
-    "floorstyled_gold_normal",
-    "floorstyled_gold",
-    "floorstyled_guts",
-    "floorstyled_mothership",
-    "floorstyled_pagoda",
-    "floorstyled_palace",
-    "floorstyled_stone",
-    "floorstyled_sunken",
-    "floorstyled_temple",
-    "floorstyled_vlad",
-    "floorstyled_wood",
-    "fontdebug",
-    "fontfirasans",
-    "fontmono",
-    "fontnewrodin",
-    "fontrodincattleya",
-    "fontyorkten",
-    "fx_ankh",
-    "fx_big",
-    "fx_explosion",
-    "fx_rubble",
-    "fx_small",
-    "fx_small2",
-    "fx_small3",
-    "hud_controller_buttons",
-    "hud_text",
-    "hud",
-    "items_ushabti",
-    "items",
-    "journal_back",
-    "journal_elements",
-    "journal_entry_bg",
-    "journal_entry_items",
-    "journal_entry_mons_big",
-    "journal_entry_mons",
-    "journal_entry_people",
-    "journal_entry_place",
-    "journal_entry_traps",
-    "journal_pageflip",
-    "journal_pagetorn",
-    "journal_select",
-    "journal_stickers",
-    "journal_story",
-    "journal_top_entry",
-    "journal_top_gameover",
-    "journal_top_main",
-    "journal_top_profile",
-    "loading",
-    "lut_backlayer",
-    "lut_blackmarket",
-    "lut_icecaves",
-    "lut_original",
-    "lut_vlad",
-    "main_body",
-    "main_dirt",
-    "main_door",
-    "main_doorback",
-    "main_doorframe",
-    "main_fore1",
-    "main_fore2",
-    "main_head",
-    "menu_basic",
-    "menu_brick1",
-    "menu_brick2",
-    "menu_cave1",
-    "menu_cave2",
-    "menu_chardoor",
-    "menu_charsel",
-    "menu_deathmatch",
-    "menu_deathmatch2",
-    "menu_deathmatch3",
-    "menu_deathmatch4",
-    "menu_deathmatch5",
-    "menu_deathmatch6",
-    "menu_disp",
-    "menu_generic",
-    "menu_header",
-    "menu_leader",
-    "menu_online",
-    "menu_title",
-    "menu_titlegal",
-    "menu_tunnel",
-    "monsters_ghost",
-    "monsters_hundun",
-    "monsters_olmec",
-    "monsters_osiris",
-    "monsters_pets",
-    "monsters_tiamat",
-    "monsters_yama",
-    "monsters01",
-    "monsters02",
-    "monsters03",
-    "monstersbasic01",
-    "monstersbasic02",
-    "monstersbasic03",
-    "monstersbig01",
-    "monstersbig02",
-    "monstersbig03",
-    "monstersbig04",
-    "monstersbig05",
-    "monstersbig06",
-    "mounts",
-    "noise0",
-    "noise1",
-    "saving",
-    "shadows",
-    "shine",
-    "splash0",
-    "splash1",
-    "splash2",
-    "extra_thorns",
-    "extra_pipes",
-};
-inline constexpr std::string_view s_KnownAudioFiles[]{
-    "AMB_Beehive",
-    "AMB_Dwelling",
-    "AMB_Ending",
-    "AMB_Factory",
-    "AMB_Ice_caves",
-    "AMB_Jungle",
-    "AMB_Layer_2",
-    "AMB_Palace",
-    "AMB_Prison",
-    "AMB_Restless_dead",
-    "AMB_Sunken_city",
-    "AMB_Temple",
-    "AMB_Tidepool",
-    "AMB_Volcano",
-    "BGM_1_1HP_A",
-    "BGM_1_1HP_B",
-    "BGM_1_Add_A",
-    "BGM_1_Add_B",
-    "BGM_1_Adventure",
-    "BGM_1_Brushu",
-    "BGM_1_Chef",
-    "BGM_1_Delp_2",
-    "BGM_1_Delp_4",
-    "BGM_1_Goblet",
-    "BGM_1_Gob_tran",
-    "BGM_1_Idle",
-    "BGM_1_Leadup_A",
-    "BGM_1_Leadup_B",
-    "BGM_1_Meppa",
-    "BGM_1_Ongaky",
-    "BGM_1_Ongrest",
-    "BGM_1_Sekatt",
-    "BGM_1_Shu_A",
-    "BGM_1_Shu_B",
-    "BGM_1_Shu_C",
-    "BGM_1_Yuzu",
-    "BGM_1_Yuzu_tem",
-    "BGM_2Adim_Cold01",
-    "BGM_2Adim_Coreps",
-    "BGM_2Adim_Coreps_bare",
-    "BGM_2Adim_Yuba",
-    "BGM_2Adim_Yuba_bare",
-    "BGM_2A_1HP_1A",
-    "BGM_2A_1HP_1B",
-    "BGM_2A_1HP_2",
-    "BGM_2A_Grova",
-    "BGM_2A_Grovette_A",
-    "BGM_2A_Grovette_B",
-    "BGM_2A_Grovette_C",
-    "BGM_2A_Idle",
-    "BGM_2A_Intro",
-    "BGM_2A_Isamme",
-    "BGM_2A_Itaki",
-    "BGM_2A_Itaki_nude",
-    "BGM_2A_Itamini",
-    "BGM_2A_Jupiter",
-    "BGM_2A_Molamola",
-    "BGM_2A_Toil",
-    "BGM_2A_Tomb",
-    "BGM_2A_Yoga",
-    "BGM_2A_Yoga_lite",
-    "BGM_2A_Yuba",
-    "BGM_2Bdim_Bares",
-    "BGM_2Bdim_Cold01",
-    "BGM_2Bdim_Druma",
-    "BGM_2Bdim_Melpa",
-    "BGM_2Bdim_Melpa_bare",
-    "BGM_2Bdim_Unep",
-    "BGM_2Bdim_Unep_bare",
-    "BGM_2B_Gordeux",
-    "BGM_2B_Gorlek",
-    "BGM_2B_Gorlek_lite",
-    "BGM_2B_Gyrak",
-    "BGM_2B_Intro",
-    "BGM_2B_Machano",
-    "BGM_2B_Pavlova",
-    "BGM_2B_Snorpek",
-    "BGM_2B_Tail_A",
-    "BGM_2B_Tail_B",
-    "BGM_2B_Tomb_A",
-    "BGM_2B_Tomb_B",
-    "BGM_3_Intro",
-    "BGM_3_P1_A",
-    "BGM_3_P1_B",
-    "BGM_3_P1_C",
-    "BGM_3_P1_D",
-    "BGM_3_P1_Tran",
-    "BGM_3_P2_A",
-    "BGM_3_P2_B",
-    "BGM_3_P2_C",
-    "BGM_3_P2_D",
-    "BGM_3_P2_Tran",
-    "BGM_3_P3_A",
-    "BGM_3_P3_B",
-    "BGM_3_P3_C",
-    "BGM_3_P3_Tran",
-    "BGM_3_Post_A",
-    "BGM_3_Post_B",
-    "BGM_3_Post_C",
-    "BGM_4Adim_Cold01",
-    "BGM_4Adim_Mable",
-    "BGM_4Adim_Mable_bare",
-    "BGM_4Adim_Mable_drum",
-    "BGM_4Adim_Ogga",
-    "BGM_4Adim_Ogga_bare",
-    "BGM_4A_1HP_1",
-    "BGM_4A_1HP_2A",
-    "BGM_4A_1HP_2B",
-    "BGM_4A_1HP_3",
-    "BGM_4A_Beat",
-    "BGM_4A_Bobby",
-    "BGM_4A_Doob",
-    "BGM_4A_Egg",
-    "BGM_4A_Erebus",
-    "BGM_4A_Erebus_alt",
-    "BGM_4A_Erexit",
-    "BGM_4A_Holsmak",
-    "BGM_4A_Idle",
-    "BGM_4A_Intro",
-    "BGM_4A_Jole",
-    "BGM_4A_Mafin",
-    "BGM_4A_Nog",
-    "BGM_4A_Spurl",
-    "BGM_4A_Spurl_alt",
-    "BGM_4A_Sweps",
-    "BGM_4A_Syrka",
-    "BGM_4A_Tomb",
-    "BGM_4Bdim_Cold01",
-    "BGM_4Bdim_Muglep",
-    "BGM_4Bdim_Muglep_bare",
-    "BGM_4Bdim_Sope",
-    "BGM_4Bdim_Toyle",
-    "BGM_4Bdim_Toyle_bare",
-    "BGM_4B_Beska_A",
-    "BGM_4B_Beska_A_strip",
-    "BGM_4B_Beska_B",
-    "BGM_4B_Eplan_A",
-    "BGM_4B_Eplan_B",
-    "BGM_4B_Eplan_B_strip",
-    "BGM_4B_Guliar",
-    "BGM_4B_Hiya_X",
-    "BGM_4B_Hiya_Y",
-    "BGM_4B_Idle_A",
-    "BGM_4B_Idle_B",
-    "BGM_4B_Idle_C",
-    "BGM_4B_Intro",
-    "BGM_4B_Magmaron",
-    "BGM_4B_Ogle",
-    "BGM_4B_Peska_A",
-    "BGM_4B_Peska_B",
-    "BGM_4B_Rinpan",
-    "BGM_4B_Uruag",
-    "BGM_5_A",
-    "BGM_5_B",
-    "BGM_5_C",
-    "BGM_5_D",
-    "BGM_5_E",
-    "BGM_5_F",
-    "BGM_5_Intro",
-    "BGM_6dim_mak01",
-    "BGM_6dim_mak02",
-    "BGM_6dim_mak03",
-    "BGM_6dim_mak04",
-    "BGM_6dim_mak05",
-    "BGM_6_1HP",
-    "BGM_6_Belly",
-    "BGM_6_Boar",
-    "BGM_6_Bogstorm",
-    "BGM_6_Booglet",
-    "BGM_6_Idle_A",
-    "BGM_6_Idle_B",
-    "BGM_6_Intro",
-    "BGM_6_Maurice",
-    "BGM_6_Memo",
-    "BGM_6_Nima",
-    "BGM_6_Nimdeps",
-    "BGM_6_Octlet",
-    "BGM_6_Octlet_strip",
-    "BGM_6_Polbas",
-    "BGM_6_Polbas_strip",
-    "BGM_6_Selk",
-    "BGM_6_Silepsis",
-    "BGM_6_Ulmer",
-    "BGM_6_Ulmer_strip",
-    "BGM_7dim_Bontos",
-    "BGM_7dim_Mospe",
-    "BGM_7dim_Reng",
-    "BGM_7dim_Soil",
-    "BGM_7_Belldor",
-    "BGM_7_Derma",
-    "BGM_7_Hexton_A",
-    "BGM_7_Hexton_B",
-    "BGM_7_Lorma",
-    "BGM_7_Lorm_Half",
-    "BGM_7_Nektarin",
-    "BGM_7_Oligar",
-    "BGM_7_Septon_A",
-    "BGM_7_Septon_B",
-    "BGM_A1d_alien",
-    "BGM_A1d_amb",
-    "BGM_A1d_p01a",
-    "BGM_A1d_p01b",
-    "BGM_A1d_p02a",
-    "BGM_A1d_p02b",
-    "BGM_A1d_p03",
-    "BGM_Abzu_Ebsen",
-    "BGM_Abzu_Mak",
-    "BGM_Abzu_Pre_A",
-    "BGM_Abzu_Pre_B",
-    "BGM_Abzu_Sak",
-    "BGM_Abzu_Sakka",
-    "BGM_Aggro_Abbas_A",
-    "BGM_Aggro_Abbas_B",
-    "BGM_Aggro_Abs_A",
-    "BGM_Aggro_Abs_B",
-    "BGM_Aggro_Abs_C",
-    "BGM_Aggro_Bombas_A",
-    "BGM_Aggro_Bombas_B",
-    "BGM_Aggro_Bombas_C",
-    "BGM_Aggro_Bombas_D",
-    "BGM_Aggro_Ebs_A",
-    "BGM_Aggro_Ebs_B",
-    "BGM_Aggro_Ebs_C",
-    "BGM_Aggro_Ebs_D",
-    "BGM_Aggro_Eglor",
-    "BGM_Aggro_Intro",
-    "BGM_Aggro_Mulp",
-    "BGM_Aggro_Namek_A",
-    "BGM_Aggro_Namek_B",
-    "BGM_Aggro_Numbas",
-    "BGM_Basecamp_A",
-    "BGM_Basecamp_B",
-    "BGM_Basecamp_C",
-    "BGM_Basecamp_D",
-    "BGM_Basecamp_E",
-    "BGM_Basecamp_Surface",
-    "BGM_Black_Market_Bazaar",
-    "BGM_Black_Market_Part_A",
-    "BGM_Black_Market_Part_B",
-    "BGM_Black_Market_Pre",
-    "BGM_Black_Market_Transition",
-    "BGM_Challenge_Moon_Bare",
-    "BGM_Challenge_Moon_Main",
-    "BGM_Challenge_Moon_Trans",
-    "BGM_Challenge_Timed",
-    "BGM_CoG_Intro",
-    "BGM_CoG_Main",
-    "BGM_Cosmic_Ocean",
-    "BGM_Credits_A_Intro",
-    "BGM_Credits_A_Main",
-    "BGM_Credits_B",
-    "BGM_Deathmatch_Babylon",
-    "BGM_Deathmatch_Default",
-    "BGM_Deathmatch_Dwelling",
-    "BGM_Deathmatch_Ice_Caves",
-    "BGM_Deathmatch_Jungle",
-    "BGM_Deathmatch_Splash",
-    "BGM_Deathmatch_Sunken",
-    "BGM_Deathmatch_Temple",
-    "BGM_Deathmatch_Tidepool",
-    "BGM_Deathmatch_Victory",
-    "BGM_Deathmatch_Victory_intro",
-    "BGM_Deathmatch_Volcana",
-    "BGM_Duat_Battle",
-    "BGM_Duat_Bat_tran",
-    "BGM_Duat_Hi_A",
-    "BGM_Duat_Hi_B",
-    "BGM_Duat_Hi_C",
-    "BGM_Duat_Hi_D",
-    "BGM_Duat_Hi_E",
-    "BGM_Duat_Intro",
-    "BGM_Duat_Low_A",
-    "BGM_Duat_Low_B",
-    "BGM_Duat_Low_C",
-    "BGM_Duat_Low_D",
-    "BGM_Duat_Low_E",
-    "BGM_Duat_Mid_A",
-    "BGM_Duat_Mid_B",
-    "BGM_Duat_Mid_C",
-    "BGM_Duat_Mid_D",
-    "BGM_Duat_Mid_E",
-    "BGM_Eggplant",
-    "BGM_Frog_Belly",
-    "BGM_ghost",
-    "BGM_Hundun_Battle_A",
-    "BGM_Hundun_Battle_B",
-    "BGM_Hundun_Battle_Trans",
-    "BGM_Hundun_Climb_A",
-    "BGM_Hundun_Climb_B",
-    "BGM_Hundun_Climb_C",
-    "BGM_Hundun_Climb_D",
-    "BGM_Hundun_Intro",
-    "BGM_Menu_Character_A",
-    "BGM_Menu_Character_B",
-    "BGM_Menu_Character_C",
-    "BGM_Menu_Character_D",
-    "BGM_Menu_Main_A",
-    "BGM_Menu_Main_B",
-    "BGM_Menu_Main_C",
-    "BGM_Menu_Main_D",
-    "BGM_Menu_Settings_A",
-    "BGM_Menu_Settings_B",
-    "BGM_Menu_Settings_C",
-    "BGM_Menu_Settings_D",
-    "BGM_Mothership_main",
-    "BGM_Mothership_Transition",
-    "BGM_Pleasure_Palace",
-    "BGM_Speedrun",
-    "BGM_Tiamat_Air",
-    "BGM_Tiamat_Intro",
-    "BGM_Tiamat_Main",
-    "BGM_Tiamat_Water",
-    "BGM_Title_Intro",
-    "BGM_Title_Loop",
-    "BGM_Tutorial",
-    "BGM_Ushabti",
-    "BGM_Vendor_A",
-    "BGM_Vendor_B",
-    "BGM_Vendor_C",
-    "BGM_Vendor_Caveman",
-    "BGM_Vendor_D",
-    "BGM_Vendor_Egg",
-    "BGM_Vendor_Ghist",
-    "BGM_Vendor_Merchant",
-    "BGM_Vendor_Storage",
-    "BGM_Vendor_Tusk",
-    "BGM_Vendor_Yang",
-    "BGM_Vlads_Castle_Idle",
-    "BGM_Vlads_Castle_Main",
-    "BGM_Yeti_Caves_Main",
-    "BGM_Yeti_Caves_Transition",
-    "Aggro_sfx",
-    "alien_jump01",
-    "alien_jump02",
-    "alien_jump03",
-    "alien_jump04",
-    "alien_queen_shot_01",
-    "alien_queen_shot_02",
-    "alien_queen_shot_03",
-    "alien_queen_shot_a01",
-    "alien_queen_shot_a02",
-    "alien_queen_shot_a03",
-    "alien_queen_shot_b",
-    "alien_queen_wiggle",
-    "ammit_a01",
-    "ammit_a02",
-    "ammit_a03",
-    "ammit_a04",
-    "ammit_a05",
-    "ammit_a06",
-    "ammit_a07",
-    "ammit_a08",
-    "ammit_b01",
-    "ammit_b02",
-    "ammit_b03",
-    "ankh_beat",
-    "ankh_break",
-    "ankh_chimes",
-    "ankh_choir",
-    "ankh_crack",
-    "ankh_heat",
-    "ankh_pad",
-    "ankh_spin",
-    "ankh_zoom",
-    "anubis_die",
-    "anubis_special01",
-    "anubis_special02",
-    "anubis_special03",
-    "anubis_wake",
-    "anubis_warn",
-    "anubis_wave01",
-    "anubis_wave02",
-    "anubis_wave03",
-    "apep_body",
-    "apep_hiss",
-    "arrowtrap_01",
-    "arrowtrap_02",
-    "arrowtrap_03",
-    "arrow_stick_01",
-    "arrow_stick_02",
-    "arrow_stick_03",
-    "asteroid_01",
-    "asteroid_02",
-    "asteroid_03",
-    "asteroid_04",
-    "asteroid_05",
-    "asteroid_06",
-    "asteroid_07",
-    "asteroid_08",
-    "asteroid_09",
-    "asteroid_10",
-    "axolotl_atk_01",
-    "axolotl_atk_02",
-    "axolotl_atk_03",
-    "axolotl_bubble_grow_01",
-    "axolotl_bubble_grow_02",
-    "axolotl_bubble_grow_03",
-    "axolotl_jump_01",
-    "axolotl_jump_02",
-    "axolotl_jump_03",
-    "axolotl_land_01",
-    "axolotl_land_02",
-    "axolotl_land_03",
-    "axolotl_legs_01",
-    "axolotl_legs_02",
-    "axolotl_legs_03",
-    "axolotl_legs_04",
-    "axolotl_legs_05",
-    "axolotl_legs_06",
-    "axolotl_legs_07",
-    "axolotl_legs_08",
-    "backpack_warn",
-    "bat_a01",
-    "bat_a02",
-    "bat_a03",
-    "bat_a04",
-    "bat_a05",
-    "bat_a06",
-    "bat_a07",
-    "bat_b01",
-    "bat_b04",
-    "bat_b05",
-    "bat_b06",
-    "bat_b07",
-    "bat_b08",
-    "bat_death01",
-    "bat_death02",
-    "bat_death03",
-    "bee_loop",
-    "big_treasure_land",
-    "big_treasure_open",
-    "bird_chirp",
-    "blink",
-    "block_heavy",
-    "block_land_hard_hi",
-    "block_land_hard_low",
-    "block_land_hard_mid",
-    "block_land_soft_hi",
-    "block_land_soft_low",
-    "block_land_soft_mid",
-    "block_land_wood_hi",
-    "block_land_wood_low",
-    "block_land_wood_mid",
-    "blood_splurt01",
-    "blood_splurt02",
-    "blood_splurt03",
-    "blood_splurt04",
-    "blood_splurt05",
-    "bodyguard_die_01",
-    "bodyguard_die_02",
-    "bodyguard_die_03",
-    "body_thud01",
-    "body_thud02",
-    "body_thud03",
-    "body_thud04",
-    "body_thud05",
-    "body_thud06",
-    "body_thud07",
-    "body_thud08",
-    "bone_a01",
-    "bone_a02",
-    "bone_a03",
-    "bone_a04",
-    "bone_a05",
-    "bone_a06",
-    "bone_drop_drop_01",
-    "bone_drop_drop_02",
-    "bone_drop_drop_03",
-    "bone_drop_rattle",
-    "boomerang_catch",
-    "boomerang_loop",
-    "boss_caveman_jump",
-    "boss_caveman_roll",
-    "boss_caveman_step01",
-    "boss_caveman_step02",
-    "boss_caveman_step03",
-    "boss_caveman_step04",
-    "boss_caveman_step05",
-    "boss_caveman_step06",
-    "boss_caveman_step_b01",
-    "boss_caveman_step_b02",
-    "boss_caveman_step_b03",
-    "boss_caveman_step_b04",
-    "boss_caveman_step_b05",
-    "boss_caveman_step_b06",
-    "boss_caveman_stomp_01",
-    "boss_caveman_stomp_02",
-    "boss_caveman_stomp_03",
-    "boulder_emerge",
-    "bow_reload",
-    "bow_shot",
-    "brick_b01",
-    "brick_b02",
-    "brick_b03",
-    "brick_b04",
-    "brick_b05",
-    "brick_b06",
-    "brick_b07",
-    "bubble_big_burst_01",
-    "bubble_bonk_01",
-    "bubble_bonk_02",
-    "bubble_bonk_03",
-    "bubble_burst01",
-    "bubble_burst02",
-    "bubble_burst03",
-    "bubble_stream01",
-    "bubble_stream02",
-    "bubble_stream03",
-    "bubble_stream04",
-    "bubble_stream05",
-    "bubble_stream06",
-    "bubble_stream07",
-    "bubble_stream08",
-    "camera01",
-    "camera02",
-    "camera03",
-    "cancel",
-    "cape_flap_01",
-    "cape_flap_02",
-    "cape_flap_03",
-    "cape_loop",
-    "cape_vlad_01",
-    "cape_vlad_02",
-    "cape_vlad_03",
-    "cape_vlad_04",
-    "catmummy_atk01",
-    "catmummy_atk02",
-    "catmummy_atk03",
-    "catmummy_jump01",
-    "catmummy_jump02",
-    "catmummy_jump03",
-    "caveman_alert01",
-    "caveman_alert02",
-    "caveman_alert03",
-    "caveman_alert04",
-    "caveman_alert05",
-    "caveman_death01",
-    "caveman_death02",
-    "caveman_death03",
-    "caveman_death04",
-    "caveman_pray",
-    "caveman_shopkeeper_die",
-    "caveman_step01",
-    "caveman_step02",
-    "caveman_step03",
-    "caveman_step04",
-    "caveman_step05",
-    "caveman_talk_1a",
-    "caveman_talk_1b",
-    "caveman_talk_1c",
-    "caveman_talk_2a",
-    "caveman_talk_2b",
-    "caveman_talk_2c",
-    "caveman_talk_3a",
-    "caveman_talk_3b",
-    "caveman_talk_3c",
-    "caveman_trip01",
-    "caveman_trip02",
-    "caveman_trip03",
-    "cave_rattle01",
-    "cave_rattle02",
-    "cave_rattle03",
-    "cave_rumble_01",
-    "cave_rumble_02",
-    "cave_rumble_03",
-    "ceiling_crumble01",
-    "ceiling_crumble02",
-    "ceiling_crumble03",
-    "ceramic_a01",
-    "ceramic_a02",
-    "ceramic_a03",
-    "ceramic_a04",
-    "ceramic_a05",
-    "ceramic_a06",
-    "ceramic_a07",
-    "ceramic_a08",
-    "ceramic_a09",
-    "ceramic_a10",
-    "chain_down_a1",
-    "chain_down_a3",
-    "chain_loop_01",
-    "chain_loop_02",
-    "chain_tighten_01",
-    "chain_tighten_02",
-    "chain_tighten_03",
-    "charsel_navi",
-    "charsel_steps",
-    "chest01",
-    "chest02",
-    "chimes01",
-    "classic_climb1",
-    "classic_climb2",
-    "classic_enter_door",
-    "classic_jump",
-    "classic_throw",
-    "classic_whip",
-    "climb_chain01",
-    "climb_chain02",
-    "climb_chain03",
-    "climb_chain04",
-    "climb_chain05",
-    "climb_chain06",
-    "climb_chain07",
-    "climb_chain08",
-    "climb_chain09",
-    "climb_chain10",
-    "climb_chain11",
-    "climb_chain12",
-    "climb_ladder01",
-    "climb_ladder02",
-    "climb_ladder03",
-    "climb_ladder04",
-    "climb_ladder05",
-    "climb_ladder06",
-    "climb_ladder07",
-    "climb_ladder08",
-    "climb_ladder09",
-    "climb_ladder10",
-    "climb_ladder11",
-    "climb_ladder12",
-    "climb_ladder13",
-    "climb_mushroom01",
-    "climb_mushroom02",
-    "climb_mushroom03",
-    "climb_mushroom04",
-    "climb_mushroom05",
-    "climb_mushroom06",
-    "climb_mushroom07",
-    "climb_mushroom08",
-    "climb_mushroom09",
-    "climb_mushroom10",
-    "climb_pole01",
-    "climb_pole02",
-    "climb_pole03",
-    "climb_pole04",
-    "climb_pole05",
-    "climb_pole06",
-    "climb_pole07",
-    "climb_pole08",
-    "climb_pole09",
-    "climb_pole10",
-    "climb_vine01",
-    "climb_vine02",
-    "climb_vine03",
-    "climb_vine04",
-    "climb_vine05",
-    "climb_vine06",
-    "climb_vine07",
-    "climb_vine08",
-    "climb_vine09",
-    "climb_vine10",
-    "climb_vine11",
-    "climb_vine12",
-    "clone_gun",
-    "cobra_spit01",
-    "cobra_spit02",
-    "cobra_spit03",
-    "cobra_spit04",
-    "cobra_spit05",
-    "cobra_spit06",
-    "cobra_spit07",
-    "coffin_break",
-    "coffin_chime_01",
-    "coffin_chime_02",
-    "coffin_chime_03",
-    "coffin_chime_04",
-    "coffin_chime_05",
-    "coffin_chime_06",
-    "coffin_rattle01",
-    "coffin_rattle02",
-    "coffin_rattle03",
-    "coin_bounce_01",
-    "coin_bounce_02",
-    "coin_bounce_03",
-    "coin_bounce_04",
-    "coin_bounce_05",
-    "collision_arrow_hard_01",
-    "collision_arrow_hard_02",
-    "collision_arrow_hard_03",
-    "collision_arrow_soft_01",
-    "collision_arrow_soft_02",
-    "collision_arrow_soft_03",
-    "collision_arrow_wood_01",
-    "collision_arrow_wood_02",
-    "collision_arrow_wood_03",
-    "collision_ball_hard_01",
-    "collision_ball_hard_02",
-    "collision_ball_hard_03",
-    "collision_ball_soft_01",
-    "collision_ball_soft_02",
-    "collision_ball_soft_03",
-    "collision_ball_wood_01",
-    "collision_ball_wood_02",
-    "collision_ball_wood_03",
-    "collision_body_hard_01",
-    "collision_body_hard_02",
-    "collision_body_hard_03",
-    "collision_body_hard_04",
-    "collision_body_hard_05",
-    "collision_body_soft_01",
-    "collision_body_soft_02",
-    "collision_body_soft_03",
-    "collision_body_soft_04",
-    "collision_body_soft_05",
-    "collision_body_wood_01",
-    "collision_body_wood_02",
-    "collision_body_wood_03",
-    "collision_body_wood_04",
-    "collision_body_wood_05",
-    "collision_bomb_hard_01",
-    "collision_bomb_hard_02",
-    "collision_bomb_hard_03",
-    "collision_bomb_soft_01",
-    "collision_bomb_soft_02",
-    "collision_bomb_soft_03",
-    "collision_bomb_wood_01",
-    "collision_bomb_wood_02",
-    "collision_bomb_wood_03",
-    "collision_crate_hard_01",
-    "collision_crate_hard_02",
-    "collision_crate_hard_03",
-    "collision_crate_soft_01",
-    "collision_crate_soft_02",
-    "collision_crate_soft_03",
-    "collision_crate_wood_01",
-    "collision_crate_wood_02",
-    "collision_crate_wood_03",
-    "collision_default_hard_01",
-    "collision_default_hard_02",
-    "collision_default_hard_03",
-    "collision_default_hard_04",
-    "collision_default_hard_05",
-    "collision_default_soft_01",
-    "collision_default_soft_02",
-    "collision_default_soft_03",
-    "collision_default_soft_04",
-    "collision_default_soft_05",
-    "collision_default_wood_01",
-    "collision_default_wood_02",
-    "collision_default_wood_03",
-    "collision_default_wood_04",
-    "collision_default_wood_05",
-    "collision_dice_01",
-    "collision_dice_02",
-    "collision_dice_03",
-    "collision_dice_04",
-    "collision_dice_05",
-    "collision_rock_hard_01",
-    "collision_rock_hard_02",
-    "collision_rock_hard_03",
-    "collision_rock_soft_01",
-    "collision_rock_soft_02",
-    "collision_rock_soft_03",
-    "collision_rock_wood_01",
-    "collision_rock_wood_02",
-    "collision_rock_wood_03",
-    "collision_torch_hard_01",
-    "collision_torch_hard_02",
-    "collision_torch_hard_03",
-    "collision_torch_soft_01",
-    "collision_torch_soft_02",
-    "collision_torch_soft_03",
-    "collision_torch_wood_01",
-    "collision_torch_wood_02",
-    "collision_torch_wood_03",
-    "constellation_amb",
-    "constellation_explosion",
-    "constellation_spin",
-    "conveyor_belt",
-    "coral01",
-    "coral02",
-    "coral03",
-    "coral04",
-    "coral05",
-    "coral06",
-    "coral07",
-    "coral08",
-    "cosmic_orb_break_01",
-    "cosmic_orb_break_02",
-    "cosmic_orb_break_03",
-    "cosmic_orb_drone",
-    "cosmic_orb_warn_hi",
-    "cosmic_orb_warn_mid",
-    "crate_break_01",
-    "crate_break_02",
-    "crate_break_03",
-    "crocman_bite",
-    "crocman_trigger01",
-    "crocman_trigger02",
-    "crocman_trigger03",
-    "crossbow_reload",
-    "crossbow_shot",
-    "crushtrap_depth_01",
-    "crushtrap_depth_02",
-    "crushtrap_depth_03",
-    "crushtrap_sand01",
-    "crushtrap_stone01",
-    "crushtrap_stone02",
-    "crushtrap_stone03",
-    "crushtrap_stone04",
-    "crushtrap_stone05",
-    "crushtrap_stone06",
-    "curse_fx01",
-    "curse_fx02",
-    "curse_fx03",
-    "curse_fx04",
-    "curse_fx05",
-    "curse_fx06",
-    "curse_fx07",
-    "curse_fx08",
-    "curse_fx09",
-    "curse_fx10",
-    "curse_get",
-    "damage_invinc_A01",
-    "damage_invinc_A02",
-    "damage_invinc_A03",
-    "damage_invinc_A04",
-    "damage_invinc_A05",
-    "damsel_cat01",
-    "damsel_cat02",
-    "damsel_cat03",
-    "damsel_hamster01",
-    "damsel_hamster02",
-    "damsel_hamster03",
-    "damsel_kiss",
-    "damsel_pug01",
-    "damsel_pug02",
-    "damsel_pug03",
-    "dark_start",
-    "deposit",
-    "destructible_bone_01",
-    "destructible_bone_02",
-    "destructible_bone_03",
-    "destructible_bone_04",
-    "destructible_bone_05",
-    "destructible_ceramic01",
-    "destructible_ceramic02",
-    "destructible_ceramic03",
-    "destructible_ceramic04",
-    "destructible_ceramic05",
-    "destructible_ceramic06",
-    "diamond",
-    "dig",
-    "dig2",
-    "dirt_01",
-    "dirt_02",
-    "dirt_03",
-    "dm_banner",
-    "dm_countdown_A",
-    "dm_countdown_B",
-    "dm_countdown_C",
-    "dm_item_spawn",
-    "dm_item_warn",
-    "dm_loser_crush",
-    "dm_pillar_move",
-    "dm_score",
-    "dm_splash",
-    "dm_timer",
-    "door_walk",
-    "drill",
-    "drone",
-    "duat_wall",
-    "earthquake",
-    "eggplant_break_01",
-    "eggplant_break_02",
-    "eggplant_break_03",
-    "eggplant_break_04",
-    "eggplant_break_05",
-    "eggplant_break_06",
-    "eggplant_break_07",
-    "eggplant_break_08",
-    "eggplant_break_09",
-    "eggplant_break_10",
-    "eggplant_dog01",
-    "eggplant_dog02",
-    "eggplant_dog03",
-    "eggplant_dog04",
-    "eggsac_burst_01",
-    "eggsac_burst_02",
-    "eggsac_burst_03",
-    "eggsac_burst_04",
-    "eggsac_burst_05",
-    "eggsac_warn_01",
-    "eggsac_warn_02",
-    "eggsac_warn_03",
-    "eggship_air01",
-    "eggship_air02",
-    "eggship_amb02",
-    "eggship_door01",
-    "eggship_exterior",
-    "eggship_interior",
-    "eggship_terminal",
-    "eggship_thruster_hi",
-    "eggship_thruster_ignite",
-    "eggship_thruster_low",
-    "eggship_wind",
-    "elevator_down",
-    "elevator_up",
-    "enemy_splat01",
-    "enemy_splat02",
-    "enemy_splat03",
-    "enemy_splat04",
-    "enemy_splat05",
-    "enemy_splat06",
-    "equip",
-    "excalibur_01",
-    "excalibur_02",
-    "excalibur_03",
-    "explosion_a01_limit",
-    "explosion_a02_limit",
-    "explosion_a03_limit",
-    "explosion_a04_limit",
-    "explosion_b",
-    "explosion_c",
-    "explosion_d01",
-    "explosion_d02",
-    "explosion_e01",
-    "explosion_e02",
-    "explosion_splash01",
-    "fireball_01",
-    "fireball_02",
-    "fireball_03",
-    "firebug_fly",
-    "firebug_loop_a1",
-    "firebug_loop_a2",
-    "firebug_loop_a3",
-    "firebug_loop_b1",
-    "firebug_loop_b2",
-    "firebug_loop_b3",
-    "firebug_open_01",
-    "firebug_open_02",
-    "firebug_open_03",
-    "firebug_open_04",
-    "firebug_open_05",
-    "firefly_a01",
-    "firefly_a02",
-    "firefly_a03",
-    "firefly_a04",
-    "firefly_a05",
-    "firefly_a06",
-    "firefly_a07",
-    "firefly_a08",
-    "firefly_a09",
-    "firefly_b01",
-    "firefly_b02",
-    "firefly_b03",
-    "firefly_b04",
-    "firefly_b05",
-    "firefly_b06",
-    "firefly_b07",
-    "firefly_b08",
-    "firefly_b09",
-    "firefly_c01",
-    "firefly_c02",
-    "firefly_c03",
-    "firefly_c04",
-    "firefly_c05",
-    "firefly_c06",
-    "firefly_c07",
-    "firefly_c08",
-    "firefly_c09",
-    "firefly_d01",
-    "firefly_d02",
-    "firefly_d03",
-    "firefly_d04",
-    "firefly_d05",
-    "firefly_d06",
-    "firefly_d07",
-    "firefly_d08",
-    "firefly_d09",
-    "firetoss",
-    "flyingfish_bonk_01",
-    "flyingfish_bonk_02",
-    "flyingfish_bonk_03",
-    "flyingfish_flap01",
-    "flyingfish_flap02",
-    "flyingfish_flap03",
-    "flyingfish_flap04",
-    "flyingfish_flap05",
-    "flyingfish_flap06",
-    "flyingfish_wiggle01",
-    "flyingfish_wiggle02",
-    "flyingfish_wiggle03",
-    "freeze_gun",
-    "freeze_gun_hit",
-    "frog_charge",
-    "frog_eat",
-    "frog_giant_01",
-    "frog_giant_02",
-    "frog_giant_03",
-    "frog_jump_01",
-    "frog_jump_02",
-    "frog_jump_03",
-    "frog_jump_04",
-    "frog_jump_05",
-    "frog_jump_06",
-    "frog_jump_07",
-    "frog_jump_08",
-    "frog_jump_09",
-    "frog_jump_10",
-    "fuse_a",
-    "fuse_b1",
-    "fuse_b2",
-    "fuse_b3",
-    "fuse_b4",
-    "fuse_b5",
-    "gem_01b",
-    "gem_02b",
-    "gem_03b",
-    "gem_04b",
-    "generator_generate_01",
-    "generator_generate_02",
-    "generator_generate_03",
-    "generator_generate_04",
-    "generator_generate_05",
-    "ghist_a01",
-    "ghist_a02",
-    "ghist_a03",
-    "ghist_a04",
-    "ghist_a05",
-    "ghist_b01",
-    "ghist_b02",
-    "ghist_b03",
-    "ghist_b04",
-    "ghist_b05",
-    "ghist_c01",
-    "ghist_c02",
-    "ghist_c03",
-    "ghist_c04",
-    "ghist_c05",
-    "ghist_d01",
-    "ghist_d02",
-    "ghist_d03",
-    "ghist_d04",
-    "ghist_d05",
-    "ghist_e01",
-    "ghist_e02",
-    "ghist_e03",
-    "ghist_e04",
-    "ghist_e05",
-    "ghist_f01",
-    "ghist_f02",
-    "ghist_f03",
-    "ghist_f04",
-    "ghist_f05",
-    "ghost_death",
-    "ghost_loopA1",
-    "ghost_loopA2",
-    "ghost_loopB1",
-    "ghost_loopC1",
-    "ghost_loopD1",
-    "ghost_loopF1",
-    "ghost_loopG1",
-    "ghost_split",
-    "giantclam_close",
-    "giantclam_open",
-    "giant_fly_buzz",
-    "giant_fly_eat",
-    "giant_fly_vox_01",
-    "giant_fly_vox_02",
-    "giant_fly_vox_03",
-    "giant_fly_vox_04",
-    "giant_fly_vox_05",
-    "giant_fly_vox_06",
-    "giant_fly_vox_07",
-    "giant_fly_vox_08",
-    "giant_spider_walk01",
-    "giant_spider_walk02",
-    "giant_spider_walk03",
-    "giant_spider_walk04",
-    "giant_spider_walk05",
-    "giant_spider_walk06",
-    "giant_spider_walk07",
-    "giant_spider_walk08",
-    "godvoice01",
-    "godvoice02",
-    "godvoice03",
-    "godvoice04",
-    "gold01",
-    "gold02",
-    "gold_monkey_jump_01",
-    "gold_monkey_jump_02",
-    "gold_monkey_jump_03",
-    "gold_monkey_poop_01",
-    "gold_monkey_poop_02",
-    "gold_monkey_poop_03",
-    "gold_monkey_poop_04",
-    "gold_monkey_poop_05",
-    "gong01",
-    "grab02",
-    "grab_ladder01",
-    "grab_ladder02",
-    "grab_ledge_grime_01",
-    "grab_ledge_grime_02",
-    "grab_ledge_grime_03",
-    "grab_ledge_grime_04",
-    "grab_ledge_grime_05",
-    "grab_ledge_solid_01",
-    "grab_ledge_solid_02",
-    "grab_ledge_solid_03",
-    "grab_ledge_solid_04",
-    "grab_ledge_solid_05",
-    "grab_ledge_wood_01",
-    "grab_ledge_wood_02",
-    "grab_ledge_wood_03",
-    "grab_ledge_wood_04",
-    "grab_ledge_wood_05",
-    "gravel_01",
-    "gravel_02",
-    "gravel_03",
-    "gravel_04",
-    "grub_jump_01",
-    "grub_jump_02",
-    "grub_jump_03",
-    "grub_move_01",
-    "grub_move_02",
-    "grub_move_03",
-    "grub_move_04",
-    "grub_move_05",
-    "grub_move_06",
-    "hangspider_atk01",
-    "hangspider_atk02",
-    "hangspider_atk03",
-    "hangspider_atk04",
-    "health_get",
-    "hermitcrab_atk_a01",
-    "hermitcrab_atk_a02",
-    "hermitcrab_atk_a03",
-    "hermitcrab_atk_b01",
-    "hermitcrab_atk_b02",
-    "hermitcrab_atk_b03",
-    "hermitcrab_die01",
-    "hermitcrab_die02",
-    "hermitcrab_die03",
-    "hh_anger01",
-    "hh_anger02",
-    "hh_anger03",
-    "hh_obey01",
-    "hh_obey02",
-    "hh_obey03",
-    "hoverpack",
-    "humpback_die",
-    "humphead_swim",
-    "hundun_atk_01",
-    "hundun_atk_02",
-    "hundun_atk_03",
-    "hundun_call_bird_01",
-    "hundun_call_bird_02",
-    "hundun_call_bird_03",
-    "hundun_call_snake_01",
-    "hundun_call_snake_02",
-    "hundun_call_snake_03",
-    "hundun_head_emerge",
-    "hundun_hurt_bird_01",
-    "hundun_hurt_bird_02",
-    "hundun_hurt_bird_03",
-    "hundun_hurt_snake_01",
-    "hundun_hurt_snake_02",
-    "hundun_hurt_snake_03",
-    "hundun_wings_01",
-    "hundun_wings_02",
-    "hundun_wings_03",
-    "hundun_wings_04",
-    "hundun_wings_05",
-    "hundun_wings_06",
-    "hundun_wings_emerge",
-    "hunter_die",
-    "ice_break",
-    "ice_slide",
-    "Ignite01",
-    "ignite02",
-    "ignite03",
-    "ignite04",
-    "impale_01",
-    "impale_02",
-    "impale_03",
-    "imp_die_01",
-    "imp_die_02",
-    "imp_die_03",
-    "imp_drop",
-    "imp_flap_01",
-    "imp_flap_02",
-    "imp_flap_03",
-    "imp_flap_04",
-    "imp_flap_05",
-    "imp_flap_06",
-    "imp_flap_07",
-    "imp_flap_08",
-    "inked",
-    "intro_foreground_dirt",
-    "item_crush",
-    "Item_get_sting",
-    "jellyfish_drone",
-    "jellyfish_swim_01",
-    "jellyfish_swim_02",
-    "jellyfish_swim_03",
-    "jellyfish_swim_04",
-    "jellyfish_swim_05",
-    "jellyfish_swim_06",
-    "jellyfish_swim_07",
-    "jellyfish_swim_08",
-    "jetpack01",
-    "jiangshi_a_charge_01",
-    "jiangshi_a_charge_02",
-    "jiangshi_a_charge_03",
-    "jiangshi_a_charge_04",
-    "jiangshi_a_charge_05",
-    "jiangshi_a_charge_06",
-    "jiangshi_a_charge_07",
-    "jiangshi_a_charge_08",
-    "jiangshi_a_jump_01",
-    "jiangshi_a_jump_02",
-    "jiangshi_a_jump_03",
-    "jiangshi_a_jump_04",
-    "jiangshi_a_jump_05",
-    "jiangshi_a_jump_06",
-    "jiangshi_a_jump_07",
-    "jiangshi_a_jump_08",
-    "jiangshi_b_jump_01",
-    "jiangshi_b_jump_02",
-    "jiangshi_b_jump_03",
-    "jiangshi_b_jump_04",
-    "jiangshi_b_jump_05",
-    "jiangshi_b_jump_06",
-    "jiangshi_flip_01",
-    "jiangshi_flip_02",
-    "jiangshi_flip_03",
-    "journal_close",
-    "journal_entry",
-    "journal_key",
-    "journal_open",
-    "journal_page",
-    "kali_anger",
-    "kappala_heal",
-    "key_turn_intro",
-    "kick01",
-    "kingu_grip_01",
-    "kingu_grip_02",
-    "kingu_grip_03",
-    "kingu_grip_04",
-    "kingu_hurt_01",
-    "kingu_hurt_02",
-    "kingu_hurt_03",
-    "kingu_hurt_04",
-    "kingu_slide",
-    "lamassu_aim_tone",
-    "lamassu_die_01",
-    "lamassu_die_02",
-    "lamassu_die_03",
-    "lamassu_fly01",
-    "lamassu_fly02",
-    "lamassu_fly03",
-    "lamassu_fly04",
-    "lamassu_fly05",
-    "lamassu_scan_01",
-    "lamassu_scan_02",
-    "lamassu_shot_01",
-    "lamassu_walk01",
-    "lamassu_walk02",
-    "lamassu_walk03",
-    "lamassu_walk04",
-    "lamassu_walk05",
-    "lamassu_walk06",
-    "lamassu_walk07",
-    "Land_belt_hard_01",
-    "Land_belt_hard_02",
-    "Land_belt_hard_03",
-    "Land_belt_hard_04",
-    "Land_belt_hard_05",
-    "Land_belt_hard_06",
-    "Land_belt_hard_07",
-    "Land_belt_hard_08",
-    "Land_belt_hard_09",
-    "Land_belt_hard_10",
-    "Land_belt_soft_01",
-    "Land_belt_soft_02",
-    "Land_belt_soft_03",
-    "Land_belt_soft_04",
-    "Land_belt_soft_05",
-    "Land_belt_soft_06",
-    "Land_belt_soft_07",
-    "Land_belt_soft_08",
-    "Land_belt_soft_09",
-    "Land_belt_soft_10",
-    "land_bubble_01",
-    "land_bubble_02",
-    "land_bubble_03",
-    "land_bubble_04",
-    "land_bubble_05",
-    "land_bubble_06",
-    "land_bubble_07",
-    "land_bubble_08",
-    "land_bubble_09",
-    "land_bubble_10",
-    "Land_crust_hard_01",
-    "Land_crust_hard_02",
-    "Land_crust_hard_03",
-    "Land_crust_hard_04",
-    "Land_crust_hard_05",
-    "Land_crust_hard_06",
-    "Land_crust_hard_07",
-    "Land_crust_hard_08",
-    "Land_crust_hard_09",
-    "Land_crust_hard_10",
-    "Land_crust_soft_01",
-    "Land_crust_soft_02",
-    "Land_crust_soft_03",
-    "Land_crust_soft_04",
-    "Land_crust_soft_05",
-    "Land_crust_soft_06",
-    "Land_crust_soft_07",
-    "Land_crust_soft_08",
-    "Land_crust_soft_09",
-    "Land_crust_soft_10",
-    "Land_dirt_hard_01",
-    "Land_dirt_hard_02",
-    "Land_dirt_hard_03",
-    "Land_dirt_hard_04",
-    "Land_dirt_hard_05",
-    "Land_dirt_hard_06",
-    "Land_dirt_hard_07",
-    "Land_dirt_hard_08",
-    "Land_dirt_hard_09",
-    "Land_dirt_hard_10",
-    "Land_dirt_soft_01",
-    "Land_dirt_soft_02",
-    "Land_dirt_soft_03",
-    "Land_dirt_soft_04",
-    "Land_dirt_soft_05",
-    "Land_dirt_soft_06",
-    "Land_dirt_soft_07",
-    "Land_dirt_soft_08",
-    "Land_dirt_soft_09",
-    "Land_dirt_soft_10",
-    "Land_foliage_hard_01",
-    "Land_foliage_hard_02",
-    "Land_foliage_hard_03",
-    "Land_foliage_hard_04",
-    "Land_foliage_hard_05",
-    "Land_foliage_hard_06",
-    "Land_foliage_hard_07",
-    "Land_foliage_hard_08",
-    "Land_foliage_hard_09",
-    "Land_foliage_hard_10",
-    "Land_foliage_soft_01",
-    "Land_foliage_soft_02",
-    "Land_foliage_soft_03",
-    "Land_foliage_soft_04",
-    "Land_foliage_soft_05",
-    "Land_foliage_soft_06",
-    "Land_foliage_soft_07",
-    "Land_foliage_soft_08",
-    "Land_foliage_soft_09",
-    "Land_foliage_soft_10",
-    "land_ice_hard_01",
-    "land_ice_hard_02",
-    "land_ice_hard_03",
-    "land_ice_hard_04",
-    "land_ice_hard_05",
-    "land_ice_hard_06",
-    "land_ice_hard_07",
-    "land_ice_hard_08",
-    "land_ice_hard_09",
-    "land_ice_hard_10",
-    "Land_ice_soft_01",
-    "Land_ice_soft_02",
-    "Land_ice_soft_03",
-    "Land_ice_soft_04",
-    "Land_ice_soft_05",
-    "Land_ice_soft_06",
-    "Land_ice_soft_07",
-    "Land_ice_soft_08",
-    "Land_ice_soft_09",
-    "Land_ice_soft_10",
-    "Land_metal_hard_01",
-    "Land_metal_hard_02",
-    "Land_metal_hard_03",
-    "Land_metal_hard_04",
-    "Land_metal_hard_05",
-    "Land_metal_hard_06",
-    "Land_metal_hard_07",
-    "Land_metal_hard_08",
-    "Land_metal_hard_09",
-    "Land_metal_hard_10",
-    "Land_metal_soft_01",
-    "Land_metal_soft_02",
-    "Land_metal_soft_03",
-    "Land_metal_soft_04",
-    "Land_metal_soft_05",
-    "Land_metal_soft_06",
-    "Land_metal_soft_07",
-    "Land_metal_soft_08",
-    "Land_metal_soft_09",
-    "Land_metal_soft_10",
-    "Land_organic_hard_01",
-    "Land_organic_hard_02",
-    "Land_organic_hard_03",
-    "Land_organic_hard_04",
-    "Land_organic_hard_05",
-    "Land_organic_hard_06",
-    "Land_organic_hard_07",
-    "Land_organic_hard_08",
-    "Land_organic_hard_09",
-    "Land_organic_hard_10",
-    "Land_organic_soft_01",
-    "Land_organic_soft_02",
-    "Land_organic_soft_03",
-    "Land_organic_soft_04",
-    "Land_organic_soft_05",
-    "Land_organic_soft_06",
-    "Land_organic_soft_07",
-    "Land_organic_soft_08",
-    "Land_organic_soft_09",
-    "Land_organic_soft_10",
-    "Land_plank_hard_01",
-    "Land_plank_hard_02",
-    "Land_plank_hard_03",
-    "Land_plank_hard_04",
-    "Land_plank_hard_05",
-    "Land_plank_hard_06",
-    "Land_plank_hard_07",
-    "Land_plank_hard_08",
-    "Land_plank_hard_09",
-    "Land_plank_hard_10",
-    "Land_plank_soft_01",
-    "Land_plank_soft_02",
-    "Land_plank_soft_03",
-    "Land_plank_soft_04",
-    "Land_plank_soft_05",
-    "Land_plank_soft_06",
-    "Land_plank_soft_07",
-    "Land_plank_soft_08",
-    "Land_plank_soft_09",
-    "Land_plank_soft_10",
-    "Land_sand_hard_01",
-    "Land_sand_hard_02",
-    "Land_sand_hard_03",
-    "Land_sand_hard_04",
-    "Land_sand_hard_05",
-    "Land_sand_hard_06",
-    "Land_sand_hard_07",
-    "Land_sand_hard_08",
-    "Land_sand_hard_09",
-    "Land_sand_hard_10",
-    "Land_sand_soft_01",
-    "Land_sand_soft_02",
-    "Land_sand_soft_03",
-    "Land_sand_soft_04",
-    "Land_sand_soft_05",
-    "Land_sand_soft_06",
-    "Land_sand_soft_07",
-    "Land_sand_soft_08",
-    "Land_sand_soft_09",
-    "Land_sand_soft_10",
-    "land_solid_01",
-    "land_solid_02",
-    "land_solid_03",
-    "land_solid_04",
-    "land_solid_05",
-    "land_solid_06",
-    "land_solid_07",
-    "land_solid_08",
-    "land_solid_09",
-    "land_solid_10",
-    "Land_stone_hard_01",
-    "Land_stone_hard_02",
-    "Land_stone_hard_03",
-    "Land_stone_hard_04",
-    "Land_stone_hard_05",
-    "Land_stone_hard_06",
-    "Land_stone_hard_07",
-    "Land_stone_hard_08",
-    "Land_stone_hard_09",
-    "Land_stone_hard_10",
-    "Land_stone_soft_01",
-    "Land_stone_soft_02",
-    "Land_stone_soft_03",
-    "Land_stone_soft_04",
-    "Land_stone_soft_05",
-    "Land_stone_soft_06",
-    "Land_stone_soft_07",
-    "Land_stone_soft_08",
-    "Land_stone_soft_09",
-    "Land_stone_soft_10",
-    "Land_wood_hard_01",
-    "Land_wood_hard_02",
-    "Land_wood_hard_03",
-    "Land_wood_hard_04",
-    "Land_wood_hard_05",
-    "Land_wood_hard_06",
-    "Land_wood_hard_07",
-    "Land_wood_hard_08",
-    "Land_wood_hard_09",
-    "Land_wood_hard_10",
-    "Land_wood_soft_01",
-    "Land_wood_soft_02",
-    "Land_wood_soft_03",
-    "Land_wood_soft_04",
-    "Land_wood_soft_05",
-    "Land_wood_soft_06",
-    "Land_wood_soft_07",
-    "Land_wood_soft_08",
-    "Land_wood_soft_09",
-    "Land_wood_soft_10",
-    "lantern_break",
-    "laserbeam_charge01",
-    "laserbeam_charge02",
-    "laserbeam_charge03",
-    "laserbeam_charge04",
-    "laserbeam_collision_spark01",
-    "laserbeam_collision_spark02",
-    "laserbeam_collision_spark03",
-    "laserbeam_end",
-    "laserbeam_hum",
-    "laserbeam_hum_dist",
-    "lasertrap_charge_full",
-    "lasertrap_charge_part",
-    "lasertrap_shot01",
-    "lasertrap_shot02",
-    "lasertrap_shot03",
-    "lasertrap_shot04",
-    "laser_shot",
-    "lavamander_atk_01",
-    "lavamander_atk_02",
-    "lavamander_atk_03",
-    "lavamander_charge_01",
-    "lavamander_charge_02",
-    "lavamander_charge_03",
-    "lavamander_jump_01",
-    "lavamander_jump_02",
-    "lavamander_jump_03",
-    "lavamander_transform_a",
-    "lavamander_transform_b",
-    "lava_flame01",
-    "lava_flame02",
-    "lava_flame03",
-    "lava_flame04",
-    "lava_flame05",
-    "lava_flame06",
-    "lava_idle_close",
-    "lava_idle_low",
-    "lava_idle_mid",
-    "lava_splat01",
-    "lava_splat02",
-    "lava_splat03",
-    "lava_splat04",
-    "lava_splat05",
-    "lava_splat06",
-    "lava_splat07",
-    "lava_splat08",
-    "lava_splat09",
-    "lava_splat10",
-    "lava_splat11",
-    "lava_splat12",
-    "lava_splat13",
-    "lava_splat14",
-    "lava_splat15",
-    "lava_splat16",
-    "lava_splat17",
-    "lava_splat18",
-    "lava_splat19",
-    "lava_splat20",
-    "lava_splat21",
-    "lava_splat22",
-    "lava_splat23",
-    "lava_splat24",
-    "lava_splat25",
-    "layer_zoom_in",
-    "layer_zoom_out",
-    "leaves01",
-    "leaves02",
-    "leaves03",
-    "leaves04",
-    "leprechaun_01",
-    "leprechaun_02",
-    "leprechaun_03",
-    "leprechaun_04",
-    "leprechaun_05",
-    "leprechaun_06",
-    "leprechaun_07",
-    "leprechaun_08",
-    "leprechaun_09",
-    "leprechaun_10",
-    "leprechaun_die",
-    "liontrap_arm01",
-    "liontrap_arm02",
-    "liontrap_arm03",
-    "liontrap_atk01",
-    "liontrap_atk02",
-    "liontrap_atk03",
-    "LISE_drive",
-    "LISE_loading",
-    "LISE_push",
-    "LISE_radar",
-    "LISE_warn",
-    "lizard_bonk_01",
-    "lizard_bonk_02",
-    "lizard_bonk_03",
-    "lizard_curl01",
-    "lizard_die_01",
-    "lizard_die_02",
-    "lizard_die_03",
-    "lizard_jump01",
-    "lizard_jump_01",
-    "lizard_jump_02",
-    "lizard_jump_03",
-    "lizard_roll_01",
-    "lizard_roll_dirt",
-    "lizard_spin_01",
-    "lizard_spin_02",
-    "lizard_spin_03",
-    "lizard_unroll",
-    "locust_jump",
-    "locust_loop",
-    "machete",
-    "magic_chime",
-    "magmaman_form01",
-    "magmaman_form02",
-    "magmaman_jump01",
-    "magmaman_loop",
-    "mantrap_bite_01",
-    "mantrap_bite_02",
-    "mantrap_bite_03",
-    "mattock_break",
-    "mattock_hit_01",
-    "mattock_hit_02",
-    "mattock_hit_03",
-    "mech_drive",
-    "mech_drive_elec",
-    "mech_jump01",
-    "mech_jump02",
-    "mech_jump03",
-    "mech_land_01",
-    "mech_land_02",
-    "mech_land_03",
-    "mech_punch_a01",
-    "mech_smash01",
-    "mech_smash02",
-    "mech_smash03",
-    "mech_spark_01",
-    "mech_spark_02",
-    "mech_spark_03",
-    "mech_spark_04",
-    "mech_spark_05",
-    "mech_spark_06",
-    "mech_spark_07",
-    "mech_spark_08",
-    "mech_spark_09",
-    "mech_spark_10",
-    "mech_transform_01",
-    "mech_transform_02",
-    "mech_turn",
-    "mech_walk_a01",
-    "mech_walk_a02",
-    "mech_walk_a03",
-    "mech_walk_a04",
-    "mech_walk_a05",
-    "mech_walk_b01",
-    "mech_walk_b02",
-    "mech_walk_b03",
-    "mech_walk_b04",
-    "mech_warn",
-    "menu_intro_01",
-    "menu_intro_02",
-    "menu_intro_03",
-    "menu_intro_amb",
-    "menu_set",
-    "menu_swipe_01",
-    "menu_swipe_02",
-    "menu_swipe_03",
-    "mine_activate01",
-    "mine_activate02",
-    "mine_activate03",
-    "mine_beep",
-    "mine_deactivate01",
-    "mine_deactivate02",
-    "mine_deactivate03",
-    "minister_grow",
-    "minister_shrink",
-    "minister_talk_01",
-    "minister_talk_02",
-    "minister_talk_03",
-    "minister_talk_04",
-    "minister_talk_05",
-    "minister_talk_06",
-    "minister_talk_07",
-    "minister_talk_08",
-    "mm_navi_a01",
-    "mm_navi_a02",
-    "mm_navi_a03",
-    "mm_navi_b",
-    "mm_reset",
-    "mm_selection",
-    "mm_slider_down",
-    "mm_slider_up",
-    "mm_submenu",
-    "mm_toggle",
-    "molerat_die_01",
-    "molerat_die_02",
-    "molerat_die_03",
-    "molerat_run_a01",
-    "molerat_run_a02",
-    "molerat_run_a03",
-    "molerat_run_a04",
-    "molerat_run_a05",
-    "molerat_run_a06",
-    "molerat_run_a07",
-    "molerat_run_a08",
-    "monkey_01",
-    "monkey_02",
-    "monkey_03",
-    "monkey_04",
-    "monkey_05",
-    "monkey_06",
-    "monkey_07",
-    "monkey_08",
-    "monkey_09",
-    "monkey_10",
-    "monkey_shake01",
-    "monkey_shake02",
-    "monkey_yell",
-    "mosq_loop",
-    "moss_a01",
-    "moss_a02",
-    "moss_a03",
-    "moss_a04",
-    "mount",
-    "mount_double_jump_01",
-    "mount_double_jump_02",
-    "mount_double_jump_03",
-    "mount_rustle",
-    "mount_tame01",
-    "mummy_fly_group",
-    "mummy_fly_single",
-    "mummy_vomit01",
-    "mummy_vomit02",
-    "mummy_vomit03",
-    "mummy_vomit04",
-    "mummy_walk01",
-    "mummy_walk02",
-    "mummy_walk03",
-    "mummy_walk04",
-    "ncp_bodyguard_neg",
-    "ncp_bodyguard_neu",
-    "ncp_bodyguard_pos",
-    "ncp_parmesan_neg",
-    "ncp_parmesan_neu",
-    "ncp_parmesan_pos",
-    "ncp_yama",
-    "necromancer_charge",
-    "necromancer_die_01",
-    "necromancer_die_02",
-    "necromancer_die_03",
-    "necromancer_raise_01",
-    "necromancer_raise_02",
-    "necromancer_raise_03",
-    "necromancer_spawn_01",
-    "necromancer_spawn_02",
-    "necromancer_spawn_03",
-    "necromancer_spawn_04",
-    "neon_sign",
-    "no_items",
-    "npc_beg_neg",
-    "npc_beg_neu",
-    "npc_beg_pos",
-    "npc_caveman_shopkeeper_neg",
-    "npc_caveman_shopkeeper_neu",
-    "npc_caveman_shopkeeper_pos",
-    "npc_hunter_neg",
-    "npc_hunter_neu",
-    "npc_hunter_pos",
-    "npc_merchant_neg",
-    "npc_merchant_neu_01",
-    "npc_merchant_neu_02",
-    "npc_merchant_pos",
-    "npc_parsley_neg",
-    "npc_parsley_neu",
-    "npc_parsley_pos",
-    "npc_parsnip_neg",
-    "npc_parsnip_neu",
-    "npc_parsnip_pos",
-    "npc_shopkeeper_ang",
-    "npc_shopkeeper_neg_01",
-    "npc_shopkeeper_neg_02",
-    "npc_shopkeeper_neg_03",
-    "npc_shopkeeper_neu_01",
-    "npc_shopkeeper_neu_02",
-    "npc_shopkeeper_neu_03",
-    "npc_shopkeeper_pos_01",
-    "npc_shopkeeper_pos_02",
-    "npc_shopkeeper_pos_03",
-    "npc_storage_neg",
-    "npc_storage_pos",
-    "npc_tiamat",
-    "npc_tusk_neg_01",
-    "npc_tusk_neg_02",
-    "npc_tusk_neg_03",
-    "npc_tusk_neu_01",
-    "npc_tusk_neu_02",
-    "npc_tusk_neu_03",
-    "npc_tusk_pos_01",
-    "npc_tusk_pos_02",
-    "npc_tusk_pos_03",
-    "npc_yang_neg",
-    "npc_yang_neu",
-    "npc_yang_pos",
-    "octopus_atk01",
-    "octopus_atk02",
-    "octopus_atk03",
-    "octopus_die01",
-    "octopus_die02",
-    "octopus_die03",
-    "octopus_jump01",
-    "octopus_jump02",
-    "octopus_jump03",
-    "octopus_walk01",
-    "octopus_walk02",
-    "octopus_walk03",
-    "octopus_walk04",
-    "octopus_walk05",
-    "octopus_walk06",
-    "olmec_bombs_01",
-    "olmec_bombs_02",
-    "olmec_bombs_03",
-    "olmec_crush_01",
-    "olmec_crush_02",
-    "olmec_crush_03",
-    "olmec_crush_04",
-    "olmec_crush_05",
-    "olmec_crush_06",
-    "olmec_emerge_01",
-    "olmec_emerge_02",
-    "olmec_emerge_03",
-    "olmec_morph_close",
-    "olmec_morph_open",
-    "olmec_pad_smash_01",
-    "olmec_pad_smash_02",
-    "olmec_pad_smash_03",
-    "olmec_show_pads",
-    "olmec_ufo_01",
-    "olmec_ufo_02",
-    "olmec_ufo_03",
-    "olmite_armor_break_01",
-    "olmite_armor_break_02",
-    "olmite_armor_break_03",
-    "olmite_die_01",
-    "olmite_die_02",
-    "olmite_die_03",
-    "olmite_die_04",
-    "olmite_die_05",
-    "olmite_jump_01",
-    "olmite_jump_02",
-    "olmite_jump_03",
-    "olmite_stomp_01",
-    "olmite_stomp_02",
-    "olmite_stomp_03",
-    "osiris_fade",
-    "osiris_punch_01",
-    "osiris_punch_02",
-    "osiris_punch_03",
-    "ouroboros_shake01",
-    "ouroboros_shake02",
-    "ouroboros_shake03",
-    "ouroboros_shake04",
-    "ouroboros_shake05",
-    "ouroboros_stinger",
-    "page_return",
-    "page_turn_01",
-    "page_turn_02",
-    "page_turn_03",
-    "page_turn_04",
-    "page_turn_05",
-    "pangxie_atk_a01",
-    "pangxie_atk_a02",
-    "pangxie_atk_a03",
-    "pangxie_atk_b01",
-    "pangxie_atk_b02",
-    "pangxie_atk_b03",
-    "parachute01",
-    "parachute02",
-    "parachute03",
-    "parchment",
-    "parmesan_die",
-    "parsley_die",
-    "parsnip_die",
-    "pause_noise_1",
-    "pause_noise_2",
-    "penguin_jump_a",
-    "penguin_jump_b01",
-    "penguin_jump_b02",
-    "penguin_jump_b03",
-    "Pghost_att01",
-    "Pghost_att02",
-    "Pghost_att03",
-    "Pghost_att04",
-    "Pghost_charge",
-    "pghost_dash_01",
-    "pghost_dash_02",
-    "pghost_dash_03",
-    "pghost_shake_01",
-    "pghost_shake_02",
-    "pghost_shake_03",
-    "pghost_shake_04",
-    "pghost_shake_05",
-    "pghost_spin_01",
-    "pghost_spin_02",
-    "pghost_spin_03",
-    "pick_up_arrow_metal",
-    "pick_up_arrow_wood",
-    "pick_up_body",
-    "pick_up_bomb",
-    "pick_up_bow",
-    "pick_up_camera",
-    "pick_up_chest",
-    "pick_up_crate",
-    "pick_up_critter",
-    "pick_up_crossbow",
-    "pick_up_curse_pot",
-    "pick_up_dice",
-    "pick_up_eggplant",
-    "pick_up_excalibur",
-    "pick_up_gun",
-    "pick_up_idol",
-    "pick_up_key",
-    "pick_up_lava_pot",
-    "pick_up_machete",
-    "pick_up_plasma_cannon",
-    "pick_up_pot",
-    "pick_up_present",
-    "pick_up_punishball",
-    "pick_up_rock",
-    "pick_up_scepter",
-    "pick_up_shield",
-    "pick_up_shotgun",
-    "pick_up_skull",
-    "pick_up_snaptrap",
-    "pick_up_torch",
-    "pipe_enter_01",
-    "pipe_enter_02",
-    "pipe_enter_03",
-    "pipe_exit_01",
-    "pipe_exit_02",
-    "pipe_exit_03",
-    "pipe_loop",
-    "plasma_cannon",
-    "plasma_cannon_charge",
-    "plasma_cannon_charge2",
-    "platform_break",
-    "platform_trigger1",
-    "platform_trigger2",
-    "platform_trigger3",
-    "player_jump04",
-    "poison_fx01",
-    "poison_fx02",
-    "poison_fx03",
-    "poison_fx04",
-    "poison_loop",
-    "poof01",
-    "portal",
-    "proto_burster",
-    "puff01",
-    "push_dirt",
-    "push_noise",
-    "push_rumble",
-    "qilin_hatch",
-    "qilin_jump_01",
-    "qilin_jump_02",
-    "qilin_jump_03",
-    "qilin_legs_01",
-    "qilin_legs_02",
-    "qilin_legs_03",
-    "qilin_legs_04",
-    "qilin_legs_05",
-    "qilin_legs_06",
-    "qilin_legs_07",
-    "qilin_legs_08",
-    "qilin_swim",
-    "qilin_swoop_01",
-    "qilin_swoop_02",
-    "qilin_swoop_03",
-    "quicksand_amb",
-    "quicksand_loop",
-    "quick_select_navi",
-    "quick_select_open",
-    "radio_off",
-    "radio_static_01",
-    "radio_static_02",
-    "radio_static_03",
-    "radio_static_04",
-    "radio_static_05",
-    "regen_block_01",
-    "regen_block_02",
-    "regen_block_03",
-    "regen_block_04",
-    "regen_block_05",
-    "regen_block_06",
-    "regen_block_07",
-    "regen_block_08",
-    "regen_block_09",
-    "regen_block_10",
-    "reso_noise",
-    "ricochet01",
-    "ricochet02",
-    "ricochet03",
-    "robot_bonk",
-    "robot_loop01",
-    "robot_loop02",
-    "robot_loop03",
-    "robot_loop04",
-    "rope_attach",
-    "rope_attach01",
-    "rope_attach02",
-    "rope_attach03",
-    "rope_attach04",
-    "rope_attach05",
-    "rope_attach06",
-    "rope_attach07",
-    "rope_attach08",
-    "rope_attach09",
-    "rope_burn",
-    "rope_toss_01",
-    "rope_toss_02",
-    "rope_toss_03",
-    "rope_toss_04",
-    "rubble_ice_01",
-    "rubble_ice_02",
-    "rubble_ice_03",
-    "rubble_ice_04",
-    "rubble_metal_a01",
-    "rubble_metal_a02",
-    "rubble_metal_a03",
-    "rubble_metal_a04",
-    "rubble_metal_a05",
-    "rubble_metal_a06",
-    "rubble_metal_a07",
-    "rubble_organic_01",
-    "rubble_organic_02",
-    "rubble_organic_03",
-    "rubble_organic_04",
-    "rubble_organic_05",
-    "rubble_organic_06",
-    "rubble_organic_07",
-    "rubble_organic_08",
-    "rubble_organic_09",
-    "rubble_organic_10",
-    "rubble_rock01",
-    "rubble_rock02",
-    "rubble_rock03",
-    "rubble_rock04",
-    "rubble_rock05",
-    "rubble_rock06",
-    "rumble_deep",
-    "rumble_punch_01",
-    "rumble_punch_02",
-    "rumble_punch_03",
-    "rumble_punch_04",
-    "scarab01",
-    "scarab02",
-    "scarab03",
-    "scarab_chimes",
-    "scarab_loop",
-    "scepter_loop",
-    "secret_a_stinger",
-    "secret_b_stinger",
-    "selection",
-    "shopkeeper_die_01",
-    "shopkeeper_die_02",
-    "shopkeeper_die_03",
-    "shop_buy",
-    "shop_enter",
-    "shop_focus",
-    "shop_nope",
-    "shop_pick_up",
-    "shotgun_fire01",
-    "shotgun_fire02",
-    "shotgun_fire03",
-    "shotgun_fire04",
-    "shotgun_juice",
-    "shotgun_snap01",
-    "shotgun_snap02",
-    "skeleton_collapse",
-    "skeleton_killed_01",
-    "skeleton_killed_02",
-    "skeleton_killed_03",
-    "skeleton_killed_04",
-    "skeleton_killed_05",
-    "skeleton_rise_01",
-    "skeleton_rise_02",
-    "skeleton_rise_03",
-    "skullblock_atk01",
-    "skullblock_atk02",
-    "skullblock_atk03",
-    "skullblock_atk04",
-    "skullblock_atk05",
-    "skullblock_atkB01",
-    "skullblock_atkB02",
-    "skullblock_atkB03",
-    "sleep_bubble01",
-    "sleep_bubble02",
-    "sleep_bubble03",
-    "slide_wall_stomp_01",
-    "slide_wall_stomp_02",
-    "slide_wall_stomp_03",
-    "snake_atk",
-    "snake_die01",
-    "snake_die02",
-    "snake_die03",
-    "snaptrap_close",
-    "snaptrap_open",
-    "sorceress_charge",
-    "sorceress_die01",
-    "sorceress_die02",
-    "sorceress_die03",
-    "sorceress_jump01",
-    "sorceress_jump02",
-    "sorceress_jump03",
-    "sorceress_shoot01",
-    "sorceress_shoot02",
-    "sorceress_shoot03",
-    "sorceress_shot_hit01",
-    "sorceress_shot_hit02",
-    "sorceress_shot_hit03",
-    "sparktrap",
-    "sparktrap_hit_01",
-    "sparktrap_hit_02",
-    "sparktrap_hit_03",
-    "speartrap_01",
-    "speartrap_02",
-    "speartrap_03",
-    "spider01",
-    "spider02",
-    "spider03",
-    "spider_drop",
-    "splat01",
-    "splat03",
-    "splat05",
-    "splat06",
-    "spring01",
-    "spring02",
-    "spring03",
-    "spring04",
-    "sticker_01",
-    "sticker_02",
-    "sticker_03",
-    "sticker_04",
-    "sticker_05",
-    "sticker_06",
-    "sticker_07",
-    "sticker_08",
-    "sticker_09",
-    "sticker_10",
-    "sticky_01",
-    "sticky_02",
-    "sticky_04",
-    "sticky_05",
-    "sticky_trap_blink",
-    "sticky_trap_down",
-    "sticky_trap_stop_01",
-    "sticky_trap_stop_02",
-    "sticky_trap_stop_03",
-    "sticky_trap_up",
-    "stone_transform_a",
-    "stone_transform_b",
-    "storage_keeper_die",
-    "storage_keeper_jump_01",
-    "storage_keeper_jump_02",
-    "storage_keeper_jump_03",
-    "storage_pad",
-    "stunned_wobble",
-    "stun_wake_01",
-    "stun_wake_02",
-    "stun_wake_03",
-    "switch01",
-    "switch_flick",
-    "swoosh_01b",
-    "swoosh_02",
-    "swoosh_04",
-    "telepoof",
-    "teleport_a01",
-    "teleport_a02",
-    "teleport_a03",
-    "teleport_a04",
-    "text_description",
-    "thinice_a01",
-    "thinice_a02",
-    "thinice_a03",
-    "thinice_a04",
-    "thinice_a05",
-    "thinice_a06",
-    "thinice_a07",
-    "thinice_a08",
-    "thinice_b01",
-    "thinice_b02",
-    "thinice_b03",
-    "thud_01",
-    "thud_02",
-    "tiamat_hurt_01",
-    "tiamat_hurt_02",
-    "tiamat_hurt_03",
-    "tiamat_pre_scream_01",
-    "tiamat_pre_scream_02",
-    "tiamat_pre_scream_03",
-    "tiamat_scepter_01",
-    "tiamat_scepter_02",
-    "tiamat_scepter_03",
-    "tiamat_scepter_orb",
-    "tiamat_scream_01",
-    "tiamat_scream_02",
-    "tiamat_scream_03",
-    "tiamat_scream_dirt_01",
-    "tiamat_scream_dirt_02",
-    "tiamat_scream_dirt_03",
-    "tiamat_sub",
-    "tikiman_die_01",
-    "tikiman_die_02",
-    "tikiman_die_03",
-    "tikiman_talk_1a",
-    "tikiman_talk_1b",
-    "tikiman_talk_1c",
-    "tikiman_talk_2a",
-    "tikiman_talk_2b",
-    "tikiman_talk_2c",
-    "tikiman_talk_3a",
-    "tikiman_talk_3b",
-    "tikiman_talk_3c",
-    "tikitrap_01",
-    "tikitrap_02",
-    "tikitrap_03",
-    "tikitrap_arm_01",
-    "tikitrap_arm_02",
-    "tikitrap_arm_03",
-    "tile_break_bone_01",
-    "tile_break_bone_02",
-    "tile_break_bone_03",
-    "tile_break_bone_04",
-    "tile_break_bone_05",
-    "tile_break_dirt_01",
-    "tile_break_dirt_02",
-    "tile_break_dirt_03",
-    "tile_break_dirt_04",
-    "tile_break_dirt_05",
-    "tile_break_ice_01",
-    "tile_break_ice_02",
-    "tile_break_ice_03",
-    "tile_break_ice_04",
-    "tile_break_ice_05",
-    "tile_break_metal_01",
-    "tile_break_metal_02",
-    "tile_break_metal_03",
-    "tile_break_metal_04",
-    "tile_break_metal_05",
-    "tile_break_moss_01",
-    "tile_break_moss_02",
-    "tile_break_moss_03",
-    "tile_break_moss_04",
-    "tile_break_moss_05",
-    "tile_break_organic_01",
-    "tile_break_organic_02",
-    "tile_break_organic_03",
-    "tile_break_organic_04",
-    "tile_break_organic_05",
-    "tile_break_sand_01",
-    "tile_break_sand_02",
-    "tile_break_sand_03",
-    "tile_break_sand_04",
-    "tile_break_sand_05",
-    "tile_break_stone_01",
-    "tile_break_stone_02",
-    "tile_break_stone_03",
-    "tile_break_stone_04",
-    "tile_break_stone_05",
-    "tile_break_wood_hollow_01",
-    "tile_break_wood_hollow_02",
-    "tile_break_wood_hollow_03",
-    "tile_break_wood_hollow_04",
-    "tile_break_wood_hollow_05",
-    "title_select",
-    "torch01",
-    "toss_swoosh_01",
-    "toss_swoosh_02",
-    "toss_swoosh_03",
-    "toss_swoosh_04",
-    "toss_swoosh_05",
-    "turkey_flap_a",
-    "turkey_flap_b1",
-    "turkey_flap_b2",
-    "turkey_flap_b3",
-    "turkey_flap_b4",
-    "turkey_gobble_01",
-    "turkey_gobble_02",
-    "turkey_gobble_03",
-    "turkey_gobble_04",
-    "turkey_gobble_05",
-    "turkey_gobble_06",
-    "turkey_gobble_07",
-    "turkey_legs_01",
-    "turkey_legs_02",
-    "turkey_legs_03",
-    "turkey_legs_04",
-    "turkey_legs_05",
-    "turkey_neck",
-    "tusk_die",
-    "tv01",
-    "tv02",
-    "tv03",
-    "tv04",
-    "udjat_blink",
-    "ufo_atk_a05",
-    "ufo_bonk01",
-    "ufo_bonk02",
-    "ufo_bonk03",
-    "ufo_charge",
-    "ufo_eject",
-    "ufo_loop01",
-    "ufo_shot_hit",
-    "unlock",
-    "ushabti_clay",
-    "ushabti_gold",
-    "ushabti_jade",
-    "ushabti_onyx",
-    "ushabti_rattle_01",
-    "ushabti_rattle_02",
-    "ushabti_rattle_03",
-    "ushabti_wood",
-    "vampire_die_01",
-    "vampire_die_02",
-    "vampire_die_03",
-    "vampire_jump_01",
-    "vampire_jump_02",
-    "vampire_jump_03",
-    "vlad_die",
-    "vlad_trigger",
-    "water_slosh_hard01",
-    "water_slosh_hard02",
-    "water_slosh_hard03",
-    "water_slosh_hard04",
-    "water_slosh_soft01",
-    "water_slosh_soft02",
-    "water_slosh_soft03",
-    "water_splash_big01",
-    "water_splash_mid01",
-    "water_splash_mid02",
-    "water_splash_mid03",
-    "water_splash_mini01",
-    "water_splash_mini02",
-    "water_splash_mini03",
-    "water_splash_small01",
-    "water_stream_high",
-    "water_stream_low",
-    "water_stream_low_rev",
-    "water_stream_mid",
-    "water_stream_mid_rev",
-    "webgun",
-    "webgun_hit1",
-    "webgun_hit2",
-    "webgun_hit3",
-    "whip01a",
-    "whip01b",
-    "whip01c",
-    "whip01d",
-    "whip01e",
-    "whip02a",
-    "whip02b",
-    "whip02c",
-    "whip02d",
-    "whip02e",
-    "whip_chain_a01",
-    "whip_chain_a02",
-    "whip_chain_a03",
-    "whip_chain_b01",
-    "whip_chain_b02",
-    "whip_chain_b03",
-    "whip_jump",
-    "whip_snap",
-    "wilddog_jump_01",
-    "wilddog_jump_02",
-    "wilddog_jump_03",
-    "wilddog_jump_04",
-    "wilddog_land_01",
-    "wilddog_land_02",
-    "wilddog_land_03",
-    "wilddog_legs_01",
-    "wilddog_legs_02",
-    "wilddog_legs_03",
-    "wilddog_legs_04",
-    "wilddog_legs_05",
-    "wilddog_legs_06",
-    "wilddog_legs_07",
-    "wilddog_legs_08",
-    "witchdoctorskull_01",
-    "witchdoctor_alert_01",
-    "witchdoctor_alert_02",
-    "witchdoctor_alert_03",
-    "witchdoctor_chant",
-    "witchdoctor_die_01",
-    "witchdoctor_die_02",
-    "witchdoctor_die_03",
-    "witchdoctor_talk_1a",
-    "witchdoctor_talk_1b",
-    "witchdoctor_talk_1c",
-    "witchdoctor_talk_2a",
-    "witchdoctor_talk_2b",
-    "witchdoctor_talk_2c",
-    "witchdoctor_talk_3a",
-    "witchdoctor_talk_3b",
-    "witchdoctor_talk_3c",
-    "wooden_shield_break01",
-    "wooden_shield_break02",
-    "wooden_shield_break03",
-    "wooden_shield_damage01",
-    "wooden_shield_damage02",
-    "wooden_shield_damage03",
-    "wooden_shield_damage04",
-    "wooden_shield_damage05",
-    "wood_clank_a01",
-    "wood_clank_a02",
-    "wood_clank_a03",
-    "wood_clank_a04",
-    "wood_clank_a05",
-    "wood_clank_a06",
-    "wood_clank_a07",
-    "wood_clank_a08",
-    "wood_clank_a09",
-    "wood_clank_b01",
-    "wood_clank_b02",
-    "wood_clank_b03",
-    "wood_clank_b04",
-    "yang_die",
-    "yeti_big_punch_01",
-    "yeti_big_punch_02",
-    "yeti_big_punch_03",
-    "yeti_big_walk_01",
-    "yeti_big_walk_02",
-    "yeti_big_walk_03",
-    "yeti_big_walk_04",
-    "yeti_big_walk_05",
-    "yeti_big_walk_06",
-    "yeti_big_walk_07",
-    "yeti_big_walk_08",
-    "yeti_king_breath01",
-    "yeti_king_breath02",
-    "yeti_king_yell01",
-    "yeti_king_yell02",
-    "yeti_king_yell03",
-    "yeti_queen_slam01",
-    "yeti_queen_slam02",
-    "yeti_queen_slam03",
-    "yeti_queen_slam04",
-    "yeti_queen_slide",
-    "yeti_queen_yell_01",
-    "yeti_queen_yell_02",
-    "yeti_queen_yell_03",
-    "Zoom_in",
-    "Zoom_out",
-    "audio_files.txt",
+    "tadpole"
+};
+inline constexpr std::string_view s_BigMonstersEntityFiles[]{
+    "alien_queen",
+    "ammit",
+    "crab_man",
+    "eggplant_minister",
+    "giant_clam",
+    "giant_fish",
+    "giant_fly",
+    "giant_frog",
+    "giant_spider",
+    "lamassu",
+    "lavamander",
+    "madame_tusk",
+    "mummy",
+    "olmec",
+    "osiris",
+    "queen_bee",
+    "quill_back",
+    "waddler",
+    "yeti_king",
+    "yeti_queen",
+};
+inline constexpr std::string_view s_PeopleEntityFiles[]{
+    "bodyguard",
+    "hunduns_servant",
+    "merchant",
+    "old_hunter",
+    "parmesan",
+    "parsley",
+    "parsnip",
+    "shopkeeper",
+    "thief",
+    "yang",
+};
+inline constexpr std::string_view s_DecorationsEntityFiles[]{
+    "udjat_wall_heads",
+};
+inline constexpr std::string_view s_KnownCharFiles[]{
+    "char_black",
+    "char_blue",
+    "char_cerulean",
+    "char_cinnabar",
+    "char_cyan",
+    "char_eggchild",
+    "char_gold",
+    "char_gray",
+    "char_green",
+    "char_hired",
+    "char_iris",
+    "char_khaki",
+    "char_lemon",
+    "char_lime",
+    "char_magenta",
+    "char_olive",
+    "char_orange",
+    "char_pink",
+    "char_red",
+    "char_violet",
+    "char_white",
+    "char_yellow",
+};
+inline constexpr std::string_view s_KnownTextureFiles[]{
+    "base_eggship",
+    "base_eggship2",
+    "base_eggship3",
+    "base_skynight",
+    "base_surface",
+    "base_surface2",
+    "bayer8",
+    "bg_babylon",
+    "bg_beehive",
+    "bg_cave",
+    "bg_duat",
+    "bg_duat2",
+    "bg_eggplant",
+    "bg_gold",
+    "bg_ice",
+    "bg_jungle",
+    "bg_mothership",
+    "bg_stone",
+    "bg_sunken",
+    "bg_temple",
+    "bg_tidepool",
+    "bg_vlad",
+    "bg_volcano",
+    "border_main",
+    "char_black",
+    "char_blue",
+    "char_cerulean",
+    "char_cinnabar",
+    "char_cyan",
+    "char_eggchild",
+    "char_gold",
+    "char_gray",
+    "char_green",
+    "char_hired",
+    "char_iris",
+    "char_khaki",
+    "char_lemon",
+    "char_lime",
+    "char_magenta",
+    "char_olive",
+    "char_orange",
+    "char_pink",
+    "char_red",
+    "char_violet",
+    "char_white",
+    "char_yellow",
+    "coffins",
+    "credits",
+    "deco_babylon",
+    "deco_basecamp",
+    "deco_cave",
+    "deco_cosmic",
+    "deco_eggplant",
+    "deco_extra",
+    "deco_gold",
+    "deco_ice",
+    "deco_jungle",
+    "deco_sunken",
+    "deco_temple",
+    "deco_tidepool",
+    "deco_tutorial",
+    "deco_volcano",
+    "floor_babylon",
+    "floor_cave",
+    "floor_eggplant",
+    "floor_ice",
+    "floor_jungle",
+    "floor_sunken",
+    "floor_surface",
+    "floor_temple",
+    "floor_tidepool",
+    "floor_volcano",
+    "floormisc",
+    "floorstyled_babylon",
+    "floorstyled_beehive",
+    "floorstyled_duat",
+    "floorstyled_gold_normal",
+    "floorstyled_gold",
+    "floorstyled_guts",
+    "floorstyled_mothership",
+    "floorstyled_pagoda",
+    "floorstyled_palace",
+    "floorstyled_stone",
+    "floorstyled_sunken",
+    "floorstyled_temple",
+    "floorstyled_vlad",
+    "floorstyled_wood",
+    "fontdebug",
+    "fontfirasans",
+    "fontmono",
+    "fontnewrodin",
+    "fontrodincattleya",
+    "fontyorkten",
+    "fx_ankh",
+    "fx_big",
+    "fx_explosion",
+    "fx_rubble",
+    "fx_small",
+    "fx_small2",
+    "fx_small3",
+    "hud_controller_buttons",
+    "hud_text",
+    "hud",
+    "items_ushabti",
+    "items",
+    "journal_back",
+    "journal_elements",
+    "journal_entry_bg",
+    "journal_entry_items",
+    "journal_entry_mons_big",
+    "journal_entry_mons",
+    "journal_entry_people",
+    "journal_entry_place",
+    "journal_entry_traps",
+    "journal_pageflip",
+    "journal_pagetorn",
+    "journal_select",
+    "journal_stickers",
+    "journal_story",
+    "journal_top_entry",
+    "journal_top_gameover",
+    "journal_top_main",
+    "journal_top_profile",
+    "loading",
+    "lut_backlayer",
+    "lut_blackmarket",
+    "lut_icecaves",
+    "lut_original",
+    "lut_vlad",
+    "main_body",
+    "main_dirt",
+    "main_door",
+    "main_doorback",
+    "main_doorframe",
+    "main_fore1",
+    "main_fore2",
+    "main_head",
+    "menu_basic",
+    "menu_brick1",
+    "menu_brick2",
+    "menu_cave1",
+    "menu_cave2",
+    "menu_chardoor",
+    "menu_charsel",
+    "menu_deathmatch",
+    "menu_deathmatch2",
+    "menu_deathmatch3",
+    "menu_deathmatch4",
+    "menu_deathmatch5",
+    "menu_deathmatch6",
+    "menu_disp",
+    "menu_generic",
+    "menu_header",
+    "menu_leader",
+    "menu_online",
+    "menu_title",
+    "menu_titlegal",
+    "menu_tunnel",
+    "monsters_ghost",
+    "monsters_hundun",
+    "monsters_olmec",
+    "monsters_osiris",
+    "monsters_pets",
+    "monsters_tiamat",
+    "monsters_yama",
+    "monsters01",
+    "monsters02",
+    "monsters03",
+    "monstersbasic01",
+    "monstersbasic02",
+    "monstersbasic03",
+    "monstersbig01",
+    "monstersbig02",
+    "monstersbig03",
+    "monstersbig04",
+    "monstersbig05",
+    "monstersbig06",
+    "mounts",
+    "noise0",
+    "noise1",
+    "saving",
+    "shadows",
+    "shine",
+    "splash0",
+    "splash1",
+    "splash2",
+    "extra_thorns",
+    "extra_pipes",
+};
+inline constexpr std::string_view s_KnownAudioFiles[]{
     "AMB_Beehive",
     "AMB_Dwelling",
     "AMB_Ending",
@@ -5346,6 +2894,7 @@ inline constexpr std::string_view s_KnownAudioFiles[]{
     "yeti_queen_yell_03",
     "Zoom_in",
     "Zoom_out",
+    "audio_files.txt",
 };
 inline constexpr std::string_view s_RestKnownFiles[]{
     "soundbank.strings.bank",
@@ -6285,3 +3834,23 @@ inline constexpr std::string_view s_PixelShaders[]{
     "mainp_UIProcess_PS",
     "mainp_Unfocuser_PS",
 };
+
+// Sets of the tables above for constant time lookups, built at compile time in known_files.cpp
+// Names of mod files are matched case insensitive like the Windows file system does, so mod files are recognized regardless of their case
+// The speedrun paths are matched against the paths the game requests, which always have the case of the tables
+extern const PerfectHashSet<std::string_view, std::size(s_ArenaLevelFiles), true> s_ArenaLevelFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_LevelFiles), true> s_LevelFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_PetsEntityFiles), true> s_PetsEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_MountsEntityFiles), true> s_MountsEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_GhostEntityFiles), true> s_GhostEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_CrittersEntityFiles), true> s_CrittersEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_MonstersEntityFiles), true> s_MonstersEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_BigMonstersEntityFiles), true> s_BigMonstersEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_PeopleEntityFiles), true> s_PeopleEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_DecorationsEntityFiles), true> s_DecorationsEntityFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_KnownCharFiles), true> s_KnownCharFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_KnownTextureFiles), true> s_KnownTextureFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_KnownAudioFiles), true> s_KnownAudioFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_RestKnownFiles), true> s_RestKnownFileSet;
+extern const PerfectHashSet<std::string_view, std::size(s_SpeedrunDbFiles)> s_SpeedrunDbFileSet;
+extern const PerfectHashSet<std::uint32_t, std::size(s_SpeedrunStringHashes)> s_SpeedrunStringHashSet;
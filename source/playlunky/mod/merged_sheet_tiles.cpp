@@ -0,0 +1,80 @@
+#include "merged_sheet_tiles.h"
+
+#include "util/algorithms.h"
+
+#include <algorithm>
+#include <tuple>
+
+void AddMergedTileSource(std::vector<MergedTile>& tiles, const Tile& target_tile, MergedTileSource tile_source)
+{
+    if (MergedTile* tile = algo::find(tiles, &MergedTile::TargetTile, target_tile))
+    {
+        tile->Sources.push_back(tile_source);
+    }
+    else
+    {
+        tiles.push_back(MergedTile{ .TargetTile{ target_tile }, .Sources{ tile_source } });
+    }
+}
+
+std::vector<bool> FindDirtyTiles(std::span<const MergedTile> tiles, const std::vector<bool>& dirty_sources)
+{
+    std::vector<bool> dirty_tiles(tiles.size(), false);
+    for (std::size_t i = 0; i < tiles.size(); i++)
+    {
+        dirty_tiles[i] = algo::any_of(tiles[i].Sources, [&dirty_sources](const MergedTileSource& tile_source)
+                                      { return dirty_sources[tile_source.SourceIndex]; });
+    }
+
+    auto overlaps = [](const Tile& lhs, const Tile& rhs)
+    {
+        return lhs.Left < rhs.Right && rhs.Left < lhs.Right && lhs.Top < rhs.Bottom && rhs.Top < lhs.Bottom;
+    };
+    bool found_overlap{ true };
+    while (found_overlap)
+    {
+        found_overlap = false;
+        for (std::size_t i = 0; i < tiles.size(); i++)
+        {
+            if (dirty_tiles[i])
+            {
+                continue;
+            }
+            for (std::size_t j = 0; j < tiles.size(); j++)
+            {
+                if (dirty_tiles[j] && overlaps(tiles[i].TargetTile, tiles[j].TargetTile))
+                {
+                    dirty_tiles[i] = true;
+                    found_overlap = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return dirty_tiles;
+}
+
+void RecompositeDirtyTiles(std::span<const MergedTile> tiles,
+                           const std::vector<bool>& dirty_tiles,
+                           const std::function<void(const Tile&)>& reset_tile,
+                           const std::function<void(const MergedTileSource&)>& blit_tile_source)
+{
+    std::vector<MergedTileSource> tile_sources;
+    for (std::size_t i = 0; i < tiles.size(); i++)
+    {
+        if (dirty_tiles[i])
+        {
+            reset_tile(tiles[i].TargetTile);
+            tile_sources.insert(tile_sources.end(), tiles[i].Sources.begin(), tiles[i].Sources.end());
+        }
+    }
+
+    // A full rebuild blits sources in order and the mappings of each source in order
+    std::sort(tile_sources.begin(), tile_sources.end(), [](const MergedTileSource& lhs, const MergedTileSource& rhs)
+              { return std::tie(lhs.SourceIndex, lhs.MappingIndex) < std::tie(rhs.SourceIndex, rhs.MappingIndex); });
+    for (const MergedTileSource& tile_source : tile_sources)
+    {
+        blit_tile_source(tile_source);
+    }
+}
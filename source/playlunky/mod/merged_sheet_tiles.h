@@ -0,0 +1,34 @@
+#pragma once
+
+#include "sprite_sheet_merger_types.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Which mappings of which sources were blitted into a target tile of a merged sheet
+struct MergedTileSource
+{
+    std::size_t SourceIndex;
+    std::size_t MappingIndex;
+};
+struct MergedTile
+{
+    Tile TargetTile;
+    std::vector<MergedTileSource> Sources; // In blitting order
+};
+
+// Mappings to the same target tile end up in the same merged tile, call in blitting order
+void AddMergedTileSource(std::vector<MergedTile>& tiles, const Tile& target_tile, MergedTileSource tile_source);
+
+// Tiles fed by any dirty source, plus all tiles that overlap those transitively
+// Overlapping tiles have to be recomposited too, otherwise the overlap would end up in the wrong order
+std::vector<bool> FindDirtyTiles(std::span<const MergedTile> tiles, const std::vector<bool>& dirty_sources);
+
+// Resets each dirty tile and then blits all sources of dirty tiles in the same order as a full rebuild would
+// A full rebuild is the same as calling this with all tiles dirty on top of the base image
+void RecompositeDirtyTiles(std::span<const MergedTile> tiles,
+                           const std::vector<bool>& dirty_tiles,
+                           const std::function<void(const Tile&)>& reset_tile,
+                           const std::function<void(const MergedTileSource&)>& blit_tile_source);
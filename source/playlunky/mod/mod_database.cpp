@@ -1,10 +1,16 @@
 #include "mod_database.h"
 
 #include "util/algorithms.h"
-#include "util/on_scope_exit.h"
-
-#include <Windows.h>
+#include "util/content_hash.h"
+#include "util/mapped_file.h"
+#include "util/thread_pool.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <functional>
 
 // Previously used magic numbers:
 //		0xF00DBAAD -- v0.3.0
@@ -24,7 +30,185 @@
 //		0xFACECA2E -- v0.13.0
 //		0x0CA4EDA1 -- v0.14.0
 //		0x0DAD2073 -- v0.14.1
-static constexpr std::uint32_t s_ModDatabaseMagicNumber{ 0x0DAD2073 };
+// The last one is migrated, anything older is rebuilt
+// Since then the magic number is fixed, bump s_ModDatabaseAssetVersion instead when converted assets change
+static constexpr std::uint32_t s_LegacyModDatabaseMagicNumber{ 0x0DAD2073 };
+
+static constexpr std::uint32_t s_ModDatabaseMagicNumber{ 0x42444C50 }; // "PLDB"
+static constexpr std::uint32_t s_ModDatabaseVersion{ 1 };
+static constexpr std::uint32_t s_ModDatabaseAssetVersion{ 1 };
+
+// The database consists of a header, a section table and the sections, all records are fixed size and all strings live in one pool
+enum ModDatabaseHeaderFlags : std::uint32_t
+{
+    ModDatabaseHeaderFlags_None = 0,
+    ModDatabaseHeaderFlags_Enabled = 1 << 0,
+};
+struct ModDatabaseHeader
+{
+    std::uint32_t MagicNumber;
+    std::uint32_t Version;
+    std::uint32_t AssetVersion;
+    std::uint32_t Flags;
+    std::uint32_t NumSections;
+    std::uint32_t Reserved;
+};
+static_assert(sizeof(ModDatabaseHeader) == 24);
+
+enum class ModDatabaseSectionType : std::uint32_t
+{
+    StringPool,
+    Files,
+    Folders,
+    Settings,
+    ModInfo,
+    Count,
+};
+struct ModDatabaseSection
+{
+    ModDatabaseSectionType Type;
+    std::uint32_t Reserved;
+    std::uint64_t Offset;
+    std::uint64_t Size;
+};
+static_assert(sizeof(ModDatabaseSection) == 24);
+
+enum ModDatabaseFileFlags : std::uint32_t
+{
+    ModDatabaseFileFlags_None = 0,
+    ModDatabaseFileFlags_HasHash = 1 << 0,
+};
+struct ModDatabaseFileRecord
+{
+    std::uint32_t PathOffset;
+    std::uint32_t PathSize;
+    std::int64_t LastWrite;
+    std::uint64_t Size;
+    std::uint64_t Hash;
+    std::uint32_t Flags;
+    std::uint32_t Reserved;
+};
+static_assert(sizeof(ModDatabaseFileRecord) == 40);
+
+struct ModDatabaseFolderRecord
+{
+    std::uint32_t PathOffset;
+    std::uint32_t PathSize;
+    std::int64_t LastWrite;
+};
+static_assert(sizeof(ModDatabaseFolderRecord) == 16);
+
+struct ModDatabaseSettingRecord
+{
+    std::uint32_t NameOffset;
+    std::uint32_t NameSize;
+    std::uint32_t Value;
+    std::uint32_t Reserved;
+};
+static_assert(sizeof(ModDatabaseSettingRecord) == 16);
+
+template<class T>
+static bool ReadPod(std::span<const std::uint8_t> data, std::uint64_t offset, T& value)
+{
+    if (offset > data.size() || data.size() - offset < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return true;
+}
+
+// Reads the layout used before the sectioned format, which was written with the native sizes of the 64 bit build
+class LegacyDatabaseReader
+{
+  public:
+    explicit LegacyDatabaseReader(std::span<const std::uint8_t> data)
+        : mData{ data }
+    {
+    }
+
+    template<class T>
+    T Read()
+    {
+        T value{};
+        if (mFailed || !ReadPod(mData, mOffset, value))
+        {
+            mFailed = true;
+            return T{};
+        }
+        mOffset += sizeof(T);
+        return value;
+    }
+    std::string_view ReadString()
+    {
+        const std::uint64_t size = Read<std::uint64_t>();
+        if (mFailed || size > mData.size() - mOffset)
+        {
+            mFailed = true;
+            return {};
+        }
+        const std::string_view str{ reinterpret_cast<const char*>(mData.data() + mOffset), static_cast<std::size_t>(size) };
+        mOffset += size;
+        return str;
+    }
+
+    bool Failed() const
+    {
+        return mFailed;
+    }
+
+  private:
+    std::span<const std::uint8_t> mData;
+    std::uint64_t mOffset{ 0 };
+    bool mFailed{ false };
+};
+
+// Uses the metadata cached by the directory iteration, so no need to open the file
+// Stores the UTC write time interpreted as local time, which is what older versions did, to not invalidate existing databases
+static std::time_t GetLastWriteTime(const std::filesystem::directory_entry& dir_entry)
+{
+    std::error_code error;
+    const auto file_time = dir_entry.last_write_time(error);
+    if (!error)
+    {
+        const auto system_time = std::chrono::file_clock::to_sys(file_time);
+        const std::time_t utc_time = std::chrono::system_clock::to_time_t(system_time);
+
+        std::tm tm;
+#ifdef _WIN32
+        if (gmtime_s(&tm, &utc_time) == 0)
+#else
+        if (gmtime_r(&utc_time, &tm) != nullptr)
+#endif
+        {
+            tm.tm_isdst = -1;
+            return std::mktime(&tm);
+        }
+    }
+    return time_t{ 0 };
+}
+
+static void ForEachIndex(ThreadPool* thread_pool, std::size_t count, const std::function<void(std::size_t)>& fun)
+{
+    if (thread_pool != nullptr)
+    {
+        thread_pool->ForEach(count, fun);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            fun(i);
+        }
+    }
+}
+
+static std::uint64_t GetFileSize(const std::filesystem::directory_entry& dir_entry)
+{
+    std::error_code error;
+    const std::uintmax_t file_size = dir_entry.file_size(error);
+    return error ? 0 : static_cast<std::uint64_t>(file_size);
+}
 
 ModDatabase::ModDatabase(std::filesystem::path database_folder, std::filesystem::path mod_folder, ModDatabaseFlags flags)
     : mDatabaseFolder(std::move(database_folder))
@@ -48,214 +232,148 @@ ModDatabase::ModDatabase(std::filesystem::path database_folder, std::filesystem:
         const fs::path db_path = mDatabaseFolder / "mod.db";
         if (fs::exists(db_path) && fs::is_regular_file(db_path))
         {
-            std::ifstream db_file(db_path, std::ios::binary);
-
+            bool read_database{ false };
             {
-                std::uint32_t magic_number;
-                db_file.read(reinterpret_cast<char*>(&magic_number), sizeof(magic_number));
-                if (magic_number != s_ModDatabaseMagicNumber)
+                const MappedFile db_file{ db_path };
+                if (db_file.IsValid())
                 {
-                    db_file.close();
-                    fs::remove_all(mDatabaseFolder);
-                    mWasOutdated = true;
-                    return;
+                    read_database = ReadDatabase(db_file.GetData());
                 }
             }
 
-            db_file.read(reinterpret_cast<char*>(&mWasEnabled), sizeof(mWasEnabled));
-            mIsEnabled = mWasEnabled;
-
+            if (!read_database)
             {
-                std::size_t num_files;
-                db_file.read(reinterpret_cast<char*>(&num_files), sizeof(num_files));
-
-                mFiles.resize(num_files);
-                for (ItemDescriptor& file : mFiles)
-                {
-                    std::size_t path_size;
-                    db_file.read(reinterpret_cast<char*>(&path_size), sizeof(path_size));
-
-                    std::string path(path_size, '\0');
-                    db_file.read(path.data(), path_size);
-
-                    std::time_t last_know_write;
-                    db_file.read(reinterpret_cast<char*>(&last_know_write), sizeof(last_know_write));
-
-                    file.Path = path;
-                    file.LastKnownWrite = last_know_write;
-                }
-            }
-
-            {
-                std::size_t num_folders;
-                db_file.read(reinterpret_cast<char*>(&num_folders), sizeof(num_folders));
-
-                mFolders.resize(num_folders);
-                for (ItemDescriptor& folder : mFolders)
-                {
-                    std::size_t path_size;
-                    db_file.read(reinterpret_cast<char*>(&path_size), sizeof(path_size));
-
-                    std::string path(path_size, '\0');
-                    db_file.read(path.data(), path_size);
-
-                    std::time_t last_know_write;
-                    db_file.read(reinterpret_cast<char*>(&last_know_write), sizeof(last_know_write));
-
-                    folder.Path = path;
-                    folder.LastKnownWrite = last_know_write;
-                }
+                mFiles.clear();
+                mFolders.clear();
+                mSettings.clear();
+                mModInfo.clear();
+                mWasEnabled = false;
+
+                fs::remove_all(mDatabaseFolder);
+                mWasOutdated = true;
+                return;
             }
+            mIsEnabled = mWasEnabled;
 
+            for (std::size_t i = 0; i < mFiles.size(); i++)
             {
-                std::size_t num_settings;
-                db_file.read(reinterpret_cast<char*>(&num_settings), sizeof(num_settings));
-
-                mSettings.resize(num_settings);
-                for (AdditionalSetting& setting : mSettings)
-                {
-                    std::size_t name_size;
-                    db_file.read(reinterpret_cast<char*>(&name_size), sizeof(name_size));
-
-                    std::string name(name_size, '\0');
-                    db_file.read(name.data(), name_size);
-
-                    bool value;
-                    db_file.read(reinterpret_cast<char*>(&value), sizeof(value));
-
-                    setting.Name = std::move(name);
-                    setting.Value = value;
-                }
+                mFileIndices.try_emplace(mFiles[i].Path.string(), i);
             }
-
+            for (std::size_t i = 0; i < mFolders.size(); i++)
             {
-                std::size_t mod_info_size;
-                db_file.read(reinterpret_cast<char*>(&mod_info_size), sizeof(mod_info_size));
-
-                mModInfo.resize(mod_info_size);
-                db_file.read(mModInfo.data(), mod_info_size);
+                mFolderIndices.try_emplace(mFolders[i].Path.string(), i);
             }
         }
     }
 }
 ModDatabase::~ModDatabase() = default;
 
-void ModDatabase::UpdateDatabase()
+void ModDatabase::UpdateDatabase(ThreadPool* thread_pool)
 {
     namespace fs = std::filesystem;
     if (fs::exists(mModFolder) && fs::is_directory(mModFolder))
     {
-        static auto get_last_write_time = [](const fs::path& file_path)
+        struct ScannedItem
         {
-            HANDLE file = CreateFile(file_path.string().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
-            if (file != INVALID_HANDLE_VALUE)
-            {
-                OnScopeExit close_handle{ [file]()
-                                          { CloseHandle(file); } };
-
-                FILETIME last_write_time;
-                if (GetFileTime(file, NULL, NULL, &last_write_time))
-                {
-                    SYSTEMTIME system_time;
-                    if (FileTimeToSystemTime(&last_write_time, &system_time))
-                    {
-                        std::tm tm;
-                        tm.tm_sec = system_time.wSecond;
-                        tm.tm_min = system_time.wMinute;
-                        tm.tm_hour = system_time.wHour;
-                        tm.tm_mday = system_time.wDay;
-                        tm.tm_mon = system_time.wMonth - 1;
-                        tm.tm_year = system_time.wYear - 1900;
-                        tm.tm_isdst = -1;
-                        return std::mktime(&tm);
-                    }
-                }
-            }
-            return time_t{ 0 };
+            fs::path Path;
+            std::time_t LastWrite;
+            std::uint64_t Size;
         };
+        struct ScanResult
+        {
+            std::vector<ScannedItem> Files;
+            std::vector<ScannedItem> Folders;
+        };
+
+        const bool scan_files = mFlags & ModDatabaseFlags_Files;
+        const bool scan_folders = mFlags & ModDatabaseFlags_Folders;
+        const bool recurse = mFlags & ModDatabaseFlags_Recurse;
 
-        auto do_iteration = [this](const fs::path& path)
+        // Walks the whole folder once, records items if requested and returns the oldest write time of the folder and anything in it
+        auto scan_folder = [&](const fs::directory_entry& folder_entry, const fs::path& rel_folder_path, bool record_folder, ScanResult& result, auto& self) -> std::time_t
         {
-            if (algo::is_sub_path(path, mDatabaseFolder))
+            std::optional<std::size_t> folder_index;
+            if (record_folder)
             {
-                return false;
+                folder_index = result.Folders.size();
+                result.Folders.push_back(ScannedItem{ .Path = rel_folder_path, .LastWrite = 0, .Size = 0 });
             }
-            else
+
+            std::time_t oldest_write_time = GetLastWriteTime(folder_entry);
+            for (const fs::directory_entry& dir_entry : fs::directory_iterator{ folder_entry.path() })
             {
-                if (fs::is_regular_file(path) && (mFlags & ModDatabaseFlags_Files))
+                const fs::path rel_path = rel_folder_path / dir_entry.path().filename();
+                if (dir_entry.is_directory())
                 {
-                    const auto rel_file_path = fs::relative(path, mModFolder);
-
-                    const auto last_write_time = get_last_write_time(path);
-
-                    if (ItemDescriptor* existing_file = algo::find(mFiles, &ItemDescriptor::Path, rel_file_path))
+                    if (!algo::is_sub_path(dir_entry.path(), mDatabaseFolder))
                     {
-                        existing_file->LastWrite = last_write_time;
-                    }
-                    else
-                    {
-                        mFiles.push_back(ItemDescriptor{
-                            .Path = rel_file_path,
-                            .LastWrite = last_write_time });
+                        const std::time_t folder_write_time = self(dir_entry, rel_path, scan_folders && recurse, result, self);
+                        oldest_write_time = std::min(oldest_write_time, folder_write_time);
                     }
                 }
-                else if (fs::is_directory(path) && (mFlags & ModDatabaseFlags_Folders))
+                else
                 {
-                    const auto rel_folder_path = fs::relative(path, mModFolder);
-
-                    auto get_last_folder_write_time = [](const fs::path& folder_path)
-                    {
-                        auto oldest_write_time = get_last_write_time(folder_path);
-                        for (auto& file_path : fs::recursive_directory_iterator(folder_path))
-                        {
-                            const auto file_write_time = get_last_write_time(file_path);
-                            oldest_write_time = std::min(oldest_write_time, file_write_time);
-                        }
-                        return oldest_write_time;
-                    };
-
-                    const auto last_write_time = get_last_folder_write_time(path);
-
-                    if (ItemDescriptor* existing_file = algo::find(mFolders, &ItemDescriptor::Path, rel_folder_path))
+                    const std::time_t file_write_time = GetLastWriteTime(dir_entry);
+                    oldest_write_time = std::min(oldest_write_time, file_write_time);
+                    if (scan_files && recurse && dir_entry.is_regular_file())
                     {
-                        existing_file->LastWrite = last_write_time;
-                    }
-                    else
-                    {
-                        mFolders.push_back(ItemDescriptor{
-                            .Path = rel_folder_path,
-                            .LastWrite = last_write_time });
+                        result.Files.push_back(ScannedItem{ .Path = rel_path, .LastWrite = file_write_time, .Size = GetFileSize(dir_entry) });
                     }
                 }
-                return true;
             }
+
+            if (folder_index.has_value())
+            {
+                result.Folders[folder_index.value()].LastWrite = oldest_write_time;
+            }
+            return oldest_write_time;
         };
 
-        if (mFlags & ModDatabaseFlags_Recurse)
+        std::vector<fs::directory_entry> top_level_entries;
+        for (const fs::directory_entry& dir_entry : fs::directory_iterator{ mModFolder })
         {
-            auto iter_recurse = [&do_iteration](const auto& path, auto& self) -> void
+            if (!dir_entry.is_directory() || !algo::is_sub_path(dir_entry.path(), mDatabaseFolder))
             {
-                namespace fs = std::filesystem;
-                for (auto& sub_path : fs::directory_iterator(path))
+                top_level_entries.push_back(dir_entry);
+            }
+        }
+
+        // Each top level entry is scanned on its own, results are merged afterwards to keep the order of a serial scan
+        std::vector<ScanResult> scan_results(top_level_entries.size());
+        auto scan_entry = [&](std::size_t i)
+        {
+            const fs::directory_entry& dir_entry = top_level_entries[i];
+            const fs::path rel_path = dir_entry.path().filename();
+            if (dir_entry.is_regular_file())
+            {
+                if (scan_files)
                 {
-                    if (do_iteration(sub_path))
-                    {
-                        if (fs::is_directory(sub_path))
-                        {
-                            self(sub_path, self);
-                        }
-                    }
+                    scan_results[i].Files.push_back(ScannedItem{ .Path = rel_path, .LastWrite = GetLastWriteTime(dir_entry), .Size = GetFileSize(dir_entry) });
                 }
-            };
-            iter_recurse(mModFolder, iter_recurse);
-        }
-        else
+            }
+            else if (dir_entry.is_directory() && (scan_folders || recurse))
+            {
+                scan_folder(dir_entry, rel_path, scan_folders, scan_results[i], scan_folder);
+            }
+        };
+        ForEachIndex(thread_pool, top_level_entries.size(), scan_entry);
+
+        for (ScanResult& scan_result : scan_results)
         {
-            for (auto& path : fs::directory_iterator(mModFolder))
+            for (ScannedItem& file : scan_result.Files)
+            {
+                UpdateItem(mFiles, mFileIndices, std::move(file.Path), file.LastWrite, file.Size);
+            }
+            for (ScannedItem& folder : scan_result.Folders)
             {
-                (void)do_iteration(path);
+                UpdateItem(mFolders, mFolderIndices, std::move(folder.Path), folder.LastWrite, folder.Size);
             }
         }
+
+        if (mFlags & ModDatabaseFlags_ContentHash)
+        {
+            UpdateContentHashes(thread_pool);
+        }
     }
 }
 void ModDatabase::WriteDatabase() const
@@ -281,85 +399,271 @@ void ModDatabase::WriteDatabase() const
 
     if (fs::exists(mDatabaseFolder) && fs::is_directory(mDatabaseFolder))
     {
-        const fs::path db_path = mDatabaseFolder / "mod.db";
-        if (fs::exists(db_path))
+        std::string string_pool;
+        auto add_string = [&string_pool](std::string_view str)
         {
-            fs::remove_all(db_path);
-        }
-
-        std::ofstream db_file(db_path, std::ios::binary);
-        db_file.write(reinterpret_cast<const char*>(&s_ModDatabaseMagicNumber), sizeof(s_ModDatabaseMagicNumber));
-        db_file.write(reinterpret_cast<const char*>(&mIsEnabled), sizeof(mIsEnabled));
+            const auto offset = static_cast<std::uint32_t>(string_pool.size());
+            string_pool += str;
+            return std::pair{ offset, static_cast<std::uint32_t>(str.size()) };
+        };
 
+        std::vector<ModDatabaseFileRecord> file_records;
         if (mFlags & ModDatabaseFlags_Files)
         {
-            const std::size_t num_files = algo::count_if(mFiles, [](const auto& file)
-                                                         { return file.Exists(); });
-            db_file.write(reinterpret_cast<const char*>(&num_files), sizeof(num_files));
-
             for (const ItemDescriptor& file : mFiles)
             {
                 if (file.Exists())
                 {
-                    const std::string path_string = file.Path.string();
-                    const std::size_t path_size = path_string.size();
-                    db_file.write(reinterpret_cast<const char*>(&path_size), sizeof(path_size));
-                    db_file.write(path_string.data(), path_string.size());
-
-                    const std::time_t last_write_time = file.LastWrite.value();
-                    db_file.write(reinterpret_cast<const char*>(&last_write_time), sizeof(last_write_time));
+                    const auto [path_offset, path_size] = add_string(file.Path.string());
+                    file_records.push_back(ModDatabaseFileRecord{
+                        .PathOffset = path_offset,
+                        .PathSize = path_size,
+                        .LastWrite = static_cast<std::int64_t>(file.LastWrite.value()),
+                        .Size = file.Size,
+                        .Hash = file.Hash.value_or(0),
+                        .Flags = file.Hash.has_value() ? ModDatabaseFileFlags_HasHash : ModDatabaseFileFlags_None,
+                        .Reserved = 0,
+                    });
                 }
             }
         }
-        else
-        {
-            const std::size_t num_files = 0;
-            db_file.write(reinterpret_cast<const char*>(&num_files), sizeof(num_files));
-        }
 
+        std::vector<ModDatabaseFolderRecord> folder_records;
         if (mFlags & ModDatabaseFlags_Folders)
         {
-            const std::size_t num_folders = algo::count_if(mFolders, [](const auto& folder)
-                                                           { return folder.Exists(); });
-            db_file.write(reinterpret_cast<const char*>(&num_folders), sizeof(num_folders));
-
             for (const ItemDescriptor& folder : mFolders)
             {
                 if (folder.Exists())
                 {
-                    const std::string path_string = folder.Path.string();
-                    const std::size_t path_size = path_string.size();
-                    db_file.write(reinterpret_cast<const char*>(&path_size), sizeof(path_size));
-                    db_file.write(path_string.data(), path_string.size());
-
-                    const std::time_t last_write_time = folder.LastWrite.value();
-                    db_file.write(reinterpret_cast<const char*>(&last_write_time), sizeof(last_write_time));
+                    const auto [path_offset, path_size] = add_string(folder.Path.string());
+                    folder_records.push_back(ModDatabaseFolderRecord{
+                        .PathOffset = path_offset,
+                        .PathSize = path_size,
+                        .LastWrite = static_cast<std::int64_t>(folder.LastWrite.value()),
+                    });
                 }
             }
         }
-        else
+
+        std::vector<ModDatabaseSettingRecord> setting_records;
+        for (const AdditionalSetting& setting : mSettings)
+        {
+            const auto [name_offset, name_size] = add_string(setting.Name);
+            setting_records.push_back(ModDatabaseSettingRecord{
+                .NameOffset = name_offset,
+                .NameSize = name_size,
+                .Value = setting.Value ? 1u : 0u,
+                .Reserved = 0,
+            });
+        }
+
+        const ModDatabaseHeader header{
+            .MagicNumber = s_ModDatabaseMagicNumber,
+            .Version = s_ModDatabaseVersion,
+            .AssetVersion = s_ModDatabaseAssetVersion,
+            .Flags = mIsEnabled ? ModDatabaseHeaderFlags_Enabled : ModDatabaseHeaderFlags_None,
+            .NumSections = static_cast<std::uint32_t>(ModDatabaseSectionType::Count),
+            .Reserved = 0,
+        };
+
+        std::vector<std::uint8_t> db_data(sizeof(ModDatabaseHeader) + sizeof(ModDatabaseSection) * header.NumSections);
+        std::memcpy(db_data.data(), &header, sizeof(header));
+
+        auto add_section = [&db_data](ModDatabaseSectionType type, const void* data, std::size_t size)
         {
-            const std::size_t num_folders = 0;
-            db_file.write(reinterpret_cast<const char*>(&num_folders), sizeof(num_folders));
+            // Keep sections aligned so records could also be accessed in place
+            db_data.resize((db_data.size() + 7) & ~std::size_t{ 7 });
+
+            const ModDatabaseSection section{
+                .Type = type,
+                .Reserved = 0,
+                .Offset = db_data.size(),
+                .Size = size,
+            };
+            const std::size_t section_index = static_cast<std::size_t>(type);
+            std::memcpy(db_data.data() + sizeof(ModDatabaseHeader) + section_index * sizeof(ModDatabaseSection), &section, sizeof(section));
+
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            db_data.insert(db_data.end(), bytes, bytes + size);
+        };
+        add_section(ModDatabaseSectionType::StringPool, string_pool.data(), string_pool.size());
+        add_section(ModDatabaseSectionType::Files, file_records.data(), file_records.size() * sizeof(ModDatabaseFileRecord));
+        add_section(ModDatabaseSectionType::Folders, folder_records.data(), folder_records.size() * sizeof(ModDatabaseFolderRecord));
+        add_section(ModDatabaseSectionType::Settings, setting_records.data(), setting_records.size() * sizeof(ModDatabaseSettingRecord));
+        add_section(ModDatabaseSectionType::ModInfo, mModInfo.data(), mModInfo.size());
+
+        // Write to a temporary file first, so a crash while writing never leaves a broken database behind
+        const fs::path db_path = mDatabaseFolder / "mod.db";
+        const fs::path temp_db_path = mDatabaseFolder / "mod.db.tmp";
+        {
+            std::ofstream db_file(temp_db_path, std::ios::binary | std::ios::trunc);
+            db_file.write(reinterpret_cast<const char*>(db_data.data()), db_data.size());
         }
+        fs::rename(temp_db_path, db_path);
+    }
+}
 
-        const std::size_t num_settings = mSettings.size();
-        db_file.write(reinterpret_cast<const char*>(&num_settings), sizeof(num_settings));
-        for (const AdditionalSetting& setting : mSettings)
+bool ModDatabase::ReadDatabase(std::span<const std::uint8_t> data)
+{
+    std::uint32_t magic_number;
+    if (!ReadPod(data, 0, magic_number))
+    {
+        return false;
+    }
+
+    switch (magic_number)
+    {
+    case s_ModDatabaseMagicNumber:
+        break;
+    case s_LegacyModDatabaseMagicNumber:
+        return ReadLegacyDatabase(data);
+    default:
+        return false;
+    }
+
+    ModDatabaseHeader header;
+    if (!ReadPod(data, 0, header) || header.Version > s_ModDatabaseVersion || header.AssetVersion != s_ModDatabaseAssetVersion)
+    {
+        return false;
+    }
+
+    // Unknown sections are skipped, so newer versions can add sections without breaking older readers
+    std::array<std::span<const std::uint8_t>, static_cast<std::size_t>(ModDatabaseSectionType::Count)> sections{};
+    for (std::uint32_t i = 0; i < header.NumSections; i++)
+    {
+        ModDatabaseSection section;
+        if (!ReadPod(data, sizeof(ModDatabaseHeader) + static_cast<std::uint64_t>(i) * sizeof(ModDatabaseSection), section) ||
+            section.Offset > data.size() || data.size() - section.Offset < section.Size)
         {
-            const std::size_t name_size = setting.Name.size();
-            db_file.write(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
-            db_file.write(setting.Name.data(), setting.Name.size());
+            return false;
+        }
+
+        const std::size_t section_index = static_cast<std::size_t>(section.Type);
+        if (section_index < sections.size())
+        {
+            sections[section_index] = data.subspan(static_cast<std::size_t>(section.Offset), static_cast<std::size_t>(section.Size));
+        }
+    }
 
-            db_file.write(reinterpret_cast<const char*>(&setting.Value), sizeof(setting.Value));
+    const std::span<const std::uint8_t> string_pool = sections[static_cast<std::size_t>(ModDatabaseSectionType::StringPool)];
+    auto get_string = [string_pool](std::uint32_t offset, std::uint32_t size) -> std::optional<std::string_view>
+    {
+        if (offset > string_pool.size() || string_pool.size() - offset < size)
+        {
+            return std::nullopt;
         }
+        return std::string_view{ reinterpret_cast<const char*>(string_pool.data() + offset), size };
+    };
+
+    mWasEnabled = (header.Flags & ModDatabaseHeaderFlags_Enabled) != 0;
 
+    {
+        const std::span<const std::uint8_t> files_section = sections[static_cast<std::size_t>(ModDatabaseSectionType::Files)];
+        const std::size_t num_files = files_section.size() / sizeof(ModDatabaseFileRecord);
+        mFiles.resize(num_files);
+        for (std::size_t i = 0; i < num_files; i++)
         {
-            std::size_t mod_info_size = mModInfo.size();
-            db_file.write(reinterpret_cast<char*>(&mod_info_size), sizeof(mod_info_size));
-            db_file.write(mModInfo.data(), mod_info_size);
+            ModDatabaseFileRecord record;
+            ReadPod(files_section, i * sizeof(ModDatabaseFileRecord), record);
+
+            const std::optional<std::string_view> path = get_string(record.PathOffset, record.PathSize);
+            if (!path.has_value())
+            {
+                return false;
+            }
+
+            ItemDescriptor& file = mFiles[i];
+            file.Path = path.value();
+            file.LastKnownWrite = static_cast<std::time_t>(record.LastWrite);
+            file.LastKnownSize = record.Size;
+            if (record.Flags & ModDatabaseFileFlags_HasHash)
+            {
+                file.LastKnownHash = record.Hash;
+            }
         }
     }
+
+    {
+        const std::span<const std::uint8_t> folders_section = sections[static_cast<std::size_t>(ModDatabaseSectionType::Folders)];
+        const std::size_t num_folders = folders_section.size() / sizeof(ModDatabaseFolderRecord);
+        mFolders.resize(num_folders);
+        for (std::size_t i = 0; i < num_folders; i++)
+        {
+            ModDatabaseFolderRecord record;
+            ReadPod(folders_section, i * sizeof(ModDatabaseFolderRecord), record);
+
+            const std::optional<std::string_view> path = get_string(record.PathOffset, record.PathSize);
+            if (!path.has_value())
+            {
+                return false;
+            }
+
+            ItemDescriptor& folder = mFolders[i];
+            folder.Path = path.value();
+            folder.LastKnownWrite = static_cast<std::time_t>(record.LastWrite);
+        }
+    }
+
+    {
+        const std::span<const std::uint8_t> settings_section = sections[static_cast<std::size_t>(ModDatabaseSectionType::Settings)];
+        const std::size_t num_settings = settings_section.size() / sizeof(ModDatabaseSettingRecord);
+        mSettings.resize(num_settings);
+        for (std::size_t i = 0; i < num_settings; i++)
+        {
+            ModDatabaseSettingRecord record;
+            ReadPod(settings_section, i * sizeof(ModDatabaseSettingRecord), record);
+
+            const std::optional<std::string_view> name = get_string(record.NameOffset, record.NameSize);
+            if (!name.has_value())
+            {
+                return false;
+            }
+
+            mSettings[i] = AdditionalSetting{ .Name{ std::string{ name.value() } }, .Value{ record.Value != 0 } };
+        }
+    }
+
+    {
+        const std::span<const std::uint8_t> mod_info_section = sections[static_cast<std::size_t>(ModDatabaseSectionType::ModInfo)];
+        mModInfo.assign(reinterpret_cast<const char*>(mod_info_section.data()), mod_info_section.size());
+    }
+
+    return true;
+}
+bool ModDatabase::ReadLegacyDatabase(std::span<const std::uint8_t> data)
+{
+    LegacyDatabaseReader reader{ data };
+    reader.Read<std::uint32_t>();
+
+    mWasEnabled = reader.Read<bool>();
+
+    const std::uint64_t num_files = reader.Read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < num_files && !reader.Failed(); i++)
+    {
+        ItemDescriptor& file = mFiles.emplace_back();
+        file.Path = reader.ReadString();
+        file.LastKnownWrite = static_cast<std::time_t>(reader.Read<std::int64_t>());
+    }
+
+    const std::uint64_t num_folders = reader.Read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < num_folders && !reader.Failed(); i++)
+    {
+        ItemDescriptor& folder = mFolders.emplace_back();
+        folder.Path = reader.ReadString();
+        folder.LastKnownWrite = static_cast<std::time_t>(reader.Read<std::int64_t>());
+    }
+
+    const std::uint64_t num_settings = reader.Read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < num_settings && !reader.Failed(); i++)
+    {
+        const std::string_view name = reader.ReadString();
+        const bool value = reader.Read<bool>();
+        mSettings.push_back(AdditionalSetting{ .Name{ std::string{ name } }, .Value{ value } });
+    }
+
+    mModInfo = reader.ReadString();
+
+    return !reader.Failed();
 }
 
 bool ModDatabase::GetAdditionalSetting(std::string_view name, bool default_value) const
@@ -379,3 +683,56 @@ void ModDatabase::SetAdditionalSetting(std::string_view name, bool value)
     }
     mSettings.push_back(AdditionalSetting{ .Name{ std::string{ name } }, .Value{ value } });
 }
+
+void ModDatabase::UpdateItem(std::vector<ItemDescriptor>& items, ItemIndices& item_indices, std::filesystem::path path, std::time_t last_write, std::uint64_t size)
+{
+    auto [it, inserted] = item_indices.try_emplace(path.string(), items.size());
+    if (inserted)
+    {
+        items.push_back(ItemDescriptor{
+            .Path = std::move(path),
+            .LastWrite = last_write,
+            .Size = size });
+    }
+    else
+    {
+        ItemDescriptor& item = items[it->second];
+        item.LastWrite = last_write;
+        item.Size = size;
+    }
+}
+void ModDatabase::UpdateContentHashes(ThreadPool* thread_pool)
+{
+    // Only hash files that are new or were touched, everything else keeps its known hash
+    // Unchanged files without a known hash, e.g. from a database written without hashes, are trusted by their write time
+    // and only get a hash once they are touched, so upgrading does not hash every mod file on the first start
+    std::vector<ItemDescriptor*> files_to_hash;
+    for (ItemDescriptor& file : mFiles)
+    {
+        if (file.Exists())
+        {
+            if (file.IsNew() || file.IsChanged())
+            {
+                files_to_hash.push_back(&file);
+            }
+            else
+            {
+                file.Hash = file.LastKnownHash;
+            }
+        }
+    }
+
+    ForEachIndex(thread_pool, files_to_hash.size(), [&](std::size_t i)
+                 {
+                     ItemDescriptor& file = *files_to_hash[i];
+                     file.Hash = HashFileContent(mModFolder / file.Path); });
+
+    // Touched but identical files adopt their new write time, so they are not reported as changed
+    for (ItemDescriptor* file : files_to_hash)
+    {
+        if (file->IsChanged() && file->Hash.has_value() && file->Hash == file->LastKnownHash && file->Size == file->LastKnownSize)
+        {
+            file->LastKnownWrite = file->LastWrite;
+        }
+    }
+}
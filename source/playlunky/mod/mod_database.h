@@ -2,15 +2,23 @@
 
 #include <filesystem>
 #include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "log.h"
 
+class ThreadPool;
+
 using ModDatabaseFlagsInt = std::int8_t;
 enum ModDatabaseFlags : ModDatabaseFlagsInt
 {
     ModDatabaseFlags_Files = 1 << 0,
     ModDatabaseFlags_Folders = 1 << 1,
-    ModDatabaseFlags_Recurse = 1 << 2
+    ModDatabaseFlags_Recurse = 1 << 2,
+    // Files whose write time or size changed are only reported as changed if their content changed
+    ModDatabaseFlags_ContentHash = 1 << 3,
 };
 
 class ModDatabase
@@ -46,7 +54,8 @@ class ModDatabase
         return mModInfo;
     }
 
-    void UpdateDatabase();
+    // Scans subfolders concurrently if a thread pool is passed
+    void UpdateDatabase(ThreadPool* thread_pool = nullptr);
     void WriteDatabase() const;
 
     bool GetAdditionalSetting(std::string_view name, bool default_value) const;
@@ -92,6 +101,10 @@ class ModDatabase
         std::filesystem::path Path{};
         std::optional<std::time_t> LastKnownWrite{ std::nullopt };
         std::optional<std::time_t> LastWrite{ std::nullopt };
+        std::optional<std::uint64_t> LastKnownSize{ std::nullopt };
+        std::uint64_t Size{ 0 };
+        std::optional<std::uint64_t> LastKnownHash{ std::nullopt };
+        std::optional<std::uint64_t> Hash{ std::nullopt };
 
         bool Exists() const
         {
@@ -107,7 +120,7 @@ class ModDatabase
         }
         bool IsChanged() const
         {
-            return Exists() && Existed() && LastKnownWrite.value() < LastWrite.value();
+            return Exists() && Existed() && (LastKnownWrite.value() < LastWrite.value() || (LastKnownSize.has_value() && LastKnownSize.value() != Size));
         }
         bool IsDeleted() const
         {
@@ -117,6 +130,17 @@ class ModDatabase
     std::vector<ItemDescriptor> mFiles;
     std::vector<ItemDescriptor> mFolders;
 
+    // Maps path strings to indices into mFiles and mFolders
+    using ItemIndices = std::unordered_map<std::string, std::size_t>;
+    ItemIndices mFileIndices;
+    ItemIndices mFolderIndices;
+
+    bool ReadDatabase(std::span<const std::uint8_t> data);
+    bool ReadLegacyDatabase(std::span<const std::uint8_t> data);
+
+    static void UpdateItem(std::vector<ItemDescriptor>& items, ItemIndices& item_indices, std::filesystem::path path, std::time_t last_write, std::uint64_t size);
+    void UpdateContentHashes(ThreadPool* thread_pool);
+
     struct AdditionalSetting
     {
         std::string Name;
@@ -28,6 +28,7 @@
 #include "util/algorithms.h"
 #include "util/function_pointer.h"
 #include "util/regex.h"
+#include "util/thread_pool.h"
 
 #include "detour/imgui.h"
 
@@ -74,6 +75,11 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
 
     const bool disable_asset_caching = settings.GetBool("general_settings", "disable_asset_caching", false);
 
+    vfs.SetMemoryMappedLoading(settings.GetBool("general_settings", "memory_mapped_file_loading", false));
+    const bool block_compressed_textures = settings.GetBool("sprite_settings", "block_compressed_textures", false);
+    SetDdsBlockCompression(block_compressed_textures);
+    const bool content_hash_change_detection = settings.GetBool("general_settings", "content_hash_change_detection", true);
+
     const bool enable_raw_string_loading = !speedrun_mode && settings.GetBool("script_settings", "enable_raw_string_loading", false);
     const bool enable_customizable_sheets = !speedrun_mode && settings.GetBool("sprite_settings", "enable_customizable_sheets", true);
 
@@ -89,10 +95,13 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
     const fs::path mods_root_path{ mModsRoot };
     if (fs::exists(mods_root_path) && fs::is_directory(mods_root_path))
     {
+        ThreadPool thread_pool;
+
         const auto db_folder{ mods_root_path / ".db" };
         const auto mod_db_folder{ db_folder / "Mods" };
 
         bool speedrun_mode_changed{ false };
+        bool texture_format_changed{ false };
         bool journal_gen_settings_change{ false };
         bool sticker_gen_settings_change{ false };
 
@@ -115,14 +124,16 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
             sticker_gen_settings_change = sticker_gen_settings_change || (mod_db.GetAdditionalSetting("generate_sticker_pixel_art", true) != sticker_pixel_gen);
 
             speedrun_mode_changed = mod_db.GetAdditionalSetting("speedrun_mode", false) != speedrun_mode;
+            texture_format_changed = mod_db.GetAdditionalSetting("block_compressed_textures", false) != block_compressed_textures;
 
             mod_db.SetEnabled(true);
             mod_db.SetAdditionalSetting("speedrun_mode", speedrun_mode);
+            mod_db.SetAdditionalSetting("block_compressed_textures", block_compressed_textures);
             mod_db.SetAdditionalSetting("generate_character_journal_entries", journal_gen);
             mod_db.SetAdditionalSetting("generate_character_journal_stickers", sticker_gen);
             mod_db.SetAdditionalSetting("generate_sticker_pixel_art", sticker_pixel_gen);
 
-            mod_db.UpdateDatabase();
+            mod_db.UpdateDatabase(&thread_pool);
             mod_db.ForEachFile([&mods_root_path, &has_loose_files, &load_order_updated](const fs::path& rel_file_path, bool outdated, bool deleted, [[maybe_unused]] std::optional<bool> new_enabled_state)
                                {
                                    if (outdated)
@@ -136,6 +147,10 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                                                UnzipMod(zip_path);
                                            }
                                        }
+                                       else if (algo::is_same_path(rel_file_path.extension(), ".plpack"))
+                                       {
+                                           // Packed mods are loaded as is
+                                       }
                                        else if (algo::is_same_path(rel_file_path.filename(), "load_order.txt") && (outdated || deleted))
                                        {
                                            load_order_updated = true;
@@ -146,7 +161,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                                        }
                                    } });
 
-            mod_db.UpdateDatabase();
+            mod_db.UpdateDatabase(&thread_pool);
             mod_db.ForEachFolder([&mods_root_path](const fs::path& rel_folder_path, [[maybe_unused]] bool outdated, [[maybe_unused]] bool deleted, [[maybe_unused]] std::optional<bool> new_enabled_state)
                                  {
                                      const fs::path folder_path = mods_root_path / rel_folder_path;
@@ -231,7 +246,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                 fs::path{ "strings12.str" },
                 fs::path{ "Data/Levels/Arena/dmpreview.tok" },
             };
-            if (ExtractGameAssets(files, db_original_folder))
+            if (ExtractGameAssets(files, db_original_folder, &thread_pool))
             {
                 LogInfo("Successfully extracted all required game assets...");
 
@@ -286,6 +301,21 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
             return mod_folders;
         }(mods_root_path);
 
+        const std::vector<fs::path> mod_packs = [](const fs::path& root_folder)
+        {
+            std::vector<fs::path> mod_packs;
+
+            for (fs::path sub_path : fs::directory_iterator{ root_folder })
+            {
+                if (fs::is_regular_file(sub_path) && algo::is_same_path(sub_path.extension(), ".plpack"))
+                {
+                    mod_packs.push_back(sub_path);
+                }
+            }
+
+            return mod_packs;
+        }(mods_root_path);
+
         struct ModPrioAndState
         {
             std::int64_t Prio;
@@ -318,6 +348,22 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
 
             return mod_name_to_prio;
         }();
+        auto get_mod_prio_and_state = [&mod_name_to_prio](const std::string& mod_name, const fs::path& mod_path)
+        {
+            std::int64_t prio{ static_cast<std::int64_t>(mod_name_to_prio.size()) };
+            bool enabled{ true };
+            if (mod_name_to_prio.contains(mod_name))
+            {
+                const auto& prio_and_state = mod_name_to_prio[mod_name];
+                prio = prio_and_state.Prio;
+                enabled = prio_and_state.Enabled;
+            }
+            else
+            {
+                mod_name_to_prio[mod_name] = { prio, fs::exists(mod_path) };
+            }
+            return std::pair{ prio, enabled };
+        };
 
         const bool enable_sprite_hot_loading = settings.GetBool("sprite_settings", "enable_sprite_hot_loading", false);
         if (enable_sprite_hot_loading)
@@ -330,37 +376,42 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
         DmPreviewMerger dmpreview_merger{ settings };
         bool has_outdated_shaders{ false };
 
+        std::vector<std::pair<std::int64_t, bool>> mod_prios_and_states;
         for (const fs::path& mod_folder : mod_folders)
         {
+            mod_prios_and_states.push_back(get_mod_prio_and_state(mod_folder.filename().string(), mod_folder));
+        }
+
+        // Scanning the mod folders is independent of everything else, so scan all of them concurrently up front
+        std::vector<std::unique_ptr<ModDatabase>> mod_databases(mod_folders.size());
+        const ModDatabaseFlags mod_database_flags = static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Recurse | (content_hash_change_detection ? ModDatabaseFlags_ContentHash : 0));
+        thread_pool.ForEach(mod_folders.size(), [&](std::size_t i)
+                            {
+                                const fs::path& mod_folder = mod_folders[i];
+                                auto mod_db = std::make_unique<ModDatabase>(db_folder / "Mods" / mod_folder.filename(), mod_folder, mod_database_flags);
+                                mod_db->SetEnabled(mod_prios_and_states[i].second);
+                                if (mod_db->IsEnabled() || mod_db->WasEnabled())
+                                {
+                                    mod_db->UpdateDatabase(&thread_pool);
+                                }
+                                mod_databases[i] = std::move(mod_db); });
+
+        for (std::size_t i = 0; i < mod_folders.size(); i++)
+        {
+            const fs::path& mod_folder = mod_folders[i];
             const std::string mod_name = mod_folder.filename().string();
             const auto this_db_folder = db_folder / "Mods" / mod_name;
 
-            const auto [prio, enabled] = [&mod_name_to_prio, &mod_name, &mod_folder]() mutable
-            {
-                std::int64_t prio{ static_cast<std::int64_t>(mod_name_to_prio.size()) };
-                bool enabled{ true };
-                if (mod_name_to_prio.contains(mod_name))
-                {
-                    const auto& prio_and_state = mod_name_to_prio[mod_name];
-                    prio = prio_and_state.Prio;
-                    enabled = prio_and_state.Enabled;
-                }
-                else
-                {
-                    mod_name_to_prio[mod_name] = { prio, fs::exists(mod_folder) };
-                }
-                return std::pair{ prio, enabled };
-            }();
+            const auto [prio, enabled] = mod_prios_and_states[i];
 
             ModInfo mod_info{ mod_name };
 
             {
-                ModDatabase mod_db{ this_db_folder, mod_folder, static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Recurse) };
-                mod_db.SetEnabled(enabled);
+                const std::unique_ptr<ModDatabase> mod_db_ptr = std::move(mod_databases[i]);
+                ModDatabase& mod_db = *mod_db_ptr;
 
                 if (mod_db.IsEnabled() || mod_db.WasEnabled())
                 {
-                    mod_db.UpdateDatabase();
                     const std::vector<fs::path> mod_load_paths{ this_db_folder, mod_folder };
                     if (mod_db.IsEnabled())
                     {
@@ -404,6 +455,11 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                                                outdated = true;
                                            }
 
+                                           if (texture_format_changed && IsSupportedFileType(rel_asset_path.extension()))
+                                           {
+                                               outdated = !deleted;
+                                           }
+
                                            if (algo::is_same_path(rel_asset_path.extension(), ".lvl"))
                                            {
                                                if (!speedrun_mode && !deleted && new_enabled_state.value_or(true))
@@ -419,7 +475,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                                            }
                                            else if (algo::is_same_path(rel_asset_path.extension(), ".dds"))
                                            {
-                                               const bool is_character_asset = algo::contains(s_KnownCharFiles, rel_asset_path.stem());
+                                               const bool is_character_asset = s_KnownCharFileSet.Contains(rel_asset_path.stem().string());
                                                Playlunky::Get().RegisterModType(is_character_asset ? ModType::CharacterSprite : ModType::Sprite);
                                            }
                                            else if (IsSupportedFileType(rel_asset_path.extension()))
@@ -450,7 +506,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                                                const bool is_entity_asset = algo::contains_if(rel_asset_path,
                                                                                               [](const fs::path& element)
                                                                                               { return algo::is_same_path(element, "Entities"); });
-                                               const bool is_character_asset = algo::contains(s_KnownCharFiles, rel_asset_path.stem());
+                                               const bool is_character_asset = s_KnownCharFileSet.Contains(rel_asset_path.stem().string());
                                                const bool is_custom_image_source = mod_info.IsCustomImageSource(rel_asset_path_string);
 
                                                Playlunky::Get().RegisterModType(is_character_asset ? ModType::CharacterSprite : ModType::Sprite);
@@ -560,6 +616,25 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
             }
         }
 
+        // Packs only contain runtime assets, so they skip the whole preprocessing step
+        for (const fs::path& mod_pack : mod_packs)
+        {
+            const std::string mod_name = mod_pack.stem().string();
+            if (algo::contains(mMods, &ModInfo::GetNameInternal, mod_name))
+            {
+                LogError("Mod pack {} has the same name as a mod folder, it will be ignored...", mod_pack.filename().string());
+                continue;
+            }
+
+            const auto [prio, enabled] = get_mod_prio_and_state(mod_name, mod_pack);
+            if (enabled)
+            {
+                vfs.MountPack(mod_pack.string(), prio, VfsType::User);
+            }
+
+            mMods.push_back(ModInfo{ mod_name });
+        }
+
         SetupSpecialPathes(vfs, settings);
 
         if (speedrun_mode)
@@ -580,7 +655,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
                             }
                         }
 
-                        return !algo::contains(s_SpeedrunDbFiles, relative_path);
+                        return !s_SpeedrunDbFileSet.Contains(relative_path);
                     }
                     return true;
                 });
@@ -601,7 +676,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
         LogInfo("Merging entity sheets... This includes the automatic generating of stickers...");
         if (mSpriteSheetMerger->NeedsRegeneration(db_folder))
         {
-            if (mSpriteSheetMerger->GenerateRequiredSheets(db_original_folder, db_folder, vfs))
+            if (mSpriteSheetMerger->GenerateRequiredSheets(db_original_folder, db_folder, vfs, false, &thread_pool))
             {
                 LogInfo("Successfully generated merged sheets from mods...");
             }
@@ -609,6 +684,9 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
             {
                 LogError("Failed generating merged sheets from mods...");
             }
+
+            const ImageCache& image_cache = mSpriteSheetMerger->GetImageCache();
+            LogInfo("Decoded {} images for merging sheets, {} were reused from the image cache...", image_cache.GetMisses(), image_cache.GetHits());
         }
 
         if (enable_sprite_hot_loading && mSpriteHotLoader)
@@ -647,7 +725,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
         LogInfo("Merging string mods...");
         if (string_merger.NeedsRegen() || !fs::exists(db_folder / "strings00.str"))
         {
-            if (string_merger.MergeStrings(db_original_folder, db_folder, "strings_hashes.hash", speedrun_mode, vfs))
+            if (string_merger.MergeStrings(db_original_folder, db_folder, "strings_hashes.hash", speedrun_mode, vfs, &thread_pool))
             {
                 LogInfo("Successfully generated a full string file from installed string mods...");
             }
@@ -710,7 +788,7 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
         {
             // Rewrite mod database so we don't trigger changes on files written during mod load (e.g. load_order.txt)
             ModDatabase mod_db{ db_folder, mods_root, static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Folders) };
-            mod_db.UpdateDatabase();
+            mod_db.UpdateDatabase(&thread_pool);
             mod_db.WriteDatabase();
         }
 
@@ -773,9 +851,15 @@ ModManager::ModManager(std::string_view mods_root, PlaylunkySettings& settings,
     Spelunky_RegisterGetImagePathFunc(FunctionPointer<Spelunky_GetImageFilePathFunc, struct ModManagerGetImagePath>(
         [this](const char* root_path, const char* relative_path, char* out_buffer, size_t out_buffer_size) -> bool
         {
+            // Same as the stem of the path, without allocating a path for the lookup
+            const std::string_view relative_path_view{ relative_path };
+            const std::string_view file_name = relative_path_view.substr(relative_path_view.find_last_of("/\\") + 1);
+            const std::size_t extension_pos = file_name.rfind('.');
+            const std::string_view file_stem = file_name.substr(0, extension_pos == 0 ? std::string_view::npos : extension_pos);
+
             auto dds_relative_path = std::filesystem::path(relative_path).replace_extension(".DDS");
             auto dds_relative_path_str = dds_relative_path.string();
-            if (algo::contains(s_KnownTextureFiles, dds_relative_path.stem().string()))
+            if (s_KnownTextureFileSet.Contains(file_stem))
             {
                 auto fmt_res = fmt::format_to_n(
                     out_buffer,
@@ -931,7 +1015,7 @@ void ModManager::PostGameInit(const class PlaylunkySettings& settings)
                                   }; });
 
     // Bugfixes may use scripts for some functionality
-    BugFixesInit(settings, db_folder, db_original_folder);
+    BugFixesInit(settings, mVfs, db_folder, db_original_folder);
 
     mScriptManager.CommitScripts(settings);
 
@@ -3,13 +3,14 @@
 #include "detour/imgui.h"
 #include "known_files.h"
 #include "log.h"
+#include "shader_source_merge.h"
 #include "util/algorithms.h"
+#include "util/content_hash.h"
 #include "util/file.h"
 #include "util/file_watch.h"
 #include "util/image.h"
 #include "util/on_scope_exit.h"
 #include "util/regex.h"
-#include "util/tokenize.h"
 #include "virtual_filesystem.h"
 
 #pragma comment(lib, "d3dcompiler")
@@ -17,9 +18,9 @@
 
 #include "spel2.h"
 
+#include <algorithm>
 #include <fstream>
 #include <imgui.h>
-#include <unordered_map>
 
 template<class... Ts>
 struct overloaded : Ts...
@@ -29,6 +30,49 @@ struct overloaded : Ts...
 template<class... Ts>
 overloaded(Ts...) -> overloaded<Ts...>;
 
+static constexpr std::uint64_t c_ShaderCacheVersion{ 1 };
+static constexpr std::size_t c_MaxCachedShaders{ 16 };
+
+static std::string ReadShaderFile(const std::filesystem::path& shader_path)
+{
+    if (auto shader_file = std::ifstream{ shader_path })
+    {
+        return std::string((std::istreambuf_iterator<char>(shader_file)), std::istreambuf_iterator<char>());
+    }
+    return std::string{};
+}
+
+static std::uint64_t HashShaderCode(std::string_view shader_code, std::uint64_t seed)
+{
+    return HashContent(std::span{ reinterpret_cast<const std::uint8_t*>(shader_code.data()), shader_code.size() }, seed);
+}
+
+// Keeps the most recently used merged shaders, so switching between sets of shader mods does not accumulate files forever
+static void PruneShaderCache(const std::filesystem::path& cache_folder)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<std::pair<fs::file_time_type, fs::path>> cached_shaders;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator{ cache_folder, ec })
+    {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".hlsl")
+        {
+            cached_shaders.push_back({ entry.last_write_time(ec), entry.path() });
+        }
+    }
+
+    if (cached_shaders.size() > c_MaxCachedShaders)
+    {
+        std::sort(cached_shaders.begin(), cached_shaders.end(), [](const auto& lhs, const auto& rhs)
+                  { return lhs.first > rhs.first; });
+        for (std::size_t i = c_MaxCachedShaders; i < cached_shaders.size(); i++)
+        {
+            fs::remove(cached_shaders[i].second, ec);
+        }
+    }
+}
+
 bool MergeShadersImpl(
     const std::filesystem::path& destination_folder,
     const std::filesystem::path& shader_file,
@@ -38,11 +82,7 @@ bool MergeShadersImpl(
     std::string source_shader_code = std::visit(overloaded{
                                                     [](const std::filesystem::path& source_shader_path)
                                                     {
-                                                        if (auto original_shader_file = std::ifstream{ source_shader_path })
-                                                        {
-                                                            return std::string((std::istreambuf_iterator<char>(original_shader_file)), std::istreambuf_iterator<char>());
-                                                        }
-                                                        return std::string{};
+                                                        return ReadShaderFile(source_shader_path);
                                                     },
                                                     [](std::string& source_shader_code)
                                                     {
@@ -56,374 +96,57 @@ bool MergeShadersImpl(
         return false;
     }
 
-    auto find_decl_in_original = [&source_shader_code](std::string_view decl)
-    {
-        return source_shader_code.find(decl) != std::string::npos;
-    };
-
-    struct ModdedFunction
-    {
-        std::string Preamble;
-        std::string Declaration;
-        std::string Body;
-    };
-    std::vector<ModdedFunction> modded_functions;
-
-    struct ExtendedFunction
-    {
-        std::string FunctionName;
-        std::vector<ModdedFunction> Extensions;
-    };
-    std::vector<ExtendedFunction> extended_functions;
-
+    // The merged shader only depends on the contents of the source and the mods, so it is cached under a hash of those
+    std::uint64_t merged_shader_hash = HashShaderCode(source_shader_code, c_ShaderCacheVersion);
+    std::vector<ShaderMod> shader_mod_codes;
+    shader_mod_codes.reserve(shader_mods.size());
     for (const auto& shader_mod : shader_mods)
     {
-        const std::string shader_mod_code = [&shader_mod]()
-        {
-            if (auto shader_mod_file = std::ifstream{ shader_mod })
-            {
-                return std::string((std::istreambuf_iterator<char>(shader_mod_file)), std::istreambuf_iterator<char>());
-            }
-            return std::string{};
-        }();
-
-        if (!shader_mod_code.empty())
-        {
-            auto parsing_index = size_t{ 0 };
-            auto read_char = [&shader_mod_code, &parsing_index]() -> std::optional<char>
-            {
-                if (parsing_index < shader_mod_code.size())
-                {
-                    char c = shader_mod_code[parsing_index];
-                    parsing_index++;
-                    return c;
-                }
-                return std::nullopt;
-            };
-            auto peek_char = [&shader_mod_code, &parsing_index]() -> std::optional<char>
-            {
-                if (parsing_index < shader_mod_code.size())
-                {
-                    char c = shader_mod_code[parsing_index];
-                    return c;
-                }
-                return std::nullopt;
-            };
-
-            enum class CommentState
-            {
-                None,
-                SingleLine,
-                MultiLine
-            };
-            CommentState comment_state = CommentState::None;
-
-            std::string function_preamble;
-            std::string current_line;
-            std::string function_body;
-            bool is_shader_extension{ false };
-            std::size_t scope_depth = 0;
-            while (auto c_opt = read_char())
-            {
-                char c = c_opt.value();
-
-                if (comment_state == CommentState::None && c == '/')
-                {
-                    if (peek_char().value_or('?') == '/')
-                    {
-                        read_char();
-                        comment_state = CommentState::SingleLine;
-                        continue;
-                    }
-                    else if (peek_char().value_or('?') == '*')
-                    {
-                        read_char();
-                        comment_state = CommentState::MultiLine;
-                        continue;
-                    }
-                }
-                else if (comment_state == CommentState::SingleLine)
-                {
-                    if (c == '\n')
-                    {
-                        comment_state = CommentState::None;
-                    }
-                    continue;
-                }
-                else if (comment_state == CommentState::MultiLine)
-                {
-                    if (c == '*' && peek_char().value_or('?') == '/')
-                    {
-                        read_char();
-                        comment_state = CommentState::None;
-                    }
-                    continue;
-                }
-
-                if (c == '{')
-                {
-                    if (scope_depth == 0)
-                    {
-                        function_body.clear();
-                    }
-                    scope_depth++;
-                }
-                else if (c == '}')
-                {
-                    if (scope_depth == 0)
-                    {
-                        LogError("Shader {} contains syntax errors...", shader_mod.string());
-                        break;
-                    }
-                    else
-                    {
-                        if (scope_depth == 1)
-                        {
-                            if (algo::trim(current_line).find("struct") == 0 || (!is_shader_extension && !find_decl_in_original(current_line)))
-                            {
-                                function_preamble += current_line + function_body;
-                            }
-                            else if (is_shader_extension)
-                            {
-                                function_body += '}';
-                                const auto first_space_pos = current_line.find(' ');
-                                const auto first_parens_pos = current_line.find('(');
-                                if (first_space_pos != std::string::npos && first_parens_pos != std::string::npos)
-                                {
-                                    std::string function_name = algo::trim(current_line.substr(first_space_pos, first_parens_pos - first_space_pos));
-                                    ExtendedFunction* extended_function = algo::find(extended_functions, &ExtendedFunction::FunctionName, function_name);
-                                    if (extended_function == nullptr)
-                                    {
-                                        extended_functions.push_back(ExtendedFunction{
-                                            .FunctionName{ std::move(function_name) } });
-                                        extended_function = &extended_functions.back();
-                                    }
-                                    extended_function->Extensions.push_back(ModdedFunction{
-                                        .Preamble = std::move(function_preamble),
-                                        .Declaration = std::move(current_line),
-                                        .Body = std::move(function_body) });
-                                }
-                                current_line.clear();
-                                function_body.clear();
-                                is_shader_extension = false;
-                                scope_depth--;
-                                continue;
-                            }
-                            else if (!algo::contains(modded_functions, &ModdedFunction::Declaration, current_line))
-                            {
-                                function_body += '}';
-                                modded_functions.push_back(ModdedFunction{
-                                    .Preamble = std::move(function_preamble),
-                                    .Declaration = std::move(current_line),
-                                    .Body = std::move(function_body) });
-                                scope_depth--;
-                                continue;
-                            }
-                            current_line.clear();
-                            function_body.clear();
-                            is_shader_extension = false;
-                        }
-                        scope_depth--;
-                    }
-                }
-                else if (c == '\n' && scope_depth == 0)
-                {
-                    if (current_line == "#extends")
-                    {
-                        is_shader_extension = true;
-                    }
-                    else
-                    {
-                        function_preamble += current_line + '\n';
-                        is_shader_extension = false;
-                    }
-                    current_line.clear();
-                }
-
-                if (scope_depth == 0)
-                {
-                    if (!current_line.empty() || !std::isspace(c))
-                    {
-                        current_line += c;
-                    }
-                }
-                else
-                {
-                    function_body += c;
-                }
-            }
-        }
+        std::string shader_mod_code = ReadShaderFile(shader_mod);
+        merged_shader_hash = HashShaderCode(shader_mod_code, merged_shader_hash);
+        shader_mod_codes.push_back(ShaderMod{
+            .Path{ shader_mod },
+            .Code{ std::move(shader_mod_code) } });
     }
 
-    for (const ModdedFunction& modded_function : modded_functions)
+    namespace fs = std::filesystem;
+
+    if (!fs::exists(destination_folder))
     {
-        const auto decl_pos = source_shader_code.find(modded_function.Declaration);
-        if (decl_pos != std::string::npos)
-        {
-            const auto opening_braces_pos = source_shader_code.find('{', decl_pos + modded_function.Declaration.size());
-            if (opening_braces_pos != std::string::npos)
-            {
-                const auto closing_braces = [&source_shader_code, &opening_braces_pos]() -> std::size_t
-                {
-                    std::size_t current_depth{ 0 };
-                    for (std::size_t i = opening_braces_pos; i < source_shader_code.size(); i++)
-                    {
-                        if (source_shader_code[i] == '{')
-                        {
-                            current_depth++;
-                        }
-                        else if (source_shader_code[i] == '}')
-                        {
-                            current_depth--;
-                            if (current_depth == 0)
-                            {
-                                return i;
-                            }
-                        }
-                    }
-                    return std::string::npos;
-                }();
-                if (closing_braces != std::string::npos)
-                {
-                    source_shader_code.replace(opening_braces_pos, closing_braces - opening_braces_pos + 1, modded_function.Body);
-                    source_shader_code.insert(decl_pos, modded_function.Preamble);
-                }
-            }
-        }
-        else
-        {
-            LogError("Could not place function with declaration '{}' into shaders. "
-                     "If you are just using this mod report the issue to the mods creator. "
-                     "If you developed this mod, make sure it's signature matches exactly the original function's signature...",
-                     modded_function.Declaration);
-        }
+        fs::create_directories(destination_folder);
     }
 
-    for (ExtendedFunction& extended_function : extended_functions)
+    const auto destination_file = destination_folder / shader_file;
+    const auto cache_folder = destination_folder / "ShaderCache";
+    const auto cache_file = cache_folder / fmt::format("{:016x}.hlsl", merged_shader_hash);
+
+    std::error_code ec;
+    if (fs::exists(cache_file, ec) && fs::copy_file(cache_file, destination_file, fs::copy_options::overwrite_existing, ec))
     {
-        std::reverse(extended_function.Extensions.begin(), extended_function.Extensions.end());
+        fs::last_write_time(cache_file, fs::file_time_type::clock::now(), ec);
+        return true;
     }
 
-    for (const ExtendedFunction& extended_function : extended_functions)
+    const std::string merged_shader_code = MergeShaderSource(source_shader_code, shader_mod_codes);
+    if (auto merged_shader_file = std::ofstream{ destination_file, std::ios::trunc })
     {
-        const auto name_pos = source_shader_code.find(extended_function.FunctionName);
-        if (name_pos != std::string::npos)
-        {
-            const auto opening_braces_pos = source_shader_code.find('{', name_pos + extended_function.FunctionName.size());
-            if (opening_braces_pos != std::string::npos)
-            {
-                const auto closing_braces = [&source_shader_code, &opening_braces_pos]() -> std::size_t
-                {
-                    std::size_t current_depth{ 0 };
-                    for (std::size_t i = opening_braces_pos; i < source_shader_code.size(); i++)
-                    {
-                        if (source_shader_code[i] == '{')
-                        {
-                            current_depth++;
-                        }
-                        else if (source_shader_code[i] == '}')
-                        {
-                            current_depth--;
-                            if (current_depth == 0)
-                            {
-                                return i;
-                            }
-                        }
-                    }
-                    return std::string::npos;
-                }();
-                if (closing_braces != std::string::npos)
-                {
-                    const auto newline_pos = source_shader_code.rfind('\n', name_pos);
-                    if (newline_pos != std::string::npos)
-                    {
-                        const auto space_pos = source_shader_code.find(' ', newline_pos);
-                        if (space_pos != std::string::npos)
-                        {
-                            const auto return_type = algo::trim(source_shader_code.substr(newline_pos + 1, name_pos - newline_pos - 1));
-                            const auto arg_list = [&source_shader_code, &name_pos, &opening_braces_pos]() -> std::string
-                            {
-                                const auto opening_parens = source_shader_code.find('(', name_pos);
-                                if (opening_parens != std::string::npos)
-                                {
-                                    const auto closing_parens = source_shader_code.rfind(')', opening_braces_pos);
-                                    if (closing_parens != std::string::npos)
-                                    {
-                                        const auto param_list = source_shader_code.substr(opening_parens, closing_parens - opening_parens);
-                                        std::string arg_list;
-                                        for (const auto param : Tokenize<','>(param_list))
-                                        {
-                                            const auto tokens = algo::split<' '>(param);
-                                            if (!tokens.empty())
-                                            {
-                                                arg_list += tokens.back();
-                                                arg_list += ", ";
-                                            }
-                                        }
-                                        return arg_list;
-                                    }
-                                }
-
-                                return "";
-                            }();
-
-                            std::string additional_code = fmt::format("\n\t{} return_value;", return_type);
-                            for (size_t i = 0; i < extended_function.Extensions.size(); i++)
-                            {
-                                const ModdedFunction& modded_function = extended_function.Extensions[i];
-
-                                const auto real_name = extended_function.FunctionName + "_ext" + std::to_string(i);
-                                const auto decl = std::string{ modded_function.Declaration }.replace(
-                                    modded_function.Declaration.find(extended_function.FunctionName),
-                                    extended_function.FunctionName.size(),
-                                    real_name);
-
-                                additional_code += fmt::format("\n\tif ({}({}return_value))\n\t\treturn return_value;", real_name, arg_list);
-                            }
-
-                            source_shader_code.insert(opening_braces_pos + 1, additional_code);
-                            for (size_t i = 0; i < extended_function.Extensions.size(); i++)
-                            {
-                                const ModdedFunction& modded_function = extended_function.Extensions[i];
-
-                                const auto real_name = extended_function.FunctionName + "_ext" + std::to_string(i);
-                                const auto decl = std::string{ modded_function.Declaration }.replace(
-                                    modded_function.Declaration.find(extended_function.FunctionName),
-                                    extended_function.FunctionName.size(),
-                                    real_name);
-
-                                source_shader_code.insert(newline_pos, fmt::format("{} {}\n", decl, modded_function.Body));
-                                source_shader_code.insert(newline_pos, modded_function.Preamble);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        else
-        {
-            LogError("Could not extend function with name '{}' into shaders. "
-                     "If you are just using this mod report the issue to the mods creator. "
-                     "If you developed this mod, make sure it's name matches exactly the original function's signatunamere...",
-                     extended_function.FunctionName);
-        }
+        merged_shader_file.write(merged_shader_code.data(), merged_shader_code.size());
     }
-
-    namespace fs = std::filesystem;
-
-    if (!fs::exists(destination_folder))
+    else
     {
-        fs::create_directories(destination_folder);
+        return false;
     }
 
-    const auto destination_file = destination_folder / shader_file;
-    if (auto merged_shader_file = std::ofstream{ destination_file, std::ios::trunc })
+    if (fs::create_directories(cache_folder, ec); !ec)
     {
-        merged_shader_file.write(source_shader_code.data(), source_shader_code.size());
-        return true;
+        if (auto cached_shader_file = std::ofstream{ cache_file, std::ios::trunc })
+        {
+            cached_shader_file.write(merged_shader_code.data(), merged_shader_code.size());
+        }
+        PruneShaderCache(cache_folder);
     }
 
-    return false;
+    return true;
 }
 
 bool MergeShaders(
@@ -433,14 +156,7 @@ bool MergeShaders(
     VirtualFilesystem& vfs)
 {
     const auto source_shader = vfs.GetFilePath(shader_file).value_or(source_folder / shader_file);
-    std::string source_shader_code = [&source_shader]()
-    {
-        if (auto original_shader_file = std::ifstream{ source_shader })
-        {
-            return std::string((std::istreambuf_iterator<char>(original_shader_file)), std::istreambuf_iterator<char>());
-        }
-        return std::string{};
-    }();
+    std::string source_shader_code = ReadShaderFile(source_shader);
 
     if (source_shader_code.empty())
     {
@@ -464,6 +180,8 @@ struct FileWatchInfo
 };
 std::vector<FileWatchInfo> g_CallbackFiles;
 std::function<bool(const std::filesystem::path&, const std::vector<std::filesystem::path>&)> g_ReloadCallback;
+// Hash of the merged shader the game is currently using, edits that don't change the merged shader don't need recompiling
+std::optional<std::uint64_t> g_CompiledShaderHash;
 
 void SetupShaderHotReload(
     const std::filesystem::path& source_folder,
@@ -478,6 +196,7 @@ void SetupShaderHotReload(
     g_ReloadTimer = 0;
     g_ReloadTimerSignal.store(0, std::memory_order_relaxed);
     g_ReloadCallback = std::bind_front(MergeShadersImpl, destination_folder, shader_file);
+    g_CompiledShaderHash = HashFileContent(destination_folder / shader_file);
     g_CallbackFiles.clear();
 
     if (modded_source_shader.has_value())
@@ -508,49 +227,57 @@ void UpdateShaderHotReload(
         if (g_ReloadCallback(source_shader, shader_mods))
         {
             const auto shader_code{ ReadWholeFile(vfs.GetFilePath(shader_file, VfsType::Backend).value().string().c_str()) };
-
-            ID3DBlob* shader_out;
-            ID3DBlob* errors_out;
-
-            const auto d3d_compile_shader = [&](std::string_view entry_point, const char* target)
+            const auto shader_code_hash = HashShaderCode(shader_code, 0);
+            if (g_CompiledShaderHash == shader_code_hash)
             {
-                char name[128]{};
-                fmt::format_to(name, "{}", entry_point);
-                return D3DCompile(shader_code.c_str(), shader_code.size(), nullptr, nullptr, nullptr, name, target, 0x800, 0x0, &shader_out, &errors_out) == S_OK;
-            };
-            const auto post_compile = [&]()
+                LogInfo("Merged shaders did not change, skipping shader reload...");
+            }
+            else
             {
-                if (shader_out)
+                ID3DBlob* shader_out;
+                ID3DBlob* errors_out;
+
+                const auto d3d_compile_shader = [&](std::string_view entry_point, const char* target)
                 {
-                    shader_out->Release();
-                }
-                if (errors_out)
+                    char name[128]{};
+                    fmt::format_to(name, "{}", entry_point);
+                    return D3DCompile(shader_code.c_str(), shader_code.size(), nullptr, nullptr, nullptr, name, target, 0x800, 0x0, &shader_out, &errors_out) == S_OK;
+                };
+                const auto post_compile = [&]()
                 {
-                    errors_out->Release();
-                }
-            };
+                    if (shader_out)
+                    {
+                        shader_out->Release();
+                    }
+                    if (errors_out)
+                    {
+                        errors_out->Release();
+                    }
+                };
 
-            for (const auto vertex_shader : s_VertexShaders)
-            {
-                OnScopeExit cleanup{ post_compile };
-                if (!d3d_compile_shader(vertex_shader, "vs_4_0"))
+                for (const auto vertex_shader : s_VertexShaders)
                 {
-                    LogError("Failed compiling shader: {}", (const char*)errors_out->GetBufferPointer());
-                    return;
+                    OnScopeExit cleanup{ post_compile };
+                    if (!d3d_compile_shader(vertex_shader, "vs_4_0"))
+                    {
+                        LogError("Failed compiling shader: {}", (const char*)errors_out->GetBufferPointer());
+                        return;
+                    }
                 }
-            }
 
-            for (const auto pixel_shader : s_PixelShaders)
-            {
-                OnScopeExit cleanup{ post_compile };
-                if (!d3d_compile_shader(pixel_shader, "ps_4_0"))
+                for (const auto pixel_shader : s_PixelShaders)
                 {
-                    LogError("Failed compiling shader: {}", (const char*)errors_out->GetBufferPointer());
-                    return;
+                    OnScopeExit cleanup{ post_compile };
+                    if (!d3d_compile_shader(pixel_shader, "ps_4_0"))
+                    {
+                        LogError("Failed compiling shader: {}", (const char*)errors_out->GetBufferPointer());
+                        return;
+                    }
                 }
-            }
 
-            Spelunky_ReloadShaders();
+                g_CompiledShaderHash = shader_code_hash;
+                Spelunky_ReloadShaders();
+            }
         }
 
         auto files = std::move(shader_mods);
@@ -0,0 +1,500 @@
+#include "shader_source_merge.h"
+
+#include "log.h"
+#include "util/algorithms.h"
+#include "util/tokenize.h"
+
+#include <algorithm>
+#include <cctype>
+
+ShaderFunctionIndex::ShaderFunctionIndex(std::string_view source)
+    : m_Source{ source }
+{
+    std::size_t block_begin{ 0 };
+    std::size_t opening_brace{ 0 };
+    std::size_t scope_depth{ 0 };
+    for (std::size_t i = 0; i < source.size(); i++)
+    {
+        if (source[i] == '{')
+        {
+            if (scope_depth == 0)
+            {
+                opening_brace = i;
+            }
+            scope_depth++;
+        }
+        else if (source[i] == '}' && scope_depth > 0)
+        {
+            scope_depth--;
+            if (scope_depth == 0)
+            {
+                m_Blocks.push_back(Block{
+                    .Begin{ block_begin },
+                    .OpeningBrace{ opening_brace },
+                    .ClosingBrace{ i } });
+                block_begin = i + 1;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < m_Blocks.size(); i++)
+    {
+        const Block& block = m_Blocks[i];
+        const std::string_view header = source.substr(block.Begin, block.OpeningBrace - block.Begin);
+        const std::size_t last_newline_pos = header.rfind('\n');
+        const std::size_t line_begin = last_newline_pos == std::string_view::npos ? 0 : last_newline_pos + 1;
+        const std::string_view declaration = algo::trim(header.substr(line_begin));
+        if (declaration.empty())
+        {
+            continue;
+        }
+
+        const std::size_t declaration_pos = declaration.data() - source.data();
+        m_Declarations.try_emplace(declaration, Match{ i, declaration_pos });
+
+        const auto first_space_pos = declaration.find(' ');
+        const auto first_parens_pos = declaration.find('(');
+        if (first_space_pos != std::string_view::npos && first_parens_pos != std::string_view::npos && first_space_pos < first_parens_pos)
+        {
+            const std::string_view function_name = algo::trim(declaration.substr(first_space_pos, first_parens_pos - first_space_pos));
+            if (!function_name.empty())
+            {
+                const std::size_t function_name_pos = function_name.data() - source.data();
+                m_Functions.try_emplace(function_name, Match{ i, function_name_pos });
+            }
+        }
+    }
+}
+
+std::optional<ShaderFunctionIndex::Match> ShaderFunctionIndex::FindDeclaration(std::string_view declaration) const
+{
+    if (auto it = m_Declarations.find(algo::trim(declaration)); it != m_Declarations.end())
+    {
+        return it->second;
+    }
+    return FindInHeaders(declaration);
+}
+
+std::optional<ShaderFunctionIndex::Match> ShaderFunctionIndex::FindFunction(std::string_view function_name) const
+{
+    if (auto it = m_Functions.find(function_name); it != m_Functions.end())
+    {
+        return it->second;
+    }
+    return FindInHeaders(function_name);
+}
+
+std::optional<ShaderFunctionIndex::Match> ShaderFunctionIndex::FindInHeaders(std::string_view text) const
+{
+    for (std::size_t i = 0; i < m_Blocks.size(); i++)
+    {
+        const Block& block = m_Blocks[i];
+        const std::string_view header = m_Source.substr(block.Begin, block.OpeningBrace - block.Begin);
+        if (const auto pos = header.find(text); pos != std::string_view::npos)
+        {
+            return Match{ i, block.Begin + pos };
+        }
+    }
+    return std::nullopt;
+}
+
+struct ModdedFunction
+{
+    std::string Preamble;
+    std::string Declaration;
+    std::string Body;
+};
+struct ExtendedFunction
+{
+    std::string FunctionName;
+    std::vector<ModdedFunction> Extensions;
+};
+
+static void ParseShaderMod(
+    const ShaderMod& shader_mod,
+    const ShaderFunctionIndex& source_index,
+    std::vector<ModdedFunction>& modded_functions,
+    std::vector<ExtendedFunction>& extended_functions)
+{
+    const std::string& shader_mod_code = shader_mod.Code;
+
+    auto parsing_index = size_t{ 0 };
+    auto read_char = [&shader_mod_code, &parsing_index]() -> std::optional<char>
+    {
+        if (parsing_index < shader_mod_code.size())
+        {
+            char c = shader_mod_code[parsing_index];
+            parsing_index++;
+            return c;
+        }
+        return std::nullopt;
+    };
+    auto peek_char = [&shader_mod_code, &parsing_index]() -> std::optional<char>
+    {
+        if (parsing_index < shader_mod_code.size())
+        {
+            char c = shader_mod_code[parsing_index];
+            return c;
+        }
+        return std::nullopt;
+    };
+
+    enum class CommentState
+    {
+        None,
+        SingleLine,
+        MultiLine
+    };
+    CommentState comment_state = CommentState::None;
+
+    std::string function_preamble;
+    std::string current_line;
+    std::string function_body;
+    bool is_shader_extension{ false };
+    std::size_t scope_depth = 0;
+    while (auto c_opt = read_char())
+    {
+        char c = c_opt.value();
+
+        if (comment_state == CommentState::None && c == '/')
+        {
+            if (peek_char().value_or('?') == '/')
+            {
+                read_char();
+                comment_state = CommentState::SingleLine;
+                continue;
+            }
+            else if (peek_char().value_or('?') == '*')
+            {
+                read_char();
+                comment_state = CommentState::MultiLine;
+                continue;
+            }
+        }
+        else if (comment_state == CommentState::SingleLine)
+        {
+            if (c == '\n')
+            {
+                comment_state = CommentState::None;
+            }
+            continue;
+        }
+        else if (comment_state == CommentState::MultiLine)
+        {
+            if (c == '*' && peek_char().value_or('?') == '/')
+            {
+                read_char();
+                comment_state = CommentState::None;
+            }
+            continue;
+        }
+
+        if (c == '{')
+        {
+            if (scope_depth == 0)
+            {
+                function_body.clear();
+            }
+            scope_depth++;
+        }
+        else if (c == '}')
+        {
+            if (scope_depth == 0)
+            {
+                LogError("Shader {} contains syntax errors...", shader_mod.Path.string());
+                break;
+            }
+            else
+            {
+                if (scope_depth == 1)
+                {
+                    if (algo::trim(current_line).find("struct") == 0 || (!is_shader_extension && !source_index.FindDeclaration(current_line).has_value()))
+                    {
+                        function_preamble += current_line + function_body;
+                    }
+                    else if (is_shader_extension)
+                    {
+                        function_body += '}';
+                        const auto first_space_pos = current_line.find(' ');
+                        const auto first_parens_pos = current_line.find('(');
+                        if (first_space_pos != std::string::npos && first_parens_pos != std::string::npos)
+                        {
+                            std::string function_name = algo::trim(current_line.substr(first_space_pos, first_parens_pos - first_space_pos));
+                            ExtendedFunction* extended_function = algo::find(extended_functions, &ExtendedFunction::FunctionName, function_name);
+                            if (extended_function == nullptr)
+                            {
+                                extended_functions.push_back(ExtendedFunction{
+                                    .FunctionName{ std::move(function_name) } });
+                                extended_function = &extended_functions.back();
+                            }
+                            extended_function->Extensions.push_back(ModdedFunction{
+                                .Preamble = std::move(function_preamble),
+                                .Declaration = std::move(current_line),
+                                .Body = std::move(function_body) });
+                        }
+                        current_line.clear();
+                        function_body.clear();
+                        is_shader_extension = false;
+                        scope_depth--;
+                        continue;
+                    }
+                    else if (!algo::contains(modded_functions, &ModdedFunction::Declaration, current_line))
+                    {
+                        function_body += '}';
+                        modded_functions.push_back(ModdedFunction{
+                            .Preamble = std::move(function_preamble),
+                            .Declaration = std::move(current_line),
+                            .Body = std::move(function_body) });
+                        scope_depth--;
+                        continue;
+                    }
+                    current_line.clear();
+                    function_body.clear();
+                    is_shader_extension = false;
+                }
+                scope_depth--;
+            }
+        }
+        else if (c == '\n' && scope_depth == 0)
+        {
+            if (current_line == "#extends")
+            {
+                is_shader_extension = true;
+            }
+            else
+            {
+                function_preamble += current_line + '\n';
+                is_shader_extension = false;
+            }
+            current_line.clear();
+        }
+
+        if (scope_depth == 0)
+        {
+            if (!current_line.empty() || !std::isspace(c))
+            {
+                current_line += c;
+            }
+        }
+        else
+        {
+            function_body += c;
+        }
+    }
+}
+
+static std::size_t FindClosingBraces(std::string_view code, std::size_t opening_braces_pos)
+{
+    std::size_t current_depth{ 0 };
+    for (std::size_t i = opening_braces_pos; i < code.size(); i++)
+    {
+        if (code[i] == '{')
+        {
+            current_depth++;
+        }
+        else if (code[i] == '}')
+        {
+            current_depth--;
+            if (current_depth == 0)
+            {
+                return i;
+            }
+        }
+    }
+    return std::string::npos;
+}
+
+static bool ReplaceFunction(std::string& block_code, std::size_t decl_pos, const ModdedFunction& modded_function)
+{
+    const auto opening_braces_pos = block_code.find('{', decl_pos);
+    if (opening_braces_pos != std::string::npos)
+    {
+        const auto closing_braces = FindClosingBraces(block_code, opening_braces_pos);
+        if (closing_braces != std::string::npos)
+        {
+            block_code.replace(opening_braces_pos, closing_braces - opening_braces_pos + 1, modded_function.Body);
+            block_code.insert(decl_pos, modded_function.Preamble);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void ExtendFunction(std::string& block_code, std::size_t name_pos, const ExtendedFunction& extended_function)
+{
+    const auto opening_braces_pos = block_code.find('{', name_pos + extended_function.FunctionName.size());
+    if (opening_braces_pos == std::string::npos || FindClosingBraces(block_code, opening_braces_pos) == std::string::npos)
+    {
+        return;
+    }
+
+    const auto newline_pos = block_code.rfind('\n', name_pos);
+    if (newline_pos == std::string::npos)
+    {
+        return;
+    }
+
+    const auto return_type = algo::trim(block_code.substr(newline_pos + 1, name_pos - newline_pos - 1));
+    const auto arg_list = [&block_code, &name_pos, &opening_braces_pos]() -> std::string
+    {
+        const auto opening_parens = block_code.find('(', name_pos);
+        if (opening_parens != std::string::npos)
+        {
+            const auto closing_parens = block_code.rfind(')', opening_braces_pos);
+            if (closing_parens != std::string::npos)
+            {
+                const auto param_list = block_code.substr(opening_parens, closing_parens - opening_parens);
+                std::string arg_list;
+                for (const auto param : Tokenize<','>(param_list))
+                {
+                    const auto tokens = algo::split<' '>(param);
+                    if (!tokens.empty())
+                    {
+                        arg_list += tokens.back();
+                        arg_list += ", ";
+                    }
+                }
+                return arg_list;
+            }
+        }
+
+        return "";
+    }();
+
+    const auto get_extension_name = [&extended_function](std::size_t i)
+    {
+        return extended_function.FunctionName + "_ext" + std::to_string(i);
+    };
+
+    std::string additional_code = fmt::format("\n\t{} return_value;", return_type);
+    for (size_t i = 0; i < extended_function.Extensions.size(); i++)
+    {
+        additional_code += fmt::format("\n\tif ({}({}return_value))\n\t\treturn return_value;", get_extension_name(i), arg_list);
+    }
+    block_code.insert(opening_braces_pos + 1, additional_code);
+
+    // Each extension goes in front of the previous one
+    std::string extensions_code;
+    for (size_t i = extended_function.Extensions.size(); i-- > 0;)
+    {
+        const ModdedFunction& modded_function = extended_function.Extensions[i];
+
+        const auto decl = std::string{ modded_function.Declaration }.replace(
+            modded_function.Declaration.find(extended_function.FunctionName),
+            extended_function.FunctionName.size(),
+            get_extension_name(i));
+
+        extensions_code += modded_function.Preamble;
+        extensions_code += fmt::format("{} {}\n", decl, modded_function.Body);
+    }
+    block_code.insert(newline_pos, extensions_code);
+}
+
+std::string MergeShaderSource(std::string_view source_shader_code, std::span<const ShaderMod> shader_mods)
+{
+    const ShaderFunctionIndex source_index{ source_shader_code };
+
+    std::vector<ModdedFunction> modded_functions;
+    std::vector<ExtendedFunction> extended_functions;
+    for (const ShaderMod& shader_mod : shader_mods)
+    {
+        if (!shader_mod.Code.empty())
+        {
+            ParseShaderMod(shader_mod, source_index, modded_functions, extended_functions);
+        }
+    }
+
+    for (ExtendedFunction& extended_function : extended_functions)
+    {
+        std::reverse(extended_function.Extensions.begin(), extended_function.Extensions.end());
+    }
+
+    // All edits are collected per block of the source first, so that each block is copied and edited only once
+    struct BlockEdits
+    {
+        std::vector<std::pair<std::size_t, const ModdedFunction*>> Replacements;
+        std::vector<std::pair<std::size_t, const ExtendedFunction*>> Extensions;
+    };
+    const auto blocks = source_index.GetBlocks();
+    std::vector<BlockEdits> block_edits(blocks.size());
+
+    for (const ModdedFunction& modded_function : modded_functions)
+    {
+        if (const auto match = source_index.FindDeclaration(modded_function.Declaration))
+        {
+            block_edits[match->BlockIndex].Replacements.push_back({ match->Position, &modded_function });
+        }
+        else
+        {
+            LogError("Could not place function with declaration '{}' into shaders. "
+                     "If you are just using this mod report the issue to the mods creator. "
+                     "If you developed this mod, make sure it's signature matches exactly the original function's signature...",
+                     modded_function.Declaration);
+        }
+    }
+
+    for (const ExtendedFunction& extended_function : extended_functions)
+    {
+        if (const auto match = source_index.FindFunction(extended_function.FunctionName))
+        {
+            block_edits[match->BlockIndex].Extensions.push_back({ match->Position, &extended_function });
+        }
+        else
+        {
+            LogError("Could not extend function with name '{}' into shaders. "
+                     "If you are just using this mod report the issue to the mods creator. "
+                     "If you developed this mod, make sure it's name matches exactly the original function's signatunamere...",
+                     extended_function.FunctionName);
+        }
+    }
+
+    std::string merged_shader_code;
+    merged_shader_code.reserve(source_shader_code.size());
+
+    std::size_t source_pos{ 0 };
+    for (std::size_t i = 0; i < blocks.size(); i++)
+    {
+        const BlockEdits& edits = block_edits[i];
+        if (edits.Replacements.empty() && edits.Extensions.empty())
+        {
+            continue;
+        }
+
+        const ShaderFunctionIndex::Block& block = blocks[i];
+        std::string block_code{ source_shader_code.substr(block.Begin, block.ClosingBrace + 1 - block.Begin) };
+
+        // Preambles are inserted into the header, so positions in the header past them have to be shifted
+        std::vector<std::pair<std::size_t, std::size_t>> inserted_preambles;
+        const auto get_block_pos = [&](std::size_t pos_in_source)
+        {
+            std::size_t block_pos = pos_in_source - block.Begin;
+            for (const auto& [insert_pos, insert_size] : inserted_preambles)
+            {
+                if (insert_pos <= pos_in_source)
+                {
+                    block_pos += insert_size;
+                }
+            }
+            return block_pos;
+        };
+
+        for (const auto& [decl_pos, modded_function] : edits.Replacements)
+        {
+            if (ReplaceFunction(block_code, get_block_pos(decl_pos), *modded_function))
+            {
+                inserted_preambles.push_back({ decl_pos, modded_function->Preamble.size() });
+            }
+        }
+        for (const auto& [name_pos, extended_function] : edits.Extensions)
+        {
+            ExtendFunction(block_code, get_block_pos(name_pos), *extended_function);
+        }
+
+        merged_shader_code += source_shader_code.substr(source_pos, block.Begin - source_pos);
+        merged_shader_code += block_code;
+        source_pos = block.ClosingBrace + 1;
+    }
+    merged_shader_code += source_shader_code.substr(source_pos);
+
+    return merged_shader_code;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Index of the top-level blocks of a shader, i.e. functions, structs and cbuffers, built in a single pass over the source
+// The source has to outlive the index
+class ShaderFunctionIndex
+{
+  public:
+    struct Block
+    {
+        std::size_t Begin; // One past the closing brace of the previous block, so everything up to the opening brace is the block's header
+        std::size_t OpeningBrace;
+        std::size_t ClosingBrace;
+    };
+    struct Match
+    {
+        std::size_t BlockIndex;
+        std::size_t Position; // Position of the match in the source
+    };
+
+    explicit ShaderFunctionIndex(std::string_view source);
+    ShaderFunctionIndex(const ShaderFunctionIndex&) = delete;
+    ShaderFunctionIndex(ShaderFunctionIndex&&) = default;
+    ShaderFunctionIndex& operator=(const ShaderFunctionIndex&) = delete;
+    ShaderFunctionIndex& operator=(ShaderFunctionIndex&&) = default;
+    ~ShaderFunctionIndex() = default;
+
+    // Finds the block declared by the declaration, falls back to the first block whose header contains the declaration
+    std::optional<Match> FindDeclaration(std::string_view declaration) const;
+    // Finds the function with the given name, falls back to the first block whose header contains the name
+    std::optional<Match> FindFunction(std::string_view function_name) const;
+
+    std::span<const Block> GetBlocks() const
+    {
+        return m_Blocks;
+    }
+
+  private:
+    std::optional<Match> FindInHeaders(std::string_view text) const;
+
+    std::string_view m_Source;
+    std::vector<Block> m_Blocks;
+
+    // Keyed by the trimmed line that opens a block and by the name of the function declared on that line
+    std::unordered_map<std::string_view, Match> m_Declarations;
+    std::unordered_map<std::string_view, Match> m_Functions;
+};
+
+struct ShaderMod
+{
+    std::filesystem::path Path;
+    std::string Code;
+};
+
+// Replaces and extends functions of the source shader with the functions of all shader mods, mods are applied in order
+// Every block of the source is copied once, so the merge is linear in the size of the source and the mods
+std::string MergeShaderSource(std::string_view source_shader_code, std::span<const ShaderMod> shader_mods);
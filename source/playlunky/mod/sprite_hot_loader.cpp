@@ -7,6 +7,7 @@
 #include "sprite_sheet_merger.h"
 #include "util/algorithms.h"
 #include "util/on_scope_exit.h"
+#include "virtual_filesystem.h"
 
 #include <spel2.h>
 
@@ -61,9 +62,9 @@ void SpriteHotLoader::Update(const std::filesystem::path& source_folder, const s
         const std::size_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
         if (now - m_ReloadTimestamp > m_ReloadDelay)
         {
-            algo::erase_if(m_PendingReloads, [this](auto& pending_reload)
+            algo::erase_if(m_PendingReloads, [this, &vfs](auto& pending_reload)
                            {
-                               pending_reload.has_warned = !PrepareHotLoad(pending_reload.sheet->full_path, pending_reload.sheet->db_destination, !pending_reload.has_warned);
+                               pending_reload.has_warned = !PrepareHotLoad(pending_reload.sheet->full_path, pending_reload.sheet->db_destination, !pending_reload.has_warned, vfs);
                                return !pending_reload.has_warned; });
             if (m_HasPendingReloads && m_PendingReloads.empty())
             {
@@ -74,7 +75,7 @@ void SpriteHotLoader::Update(const std::filesystem::path& source_folder, const s
     }
 }
 
-bool SpriteHotLoader::PrepareHotLoad(const std::filesystem::path& full_path, const std::filesystem::path& db_destination, bool emit_info)
+bool SpriteHotLoader::PrepareHotLoad(const std::filesystem::path& full_path, const std::filesystem::path& db_destination, bool emit_info, VirtualFilesystem& vfs)
 {
     if (emit_info)
     {
@@ -82,26 +83,28 @@ bool SpriteHotLoader::PrepareHotLoad(const std::filesystem::path& full_path, con
     }
 
     // Try to load image, might not be written correctly yet  :/
+    // The decoded image stays cached, so the merger does not have to decode it again
+    ImageCache& image_cache = m_Merger.GetImageCache();
+    const std::shared_ptr<const Image> image = image_cache.GetImage(full_path);
+    if (image->IsEmpty())
     {
-        Image test_image{};
-        test_image.Load(full_path);
-        if (test_image.IsEmpty())
-        {
-            if (emit_info)
-            {
-                LogInfo("File is not full written yet, trying periodically to reload...");
-            }
+        image_cache.Invalidate(full_path);
 
-            const std::size_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-            m_ReloadTimestamp = now - 100;
-            return false;
+        if (emit_info)
+        {
+            LogInfo("File is not full written yet, trying periodically to reload...");
         }
+
+        const std::size_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        m_ReloadTimestamp = now - 100;
+        return false;
     }
 
-    if (!ConvertImageToDds(full_path, db_destination))
+    if (!ConvertRBGAToDds(image->GetData(), image->GetWidth(), image->GetHeight(), db_destination))
     {
         return false;
     }
+    vfs.RegisterNewFile(db_destination);
 
     const std::filesystem::path path = [&]()
     {
@@ -136,7 +139,7 @@ bool SpriteHotLoader::PrepareHotLoad(const std::filesystem::path& full_path, con
 
     m_Merger.RegisterSheet(path, true, false);
 
-    if (algo::contains(s_KnownTextureFiles, std::filesystem::path{ path }.replace_extension("").filename().string()))
+    if (s_KnownTextureFileSet.Contains(std::filesystem::path{ path }.replace_extension("").filename().string()))
     {
         std::string dds_path = std::filesystem::path{ path }.replace_extension(".DDS").string();
         std::replace(dds_path.begin(), dds_path.end(), '\\', '/');
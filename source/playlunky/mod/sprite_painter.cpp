@@ -120,7 +120,7 @@ void SpritePainter::RegisterSheet(std::filesystem::path full_path, std::filesyst
     if (outdated || deleted)
     {
         const auto [real_path, real_db_destination] = ConvertToRealFilePair(full_path, db_destination);
-        if (algo::contains(s_KnownTextureFiles, std::filesystem::path{ real_path }.replace_extension("").filename().string()))
+        if (s_KnownTextureFileSet.Contains(std::filesystem::path{ real_path }.replace_extension("").filename().string()))
         {
             const auto dds_db_destination = std::filesystem::path{ real_db_destination }.replace_extension(".DDS");
             std::filesystem::remove(dds_db_destination);
@@ -151,7 +151,7 @@ void SpritePainter::RegisterSheet(std::filesystem::path full_path, std::filesyst
     if (!deleted)
     {
         const auto [real_path, real_db_destination] = ConvertToRealFilePair(full_path, db_destination);
-        if (algo::contains(s_KnownTextureFiles, std::filesystem::path{ real_path }.replace_extension("").filename().string()))
+        if (s_KnownTextureFileSet.Contains(std::filesystem::path{ real_path }.replace_extension("").filename().string()))
         {
             const auto target_sheet_dds = std::filesystem::path{ real_path }.replace_extension(".DDS");
             ExtractGameAssets(std::array{ target_sheet_dds }, m_OriginalDataFolder);
@@ -520,14 +520,13 @@ void SpritePainter::SetupSheet(RegisteredColorModSheet& sheet)
     const auto [real_path, real_db_destination] = ConvertToRealFilePair(sheet.full_path, sheet.db_destination);
     if (const auto source_path = GetSourcePath(real_path))
     {
-        sheet.source_image.Load(source_path.value());
+        sheet.source_image = m_Merger.GetImageCache().GetImage(source_path.value())->Clone();
 
         {
             const auto luminance_image_path = ReplaceColExtension(sheet.full_path, "_lumin");
             if (std::filesystem::exists(luminance_image_path))
             {
-                Image luminance_mod_image;
-                luminance_mod_image.Load(luminance_image_path);
+                Image luminance_mod_image = m_Merger.GetImageCache().GetImage(luminance_image_path)->Clone();
                 sheet.source_image = LuminanceBlend(std::move(luminance_mod_image), std::move(sheet.source_image));
             }
         }
@@ -801,19 +800,19 @@ bool SpritePainter::RepaintImage(const std::filesystem::path& full_path, const s
 
     if (const auto source_path = GetSourcePath(real_path))
     {
-        Image repainted_image;
-        repainted_image.Load(source_path.value());
+        ImageCache& image_cache = m_Merger.GetImageCache();
+        Image repainted_image = image_cache.GetImage(source_path.value())->Clone();
 
         Image color_mod_image;
         bool do_luminance_scale = false;
         if (std::filesystem::exists(db_destination))
         {
-            color_mod_image.Load(db_destination);
+            color_mod_image = image_cache.GetImage(db_destination)->Clone();
             do_luminance_scale = true;
         }
         else
         {
-            color_mod_image.Load(full_path);
+            color_mod_image = image_cache.GetImage(full_path)->Clone();
         }
 
         repainted_image = ColorBlend(color_mod_image.Copy(), std::move(repainted_image));
@@ -821,8 +820,7 @@ bool SpritePainter::RepaintImage(const std::filesystem::path& full_path, const s
         const auto luminance_image_path = ReplaceColExtension(full_path, "_lumin");
         if (std::filesystem::exists(luminance_image_path))
         {
-            Image luminance_mod_image;
-            luminance_mod_image.Load(luminance_image_path);
+            Image luminance_mod_image = image_cache.GetImage(luminance_image_path)->Clone();
             repainted_image = LuminanceBlend(std::move(luminance_mod_image), std::move(repainted_image));
         }
 
@@ -831,16 +829,18 @@ bool SpritePainter::RepaintImage(const std::filesystem::path& full_path, const s
             repainted_image = LuminanceScale(color_mod_image.Copy(), std::move(repainted_image));
         }
 
-        if (algo::contains(s_KnownTextureFiles, std::filesystem::path{ real_path }.replace_extension("").filename().string()))
+        if (s_KnownTextureFileSet.Contains(std::filesystem::path{ real_path }.replace_extension("").filename().string()))
         {
             // Save to .DDS
             const auto dds_db_destination = std::filesystem::path{ real_db_destination }.replace_extension(".DDS");
             ConvertRBGAToDds(repainted_image.GetData(), repainted_image.GetWidth(), repainted_image.GetHeight(), dds_db_destination);
+            m_Vfs.RegisterNewFile(dds_db_destination);
         }
         else
         {
             // Save to .png (or possibly other source format, should work too)
             repainted_image.Write(real_db_destination);
+            m_Vfs.RegisterNewFile(real_db_destination);
         }
     }
 
@@ -852,7 +852,7 @@ bool SpritePainter::ReloadSheet(const std::filesystem::path& full_path, const st
 
     const auto [real_path, real_db_destination] = ConvertToRealFilePair(full_path, db_destination);
 
-    if (algo::contains(s_KnownTextureFiles, std::filesystem::path{ real_path }.replace_extension("").filename().string()))
+    if (s_KnownTextureFileSet.Contains(std::filesystem::path{ real_path }.replace_extension("").filename().string()))
     {
         // Make game reload directly
         std::string dds_path = std::filesystem::path{ real_path }.replace_extension(".DDS").string();
@@ -908,7 +908,7 @@ SpritePainter::FilePair SpritePainter::ConvertToRealFilePair(const std::filesyst
 std::optional<std::filesystem::path> SpritePainter::GetSourcePath(const std::filesystem::path& relative_path)
 {
     std::optional<std::filesystem::path> vfs_path = m_Vfs.GetFilePathFilterExt(relative_path, Image::AllowedExtensions, VfsType::User);
-    if (!vfs_path && algo::contains(s_KnownTextureFiles, std::filesystem::path{ relative_path }.replace_extension("").filename().string()))
+    if (!vfs_path && s_KnownTextureFileSet.Contains(std::filesystem::path{ relative_path }.replace_extension("").filename().string()))
     {
         vfs_path = m_OriginalDataFolder / relative_path;
         if (!std::filesystem::exists(vfs_path.value()))
@@ -8,6 +8,7 @@
 #include "util/algorithms.h"
 #include "util/format.h"
 #include "util/on_scope_exit.h"
+#include "util/thread_pool.h"
 #include "virtual_filesystem.h"
 
 #include <spel2.h>
@@ -27,6 +28,7 @@ SpriteSheetMerger::SpriteSheetMerger(const PlaylunkySettings& settings)
     , mGenerateCharacterJournalStickersEnabled{ settings.GetBool("sprite_settings", "generate_character_journal_stickers", true) }
     , mGenerateCharacterJournalEntriesEnabled{ settings.GetBool("sprite_settings", "generate_character_journal_entries", true) }
     , mGenerateStickerPixelArtEnabled{ settings.GetBool("sprite_settings", "generate_sticker_pixel_art", true) }
+    , m_ImageCache{ static_cast<std::size_t>(std::max(settings.GetInt("sprite_settings", "image_cache_size", 512), 0)) * 1024 * 1024 }
 {
 }
 SpriteSheetMerger::~SpriteSheetMerger() = default;
@@ -95,19 +97,6 @@ void SpriteSheetMerger::RegisterCustomImages(std::string_view mod_name, std::spa
 {
     namespace fs = std::filesystem;
 
-    auto get_image = [this](const fs::path& image_path) -> Image&
-    {
-        if (auto* image = algo::find_if(m_CachedImages,
-                                        [&image_path](const LoadedImage& image)
-                                        { return algo::is_same_path(image.ImagePath, image_path); }))
-        {
-            return *image->ImageFile;
-        }
-        m_CachedImages.push_back({ image_path, std::make_unique<Image>() });
-        m_CachedImages.back().ImageFile->Load(image_path);
-        return *m_CachedImages.back().ImageFile;
-    };
-
     for (const auto& [relative_path, custom_image] : custom_images)
     {
         const auto absolute_path = [&]() -> std::optional<fs::path>
@@ -128,7 +117,7 @@ void SpriteSheetMerger::RegisterCustomImages(std::string_view mod_name, std::spa
             continue;
         }
 
-        const Image& source_image = get_image(absolute_path.value());
+        const std::shared_ptr<const Image> source_image = m_ImageCache.GetImage(absolute_path.value());
 
         for (const auto& [target_sheet, custom_image_map] : custom_image.ImageMap)
         {
@@ -142,7 +131,7 @@ void SpriteSheetMerger::RegisterCustomImages(std::string_view mod_name, std::spa
                     SourceSheet{
                         .Path{ relative_path },
                         .LoadPaths{ load_paths.begin(), load_paths.end() },
-                        .Size{ .Width{ source_image.GetWidth() }, .Height{ source_image.GetHeight() } },
+                        .Size{ .Width{ source_image->GetWidth() }, .Height{ source_image->GetHeight() } },
                         .TileMap{ custom_image_map } });
                 existing_target_sheet->ForceRegen = existing_target_sheet->ForceRegen || custom_image.Outdated;
             }
@@ -152,20 +141,20 @@ void SpriteSheetMerger::RegisterCustomImages(std::string_view mod_name, std::spa
                 if (ExtractGameAssets(std::array{ target_sheet_dds }, original_data_folder))
                 {
                     const auto target_file_path = original_data_folder / fs::path{ target_sheet_no_ext }.replace_extension(".png");
-                    const Image& target_image = get_image(target_file_path);
+                    const std::shared_ptr<const Image> target_image = m_ImageCache.GetImage(target_file_path);
 
                     auto source_sheets = std::vector<SourceSheet>{
                         SourceSheet{
                             .Path{ relative_path },
                             .LoadPaths{ load_paths.begin(), load_paths.end() },
                             .Priority{ priority },
-                            .Size{ .Width{ source_image.GetWidth() }, .Height{ source_image.GetHeight() } },
+                            .Size{ .Width{ source_image->GetWidth() }, .Height{ source_image->GetHeight() } },
                             .TileMap{ custom_image_map } }
                     };
 
                     m_TargetSheets.push_back(TargetSheet{
                         .Path{ target_sheet_no_ext },
-                        .Size{ .Width{ target_image.GetWidth() }, .Height{ target_image.GetHeight() } },
+                        .Size{ .Width{ target_image->GetWidth() }, .Height{ target_image->GetHeight() } },
                         .SourceSheets{ std::move(source_sheets) },
                         .ForceRegen{ custom_image.Outdated } });
                 }
@@ -235,7 +224,7 @@ bool SpriteSheetMerger::NeedsRegen(const TargetSheet& target_sheet, const std::f
     return false;
 }
 
-bool SpriteSheetMerger::GenerateRequiredSheets(const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, VirtualFilesystem& vfs, bool force_reload)
+bool SpriteSheetMerger::GenerateRequiredSheets(const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, VirtualFilesystem& vfs, bool force_reload, ThreadPool* thread_pool)
 {
     OnScopeExit clear_sheet_data{
         [this]()
@@ -245,241 +234,436 @@ bool SpriteSheetMerger::GenerateRequiredSheets(const std::filesystem::path& sour
                 sheet.Outdated = false;
                 sheet.Deleted = false;
             }
-            m_CachedImages.clear();
         },
     };
 
     namespace fs = std::filesystem;
 
-    auto get_image = [this](const fs::path& image_path) -> Image&
+    auto is_outdated = [this](const fs::path& path)
     {
-        if (auto* image = algo::find(m_CachedImages, &LoadedImage::ImagePath, image_path))
+        const auto path_no_ext = path.has_extension()
+                                     ? fs::path{ path }.replace_extension()
+                                     : path;
+        const RegisteredSourceSheet* registered_sheet = algo::find_if(m_RegisteredSourceSheets,
+                                                                      [&path_no_ext](const RegisteredSourceSheet& sheet)
+                                                                      { return algo::is_same_path(sheet.Path, path_no_ext); });
+        return registered_sheet != nullptr && (registered_sheet->Outdated || registered_sheet->Deleted);
+    };
+
+    std::vector<std::size_t> required_sheets;
+    for (std::size_t i = 0; i < m_TargetSheets.size(); i++)
+    {
+        if (NeedsRegen(m_TargetSheets[i], destination_folder))
         {
-            return *image->ImageFile;
+            required_sheets.push_back(i);
         }
-        m_CachedImages.push_back({ image_path, std::make_unique<Image>() });
-        m_CachedImages.back().ImageFile->Load(image_path);
-        return *m_CachedImages.back().ImageFile;
-    };
+    }
+    m_MergedSheets.resize(m_TargetSheets.size());
 
-    for (const TargetSheet& target_sheet : m_TargetSheets)
+    // Each sheet only writes its own output, so they can all be generated concurrently
+    std::vector<std::uint8_t> generated_sheets(required_sheets.size(), false);
+    auto generate_sheet = [&](std::size_t sheet_index)
     {
-        if (NeedsRegen(target_sheet, destination_folder))
+        using MergedSource = MergedSheet::MergedSource;
+
+        const TargetSheet& target_sheet = m_TargetSheets[required_sheets[sheet_index]];
+        const auto target_file_path = vfs.GetFilePathFilterExt(target_sheet.Path, Image::AllowedExtensions).value_or(fs::path{ source_folder / target_sheet.Path }.replace_extension(".png"));
+        const auto destination_file_path = fs::path{ destination_folder / target_sheet.Path }.replace_extension(".DDS");
+
+        // Only kept if this generation succeeds, otherwise the next generation has to start from scratch
+        std::unique_ptr<MergedSheet> previous_sheet = std::move(m_MergedSheets[required_sheets[sheet_index]]);
+        if (previous_sheet != nullptr)
         {
-            const auto target_file_path = vfs.GetFilePathFilterExt(target_sheet.Path, Image::AllowedExtensions).value_or(fs::path{ source_folder / target_sheet.Path }.replace_extension(".png"));
-            Image target_image = get_image(target_file_path).Clone();
+            const bool same_target = !target_sheet.ForceRegen && previous_sheet->TargetFilePath == target_file_path && !is_outdated(target_sheet.Path);
+            const bool same_sources = previous_sheet->Sources.size() == target_sheet.SourceSheets.size() && previous_sheet->MultiSourceFilePaths.size() == target_sheet.MultiSourceTiles.size();
+            if (!same_target || !same_sources)
+            {
+                previous_sheet = nullptr;
+            }
+        }
 
-            static auto validate_source_aspect_ratio = [](const SourceSheet& source_sheet, const Image& source_image)
+        static auto validate_source_aspect_ratio = [](const SourceSheet& source_sheet, const Image& source_image)
+        {
+            // Skip images with wrong aspect ratio
+            const std::uint64_t aspect_ratio_offset =
+                std::abs(
+                    static_cast<int64_t>(source_sheet.Size.Width) * source_image.GetHeight() - static_cast<int64_t>(source_image.GetWidth()) * source_sheet.Size.Height);
+            // We accept images that are 10 pixels off in width
+            static constexpr std::uint64_t s_AcceptedPixelError{ 10 };
+            return aspect_ratio_offset <= source_sheet.Size.Height * s_AcceptedPixelError;
+        };
+
+        auto next_sheet = std::make_unique<MergedSheet>();
+        next_sheet->TargetFilePath = target_file_path;
+
+        // Holding on to the images while they are used, the cache may evict them at any time
+        std::vector<std::shared_ptr<const Image>> source_images(target_sheet.SourceSheets.size());
+        auto get_source_image = [&](std::size_t source_index) -> const Image&
+        {
+            if (source_images[source_index] == nullptr)
             {
-                // Skip images with wrong aspect ratio
-                const std::uint64_t aspect_ratio_offset =
-                    std::abs(
-                        static_cast<int64_t>(source_sheet.Size.Width) * source_image.GetHeight() - static_cast<int64_t>(source_image.GetWidth()) * source_sheet.Size.Height);
-                // We accept images that are 10 pixels off in width
-                static constexpr std::uint64_t s_AcceptedPixelError{ 10 };
-                return aspect_ratio_offset <= source_sheet.Size.Height * s_AcceptedPixelError;
-            };
+                source_images[source_index] = m_ImageCache.GetImage(next_sheet->Sources[source_index].FilePath.value());
+            }
+            return *source_images[source_index];
+        };
+
+        // A source is dirty if it resolves to a different file than in the last generation or if that file changed
+        std::vector<bool> dirty_sources;
 
-            float upscaling = 1.0f;
+        float upscaling = 1.0f;
 
-            std::vector<std::optional<fs::path>> target_sheet_paths;
-            for (const SourceSheet& source_sheet : target_sheet.SourceSheets)
+        for (std::size_t i = 0; i < target_sheet.SourceSheets.size(); i++)
+        {
+            const SourceSheet& source_sheet = target_sheet.SourceSheets[i];
+            auto source_file_path = [&, random_select = target_sheet.RandomSelect]() -> std::optional<fs::path>
             {
-                auto source_file_path = [&, random_select = target_sheet.RandomSelect]() -> std::optional<fs::path>
+                for (const fs::path& load_path : source_sheet.LoadPaths)
                 {
-                    for (const fs::path& load_path : source_sheet.LoadPaths)
+                    const fs::path absolute_path = load_path / source_sheet.Path;
+                    if (fs::exists(absolute_path))
                     {
-                        const fs::path absolute_path = load_path / source_sheet.Path;
-                        if (fs::exists(absolute_path))
-                        {
-                            return absolute_path;
-                        }
+                        return absolute_path;
                     }
+                }
 
-                    if (!random_select)
-                    {
-                        return vfs.GetFilePathFilterExt(source_sheet.Path, Image::AllowedExtensions);
-                    }
-                    else
+                if (!random_select)
+                {
+                    return vfs.GetFilePathFilterExt(source_sheet.Path, Image::AllowedExtensions);
+                }
+                else
+                {
+                    return vfs.GetRandomFilePathFilterExt(source_sheet.Path, Image::AllowedExtensions);
+                }
+            }();
+
+            const bool is_dirty = previous_sheet == nullptr || previous_sheet->Sources[i].FilePath != source_file_path || (source_file_path && is_outdated(source_sheet.Path));
+
+            next_sheet->Sources.push_back(MergedSource{ .FilePath{ std::move(source_file_path) } });
+            MergedSource& merged_source = next_sheet->Sources.back();
+            if (merged_source.FilePath)
+            {
+                if (!is_dirty)
+                {
+                    merged_source.Size = previous_sheet->Sources[i].Size;
+                }
+                else
+                {
+                    const Image& source_image = get_source_image(i);
+                    if (validate_source_aspect_ratio(source_sheet, source_image))
                     {
-                        return vfs.GetRandomFilePathFilterExt(source_sheet.Path, Image::AllowedExtensions);
+                        merged_source.Size = ImageSize{ .x{ source_image.GetWidth() }, .y{ source_image.GetHeight() } };
                     }
-                }();
+                }
 
-                if (source_file_path)
+                if (merged_source.Size)
                 {
-                    const Image& source_image = get_image(source_file_path.value());
+                    const float source_width_scaling = static_cast<float>(merged_source.Size->x) / source_sheet.Size.Width;
+                    const float source_height_scaling = static_cast<float>(merged_source.Size->y) / source_sheet.Size.Height;
+                    upscaling = std::max(std::max(upscaling, source_width_scaling), source_height_scaling);
+                }
+            }
 
-                    if (!validate_source_aspect_ratio(source_sheet, source_image))
+            dirty_sources.push_back(is_dirty);
+        }
+
+        for (std::size_t i = 0; i < target_sheet.MultiSourceTiles.size(); i++)
+        {
+            std::vector<std::optional<fs::path>> source_file_paths;
+            bool is_dirty = previous_sheet == nullptr;
+            for (const fs::path& path : target_sheet.MultiSourceTiles[i].Paths)
+            {
+                auto source_file_path = [&, random_select = target_sheet.RandomSelect]() -> std::optional<fs::path>
+                {
+                    if (!random_select)
                     {
-                        source_file_path.reset();
+                        return vfs.GetFilePathFilterExt(path, Image::AllowedExtensions);
                     }
                     else
                     {
-                        const float source_width_scaling = static_cast<float>(source_image.GetWidth()) / source_sheet.Size.Width;
-                        const float source_height_scaling = static_cast<float>(source_image.GetHeight()) / source_sheet.Size.Height;
-                        upscaling = std::max(std::max(upscaling, source_width_scaling), source_height_scaling);
+                        return vfs.GetRandomFilePathFilterExt(path, Image::AllowedExtensions);
                     }
+                }();
+                is_dirty = is_dirty || (source_file_path && is_outdated(path));
+                source_file_paths.push_back(std::move(source_file_path));
+            }
+            is_dirty = is_dirty || previous_sheet->MultiSourceFilePaths[i] != source_file_paths;
+
+            dirty_sources.push_back(is_dirty);
+            next_sheet->MultiSourceFilePaths.push_back(std::move(source_file_paths));
+        }
+
+        const std::shared_ptr<const Image> base_image_ptr = m_ImageCache.GetImage(target_file_path);
+        const Image& base_image = *base_image_ptr;
+        const float original_target_width_scaling = static_cast<float>(base_image.GetWidth()) / target_sheet.Size.Width;
+        const float original_target_height_scaling = static_cast<float>(base_image.GetHeight()) / target_sheet.Size.Height;
+        const float adjusted_upscaling = upscaling / std::min(original_target_width_scaling, original_target_height_scaling);
+
+        next_sheet->Size = ImageSize{
+            .x{ static_cast<std::uint32_t>(adjusted_upscaling * target_sheet.Size.Width) },
+            .y{ static_cast<std::uint32_t>(adjusted_upscaling * target_sheet.Size.Height) }
+        };
+
+        [[maybe_unused]] const float target_width_scaling = static_cast<float>(next_sheet->Size.x) / target_sheet.Size.Width;
+        const float target_height_scaling = static_cast<float>(next_sheet->Size.y) / target_sheet.Size.Height;
+
+        auto get_target_region = [target_height_scaling](const Tile& target_tile)
+        {
+            return ImageSubRegion{
+                .x{ static_cast<std::int32_t>(target_tile.Left * target_height_scaling) },
+                .y{ static_cast<std::int32_t>(target_tile.Top * target_height_scaling) },
+                .width{ static_cast<std::uint32_t>((target_tile.Right - target_tile.Left) * target_height_scaling) },
+                .height{ static_cast<std::uint32_t>((target_tile.Bottom - target_tile.Top) * target_height_scaling) },
+            };
+        };
+
+        // Continue from the last merged result if it is still on disk and sources did not change the size of the sheet
+        std::vector<std::uint8_t> merged_data;
+        Image target_image;
+        bool incremental{ false };
+        if (previous_sheet != nullptr && previous_sheet->Size.x == next_sheet->Size.x && previous_sheet->Size.y == next_sheet->Size.y)
+        {
+            std::uint32_t merged_width{ 0 };
+            std::uint32_t merged_height{ 0 };
+            if (ReadRBGAFromDds(destination_file_path, merged_data, merged_width, merged_height) && merged_width == next_sheet->Size.x && merged_height == next_sheet->Size.y)
+            {
+                target_image.LoadRawData(merged_data, merged_width, merged_height);
+                incremental = true;
+            }
+        }
+
+        // The sources of each tile only depend on the tile maps, so they can be reused as well
+        std::vector<MergedTile>& tiles = next_sheet->Tiles;
+        if (incremental)
+        {
+            tiles = std::move(previous_sheet->Tiles);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < target_sheet.SourceSheets.size(); i++)
+            {
+                for (std::size_t j = 0; j < target_sheet.SourceSheets[i].TileMap.size(); j++)
+                {
+                    AddMergedTileSource(tiles, target_sheet.SourceSheets[i].TileMap[j].TargetTile, MergedTileSource{ .SourceIndex{ i }, .MappingIndex{ j } });
                 }
+            }
+            for (std::size_t i = 0; i < target_sheet.MultiSourceTiles.size(); i++)
+            {
+                AddMergedTileSource(tiles, target_sheet.MultiSourceTiles[i].TileMap.front().TargetTile, MergedTileSource{ .SourceIndex{ target_sheet.SourceSheets.size() + i }, .MappingIndex{ 0 } });
+            }
+        }
 
-                target_sheet_paths.push_back(std::move(source_file_path));
+        const std::vector<bool> dirty_tiles = incremental
+                                                  ? FindDirtyTiles(tiles, dirty_sources)
+                                                  : std::vector<bool>(tiles.size(), true);
+        if (!incremental)
+        {
+            target_image = base_image.Clone();
+            target_image.Resize(next_sheet->Size);
+        }
+
+        // Only needed to reset dirty tiles of an incremental generation, a full one starts from the base image
+        std::optional<Image> resized_base_image;
+        auto reset_tile = [&](const Tile& target_tile)
+        {
+            if (!incremental)
+            {
+                return;
+            }
+            if (!resized_base_image.has_value())
+            {
+                resized_base_image = base_image.Clone();
+                resized_base_image->Resize(next_sheet->Size);
+            }
+            const ImageSubRegion target_region = get_target_region(target_tile);
+            if (target_image.ContainsSubRegion(target_region))
+            {
+                target_image.Blit(resized_base_image->CloneSubImage(target_region), target_region);
+            }
+        };
+
+        auto blit_source_tile = [&](const MergedTileSource& tile_source)
+        {
+            const SourceSheet& source_sheet = target_sheet.SourceSheets[tile_source.SourceIndex];
+            const MergedSource& merged_source = next_sheet->Sources[tile_source.SourceIndex];
+            if (!merged_source.FilePath || !merged_source.Size)
+            {
+                return;
             }
 
-            const float original_target_width_scaling = static_cast<float>(target_image.GetWidth()) / target_sheet.Size.Width;
-            const float original_target_height_scaling = static_cast<float>(target_image.GetHeight()) / target_sheet.Size.Height;
-            const float adjusted_upscaling = upscaling / std::min(original_target_width_scaling, original_target_height_scaling);
+            const fs::path& source_file_path = merged_source.FilePath.value();
+            const Image& source_image = get_source_image(tile_source.SourceIndex);
 
-            target_image.Resize(ImageSize{
-                .x{ static_cast<std::uint32_t>(adjusted_upscaling * target_sheet.Size.Width) },
-                .y{ static_cast<std::uint32_t>(adjusted_upscaling * target_sheet.Size.Height) } });
+            const float source_width_scaling = static_cast<float>(source_image.GetWidth()) / source_sheet.Size.Width;
+            const float source_height_scaling = static_cast<float>(source_image.GetHeight()) / source_sheet.Size.Height;
 
-            [[maybe_unused]] const float target_width_scaling = static_cast<float>(target_image.GetWidth()) / target_sheet.Size.Width;
-            const float target_height_scaling = static_cast<float>(target_image.GetHeight()) / target_sheet.Size.Height;
+            const TileMapping& tile_mapping = source_sheet.TileMap[tile_source.MappingIndex];
+            const ImageSubRegion source_region = ImageSubRegion{
+                .x{ static_cast<std::int32_t>(tile_mapping.SourceTile.Left * source_width_scaling) },
+                .y{ static_cast<std::int32_t>(tile_mapping.SourceTile.Top * source_height_scaling) },
+                .width{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Right - tile_mapping.SourceTile.Left) * source_width_scaling) },
+                .height{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Bottom - tile_mapping.SourceTile.Top) * source_height_scaling) },
+            };
+            const ImageSubRegion target_region = get_target_region(tile_mapping.TargetTile);
 
-            for (const auto [source_sheet, source_file_path] : zip::zip(target_sheet.SourceSheets, target_sheet_paths))
+            if (!source_image.ContainsSubRegion(source_region))
             {
-                if (source_file_path)
-                {
-                    const Image& source_image = get_image(source_file_path.value());
+                LogError("Source image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from target image {}...", source_file_path.string(), source_region.x, source_region.y, source_region.width, source_region.height, source_image.GetWidth(), source_image.GetHeight(), target_file_path.string());
+                return;
+            }
+            if (!target_image.ContainsSubRegion(target_region))
+            {
+                LogError("Target image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from source image {}...", target_file_path.string(), target_region.x, target_region.y, target_region.width, target_region.height, target_image.GetWidth(), target_image.GetHeight(), source_file_path.string());
+                return;
+            }
 
-                    const float source_width_scaling = static_cast<float>(source_image.GetWidth()) / source_sheet.Size.Width;
-                    const float source_height_scaling = static_cast<float>(source_image.GetHeight()) / source_sheet.Size.Height;
+            Image source_tile = source_image.CloneSubImage(source_region);
+            const auto target_size = ::ImageSize{ .x{ static_cast<std::uint32_t>(target_region.width) }, .y{ static_cast<std::uint32_t>(target_region.height) } };
 
-                    for (const TileMapping& tile_mapping : source_sheet.TileMap)
-                    {
-                        const ImageSubRegion source_region = ImageSubRegion{
-                            .x{ static_cast<std::int32_t>(tile_mapping.SourceTile.Left * source_width_scaling) },
-                            .y{ static_cast<std::int32_t>(tile_mapping.SourceTile.Top * source_height_scaling) },
-                            .width{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Right - tile_mapping.SourceTile.Left) * source_width_scaling) },
-                            .height{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Bottom - tile_mapping.SourceTile.Top) * source_height_scaling) },
-                        };
-                        const ImageSubRegion target_region = ImageSubRegion{
-                            .x{ static_cast<std::int32_t>(tile_mapping.TargetTile.Left * target_height_scaling) },
-                            .y{ static_cast<std::int32_t>(tile_mapping.TargetTile.Top * target_height_scaling) },
-                            .width{ static_cast<std::uint32_t>((tile_mapping.TargetTile.Right - tile_mapping.TargetTile.Left) * target_height_scaling) },
-                            .height{ static_cast<std::uint32_t>((tile_mapping.TargetTile.Bottom - tile_mapping.TargetTile.Top) * target_height_scaling) },
-                        };
-
-                        if (!source_image.ContainsSubRegion(source_region))
-                        {
-                            LogError("Source image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from target image {}...", source_file_path.value().string(), source_region.x, source_region.y, source_region.width, source_region.height, source_image.GetWidth(), source_image.GetHeight(), target_file_path.string());
-                            continue;
-                        }
-                        if (!target_image.ContainsSubRegion(target_region))
-                        {
-                            LogError("Target image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from source image {}...", target_file_path.string(), target_region.x, target_region.y, target_region.width, target_region.height, target_image.GetWidth(), target_image.GetHeight(), source_file_path.value().string());
-                            continue;
-                        }
-
-                        Image source_tile = source_image.CloneSubImage(source_region);
-                        const auto target_size = ::ImageSize{ .x{ static_cast<std::uint32_t>(target_region.width) }, .y{ static_cast<std::uint32_t>(target_region.height) } };
-
-                        if (source_sheet.Processing)
-                        {
-                            source_tile = source_sheet.Processing(std::move(source_tile), target_size);
-                        }
-
-                        if (source_tile.GetWidth() != target_size.x || source_tile.GetHeight() != target_size.y)
-                        {
-                            source_tile.Resize(target_size);
-                        }
-
-                        try
-                        {
-                            target_image.Blit(source_tile, target_region);
-                        }
-                        catch (cv::Exception& e)
-                        {
-                            fmt::print("{}", e.what());
-                        }
-                    }
-                }
+            if (source_sheet.Processing)
+            {
+                source_tile = source_sheet.Processing(std::move(source_tile), target_size);
+            }
+
+            if (source_tile.GetWidth() != target_size.x || source_tile.GetHeight() != target_size.y)
+            {
+                source_tile.Resize(target_size);
             }
 
-            for (const MultiSourceTile& multi_source_sheet : target_sheet.MultiSourceTiles)
+            try
+            {
+                target_image.Blit(source_tile, target_region);
+            }
+            catch (cv::Exception& e)
             {
-                std::vector<std::pair<Image, std::filesystem::path>> tiles;
-                auto front_tile = multi_source_sheet.TileMap.front();
-                const ImageSubRegion target_region = ImageSubRegion{
-                    .x{ static_cast<std::int32_t>(front_tile.TargetTile.Left * target_height_scaling) },
-                    .y{ static_cast<std::int32_t>(front_tile.TargetTile.Top * target_height_scaling) },
-                    .width{ static_cast<std::uint32_t>((front_tile.TargetTile.Right - front_tile.TargetTile.Left) * target_height_scaling) },
-                    .height{ static_cast<std::uint32_t>((front_tile.TargetTile.Bottom - front_tile.TargetTile.Top) * target_height_scaling) },
-                };
-                const auto target_size = ::ImageSize{ .x{ static_cast<std::uint32_t>(target_region.width) }, .y{ static_cast<std::uint32_t>(target_region.height) } };
-
-                for (auto [path, size, tile_mapping] : zip::zip(multi_source_sheet.Paths, multi_source_sheet.Sizes, multi_source_sheet.TileMap))
+                fmt::print("{}", e.what());
+            }
+        };
+
+        auto blit_multi_source_tile = [&](std::size_t multi_source_index)
+        {
+            const MultiSourceTile& multi_source_sheet = target_sheet.MultiSourceTiles[multi_source_index];
+            const auto& source_file_paths = next_sheet->MultiSourceFilePaths[multi_source_index];
+
+            std::vector<std::pair<Image, std::filesystem::path>> source_tiles;
+            const ImageSubRegion target_region = get_target_region(multi_source_sheet.TileMap.front().TargetTile);
+            const auto target_size = ::ImageSize{ .x{ static_cast<std::uint32_t>(target_region.width) }, .y{ static_cast<std::uint32_t>(target_region.height) } };
+
+            for (auto [source_file_path, size, tile_mapping] : zip::zip(source_file_paths, multi_source_sheet.Sizes, multi_source_sheet.TileMap))
+            {
+                if (source_file_path)
                 {
-                    auto source_file_path = [&, random_select = target_sheet.RandomSelect]() -> std::optional<fs::path>
-                    {
-                        if (!random_select)
-                        {
-                            return vfs.GetFilePathFilterExt(path, Image::AllowedExtensions);
-                        }
-                        else
-                        {
-                            return vfs.GetRandomFilePathFilterExt(path, Image::AllowedExtensions);
-                        }
-                    }();
-
-                    if (source_file_path)
+                    const std::shared_ptr<const Image> source_image_ptr = m_ImageCache.GetImage(source_file_path.value());
+                    const Image& source_image = *source_image_ptr;
+
+                    const float source_width_scaling = static_cast<float>(source_image.GetWidth()) / size.Width;
+                    const float source_height_scaling = static_cast<float>(source_image.GetHeight()) / size.Height;
+
+                    const ImageSubRegion source_region = ImageSubRegion{
+                        .x{ static_cast<std::int32_t>(tile_mapping.SourceTile.Left * source_width_scaling) },
+                        .y{ static_cast<std::int32_t>(tile_mapping.SourceTile.Top * source_height_scaling) },
+                        .width{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Right - tile_mapping.SourceTile.Left) * source_width_scaling) },
+                        .height{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Bottom - tile_mapping.SourceTile.Top) * source_height_scaling) },
+                    };
+
+                    if (!source_image.ContainsSubRegion(source_region))
                     {
-                        const Image& source_image = get_image(source_file_path.value());
-
-                        const float source_width_scaling = static_cast<float>(source_image.GetWidth()) / size.Width;
-                        const float source_height_scaling = static_cast<float>(source_image.GetHeight()) / size.Height;
-
-                        const ImageSubRegion source_region = ImageSubRegion{
-                            .x{ static_cast<std::int32_t>(tile_mapping.SourceTile.Left * source_width_scaling) },
-                            .y{ static_cast<std::int32_t>(tile_mapping.SourceTile.Top * source_height_scaling) },
-                            .width{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Right - tile_mapping.SourceTile.Left) * source_width_scaling) },
-                            .height{ static_cast<std::uint32_t>((tile_mapping.SourceTile.Bottom - tile_mapping.SourceTile.Top) * source_height_scaling) },
-                        };
-
-                        if (!source_image.ContainsSubRegion(source_region))
-                        {
-                            LogError("Source image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from target image {}...", source_file_path.value().string(), source_region.x, source_region.y, source_region.width, source_region.height, source_image.GetWidth(), source_image.GetHeight(), target_file_path.string());
-                            continue;
-                        }
-
-                        Image source_tile = source_image.CloneSubImage(source_region);
-                        tiles.push_back({ source_tile.Clone(), std::move(source_file_path).value() });
+                        LogError("Source image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {})... Tile expected from target image {}...", source_file_path.value().string(), source_region.x, source_region.y, source_region.width, source_region.height, source_image.GetWidth(), source_image.GetHeight(), target_file_path.string());
+                        continue;
                     }
-                }
 
-                if (!target_image.ContainsSubRegion(target_region))
-                {
-                    LogError("Target image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {}) needed for multi-source target...", target_file_path.string(), target_region.x, target_region.y, target_region.width, target_region.height, target_image.GetWidth(), target_image.GetHeight());
-                    continue;
+                    Image source_tile = source_image.CloneSubImage(source_region);
+                    source_tiles.push_back({ source_tile.Clone(), source_file_path.value() });
                 }
+            }
 
-                Image source_tile = multi_source_sheet.Processing(std::move(tiles), target_size);
-                if (source_tile.GetWidth() != target_size.x || source_tile.GetHeight() != target_size.y)
-                {
-                    source_tile.Resize(target_size);
-                }
+            if (!target_image.ContainsSubRegion(target_region))
+            {
+                LogError("Target image {} does not contain tile ({}, {}, {}, {}), image size is ({}, {}) needed for multi-source target...", target_file_path.string(), target_region.x, target_region.y, target_region.width, target_region.height, target_image.GetWidth(), target_image.GetHeight());
+                return;
+            }
 
-                try
-                {
-                    target_image.Blit(source_tile, target_region);
-                }
-                catch (cv::Exception& e)
-                {
-                    fmt::print("{}", e.what());
-                }
+            Image source_tile = multi_source_sheet.Processing(std::move(source_tiles), target_size);
+            if (source_tile.GetWidth() != target_size.x || source_tile.GetHeight() != target_size.y)
+            {
+                source_tile.Resize(target_size);
             }
 
-            const auto destination_file_path = fs::path{ destination_folder / target_sheet.Path }.replace_extension(".DDS");
-            if (!ConvertRBGAToDds(target_image.GetData(), target_image.GetWidth(), target_image.GetHeight(), destination_file_path))
+            try
+            {
+                target_image.Blit(source_tile, target_region);
+            }
+            catch (cv::Exception& e)
             {
-                return false;
+                fmt::print("{}", e.what());
             }
-            else if (force_reload)
+        };
+
+        RecompositeDirtyTiles(tiles, dirty_tiles, reset_tile, [&](const MergedTileSource& tile_source)
+                              {
+                                  if (tile_source.SourceIndex < target_sheet.SourceSheets.size())
+                                  {
+                                      blit_source_tile(tile_source);
+                                  }
+                                  else
+                                  {
+                                      blit_multi_source_tile(tile_source.SourceIndex - target_sheet.SourceSheets.size());
+                                  }
+                              });
+
+        const bool generated = [&]()
+        {
+            if (incremental)
             {
-                Spelunky_ReloadTexture(fs::path{ target_sheet.Path }.replace_extension(".DDS").string().c_str());
+                std::vector<ImageSubRegion> dirty_regions;
+                for (std::size_t i = 0; i < tiles.size(); i++)
+                {
+                    const ImageSubRegion target_region = get_target_region(tiles[i].TargetTile);
+                    if (dirty_tiles[i] && target_image.ContainsSubRegion(target_region))
+                    {
+                        dirty_regions.push_back(target_region);
+                    }
+                }
+                return UpdateRBGAInDds(target_image.GetData(), target_image.GetWidth(), target_image.GetHeight(), dirty_regions, destination_file_path);
             }
+            return ConvertRBGAToDds(target_image.GetData(), target_image.GetWidth(), target_image.GetHeight(), destination_file_path);
+        }();
+
+        if (generated)
+        {
+            m_MergedSheets[required_sheets[sheet_index]] = std::move(next_sheet);
+        }
+        generated_sheets[sheet_index] = generated;
+    };
+
+    if (thread_pool != nullptr)
+    {
+        thread_pool->ForEach(required_sheets.size(), generate_sheet);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < required_sheets.size(); i++)
+        {
+            generate_sheet(i);
+        }
+    }
+
+    // Registering and reloading happens afterwards, the game expects textures to be reloaded from this thread
+    bool generated_all_sheets{ true };
+    for (std::size_t i = 0; i < required_sheets.size(); i++)
+    {
+        if (!generated_sheets[i])
+        {
+            generated_all_sheets = false;
+            continue;
+        }
+
+        const TargetSheet& target_sheet = m_TargetSheets[required_sheets[i]];
+        vfs.RegisterNewFile(fs::path{ destination_folder / target_sheet.Path }.replace_extension(".DDS"));
+        if (force_reload)
+        {
+            Spelunky_ReloadTexture(fs::path{ target_sheet.Path }.replace_extension(".DDS").string().c_str());
         }
     }
 
-    return true;
+    return generated_all_sheets;
 }
@@ -3,15 +3,20 @@
 #include <array>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "merged_sheet_tiles.h"
 #include "sprite_sheet_merger_types.h"
 #include "util/image.h"
+#include "util/image_cache.h"
 
 class VirtualFilesystem;
 class EntityDataExtractor;
+class ThreadPool;
 
 class SpriteSheetMerger
 {
@@ -30,7 +35,15 @@ class SpriteSheetMerger
 
     bool NeedsRegeneration(const std::filesystem::path& destination_folder) const;
 
-    bool GenerateRequiredSheets(const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, VirtualFilesystem& vfs, bool force_reload = false);
+    // Sheets are generated concurrently if a thread pool is passed
+    // Sheets that were generated before only get the tiles recomposited whose sources changed since
+    bool GenerateRequiredSheets(const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, VirtualFilesystem& vfs, bool force_reload = false, ThreadPool* thread_pool = nullptr);
+
+    // Decoded images are shared with everything that works on sprites while the merger is alive
+    ImageCache& GetImageCache()
+    {
+        return m_ImageCache;
+    }
 
   private:
     friend class EntityDataExtractor;
@@ -77,12 +90,24 @@ class SpriteSheetMerger
     };
     std::vector<RegisteredSourceSheet> m_RegisteredSourceSheets;
 
-    std::unique_ptr<EntityDataExtractor> m_EntityDataExtractor;
-
-    struct LoadedImage
+    // What the last generation of a target sheet was made from, the merged result itself is the generated dds
+    struct MergedSheet
     {
-        std::filesystem::path ImagePath;
-        std::unique_ptr<Image> ImageFile;
+        struct MergedSource
+        {
+            std::optional<std::filesystem::path> FilePath;
+            std::optional<ImageSize> Size; // Not set if the image can not be used as a source
+        };
+
+        std::filesystem::path TargetFilePath;
+        ImageSize Size;
+        std::vector<MergedSource> Sources;
+        std::vector<std::vector<std::optional<std::filesystem::path>>> MultiSourceFilePaths;
+        std::vector<MergedTile> Tiles; // MultiSourceTiles are indexed after all SourceSheets
     };
-    std::vector<LoadedImage> m_CachedImages;
+    std::vector<std::unique_ptr<MergedSheet>> m_MergedSheets;
+
+    std::unique_ptr<EntityDataExtractor> m_EntityDataExtractor;
+
+    ImageCache m_ImageCache;
 };
@@ -1,15 +1,15 @@
 #include "string_hash.h"
 
 #include "util/algorithms.h"
-#include "util/regex.h"
+#include "util/file.h"
+#include "util/format.h"
 
 #include <array>
 #include <fstream>
+#include <iterator>
 #include <span>
 #include <zlib.h>
 
-static constexpr ctll::fixed_string s_CommentBlockRule{ "^#+" };
-
 std::uint32_t HashString(std::string_view string)
 {
     return crc32(0, reinterpret_cast<const Bytef*>(string.data()), static_cast<std::uint32_t>(string.size()));
@@ -26,33 +26,36 @@ bool CreateHashedStringsFile(const std::filesystem::path& source_file, const std
         }
     } // namespace std::filesystem;
 
-    if (auto source = std::ifstream{ source_file })
+    auto source_stream = std::ifstream{ source_file, std::ios::binary };
+    if (!source_stream)
     {
-        if (auto destination = std::ofstream{ destination_file, std::ios::trunc })
-        {
-            destination << std::hex << std::setfill('0');
+        return true;
+    }
+    const std::string source{ std::istreambuf_iterator<char>{ source_stream }, std::istreambuf_iterator<char>{} };
 
-            std::string current_comment_block;
-            while (!source.eof())
+    std::string hashes;
+    std::string current_comment_block;
+    for (const std::string_view line : SplitLines(source))
+    {
+        if (line.starts_with('#'))
+        {
+            std::string comment_block = algo::trim(algo::trim(std::string{ line }, '#'));
+            if (!comment_block.empty())
             {
-                std::string line;
-                std::getline(source, line);
-                if (ctre::starts_with<s_CommentBlockRule>(line))
-                {
-                    std::string comment_block = algo::trim(algo::trim(line, '#'));
-                    if (!comment_block.empty())
-                    {
-                        current_comment_block = std::move(comment_block);
-                    }
-                    destination << "0x" << std::setw(8) << 0xdeadbeef << '\n';
-                }
-                else
-                {
-                    const auto comment_and_line = algo::trim(line) + current_comment_block;
-                    destination << "0x" << std::setw(8) << HashString(comment_and_line) << '\n';
-                }
+                current_comment_block = std::move(comment_block);
             }
+            fmt::format_to(std::back_inserter(hashes), "0x{:08x}\n", 0xdeadbeef);
         }
+        else
+        {
+            const auto comment_and_line = algo::trim(std::string{ line }) + current_comment_block;
+            fmt::format_to(std::back_inserter(hashes), "0x{:08x}\n", HashString(comment_and_line));
+        }
+    }
+
+    if (auto destination = std::ofstream{ destination_file, std::ios::trunc })
+    {
+        destination.write(hashes.data(), hashes.size());
     }
 
     return true;
@@ -1,15 +1,14 @@
 #include "string_merge.h"
 
-#include "known_files.h"
-#include "log.h"
 #include "playlunky.h"
+#include "string_table_merge.h"
 #include "util/algorithms.h"
 #include "util/format.h"
+#include "util/thread_pool.h"
 #include "virtual_filesystem.h"
 
+#include <atomic>
 #include <charconv>
-#include <fstream>
-#include <unordered_map>
 
 bool StringMerger::RegisterOutdatedStringTable(std::string_view table)
 {
@@ -59,12 +58,14 @@ bool StringMerger::RegisterModdedStringTable(std::string_view table)
 }
 
 bool StringMerger::MergeStrings(
-    const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, const std::filesystem::path& hash_file_path, bool speedrun_mode, VirtualFilesystem& vfs)
+    const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, const std::filesystem::path& hash_file_path, bool speedrun_mode, VirtualFilesystem& vfs, ThreadPool* thread_pool)
 {
 
     namespace fs = std::filesystem;
 
-    if (auto hash_file = std::ifstream{ source_folder / hash_file_path })
+    // Only parsed if the cache of any original table is outdated
+    StringHashFile string_hashes{ source_folder / hash_file_path };
+    if (string_hashes.GetStamp().has_value())
     {
         {
             std::vector<std::uint8_t> forced_string_tables{};
@@ -103,109 +104,58 @@ bool StringMerger::MergeStrings(
             }
         }
 
+        struct ModdedStringTable
+        {
+            std::uint8_t Index;
+            std::vector<fs::path> SourceFiles;
+        };
+        std::vector<ModdedStringTable> modded_string_tables;
         for (auto outdated_string_table : mOutdatedStringTables)
         {
             if (outdated_string_table.Modded)
             {
-                struct ModdedString
-                {
-                    std::string Hash;
-                    std::string String;
-                };
-                std::vector<ModdedString> modded_strings;
+                const auto string_table_mod_name = fmt::format("strings{:02}_mod.str", outdated_string_table.Index);
+                modded_string_tables.push_back(ModdedStringTable{
+                    .Index{ outdated_string_table.Index },
+                    .SourceFiles{ vfs.GetAllFilePaths(string_table_mod_name) } });
 
+                if (!modded_string_tables.back().SourceFiles.empty())
                 {
-                    const auto string_table_mod_name = fmt::format("strings{:02}_mod.str", outdated_string_table.Index);
-                    const auto string_table_source_files = vfs.GetAllFilePaths(string_table_mod_name);
-
-                    if (!string_table_source_files.empty())
-                    {
-                        Playlunky::Get().RegisterModType(ModType::String);
-                    }
-
-                    for (const auto& string_table_source_file : string_table_source_files)
-                    {
-                        if (auto source_file = std::ifstream{ string_table_source_file })
-                        {
-                            while (!source_file.eof())
-                            {
-                                std::string modded_string;
-                                std::getline(source_file, modded_string);
-                                if (modded_string.size() >= 2 && modded_string[0] == '0' && modded_string[1] == 'x')
-                                {
-                                    const auto colon_pos = modded_string.find(':');
-                                    if (colon_pos != std::string::npos)
-                                    {
-                                        std::string_view hash_string = std::string_view{ modded_string }.substr(2, colon_pos - 2);
-                                        std::string_view full_hash_string = std::string_view{ modded_string }.substr(0, colon_pos);
-
-                                        std::uint32_t hash;
-                                        auto result = std::from_chars(hash_string.data(), hash_string.data() + hash_string.size(), hash, 16);
-                                        if (result.ec == std::errc::invalid_argument)
-                                        {
-                                            LogError("Failed parsing string hash '0x{}', modded string '{}' will be discarded...", hash_string, modded_string);
-                                            return false;
-                                        }
-
-                                        const bool is_allowed_string = !speedrun_mode || algo::contains(s_SpeedrunStringHashes, hash);
-
-                                        if (is_allowed_string && !algo::contains(modded_strings, &ModdedString::Hash, full_hash_string))
-                                        {
-                                            const std::size_t string_start = 3 + hash_string.size();
-                                            std::string_view string = std::string_view{ modded_string }.substr(modded_string.find_first_not_of(' ', string_start));
-                                            modded_strings.push_back(ModdedString{
-                                                .Hash{ std::string{ full_hash_string } },
-                                                .String{ std::string{ string } } });
-                                        }
-                                    }
-                                    else
-                                    {
-                                        LogError("Failed parsing modded string '{}', expected ':' after hash, the string will be discarded...", modded_string);
-                                    }
-                                }
-                                else if (modded_string.size() > 0 && modded_string[0] != '#')
-                                {
-                                    LogError("Failed parsing modded string '{}', expected hash at beginning of line, the string will be discarded...", modded_string);
-                                }
-                            }
-                        }
-                    }
+                    Playlunky::Get().RegisterModType(ModType::String);
                 }
+            }
+        }
 
-                const auto string_table_name = fmt::format("strings{:02}.str", outdated_string_table.Index);
-                const auto string_table_source_file = source_folder / string_table_name;
-                const auto string_table_destination_file = destination_folder / string_table_name;
-
-                auto strings_source_file = std::ifstream{ string_table_source_file };
-                auto strings_destination_file = std::ofstream{ string_table_destination_file, std::ios::trunc };
-
-                if (strings_source_file && strings_destination_file)
-                {
-                    hash_file.seekg(0, std::ios::beg);
-
-                    while (!strings_source_file.eof() && !hash_file.eof())
-                    {
-                        std::string source_string;
-                        std::getline(strings_source_file, source_string);
-
-                        std::string hash_string;
-                        std::getline(hash_file, hash_string);
+        const fs::path cache_folder = destination_folder / "StringCache";
+        {
+            std::error_code ec;
+            fs::create_directories(cache_folder, ec);
+        }
 
-                        if (hash_string != "0xdeadbeef")
-                        {
-                            if (auto* modded_string = algo::find(modded_strings, &ModdedString::Hash, hash_string))
-                            {
-                                strings_destination_file << modded_string->String << '\n';
-                                continue;
-                            }
-                        }
+        std::atomic_bool success{ true };
+        auto merge_string_table = [&](std::size_t i)
+        {
+            const ModdedStringTable& modded_string_table = modded_string_tables[i];
+            const auto string_table_name = fmt::format("strings{:02}.str", modded_string_table.Index);
+            if (!MergeStringTable(string_hashes, source_folder / string_table_name, modded_string_table.SourceFiles, destination_folder / string_table_name, cache_folder, speedrun_mode))
+            {
+                success = false;
+            }
+        };
 
-                        strings_destination_file << source_string << '\n';
-                    }
-                }
+        if (thread_pool != nullptr)
+        {
+            thread_pool->ForEach(modded_string_tables.size(), merge_string_table);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < modded_string_tables.size(); i++)
+            {
+                merge_string_table(i);
             }
         }
-        return true;
+
+        return success;
     }
 
     return false;
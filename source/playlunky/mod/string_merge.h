@@ -5,6 +5,7 @@
 #include <string_view>
 #include <vector>
 
+class ThreadPool;
 class VirtualFilesystem;
 
 class StringMerger
@@ -26,7 +27,7 @@ class StringMerger
     }
 
     bool MergeStrings(
-        const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, const std::filesystem::path& hash_file_path, bool speedrun_mode, VirtualFilesystem& vfs);
+        const std::filesystem::path& source_folder, const std::filesystem::path& destination_folder, const std::filesystem::path& hash_file_path, bool speedrun_mode, VirtualFilesystem& vfs, ThreadPool* thread_pool = nullptr);
 
   private:
     bool mNeedsRegen{ false };
@@ -0,0 +1,448 @@
+#include "string_table_merge.h"
+
+#include "known_files.h"
+#include "log.h"
+#include "string_hash.h"
+#include "util/file.h"
+#include "util/format.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Hash of comment lines in the hash file, the strings of these lines are never replaced
+static constexpr std::uint32_t c_CommentStringHash{ 0xdeadbeef };
+
+static bool ReadFile(const std::filesystem::path& file_path, std::string& file_content)
+{
+    if (auto file = std::ifstream{ file_path, std::ios::binary })
+    {
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(file_path, ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        file_content.resize(file_size);
+        file.read(file_content.data(), file_content.size());
+        file_content.resize(file.gcount());
+        return true;
+    }
+    return false;
+}
+
+static std::optional<FileStamp> GetFileStamp(const std::filesystem::path& file_path)
+{
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(file_path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    const auto write_time = std::filesystem::last_write_time(file_path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    return FileStamp{
+        .Size{ file_size },
+        .WriteTime{ static_cast<std::int64_t>(write_time.time_since_epoch().count()) }
+    };
+}
+
+template<class T>
+static bool ReadValue(std::istream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(stream);
+}
+template<class T>
+static bool ReadArray(std::istream& stream, std::vector<T>& values, std::uint64_t count)
+{
+    // Guards against allocating absurd amounts of memory for corrupt caches
+    if (count > (std::uint64_t{ 1 } << 28))
+    {
+        return false;
+    }
+    values.resize(count);
+    stream.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+    return static_cast<bool>(stream);
+}
+template<class T>
+static void WriteValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+template<class T>
+static void WriteArray(std::ostream& stream, const std::vector<T>& values)
+{
+    stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+static std::optional<std::vector<std::uint32_t>> ReadStringHashes(const std::filesystem::path& hash_file_path)
+{
+    std::string hash_file_content;
+    if (ReadFile(hash_file_path, hash_file_content))
+    {
+        const std::vector<std::string_view> hash_lines = SplitLines(hash_file_content);
+        std::vector<std::uint32_t> hashes(hash_lines.size(), c_CommentStringHash);
+        for (std::size_t i = 0; i < hash_lines.size(); i++)
+        {
+            const std::string_view hash_line = hash_lines[i];
+            if (hash_line.starts_with("0x"))
+            {
+                // Lines that fail to parse stay comments, so they are never replaced
+                std::from_chars(hash_line.data() + 2, hash_line.data() + hash_line.size(), hashes[i], 16);
+            }
+        }
+        return hashes;
+    }
+    return std::nullopt;
+}
+
+// An original string table split into lines, together with the hash of each line
+// Cached in binary form in the .db folder so that neither the table nor the hash file has to be parsed again
+struct BaseStringTable
+{
+    std::string Text;
+    std::vector<std::uint32_t> LineOffsets; // One past the last line, lines are stored without newlines
+    std::vector<std::uint32_t> Hashes;
+
+    std::size_t GetNumLines() const
+    {
+        return Hashes.size();
+    }
+    std::string_view GetLine(std::size_t i) const
+    {
+        return std::string_view{ Text }.substr(LineOffsets[i], LineOffsets[i + 1] - LineOffsets[i]);
+    }
+};
+
+static constexpr std::array<char, 4> c_BaseStringTableMagic{ 'P', 'L', 'S', 'T' };
+static constexpr std::array<char, 4> c_ModdedStringsMagic{ 'P', 'L', 'S', 'M' };
+static constexpr std::uint32_t c_StringCacheVersion{ 1 };
+
+static std::optional<BaseStringTable> ReadBaseStringTableCache(const std::filesystem::path& cache_path, const FileStamp& table_stamp, const FileStamp& hashes_stamp)
+{
+    if (auto cache_file = std::ifstream{ cache_path, std::ios::binary })
+    {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        FileStamp cached_table_stamp;
+        FileStamp cached_hashes_stamp;
+        std::uint64_t num_lines;
+        std::uint64_t text_size;
+        if (!ReadValue(cache_file, magic) || !ReadValue(cache_file, version) || !ReadValue(cache_file, cached_table_stamp) || !ReadValue(cache_file, cached_hashes_stamp) || !ReadValue(cache_file, num_lines) || !ReadValue(cache_file, text_size))
+        {
+            return std::nullopt;
+        }
+        if (magic != c_BaseStringTableMagic || version != c_StringCacheVersion || cached_table_stamp != table_stamp || cached_hashes_stamp != hashes_stamp)
+        {
+            return std::nullopt;
+        }
+
+        BaseStringTable table;
+        if (!ReadArray(cache_file, table.Hashes, num_lines) || !ReadArray(cache_file, table.LineOffsets, num_lines + 1) || text_size != table.LineOffsets.back())
+        {
+            return std::nullopt;
+        }
+        table.Text.resize(text_size);
+        if (!cache_file.read(table.Text.data(), table.Text.size()))
+        {
+            return std::nullopt;
+        }
+        if (!std::ranges::is_sorted(table.LineOffsets))
+        {
+            return std::nullopt;
+        }
+        return table;
+    }
+    return std::nullopt;
+}
+static void WriteBaseStringTableCache(const std::filesystem::path& cache_path, const BaseStringTable& table, const FileStamp& table_stamp, const FileStamp& hashes_stamp)
+{
+    if (auto cache_file = std::ofstream{ cache_path, std::ios::binary | std::ios::trunc })
+    {
+        WriteValue(cache_file, c_BaseStringTableMagic);
+        WriteValue(cache_file, c_StringCacheVersion);
+        WriteValue(cache_file, table_stamp);
+        WriteValue(cache_file, hashes_stamp);
+        WriteValue(cache_file, std::uint64_t{ table.GetNumLines() });
+        WriteValue(cache_file, std::uint64_t{ table.Text.size() });
+        WriteArray(cache_file, table.Hashes);
+        WriteArray(cache_file, table.LineOffsets);
+        cache_file.write(table.Text.data(), table.Text.size());
+    }
+}
+
+static std::optional<BaseStringTable> CreateBaseStringTable(const std::filesystem::path& table_path, const std::vector<std::uint32_t>& hashes)
+{
+    std::string table_content;
+    if (!ReadFile(table_path, table_content))
+    {
+        return std::nullopt;
+    }
+
+    const std::vector<std::string_view> lines = SplitLines(table_content);
+    const std::size_t num_lines = std::min(lines.size(), hashes.size());
+
+    BaseStringTable table;
+    table.Text.reserve(table_content.size());
+    table.LineOffsets.reserve(num_lines + 1);
+    for (std::size_t i = 0; i < num_lines; i++)
+    {
+        table.LineOffsets.push_back(static_cast<std::uint32_t>(table.Text.size()));
+        table.Text += lines[i];
+    }
+    table.LineOffsets.push_back(static_cast<std::uint32_t>(table.Text.size()));
+    table.Hashes.assign(hashes.begin(), hashes.begin() + num_lines);
+    return table;
+}
+
+// Strings of a single mod file in the order they appear in the file
+struct ModdedString
+{
+    std::uint32_t Hash;
+    std::string String;
+};
+using ModdedStrings = std::vector<ModdedString>;
+
+// Returns nullopt if any hash fails to parse so that the whole file is discarded, malformed lines are skipped
+static std::optional<ModdedStrings> ParseModdedStrings(const std::filesystem::path& source_path)
+{
+    std::string source_content;
+    if (!ReadFile(source_path, source_content))
+    {
+        return ModdedStrings{};
+    }
+
+    ModdedStrings modded_strings;
+    for (const std::string_view modded_string : SplitLines(source_content))
+    {
+        if (modded_string.size() >= 2 && modded_string[0] == '0' && modded_string[1] == 'x')
+        {
+            const auto colon_pos = modded_string.find(':');
+            if (colon_pos != std::string::npos)
+            {
+                std::string_view hash_string = modded_string.substr(2, colon_pos - 2);
+
+                std::uint32_t hash{ 0 };
+                auto result = std::from_chars(hash_string.data(), hash_string.data() + hash_string.size(), hash, 16);
+                if (result.ec != std::errc{})
+                {
+                    LogError("Failed parsing string hash '0x{}' in modded string '{}', all strings in file '{}' will be discarded...", hash_string, modded_string, source_path.string());
+                    return std::nullopt;
+                }
+
+                // Nothing but spaces after the colon replaces the string with an empty one
+                const std::size_t string_start = std::min(modded_string.find_first_not_of(' ', colon_pos + 1), modded_string.size());
+                std::string_view string = modded_string.substr(string_start);
+                modded_strings.push_back(ModdedString{
+                    .Hash{ hash },
+                    .String{ std::string{ string } } });
+            }
+            else
+            {
+                LogError("Failed parsing modded string '{}', expected ':' after hash, the string will be discarded...", modded_string);
+            }
+        }
+        else if (modded_string.size() > 0 && modded_string[0] != '#')
+        {
+            LogError("Failed parsing modded string '{}', expected hash at beginning of line, the string will be discarded...", modded_string);
+        }
+    }
+    return modded_strings;
+}
+
+static std::optional<ModdedStrings> ReadModdedStringsCache(const std::filesystem::path& cache_path, std::string_view source_path, const FileStamp& source_stamp)
+{
+    if (auto cache_file = std::ifstream{ cache_path, std::ios::binary })
+    {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        FileStamp cached_source_stamp;
+        std::uint64_t source_path_size;
+        if (!ReadValue(cache_file, magic) || !ReadValue(cache_file, version) || !ReadValue(cache_file, cached_source_stamp) || !ReadValue(cache_file, source_path_size))
+        {
+            return std::nullopt;
+        }
+        if (magic != c_ModdedStringsMagic || version != c_StringCacheVersion || cached_source_stamp != source_stamp || source_path_size != source_path.size())
+        {
+            return std::nullopt;
+        }
+
+        // Cache files are named by a hash of the source path, so make sure this is not a collision
+        std::string cached_source_path(source_path_size, '\0');
+        if (!cache_file.read(cached_source_path.data(), cached_source_path.size()) || cached_source_path != source_path)
+        {
+            return std::nullopt;
+        }
+
+        std::uint64_t num_strings;
+        if (!ReadValue(cache_file, num_strings) || num_strings > (std::uint64_t{ 1 } << 24))
+        {
+            return std::nullopt;
+        }
+
+        ModdedStrings modded_strings(num_strings);
+        for (ModdedString& modded_string : modded_strings)
+        {
+            std::uint32_t string_size;
+            if (!ReadValue(cache_file, modded_string.Hash) || !ReadValue(cache_file, string_size))
+            {
+                return std::nullopt;
+            }
+            modded_string.String.resize(string_size);
+            if (!cache_file.read(modded_string.String.data(), modded_string.String.size()))
+            {
+                return std::nullopt;
+            }
+        }
+        return modded_strings;
+    }
+    return std::nullopt;
+}
+static void WriteModdedStringsCache(const std::filesystem::path& cache_path, std::string_view source_path, const FileStamp& source_stamp, const ModdedStrings& modded_strings)
+{
+    if (auto cache_file = std::ofstream{ cache_path, std::ios::binary | std::ios::trunc })
+    {
+        WriteValue(cache_file, c_ModdedStringsMagic);
+        WriteValue(cache_file, c_StringCacheVersion);
+        WriteValue(cache_file, source_stamp);
+        WriteValue(cache_file, std::uint64_t{ source_path.size() });
+        cache_file.write(source_path.data(), source_path.size());
+        WriteValue(cache_file, std::uint64_t{ modded_strings.size() });
+        for (const ModdedString& modded_string : modded_strings)
+        {
+            WriteValue(cache_file, modded_string.Hash);
+            WriteValue(cache_file, static_cast<std::uint32_t>(modded_string.String.size()));
+            cache_file.write(modded_string.String.data(), modded_string.String.size());
+        }
+    }
+}
+
+StringHashFile::StringHashFile(std::filesystem::path hash_file_path)
+    : m_Path{ std::move(hash_file_path) }
+    , m_Stamp{ GetFileStamp(m_Path) }
+{
+}
+
+const std::vector<std::uint32_t>* StringHashFile::GetHashes()
+{
+    std::call_once(m_HashesFlag, [this]()
+                   { m_Hashes = ReadStringHashes(m_Path); });
+    return m_Hashes.has_value() ? &m_Hashes.value() : nullptr;
+}
+
+bool MergeStringTable(StringHashFile& hash_file,
+                      const std::filesystem::path& string_table_file,
+                      std::span<const std::filesystem::path> mod_files,
+                      const std::filesystem::path& destination_file,
+                      const std::filesystem::path& cache_folder,
+                      bool speedrun_mode)
+{
+    namespace fs = std::filesystem;
+
+    if (!hash_file.GetStamp().has_value())
+    {
+        return false;
+    }
+    const FileStamp& string_hashes_stamp = hash_file.GetStamp().value();
+
+    // Keyed by hash, files are in order of priority so the first string for each hash wins
+    std::unordered_map<std::uint32_t, std::string> modded_strings;
+    for (const auto& string_table_source_file : mod_files)
+    {
+        // Parsed mod files are cached, so changing one mod does not re-parse the files of all other mods
+        const std::string source_path = string_table_source_file.string();
+        const fs::path cache_path = cache_folder / fmt::format("{:08x}.mod", HashString(source_path));
+        const std::optional<FileStamp> source_stamp = GetFileStamp(string_table_source_file);
+
+        std::optional<ModdedStrings> source_strings;
+        if (source_stamp.has_value())
+        {
+            source_strings = ReadModdedStringsCache(cache_path, source_path, source_stamp.value());
+        }
+        if (!source_strings.has_value())
+        {
+            source_strings = ParseModdedStrings(string_table_source_file);
+            if (!source_strings.has_value())
+            {
+                continue;
+            }
+            if (source_stamp.has_value())
+            {
+                WriteModdedStringsCache(cache_path, source_path, source_stamp.value(), source_strings.value());
+            }
+        }
+
+        modded_strings.reserve(modded_strings.size() + source_strings->size());
+        for (ModdedString& modded_string : source_strings.value())
+        {
+            const bool is_allowed_string = modded_string.Hash != c_CommentStringHash && (!speedrun_mode || s_SpeedrunStringHashSet.Contains(modded_string.Hash));
+            if (is_allowed_string)
+            {
+                modded_strings.try_emplace(modded_string.Hash, std::move(modded_string.String));
+            }
+        }
+    }
+
+    const fs::path string_table_cache_file = cache_folder / fs::path{ string_table_file.filename() }.replace_extension(".base");
+    const std::optional<FileStamp> string_table_stamp = GetFileStamp(string_table_file);
+
+    std::optional<BaseStringTable> base_table;
+    if (string_table_stamp.has_value())
+    {
+        base_table = ReadBaseStringTableCache(string_table_cache_file, string_table_stamp.value(), string_hashes_stamp);
+    }
+    if (!base_table.has_value())
+    {
+        const std::vector<std::uint32_t>* string_hashes = hash_file.GetHashes();
+        if (string_hashes == nullptr)
+        {
+            return false;
+        }
+
+        // Same as before string tables were cached, a missing table is not an error
+        base_table = CreateBaseStringTable(string_table_file, *string_hashes);
+        if (!base_table.has_value())
+        {
+            return true;
+        }
+        if (string_table_stamp.has_value())
+        {
+            WriteBaseStringTableCache(string_table_cache_file, base_table.value(), string_table_stamp.value(), string_hashes_stamp);
+        }
+    }
+
+    // Build the whole table in memory and write it at once
+    std::string merged_strings;
+    merged_strings.reserve(base_table->Text.size() + base_table->Text.size() / 4);
+    for (std::size_t j = 0; j < base_table->GetNumLines(); j++)
+    {
+        const std::uint32_t hash = base_table->Hashes[j];
+        if (hash != c_CommentStringHash)
+        {
+            if (auto it = modded_strings.find(hash); it != modded_strings.end())
+            {
+                merged_strings += it->second;
+                merged_strings += '\n';
+                continue;
+            }
+        }
+
+        merged_strings += base_table->GetLine(j);
+        merged_strings += '\n';
+    }
+
+    if (auto strings_destination_file = std::ofstream{ destination_file, std::ios::trunc })
+    {
+        strings_destination_file.write(merged_strings.data(), merged_strings.size());
+    }
+    return true;
+}
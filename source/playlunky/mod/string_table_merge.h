@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Identifies the version of a file that a cache was created from
+struct FileStamp
+{
+    std::uint64_t Size;
+    std::int64_t WriteTime;
+
+    bool operator==(const FileStamp&) const = default;
+};
+
+// The hash of each line of the original string tables, only parsed once the first table needs them
+class StringHashFile
+{
+  public:
+    explicit StringHashFile(std::filesystem::path hash_file_path);
+    StringHashFile(const StringHashFile&) = delete;
+    StringHashFile(StringHashFile&&) = delete;
+    StringHashFile& operator=(const StringHashFile&) = delete;
+    StringHashFile& operator=(StringHashFile&&) = delete;
+    ~StringHashFile() = default;
+
+    // Not set if the file does not exist
+    const std::optional<FileStamp>& GetStamp() const
+    {
+        return m_Stamp;
+    }
+
+    // Thread-safe, returns nullptr if the file can not be read
+    const std::vector<std::uint32_t>* GetHashes();
+
+  private:
+    std::filesystem::path m_Path;
+    std::optional<FileStamp> m_Stamp;
+
+    std::once_flag m_HashesFlag;
+    std::optional<std::vector<std::uint32_t>> m_Hashes;
+};
+
+// Replaces lines of an original string table with the strings of all string mods and writes the result to destination_file
+// Mod files are in order of priority, so the first string for each hash wins
+// Parsed tables and mod files are cached in cache_folder, so unchanged files are not parsed again
+// Returns false if the hash file or any mod file can not be parsed, independent of the virtual filesystem so it can be tested on its own
+bool MergeStringTable(StringHashFile& hash_file,
+                      const std::filesystem::path& string_table_file,
+                      std::span<const std::filesystem::path> mod_files,
+                      const std::filesystem::path& destination_file,
+                      const std::filesystem::path& cache_folder,
+                      bool speedrun_mode);
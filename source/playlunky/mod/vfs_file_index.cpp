@@ -0,0 +1,46 @@
+#include "vfs_file_index.h"
+
+#include <algorithm>
+#include <cstdint>
+
+static char GetKeyChar(char c)
+{
+    if (c == '\\')
+    {
+        return '/';
+    }
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::size_t VfsIndexKeyHash::operator()(std::string_view key) const
+{
+    std::uint64_t hash{ 0xcbf29ce484222325ull };
+    for (char c : key)
+    {
+        hash = (hash ^ static_cast<std::uint8_t>(GetKeyChar(c))) * 0x100000001b3ull;
+    }
+    return static_cast<std::size_t>(hash);
+}
+bool VfsIndexKeyEqual::operator()(std::string_view lhs, std::string_view rhs) const
+{
+    return std::ranges::equal(lhs, rhs, {}, &GetKeyChar, &GetKeyChar);
+}
+
+std::string GetVfsIndexKey(const std::filesystem::path& path)
+{
+    std::string key = path.string();
+    std::ranges::transform(key, key.begin(), &GetKeyChar);
+    return key;
+}
+bool VfsPathHasExtension(std::string_view path)
+{
+    const std::size_t file_name_start = path.find_last_of("/\\");
+    const std::string_view file_name = file_name_start == std::string_view::npos ? path : path.substr(file_name_start + 1);
+    if (file_name == "..")
+    {
+        return false;
+    }
+
+    const std::size_t dot = file_name.rfind('.');
+    return dot != std::string_view::npos && dot != 0;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "util/algorithms.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Hash and equality of index keys that ignore ascii case and treat both kinds of slashes the same,
+// so a path can be looked up as it is passed in without building a lowercase copy first
+struct VfsIndexKeyHash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view key) const;
+};
+struct VfsIndexKeyEqual
+{
+    using is_transparent = void;
+    bool operator()(std::string_view lhs, std::string_view rhs) const;
+};
+
+// Lowercase path with forward slashes, as stored in the index
+std::string GetVfsIndexKey(const std::filesystem::path& path);
+// Same as std::filesystem::path::has_extension, without building a path
+bool VfsPathHasExtension(std::string_view path);
+
+// Index of the files in mounted folders and packs, keyed by relative path and by relative path without extension
+// Each file lists the mounts that contain it in load order, MountT needs the Priority and MountOrder of VirtualFilesystem::VfsMount
+// The index is not synchronized, its owner has to guard it
+template<class MountT>
+class VfsFileIndex
+{
+  public:
+    struct IndexedFile
+    {
+        const MountT* Mount;
+        std::filesystem::path FileName;
+    };
+
+    void Add(const MountT* mount, const std::filesystem::path& relative_path)
+    {
+        auto add_to_index = [mount](Index& index, std::string key, std::filesystem::path file_name)
+        {
+            auto& indexed_files = index[std::move(key)];
+
+            // Only the first file with a given stem is found in a mount, same as when iterating the folder
+            if (algo::contains(indexed_files, &IndexedFile::Mount, mount))
+            {
+                return;
+            }
+
+            auto it = std::upper_bound(indexed_files.begin(), indexed_files.end(), mount, [](const MountT* lhs, const IndexedFile& rhs)
+                                       { return IsMountedBefore(lhs, rhs.Mount); });
+            indexed_files.insert(it, IndexedFile{ mount, std::move(file_name) });
+        };
+
+        add_to_index(m_FileIndex, GetVfsIndexKey(relative_path), relative_path.filename());
+        add_to_index(m_StemIndex, GetVfsIndexKey(std::filesystem::path{ relative_path }.replace_extension()), relative_path.filename());
+    }
+    void Remove(const MountT* mount, const std::filesystem::path& relative_path)
+    {
+        auto remove_from_index = [mount](Index& index, const std::string& key, const std::filesystem::path& file_name)
+        {
+            if (auto it = index.find(key); it != index.end())
+            {
+                std::erase_if(it->second, [&](const IndexedFile& indexed_file)
+                              { return indexed_file.Mount == mount && algo::is_same_path(indexed_file.FileName, file_name); });
+                if (it->second.empty())
+                {
+                    index.erase(it);
+                }
+            }
+        };
+
+        remove_from_index(m_FileIndex, GetVfsIndexKey(relative_path), relative_path.filename());
+        remove_from_index(m_StemIndex, GetVfsIndexKey(std::filesystem::path{ relative_path }.replace_extension()), relative_path.filename());
+    }
+
+    // Mounts that contain the file in load order, pathes without extension match any file with that stem
+    std::span<const IndexedFile> Find(std::string_view path) const
+    {
+        const Index& index = VfsPathHasExtension(path) ? m_FileIndex : m_StemIndex;
+        if (auto it = index.find(path); it != index.end())
+        {
+            return it->second;
+        }
+        return {};
+    }
+
+    // Lowercase relative pathes of all files inside of the folder or its subfolders
+    std::vector<std::string> GetFilePaths(const std::filesystem::path& folder) const
+    {
+        const std::string folder_prefix = GetVfsIndexKey(folder) + '/';
+
+        std::vector<std::string> file_paths;
+        for (const auto& [key, indexed_files] : m_FileIndex)
+        {
+            if (key.starts_with(folder_prefix))
+            {
+                file_paths.push_back(key);
+            }
+        }
+        return file_paths;
+    }
+
+    // Same order as the mounts of VirtualFilesystem, mounts of same priority are ordered by time of mounting
+    static bool IsMountedBefore(const MountT* lhs, const MountT* rhs)
+    {
+        return lhs->Priority < rhs->Priority || (lhs->Priority == rhs->Priority && lhs->MountOrder < rhs->MountOrder);
+    }
+
+  private:
+    using Index = std::unordered_map<std::string, std::vector<IndexedFile>, VfsIndexKeyHash, VfsIndexKeyEqual>;
+    Index m_FileIndex;
+    Index m_StemIndex;
+};
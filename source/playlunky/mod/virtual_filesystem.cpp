@@ -2,6 +2,8 @@
 
 #include "log.h"
 #include "util/algorithms.h"
+#include "util/mapped_file.h"
+#include "util/mod_pack.h"
 #include "util/on_scope_exit.h"
 
 #include <spel2.h>
@@ -18,15 +20,24 @@ class IVfsMountImpl
     virtual FileInfo* LoadFile(const char* file_path, void* (*allocator)(std::size_t)) const = 0;
     virtual std::optional<std::filesystem::path> GetFilePath(const std::filesystem::path& path) const = 0;
     virtual bool IsType(VfsType type) const = 0;
+
+    // Calls index_file with the relative path of each file in the mount, returns false if the mount can not be indexed
+    virtual bool IndexFiles(const std::function<void(const std::filesystem::path&)>& index_file) const = 0;
+    virtual std::filesystem::path GetFullPath(const std::filesystem::path& path) const = 0;
+    virtual std::optional<std::filesystem::path> GetRelativePath(const std::filesystem::path& file_path) const = 0;
+
+    // Packed mounts have no files on disk, so they can only be used for runtime loading
+    virtual bool IsPacked() const = 0;
 };
 
 class VfsFolderMount : public IVfsMountImpl
 {
   public:
-    VfsFolderMount(std::filesystem::path mounted_path, VfsType type)
+    VfsFolderMount(std::filesystem::path mounted_path, VfsType type, bool memory_mapped)
         : mMountedPath(std::move(mounted_path))
         , mMountedPathString(mMountedPath.string())
         , mType(type)
+        , mMemoryMapped(memory_mapped)
     {
         std::replace(mMountedPathString.begin(), mMountedPathString.end(), '\\', '/');
     }
@@ -44,6 +55,11 @@ class VfsFolderMount : public IVfsMountImpl
             sprintf_s(full_path, "%s/%s", mMountedPathString.c_str(), file_path);
         }
 
+        if (mMemoryMapped)
+        {
+            return LoadMappedFile(full_path, allocator);
+        }
+
         FILE* file{ nullptr };
         auto error = fopen_s(&file, full_path, "rb");
         if (error == 0 && file != nullptr)
@@ -120,20 +136,227 @@ class VfsFolderMount : public IVfsMountImpl
         return type == VfsType::Any || type == mType;
     }
 
+    virtual bool IndexFiles(const std::function<void(const std::filesystem::path&)>& index_file) const override
+    {
+        namespace fs = std::filesystem;
+
+        // The game folder contains all the mods, so we don't want to walk all of it
+        if (mMountedPath.empty())
+        {
+            return false;
+        }
+
+        if (fs::exists(mMountedPath))
+        {
+            for (const auto& dir_entry : fs::recursive_directory_iterator{ mMountedPath })
+            {
+                if (dir_entry.is_regular_file())
+                {
+                    index_file(dir_entry.path().lexically_relative(mMountedPath));
+                }
+            }
+        }
+        return true;
+    }
+    virtual std::filesystem::path GetFullPath(const std::filesystem::path& path) const override
+    {
+        return mMountedPath / path;
+    }
+    virtual std::optional<std::filesystem::path> GetRelativePath(const std::filesystem::path& file_path) const override
+    {
+        if (!mMountedPath.empty() && algo::is_sub_path(file_path, mMountedPath))
+        {
+            return file_path.lexically_relative(mMountedPath);
+        }
+        return std::nullopt;
+    }
+    virtual bool IsPacked() const override
+    {
+        return false;
+    }
+
   private:
+    FileInfo* LoadMappedFile(const char* full_path, void* (*allocator)(std::size_t)) const
+    {
+        // Copies straight from the mapped pages into the game's allocation, skipping the stdio buffering
+        // Can't hand out the mapping itself since the game owns and frees the returned buffer
+        MappedFile mapped_file{ full_path };
+        if (mapped_file.IsValid())
+        {
+            const std::span<const std::uint8_t> file_data = mapped_file.GetData();
+            const std::size_t file_size = file_data.size();
+
+            if (allocator == nullptr)
+            {
+                allocator = malloc;
+            }
+
+            const std::size_t allocation_size = file_size + sizeof(FileInfo);
+            if (void* buf = allocator(allocation_size))
+            {
+                void* data = static_cast<void*>(reinterpret_cast<char*>(buf) + 24);
+                if (!mapped_file.CopyTo(data) && !ReadFileData(full_path, data, file_size))
+                {
+                    LogError("Could not read file {}, this will either crash or cause glitches...", full_path);
+                }
+
+                FileInfo* file_info = new (buf) FileInfo();
+                *file_info = {
+                    .Data = data,
+                    .DataSize = static_cast<int>(file_size),
+                    .AllocationSize = static_cast<int>(allocation_size)
+                };
+
+                return file_info;
+            }
+        }
+
+        return nullptr;
+    }
+    // Fallback for when reading the mapped pages fails
+    static bool ReadFileData(const char* full_path, void* data, std::size_t size)
+    {
+        FILE* file{ nullptr };
+        auto error = fopen_s(&file, full_path, "rb");
+        if (error == 0 && file != nullptr)
+        {
+            auto close_file = OnScopeExit{ [file]()
+                                           { fclose(file); } };
+            return fread(data, 1, size, file) == size;
+        }
+        return false;
+    }
+
     std::filesystem::path mMountedPath;
     std::string mMountedPathString;
     VfsType mType;
+    bool mMemoryMapped;
+};
+
+class VfsPackMount : public IVfsMountImpl
+{
+  public:
+    VfsPackMount(std::filesystem::path pack_path, VfsType type)
+        : mPackPath(std::move(pack_path))
+        , mPack(mPackPath)
+        , mType(type)
+    {
+        if (!mPack.IsValid())
+        {
+            LogError("Could not open mod pack {}, it is either corrupt or from an incompatible version...", mPackPath.string());
+        }
+    }
+    virtual ~VfsPackMount() override = default;
+
+    virtual FileInfo* LoadFile(const char* file_path, void* (*allocator)(std::size_t)) const override
+    {
+        if (const ModPackEntry* entry = mPack.FindEntry(file_path))
+        {
+            if (allocator == nullptr)
+            {
+                allocator = malloc;
+            }
+
+            // Decompresses straight into the game's allocation, the pack limits entry sizes so this fits into an int
+            static_assert(sizeof(FileInfo) <= s_ModPackMaxFileInfoSize);
+            const std::size_t file_size = static_cast<std::size_t>(entry->Size);
+            const std::size_t allocation_size = file_size + sizeof(FileInfo);
+            if (void* buf = allocator(allocation_size))
+            {
+                void* data = static_cast<void*>(reinterpret_cast<char*>(buf) + 24);
+                if (!mPack.ReadEntry(*entry, std::span{ static_cast<std::uint8_t*>(data), file_size }))
+                {
+                    LogError("Could not read file {} from mod pack {}, this will either crash or cause glitches...", file_path, mPackPath.string());
+                }
+
+                FileInfo* file_info = new (buf) FileInfo();
+                *file_info = {
+                    .Data = data,
+                    .DataSize = static_cast<int>(file_size),
+                    .AllocationSize = static_cast<int>(allocation_size)
+                };
+
+                return file_info;
+            }
+        }
+
+        return nullptr;
+    }
+
+    virtual std::optional<std::filesystem::path> GetFilePath(const std::filesystem::path& path) const override
+    {
+        if (path.has_extension())
+        {
+            if (mPack.FindEntry(algo::path_string(path)) != nullptr)
+            {
+                return mPackPath / path;
+            }
+        }
+        else
+        {
+            const std::string stem = algo::to_lower(algo::path_string(path));
+            for (const ModPackEntry& entry : mPack.GetEntries())
+            {
+                if (std::filesystem::path{ entry.Path }.replace_extension() == stem)
+                {
+                    return mPackPath / entry.Path;
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    virtual bool IsType(VfsType type) const override
+    {
+        return type == VfsType::Any || type == mType;
+    }
+
+    virtual bool IndexFiles(const std::function<void(const std::filesystem::path&)>& index_file) const override
+    {
+        for (const ModPackEntry& entry : mPack.GetEntries())
+        {
+            index_file(entry.Path);
+        }
+        return true;
+    }
+    virtual std::filesystem::path GetFullPath(const std::filesystem::path& path) const override
+    {
+        return mPackPath / path;
+    }
+    virtual std::optional<std::filesystem::path> GetRelativePath(const std::filesystem::path& /*file_path*/) const override
+    {
+        // Packs are never written to at runtime
+        return std::nullopt;
+    }
+    virtual bool IsPacked() const override
+    {
+        return true;
+    }
+
+  private:
+    std::filesystem::path mPackPath;
+    ModPack mPack;
+    VfsType mType;
 };
 
 struct VirtualFilesystem::VfsMount
 {
     std::int64_t Priority;
+    std::size_t MountOrder;
+    bool Indexed{ false };
     std::vector<VfsMount*> LinkedMounts;
     std::unique_ptr<IVfsMountImpl> MountImpl;
 };
 
+// Same order as mMounts, mounts of same priority are ordered by time of mounting
+static bool IsMountedBefore(const VirtualFilesystem::VfsMount* lhs, const VirtualFilesystem::VfsMount* rhs)
+{
+    return VfsFileIndex<VirtualFilesystem::VfsMount>::IsMountedBefore(lhs, rhs);
+}
+
 VirtualFilesystem::VirtualFilesystem()
+    : m_RandomEngine{ static_cast<std::uint32_t>(time(nullptr)) }
 {
     srand(static_cast<unsigned int>(time(nullptr))); // use something better for randomness?
 }
@@ -141,16 +364,13 @@ VirtualFilesystem::~VirtualFilesystem() = default;
 
 VirtualFilesystem::VfsMount* VirtualFilesystem::MountFolder(std::string_view path, std::int64_t priority, VfsType type)
 {
-    namespace fs = std::filesystem;
-
     LogInfo("Mounting folder '{}' as a virtual filesystem...", path);
-
-    auto it = std::upper_bound(mMounts.begin(), mMounts.end(), priority, [](std::int64_t prio, const auto& mount)
-                               { return mount->Priority > prio; });
-    VfsMount* new_mount = new VfsMount{ .Priority = priority, .MountImpl = std::make_unique<VfsFolderMount>(path, type) };
-    mMounts.emplace(it, new_mount);
-
-    return new_mount;
+    return AddMount(priority, std::make_unique<VfsFolderMount>(path, type, m_MemoryMappedLoading));
+}
+VirtualFilesystem::VfsMount* VirtualFilesystem::MountPack(std::string_view path, std::int64_t priority, VfsType type)
+{
+    LogInfo("Mounting pack '{}' as a virtual filesystem...", path);
+    return AddMount(priority, std::make_unique<VfsPackMount>(path, type));
 }
 void VirtualFilesystem::LinkMounts(struct VfsMount* lhs_mount, struct VfsMount* rhs_mount)
 {
@@ -223,6 +443,21 @@ void VirtualFilesystem::LinkPathes(std::vector<LinkedPathesElement> pathes)
     }
 }
 
+void VirtualFilesystem::RegisterNewFile(const std::filesystem::path& file_path)
+{
+    std::unique_lock lock{ m_FileIndexMutex };
+    for (const auto& mount : mMounts)
+    {
+        if (mount->Indexed)
+        {
+            if (auto relative_path = mount->MountImpl->GetRelativePath(file_path))
+            {
+                AddToIndex(mount.get(), relative_path.value());
+            }
+        }
+    }
+}
+
 VirtualFilesystem::FileInfo* VirtualFilesystem::LoadFile(const char* path, void* (*allocator)(std::size_t)) const
 {
     if (mMounts.empty())
@@ -240,22 +475,50 @@ VirtualFilesystem::FileInfo* VirtualFilesystem::LoadFile(const char* path, void*
     // Should not need to use bound pathes here because those should all be handled during preprocessing
     // Bound pathes should usually contain one 'actual' game asset and the rest addon assets
     // Same reasoning for linked pathes
-    for (const auto& mount : mMounts)
+    // This runs for every file the game loads, so the full path of a file is only built when it is needed
+    MountedFileCandidates candidates;
+    const VfsMount* last_mount{ nullptr };
+    bool has_more_candidates{ true };
+    while (has_more_candidates)
     {
-        if (!m_CustomFilters.empty())
+        has_more_candidates = GetMountedFileCandidates(path_view, VfsType::Any, true, last_mount, candidates);
+        for (std::size_t i = 0; i < candidates.NumFiles; i++)
         {
-            if (const auto& asset_path = mount->MountImpl->GetFilePath(path))
+            const VfsMount* mount = candidates.Files[i].Mount;
+            last_mount = mount;
+
+            std::optional<std::filesystem::path> asset_path;
+            if (!mount->Indexed)
             {
+                asset_path = mount->MountImpl->GetFilePath(path);
+                if (!asset_path.has_value())
+                {
+                    continue;
+                }
+            }
+
+            if (!m_CustomFilters.empty())
+            {
+                if (!asset_path.has_value())
+                {
+                    asset_path = mount->MountImpl->GetFullPath(path);
+                }
                 if (!FilterPath(asset_path.value(), path_view, {}))
                 {
                     continue;
                 }
             }
-        }
 
-        if (FileInfo* loaded_data = mount->MountImpl->LoadFile(path, allocator))
-        {
-            return loaded_data;
+            if (FileInfo* loaded_data = mount->MountImpl->LoadFile(path, allocator))
+            {
+                return loaded_data;
+            }
+
+            // The file might have been deleted after it was indexed
+            if (mount->Indexed)
+            {
+                DropStaleFile(mount, asset_path.value_or(mount->MountImpl->GetFullPath(path)));
+            }
         }
     }
 
@@ -340,18 +603,23 @@ std::vector<std::filesystem::path> VirtualFilesystem::GetAllFilePaths(const std:
         return file_paths;
     }
 
-    for (const auto& mount : mMounts)
+    FindMountedFile(path, type, false, [&](const VfsMount*, const std::filesystem::path& file_path)
+                    {
+                        file_paths.push_back(file_path);
+                        return false; });
+
+    return file_paths;
+}
+
+std::optional<std::vector<std::string>> VirtualFilesystem::GetIndexedFilePaths(const std::filesystem::path& folder) const
+{
+    std::shared_lock lock{ m_FileIndexMutex };
+    if (!m_UnindexedMounts.empty())
     {
-        if (mount->MountImpl->IsType(type))
-        {
-            if (auto file_path = mount->MountImpl->GetFilePath(path))
-            {
-                file_paths.push_back(std::move(file_path).value());
-            }
-        }
+        return std::nullopt;
     }
 
-    return file_paths;
+    return m_FileIndex.GetFilePaths(folder);
 }
 
 bool VirtualFilesystem::IsAllowedFile(const std::filesystem::path& path) const
@@ -365,6 +633,201 @@ bool VirtualFilesystem::IsAllowedFile(const std::filesystem::path& path) const
     return true;
 }
 
+VirtualFilesystem::VfsMount* VirtualFilesystem::AddMount(std::int64_t priority, std::unique_ptr<IVfsMountImpl> mount_impl)
+{
+    auto it = std::upper_bound(mMounts.begin(), mMounts.end(), priority, [](std::int64_t prio, const auto& mount)
+                               { return mount->Priority > prio; });
+    VfsMount* new_mount = new VfsMount{ .Priority = priority, .MountOrder = mMounts.size(), .MountImpl = std::move(mount_impl) };
+    mMounts.emplace(it, new_mount);
+    IndexMount(new_mount);
+
+    return new_mount;
+}
+
+void VirtualFilesystem::IndexMount(VfsMount* mount)
+{
+    std::unique_lock lock{ m_FileIndexMutex };
+    mount->Indexed = mount->MountImpl->IndexFiles([this, mount](const std::filesystem::path& relative_path)
+                                                  { AddToIndex(mount, relative_path); });
+    if (!mount->Indexed)
+    {
+        auto it = std::upper_bound(m_UnindexedMounts.begin(), m_UnindexedMounts.end(), mount, IsMountedBefore);
+        m_UnindexedMounts.insert(it, mount);
+    }
+}
+void VirtualFilesystem::AddToIndex(const VfsMount* mount, const std::filesystem::path& relative_path) const
+{
+    m_FileIndex.Add(mount, relative_path);
+}
+void VirtualFilesystem::DropStaleFile(const VfsMount* mount, const std::filesystem::path& file_path) const
+{
+    namespace fs = std::filesystem;
+
+    if (mount->MountImpl->IsPacked() || fs::exists(file_path))
+    {
+        return;
+    }
+
+    const auto relative_path = mount->MountImpl->GetRelativePath(file_path);
+    if (!relative_path.has_value())
+    {
+        return;
+    }
+
+    // Another file with the same stem may have been hidden by the deleted file
+    const fs::path relative_stem = fs::path{ relative_path.value() }.replace_extension();
+    const std::optional<fs::path> same_stem_file = mount->MountImpl->GetFilePath(relative_stem);
+
+    std::unique_lock lock{ m_FileIndexMutex };
+    m_FileIndex.Remove(mount, relative_path.value());
+
+    if (same_stem_file.has_value())
+    {
+        if (auto same_stem_relative_path = mount->MountImpl->GetRelativePath(same_stem_file.value()))
+        {
+            AddToIndex(mount, same_stem_relative_path.value());
+        }
+    }
+}
+
+bool VirtualFilesystem::GetMountedFileCandidates(std::string_view path, VfsType type, bool include_packed, const VfsMount* after, MountedFileCandidates& candidates) const
+{
+    // File names are only needed to resolve pathes without extension
+    const bool match_stem = !VfsPathHasExtension(path);
+    auto is_candidate = [after](const VfsMount* mount)
+    {
+        return after == nullptr || IsMountedBefore(after, mount);
+    };
+
+    candidates.NumFiles = 0;
+
+    std::shared_lock lock{ m_FileIndexMutex };
+
+    const std::span<const IndexedFile> indexed_files = m_FileIndex.Find(path);
+
+    // Merge indexed files with the unindexed mounts, which have to be probed
+    auto indexed_it = std::find_if(indexed_files.begin(), indexed_files.end(), [&](const IndexedFile& indexed_file)
+                                   { return is_candidate(indexed_file.Mount); });
+    auto unindexed_it = std::find_if(m_UnindexedMounts.begin(), m_UnindexedMounts.end(), is_candidate);
+    while (indexed_it != indexed_files.end() || unindexed_it != m_UnindexedMounts.end())
+    {
+        if (candidates.NumFiles == candidates.Files.size())
+        {
+            return true;
+        }
+
+        const bool take_indexed = unindexed_it == m_UnindexedMounts.end() ||
+                                  (indexed_it != indexed_files.end() && IsMountedBefore(indexed_it->Mount, *unindexed_it));
+        if (take_indexed)
+        {
+            const IndexedFile& indexed_file = *indexed_it++;
+            const VfsMount* mount = indexed_file.Mount;
+            if ((include_packed || !mount->MountImpl->IsPacked()) && mount->MountImpl->IsType(type))
+            {
+                IndexedFile& candidate = candidates.Files[candidates.NumFiles++];
+                candidate.Mount = mount;
+                candidate.FileName = match_stem ? indexed_file.FileName : std::filesystem::path{};
+            }
+        }
+        else
+        {
+            const VfsMount* mount = *unindexed_it++;
+            if (mount->MountImpl->IsType(type))
+            {
+                IndexedFile& candidate = candidates.Files[candidates.NumFiles++];
+                candidate.Mount = mount;
+                candidate.FileName.clear();
+            }
+        }
+    }
+
+    return false;
+}
+
+template<class FunT>
+const VirtualFilesystem::VfsMount* VirtualFilesystem::FindMountedFile(const std::filesystem::path& path, VfsType type, bool include_packed, FunT&& fun) const
+{
+    namespace fs = std::filesystem;
+
+    // Pathes without extension match any file with that stem
+    const bool match_stem = !path.has_extension();
+    const std::string path_string = path.string();
+
+    // fun may load the file, so it runs without holding the index lock
+    MountedFileCandidates candidates;
+    const VfsMount* last_mount{ nullptr };
+    bool has_more_candidates{ true };
+    while (has_more_candidates)
+    {
+        has_more_candidates = GetMountedFileCandidates(path_string, type, include_packed, last_mount, candidates);
+        for (std::size_t i = 0; i < candidates.NumFiles; i++)
+        {
+            const IndexedFile& candidate = candidates.Files[i];
+            const VfsMount* mount = candidate.Mount;
+            last_mount = mount;
+
+            std::optional<fs::path> file_path;
+            if (mount->Indexed)
+            {
+                file_path = match_stem
+                                ? mount->MountImpl->GetFullPath(path.parent_path() / candidate.FileName)
+                                : mount->MountImpl->GetFullPath(path);
+
+                // Runtime loads drop deleted files when opening them fails, everything else checks that indexed files still exist
+                if (!include_packed && !fs::exists(file_path.value()))
+                {
+                    DropStaleFile(mount, file_path.value());
+                    file_path = mount->MountImpl->GetFilePath(path);
+                }
+            }
+            else
+            {
+                file_path = mount->MountImpl->GetFilePath(path);
+            }
+
+            if (file_path.has_value() && fun(mount, file_path.value()))
+            {
+                return mount;
+            }
+        }
+    }
+
+    return nullptr;
+}
+std::optional<std::filesystem::path> VirtualFilesystem::GetMountFilePath(const VfsMount* mount, const std::filesystem::path& path) const
+{
+    if (mount->MountImpl->IsPacked())
+    {
+        return std::nullopt;
+    }
+
+    if (!mount->Indexed)
+    {
+        return mount->MountImpl->GetFilePath(path);
+    }
+
+    const bool match_stem = !path.has_extension();
+
+    std::optional<std::filesystem::path> file_path;
+    {
+        std::shared_lock lock{ m_FileIndexMutex };
+        if (const IndexedFile* indexed_file = algo::find(m_FileIndex.Find(path.string()), &IndexedFile::Mount, mount))
+        {
+            file_path = match_stem
+                            ? mount->MountImpl->GetFullPath(path.parent_path() / indexed_file->FileName)
+                            : mount->MountImpl->GetFullPath(path);
+        }
+    }
+
+    if (file_path.has_value() && !std::filesystem::exists(file_path.value()))
+    {
+        DropStaleFile(mount, file_path.value());
+        return mount->MountImpl->GetFilePath(path);
+    }
+
+    return file_path;
+}
+
 std::optional<std::filesystem::path> VirtualFilesystem::GetFilePath(const VfsMount* mount,
                                                                     const std::filesystem::path& path,
                                                                     std::string_view path_view,
@@ -375,7 +838,7 @@ std::optional<std::filesystem::path> VirtualFilesystem::GetFilePath(const VfsMou
     {
         if (linked_mount->MountImpl->IsType(type))
         {
-            if (const auto return_path = linked_mount->MountImpl->GetFilePath(path))
+            if (const auto return_path = GetMountFilePath(linked_mount, path))
             {
                 std::filesystem::path file_path = std::move(return_path).value();
                 if (FilterPath(file_path, path_view, allowed_extensions))
@@ -386,7 +849,7 @@ std::optional<std::filesystem::path> VirtualFilesystem::GetFilePath(const VfsMou
         }
     }
 
-    return mount->MountImpl->GetFilePath(path);
+    return GetMountFilePath(mount, path);
 }
 
 const VirtualFilesystem::VfsMount* VirtualFilesystem::GetLinkedMount(
@@ -451,47 +914,46 @@ const VirtualFilesystem::VfsMount* VirtualFilesystem::GetLoadingMount(
         for (std::string_view bound_path_str : *bound_pathes)
         {
             std::filesystem::path bound_path = bound_path_str;
-            for (const auto& mount : mMounts)
-            {
-                if (mount->MountImpl->IsType(type) && mount->Priority < current_file_prio)
-                {
-                    if (auto bound_file_path = mount->MountImpl->GetFilePath(bound_path))
-                    {
-                        if (!FilterPath(bound_file_path.value(), path_view, allowed_extensions))
-                        {
-                            continue;
-                        }
-
-                        current_file_prio = mount->Priority;
-
-                        auto is_this_path = [&path](const std::filesystem::path& found_path)
-                        {
-                            if (path.has_extension())
-                            {
-                                return algo::is_end_of_path(path, found_path);
-                            }
-                            else
+            FindMountedFile(bound_path, type, false, [&](const VfsMount* mount, const std::filesystem::path& bound_file_path)
                             {
-                                auto found_path_no_ext = std::filesystem::path{ found_path }.replace_extension();
-                                return algo::is_end_of_path(path, found_path_no_ext);
-                            }
-                        };
-
-                        // Only assign pathes that we are actually looking for
-                        // Anything else blocks lower prio files by design
-                        if (is_this_path(bound_file_path.value()))
-                        {
-                            file_mount = mount.get();
-                        }
-                        else
-                        {
-                            file_mount = nullptr;
-                        }
-
-                        break; // into loop over bound pathes
-                    }
-                }
-            }
+                                // Mounts are sorted by priority, so nothing after this can win
+                                if (mount->Priority >= current_file_prio)
+                                {
+                                    return true;
+                                }
+
+                                if (!FilterPath(bound_file_path, path_view, allowed_extensions))
+                                {
+                                    return false;
+                                }
+
+                                current_file_prio = mount->Priority;
+
+                                auto is_this_path = [&path](const std::filesystem::path& found_path)
+                                {
+                                    if (path.has_extension())
+                                    {
+                                        return algo::is_end_of_path(path, found_path);
+                                    }
+                                    else
+                                    {
+                                        auto found_path_no_ext = std::filesystem::path{ found_path }.replace_extension();
+                                        return algo::is_end_of_path(path, found_path_no_ext);
+                                    }
+                                };
+
+                                // Only assign pathes that we are actually looking for
+                                // Anything else blocks lower prio files by design
+                                if (is_this_path(bound_file_path))
+                                {
+                                    file_mount = mount;
+                                }
+                                else
+                                {
+                                    file_mount = nullptr;
+                                }
+
+                                return true; });
 
             // No need to continue looking if we found a file in the first mount
             if (current_file_prio == mMounts.front()->Priority)
@@ -504,22 +966,9 @@ const VirtualFilesystem::VfsMount* VirtualFilesystem::GetLoadingMount(
     }
     else
     {
-        for (const auto& mount : mMounts)
-        {
-            if (mount->MountImpl->IsType(type))
-            {
-                if (auto file_path = mount->MountImpl->GetFilePath(path))
-                {
-                    if (FilterPath(file_path.value(), path_view, allowed_extensions))
-                    {
-                        return mount.get();
-                    }
-                }
-            }
-        }
+        return FindMountedFile(path, type, false, [&](const VfsMount*, const std::filesystem::path& file_path)
+                               { return FilterPath(file_path, path_view, allowed_extensions); });
     }
-
-    return nullptr;
 }
 
 const VirtualFilesystem::VfsMount* VirtualFilesystem::GetRandomLinkedMount(
@@ -563,7 +1012,7 @@ const VirtualFilesystem::VfsMount* VirtualFilesystem::GetRandomLinkedMount(
                                           all_mounts.erase(std::unique(all_mounts.begin(), all_mounts.end()), all_mounts.end());
                                           if (!all_mounts.empty())
                                           {
-                                              return all_mounts[rand() % all_mounts.size()]; // use something better for randomness??? nah...
+                                              return all_mounts[m_RandomEngine() % all_mounts.size()]; // use something better for randomness??? nah...
                                           }
                                           else
                                           {
@@ -623,7 +1072,7 @@ const VirtualFilesystem::VfsMount* VirtualFilesystem::GetRandomLoadingMount(
                                             std::vector<const VfsMount*> mounts = GetAllLoadingMounts(path, path_view, allowed_extensions, type);
                                             if (!mounts.empty())
                                             {
-                                                return mounts[rand() % mounts.size()]; // use something better for randomness??? nah...
+                                                return mounts[m_RandomEngine() % mounts.size()]; // use something better for randomness??? nah...
                                             }
                                             else
                                             {
@@ -644,42 +1093,25 @@ std::vector<const VirtualFilesystem::VfsMount*> VirtualFilesystem::GetAllLoading
     VfsType type) const
 {
     std::vector<const VfsMount*> mounts;
+    auto collect_mounts = [&](const VfsMount* mount, const std::filesystem::path& file_path)
+    {
+        if (FilterPath(file_path, path_view, allowed_extensions))
+        {
+            mounts.push_back(mount);
+        }
+        return false;
+    };
+
     if (const BoundPathes* bound_pathes = GetBoundPathes(path_view))
     {
         for (std::string_view bound_path : *bound_pathes)
         {
-            for (const auto& mount : mMounts)
-            {
-                if (mount->MountImpl->IsType(type))
-                {
-                    if (auto file_path_res = mount->MountImpl->GetFilePath(bound_path))
-                    {
-                        std::filesystem::path file_path = std::move(file_path_res).value();
-                        if (FilterPath(file_path, path_view, allowed_extensions))
-                        {
-                            mounts.push_back(mount.get());
-                        }
-                    }
-                }
-            }
+            FindMountedFile(bound_path, type, false, collect_mounts);
         }
     }
     else
     {
-        for (const auto& mount : mMounts)
-        {
-            if (mount->MountImpl->IsType(type))
-            {
-                if (auto file_path_res = mount->MountImpl->GetFilePath(path))
-                {
-                    std::filesystem::path file_path = std::move(file_path_res).value();
-                    if (FilterPath(file_path, path_view, allowed_extensions))
-                    {
-                        mounts.push_back(mount.get());
-                    }
-                }
-            }
-        }
+        FindMountedFile(path, type, false, collect_mounts);
     }
     return mounts;
 }
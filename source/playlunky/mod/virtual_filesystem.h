@@ -1,16 +1,24 @@
 #pragma once
 
+#include "vfs_file_index.h"
+
+#include <array>
 #include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <random>
+#include <shared_mutex>
 #include <span>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
 struct SpelunkyFileInfo;
+class IVfsMountImpl;
 
 enum class VfsType
 {
@@ -32,8 +40,16 @@ class VirtualFilesystem
 
     struct VfsMount;
     VfsMount* MountFolder(std::string_view path, std::int64_t priority, VfsType vfs_type);
+    // Packs can only be used for runtime loading, preprocessing never sees their files
+    VfsMount* MountPack(std::string_view path, std::int64_t priority, VfsType vfs_type);
     void LinkMounts(struct VfsMount* lhs, struct VfsMount* rhs);
 
+    // Load files at runtime through a memory mapping instead of stdio, only affects folders mounted afterwards
+    void SetMemoryMappedLoading(bool memory_mapped_loading)
+    {
+        m_MemoryMappedLoading = memory_mapped_loading;
+    }
+
     // Allow loading only files specified in this list
     void RestrictFiles(std::span<const std::string_view> files);
     bool HasRestrictedFiles() const
@@ -57,6 +73,9 @@ class VirtualFilesystem
     };
     void LinkPathes(std::vector<LinkedPathesElement> pathes);
 
+    // Files are indexed when their folder is mounted, files written into a mounted folder afterwards have to be registered
+    void RegisterNewFile(const std::filesystem::path& file_path);
+
     // Interface for runtime loading
     using FileInfo = SpelunkyFileInfo;
     FileInfo* LoadFile(const char* path, void* (*allocator)(std::size_t) = nullptr) const;
@@ -69,12 +88,38 @@ class VirtualFilesystem
     std::optional<std::filesystem::path> GetRandomFilePathFilterExt(const std::filesystem::path& path, std::span<const std::filesystem::path> allowed_extensions, VfsType type = VfsType::Any) const;
     std::vector<std::filesystem::path> GetAllFilePaths(const std::filesystem::path& path, VfsType type = VfsType::Any) const;
 
+    // Lists the lowercase relative pathes of all indexed files inside of the folder or its subfolders in a single pass over the index
+    // Returns nullopt if some mounts could not be indexed, the listing would be incomplete in that case
+    std::optional<std::vector<std::string>> GetIndexedFilePaths(const std::filesystem::path& folder) const;
+
   private:
     using BoundPathes = std::vector<std::string_view>;
     using LinkedPathes = std::vector<LinkedPathesElement>;
 
     bool IsAllowedFile(const std::filesystem::path& path) const;
 
+    VfsMount* AddMount(std::int64_t priority, std::unique_ptr<IVfsMountImpl> mount_impl);
+    void IndexMount(VfsMount* mount);
+    void AddToIndex(const VfsMount* mount, const std::filesystem::path& relative_path) const;
+    // Removes the file from the index if it does not exist anymore
+    void DropStaleFile(const VfsMount* mount, const std::filesystem::path& file_path) const;
+
+    using IndexedFile = VfsFileIndex<VfsMount>::IndexedFile;
+    // Candidates are collected in batches of fixed size, so lookups on the game's loading path do not allocate
+    struct MountedFileCandidates
+    {
+        std::array<IndexedFile, 8> Files;
+        std::size_t NumFiles{ 0 };
+    };
+    // Mounts of the given type that may contain the file in load order, mounts that are not indexed have to be probed
+    // Only collects mounts loaded after the given mount, returns false once all candidates were collected
+    bool GetMountedFileCandidates(std::string_view path, VfsType type, bool include_packed, const VfsMount* after, MountedFileCandidates& candidates) const;
+    // Calls fun with each mount of the given type that contains the file in load order until fun returns true, returns that mount
+    // Packed mounts are skipped unless include_packed is set, which is only done for runtime loading
+    template<class FunT>
+    const VfsMount* FindMountedFile(const std::filesystem::path& path, VfsType type, bool include_packed, FunT&& fun) const;
+    std::optional<std::filesystem::path> GetMountFilePath(const VfsMount* mount, const std::filesystem::path& path) const;
+
     std::optional<std::filesystem::path> GetFilePath(const VfsMount* mount, const std::filesystem::path& path, std::string_view path_view, std::span<const std::filesystem::path> allowed_extensions, VfsType type) const;
 
     const VfsMount* GetLinkedMount(const std::filesystem::path& path, std::string_view path_view, std::span<const std::filesystem::path> allowed_extensions, VfsType type) const;
@@ -99,6 +144,11 @@ class VirtualFilesystem
 
     std::vector<std::unique_ptr<VfsMount>> mMounts;
 
+    mutable std::shared_mutex m_FileIndexMutex;
+    // Mutable since lookups drop files that were deleted after indexing
+    mutable VfsFileIndex<VfsMount> m_FileIndex;
+    std::vector<const VfsMount*> m_UnindexedMounts;
+
     using CachedMountKey = std::variant<const BoundPathes*, const LinkedPathes*, std::filesystem::path>;
     struct CachedMount
     {
@@ -107,6 +157,10 @@ class VirtualFilesystem
     };
     mutable std::mutex m_MountCacheMutex;
     mutable std::vector<CachedMount> m_MountCache;
+    // Guarded by m_MountCacheMutex, rand() would be seeded per thread
+    mutable std::minstd_rand m_RandomEngine;
+
+    bool m_MemoryMappedLoading{ false };
 
     std::span<const std::string_view> m_RestrictedFiles;
     std::vector<CustomFilterFun> m_CustomFilters;
@@ -3,6 +3,7 @@
 #include "detour/detour.h"
 #include "detour/fmod_crap.h"
 #include "log.h"
+#include "mod/audio_cache.h"
 #include "mod/mod_manager.h"
 #include "mod/save_game.h"
 #include "mod/virtual_filesystem.h"
@@ -19,6 +20,7 @@ struct Playlunky::PlaylunkyImpl
     PlaylunkySettings Settings;
     std::unique_ptr<VirtualFilesystem> Vfs;
     std::unique_ptr<ModManager> Manager;
+    std::unique_ptr<AudioCache> Audio;
 };
 
 struct PlaylunkyDeleter
@@ -77,6 +79,12 @@ void Playlunky::Init()
     mImpl->Settings.WriteToFile("playlunky.ini");
 
     SetFmodVfs(mImpl->Vfs.get());
+    if (mImpl->Settings.GetBool("audio_settings", "lazy_load_audio_files", false))
+    {
+        const std::size_t audio_cache_size = static_cast<std::size_t>(std::max(mImpl->Settings.GetInt("audio_settings", "audio_cache_size", 256), 0)) * 1024 * 1024;
+        mImpl->Audio = std::make_unique<AudioCache>(audio_cache_size);
+        SetFmodAudioCache(mImpl->Audio.get());
+    }
     SetSaveGameVfs(mImpl->Vfs.get());
 }
 
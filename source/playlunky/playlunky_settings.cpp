@@ -79,6 +79,8 @@ void PlaylunkySettings::WriteToFile(std::string settings_file) const
                                                    KnownSetting{ .Name{ "enable_loose_file_warning" }, .AltCategory{ "settings" }, .DefaultValue{ "true" } },
                                                    KnownSetting{ .Name{ "enable_raw_string_loading" }, .DefaultValue{ "false" } },
                                                    KnownSetting{ .Name{ "disable_asset_caching" }, .DefaultValue{ "false" } },
+                                                   KnownSetting{ .Name{ "memory_mapped_file_loading" }, .DefaultValue{ "false" }, .Comment{ "Experimental and not shown to be faster, loads modded assets through memory mapped files instead of reading them" } },
+                                                   KnownSetting{ .Name{ "content_hash_change_detection" }, .DefaultValue{ "true" }, .Comment{ "Compares file contents when detecting changed mod files, avoids reconverting assets that were only touched or copied, files are hashed when they are first added or touched" } },
                                                    KnownSetting{ .Name{ "block_save_game" }, .DefaultValue{ "false" } },
                                                    KnownSetting{ .Name{ "allow_save_game_mods" }, .DefaultValue{ "true" } },
                                                    KnownSetting{ .Name{ "use_playlunky_save" }, .DefaultValue{ "false" } },
@@ -102,6 +104,8 @@ void PlaylunkySettings::WriteToFile(std::string settings_file) const
                                                  KnownSetting{ .Name{ "enable_loose_audio_files" }, .AltCategory{ "settings" }, .DefaultValue{ "true" } },
                                                  KnownSetting{ .Name{ "cache_decoded_audio_files" }, .AltCategory{ "settings" }, .DefaultValue{ "false" } },
                                                  KnownSetting{ .Name{ "synchronous_update" }, .DefaultValue{ "true" } },
+                                                 KnownSetting{ .Name{ "lazy_load_audio_files" }, .DefaultValue{ "false" }, .Comment{ "Decodes modded sounds when they are first played instead of at startup, saves memory with big soundpacks" } },
+                                                 KnownSetting{ .Name{ "audio_cache_size" }, .DefaultValue{ "256" }, .Comment{ "Memory in MB used to keep sounds around when lazy_load_audio_files is enabled" } },
                                              } },
         KnownCategory{ { "sprite_settings" }, {
                                                   KnownSetting{ .Name{ "random_character_select" }, .AltCategory{ "settings" }, .DefaultValue{ "false" } },
@@ -113,6 +117,8 @@ void PlaylunkySettings::WriteToFile(std::string settings_file) const
                                                   KnownSetting{ .Name{ "sprite_hot_load_delay" }, .DefaultValue{ "400" }, .Comment{ "Increase this value if you experience crashes when a sprite is reloaded" } },
                                                   KnownSetting{ .Name{ "enable_customizable_sheets" }, .DefaultValue{ "true" }, .Comment{ "Enables the customizable sprite sheets feature, does not work in speedrun mode" } },
                                                   KnownSetting{ .Name{ "enable_luminance_scaling" }, .DefaultValue{ "true" }, .Comment{ "Scales luminance of customized images based on the color" } },
+                                                  KnownSetting{ .Name{ "block_compressed_textures" }, .DefaultValue{ "false" }, .Comment{ "Experimental, writes converted and merged textures BC3 compressed, uses a quarter of the disk space and memory at a small loss in quality" } },
+                                                  KnownSetting{ .Name{ "image_cache_size" }, .DefaultValue{ "512" }, .Comment{ "Memory in MB used to keep decoded images around for hot-loading and customizable sheets" } },
                                               } },
         KnownCategory{ { "bug_fixes" }, {
                                             KnownSetting{ .Name{ "missing_thorns" }, .DefaultValue{ "true" }, .Comment{ "Adds textures for the missing jungle thorns configurations" } },
@@ -0,0 +1,287 @@
+#include "block_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// https://learn.microsoft.com/en-us/windows/win32/direct3d10/d3d10-graphics-programming-guide-resources-block-compression#bc3
+inline constexpr std::size_t c_BC3BlockSize{ 16 };
+
+using BlockPixels = std::array<std::array<std::uint8_t, 4>, 16>;
+
+static std::uint32_t GetNumBlocks(std::uint32_t pixels)
+{
+    return (pixels + 3) / 4;
+}
+
+static std::uint16_t ToRGB565(const std::array<std::uint8_t, 4>& color)
+{
+    const std::uint16_t r = static_cast<std::uint16_t>((color[0] * 31 + 127) / 255);
+    const std::uint16_t g = static_cast<std::uint16_t>((color[1] * 63 + 127) / 255);
+    const std::uint16_t b = static_cast<std::uint16_t>((color[2] * 31 + 127) / 255);
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+static std::array<std::int32_t, 3> FromRGB565(std::uint16_t color)
+{
+    const std::int32_t r = (color >> 11) & 0x1f;
+    const std::int32_t g = (color >> 5) & 0x3f;
+    const std::int32_t b = color & 0x1f;
+    return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+}
+static std::array<std::array<std::int32_t, 3>, 4> GetColorPalette(std::uint16_t color_0, std::uint16_t color_1)
+{
+    // BC3 always uses the four color mode, independent of the order of the endpoints
+    const auto c0 = FromRGB565(color_0);
+    const auto c1 = FromRGB565(color_1);
+    std::array<std::array<std::int32_t, 3>, 4> palette{ c0, c1 };
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        palette[2][i] = (2 * c0[i] + c1[i]) / 3;
+        palette[3][i] = (c0[i] + 2 * c1[i]) / 3;
+    }
+    return palette;
+}
+static std::array<std::uint8_t, 8> GetAlphaPalette(std::uint8_t alpha_0, std::uint8_t alpha_1)
+{
+    std::array<std::uint8_t, 8> palette{ alpha_0, alpha_1 };
+    if (alpha_0 > alpha_1)
+    {
+        for (std::int32_t i = 2; i < 8; i++)
+        {
+            palette[i] = static_cast<std::uint8_t>(((8 - i) * alpha_0 + (i - 1) * alpha_1) / 7);
+        }
+    }
+    else
+    {
+        for (std::int32_t i = 2; i < 6; i++)
+        {
+            palette[i] = static_cast<std::uint8_t>(((6 - i) * alpha_0 + (i - 1) * alpha_1) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    return palette;
+}
+
+static void EncodeAlphaBlock(const BlockPixels& pixels, std::uint8_t* block)
+{
+    std::uint8_t min_alpha{ 255 };
+    std::uint8_t max_alpha{ 0 };
+    for (const auto& pixel : pixels)
+    {
+        min_alpha = std::min(min_alpha, pixel[3]);
+        max_alpha = std::max(max_alpha, pixel[3]);
+    }
+
+    // Eight alpha values mode, the interpolated values are evenly spaced so the closest one can be computed directly
+    std::uint64_t indices{ 0 };
+    if (max_alpha > min_alpha)
+    {
+        const std::int32_t range = max_alpha - min_alpha;
+        for (std::size_t i = 0; i < pixels.size(); i++)
+        {
+            const std::int32_t step = ((pixels[i][3] - min_alpha) * 7 + range / 2) / range;
+            const std::uint64_t index = step == 7 ? 0 : step == 0 ? 1
+                                                                  : 8 - step;
+            indices |= index << (3 * i);
+        }
+    }
+
+    block[0] = max_alpha;
+    block[1] = min_alpha;
+    for (std::size_t i = 0; i < 6; i++)
+    {
+        block[2 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+    }
+}
+static void EncodeColorBlock(const BlockPixels& pixels, std::uint8_t* block)
+{
+    // Find the principal axis of the colors via power iteration on their covariance
+    std::array<float, 3> mean{};
+    for (const auto& pixel : pixels)
+    {
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            mean[i] += pixel[i];
+        }
+    }
+    for (float& channel : mean)
+    {
+        channel /= static_cast<float>(pixels.size());
+    }
+
+    std::array<std::array<float, 3>, 3> covariance{};
+    for (const auto& pixel : pixels)
+    {
+        const std::array<float, 3> offset{ pixel[0] - mean[0], pixel[1] - mean[1], pixel[2] - mean[2] };
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            for (std::size_t j = 0; j < 3; j++)
+            {
+                covariance[i][j] += offset[i] * offset[j];
+            }
+        }
+    }
+
+    std::array<float, 3> axis{ 1.0f, 1.0f, 1.0f };
+    for (std::size_t iteration = 0; iteration < 8; iteration++)
+    {
+        std::array<float, 3> next_axis{};
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            next_axis[i] = covariance[i][0] * axis[0] + covariance[i][1] * axis[1] + covariance[i][2] * axis[2];
+        }
+        const float length = std::max({ std::abs(next_axis[0]), std::abs(next_axis[1]), std::abs(next_axis[2]) });
+        if (length == 0.0f)
+        {
+            break;
+        }
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            axis[i] = next_axis[i] / length;
+        }
+    }
+
+    // Use the extreme colors along that axis as endpoints
+    std::size_t min_pixel{ 0 };
+    std::size_t max_pixel{ 0 };
+    float min_projection{ std::numeric_limits<float>::max() };
+    float max_projection{ std::numeric_limits<float>::lowest() };
+    for (std::size_t i = 0; i < pixels.size(); i++)
+    {
+        const float projection = pixels[i][0] * axis[0] + pixels[i][1] * axis[1] + pixels[i][2] * axis[2];
+        if (projection < min_projection)
+        {
+            min_projection = projection;
+            min_pixel = i;
+        }
+        if (projection > max_projection)
+        {
+            max_projection = projection;
+            max_pixel = i;
+        }
+    }
+
+    std::uint16_t color_0 = ToRGB565(pixels[max_pixel]);
+    std::uint16_t color_1 = ToRGB565(pixels[min_pixel]);
+    if (color_0 < color_1)
+    {
+        std::swap(color_0, color_1);
+    }
+
+    std::uint32_t indices{ 0 };
+    if (color_0 != color_1)
+    {
+        const auto palette = GetColorPalette(color_0, color_1);
+        for (std::size_t i = 0; i < pixels.size(); i++)
+        {
+            std::uint32_t best_index{ 0 };
+            std::int32_t best_distance{ std::numeric_limits<std::int32_t>::max() };
+            for (std::uint32_t j = 0; j < 4; j++)
+            {
+                const std::int32_t dr = pixels[i][0] - palette[j][0];
+                const std::int32_t dg = pixels[i][1] - palette[j][1];
+                const std::int32_t db = pixels[i][2] - palette[j][2];
+                const std::int32_t distance = dr * dr + dg * dg + db * db;
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best_index = j;
+                }
+            }
+            indices |= best_index << (2 * i);
+        }
+    }
+
+    std::memcpy(block, &color_0, sizeof(color_0));
+    std::memcpy(block + 2, &color_1, sizeof(color_1));
+    std::memcpy(block + 4, &indices, sizeof(indices));
+}
+
+std::size_t GetBC3CompressedSize(std::uint32_t width, std::uint32_t height)
+{
+    return static_cast<std::size_t>(GetNumBlocks(width)) * GetNumBlocks(height) * c_BC3BlockSize;
+}
+
+void CompressBC3(std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, std::span<std::uint8_t> blocks)
+{
+    assert(rgba.size() >= static_cast<std::size_t>(width) * height * 4);
+    assert(blocks.size() >= GetBC3CompressedSize(width, height));
+
+    const std::uint32_t num_blocks_x = GetNumBlocks(width);
+    const std::uint32_t num_blocks_y = GetNumBlocks(height);
+
+    // Block rows are independent of each other, so they are compressed in parallel
+    std::vector<std::uint32_t> block_rows(num_blocks_y);
+    std::iota(block_rows.begin(), block_rows.end(), 0);
+    std::for_each(std::execution::par, block_rows.begin(), block_rows.end(), [&](std::uint32_t block_y)
+                  {
+                      BlockPixels pixels;
+                      for (std::uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+                      {
+                          for (std::uint32_t y = 0; y < 4; y++)
+                          {
+                              const std::uint32_t source_y = std::min(block_y * 4 + y, height - 1);
+                              for (std::uint32_t x = 0; x < 4; x++)
+                              {
+                                  const std::uint32_t source_x = std::min(block_x * 4 + x, width - 1);
+                                  std::memcpy(pixels[y * 4 + x].data(), rgba.data() + (static_cast<std::size_t>(source_y) * width + source_x) * 4, 4);
+                              }
+                          }
+
+                          std::uint8_t* block = blocks.data() + (static_cast<std::size_t>(block_y) * num_blocks_x + block_x) * c_BC3BlockSize;
+                          EncodeAlphaBlock(pixels, block);
+                          EncodeColorBlock(pixels, block + 8);
+                      } });
+}
+
+void DecompressBC3(std::span<const std::uint8_t> blocks, std::uint32_t width, std::uint32_t height, std::span<std::uint8_t> rgba)
+{
+    assert(blocks.size() >= GetBC3CompressedSize(width, height));
+    assert(rgba.size() >= static_cast<std::size_t>(width) * height * 4);
+
+    const std::uint32_t num_blocks_x = GetNumBlocks(width);
+    const std::uint32_t num_blocks_y = GetNumBlocks(height);
+    for (std::uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+    {
+        for (std::uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+        {
+            const std::uint8_t* block = blocks.data() + (static_cast<std::size_t>(block_y) * num_blocks_x + block_x) * c_BC3BlockSize;
+
+            const auto alpha_palette = GetAlphaPalette(block[0], block[1]);
+            std::uint64_t alpha_indices{ 0 };
+            for (std::size_t i = 0; i < 6; i++)
+            {
+                alpha_indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+            }
+
+            std::uint16_t color_0;
+            std::uint16_t color_1;
+            std::uint32_t color_indices;
+            std::memcpy(&color_0, block + 8, sizeof(color_0));
+            std::memcpy(&color_1, block + 10, sizeof(color_1));
+            std::memcpy(&color_indices, block + 12, sizeof(color_indices));
+            const auto color_palette = GetColorPalette(color_0, color_1);
+
+            for (std::uint32_t y = 0; y < 4 && block_y * 4 + y < height; y++)
+            {
+                for (std::uint32_t x = 0; x < 4 && block_x * 4 + x < width; x++)
+                {
+                    const std::uint32_t i = y * 4 + x;
+                    const auto& color = color_palette[(color_indices >> (2 * i)) & 0x3];
+                    std::uint8_t* pixel = rgba.data() + ((static_cast<std::size_t>(block_y) * 4 + y) * width + block_x * 4 + x) * 4;
+                    pixel[0] = static_cast<std::uint8_t>(color[0]);
+                    pixel[1] = static_cast<std::uint8_t>(color[1]);
+                    pixel[2] = static_cast<std::uint8_t>(color[2]);
+                    pixel[3] = alpha_palette[(alpha_indices >> (3 * i)) & 0x7];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// BC3 (aka DXT5) block compression of tightly packed RGBA8 images
+// Images that are not a multiple of 4 in size are padded by repeating their edge pixels
+std::size_t GetBC3CompressedSize(std::uint32_t width, std::uint32_t height);
+void CompressBC3(std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, std::span<std::uint8_t> blocks);
+void DecompressBC3(std::span<const std::uint8_t> blocks, std::uint32_t width, std::uint32_t height, std::span<std::uint8_t> rgba);
@@ -1,5 +1,6 @@
 #include "util/color.h"
 
+#include <algorithm>
 #include <array>
 #include <random>
 #include <span>
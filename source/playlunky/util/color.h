@@ -1,6 +1,8 @@
 #pragma once
 
 #include <compare>
+#include <cstdint>
+#include <tuple>
 #include <vector>
 
 struct ColorRGB8
@@ -0,0 +1,214 @@
+#include "connected_components.h"
+
+#include <algorithm>
+#include <limits>
+
+inline constexpr std::uint32_t c_NoLabel{ std::numeric_limits<std::uint32_t>::max() };
+
+struct ForegroundComponent
+{
+    std::uint32_t Parent;
+    std::uint32_t MinX;
+    std::uint32_t MinY;
+    std::uint32_t MaxX;
+    std::uint32_t MaxY;
+    std::size_t FirstPixel;
+    // The background left of the first pixel is the background the component lies in, c_NoLabel if that is outside of the mask
+    std::uint32_t EnclosingBackground;
+};
+struct BackgroundRegion
+{
+    std::uint32_t Parent;
+    bool TouchesBorder;
+};
+
+template<class NodeT>
+static std::uint32_t FindRoot(std::vector<NodeT>& nodes, std::uint32_t label)
+{
+    while (nodes[label].Parent != label)
+    {
+        nodes[label].Parent = nodes[nodes[label].Parent].Parent;
+        label = nodes[label].Parent;
+    }
+    return label;
+}
+
+// The root is always the component that starts first, so it knows the first pixel of the merged component
+static std::uint32_t Unite(std::vector<ForegroundComponent>& components, std::uint32_t lhs, std::uint32_t rhs)
+{
+    lhs = FindRoot(components, lhs);
+    rhs = FindRoot(components, rhs);
+    if (lhs == rhs)
+    {
+        return lhs;
+    }
+
+    if (components[rhs].FirstPixel < components[lhs].FirstPixel)
+    {
+        std::swap(lhs, rhs);
+    }
+
+    ForegroundComponent& root = components[lhs];
+    const ForegroundComponent& child = components[rhs];
+    root.MinX = std::min(root.MinX, child.MinX);
+    root.MinY = std::min(root.MinY, child.MinY);
+    root.MaxX = std::max(root.MaxX, child.MaxX);
+    root.MaxY = std::max(root.MaxY, child.MaxY);
+    components[rhs].Parent = lhs;
+    return lhs;
+}
+static std::uint32_t Unite(std::vector<BackgroundRegion>& regions, std::uint32_t lhs, std::uint32_t rhs)
+{
+    lhs = FindRoot(regions, lhs);
+    rhs = FindRoot(regions, rhs);
+    if (lhs != rhs)
+    {
+        regions[lhs].TouchesBorder = regions[lhs].TouchesBorder || regions[rhs].TouchesBorder;
+        regions[rhs].Parent = lhs;
+    }
+    return lhs;
+}
+
+// Runs of equal pixels in a row, end is exclusive
+struct Run
+{
+    std::uint32_t Begin;
+    std::uint32_t End;
+    std::uint32_t Label;
+    bool Foreground;
+};
+
+std::vector<ImageSubRegion> GetOuterComponentBounds(std::span<const std::uint8_t> mask, std::uint32_t width, std::uint32_t height, std::size_t stride)
+{
+    // Foreground is 8-connected and background 4-connected, as in findContours
+    std::vector<ForegroundComponent> components;
+    std::vector<BackgroundRegion> background_regions;
+
+    std::vector<Run> previous_runs;
+    std::vector<Run> runs;
+    for (std::uint32_t y = 0; y < height; y++)
+    {
+        const std::uint8_t* row = mask.data() + y * stride;
+
+        runs.clear();
+        for (std::uint32_t x = 0; x < width;)
+        {
+            const bool foreground = row[x] != 0;
+            const std::uint32_t begin = x;
+            while (x < width && (row[x] != 0) == foreground)
+            {
+                x++;
+            }
+            runs.push_back(Run{
+                .Begin{ begin },
+                .End{ x },
+                .Label{ c_NoLabel },
+                .Foreground{ foreground },
+            });
+        }
+
+        std::size_t first_previous_run{ 0 };
+        for (std::size_t i = 0; i < runs.size(); i++)
+        {
+            Run& run = runs[i];
+
+            // Foreground also connects diagonally, so it touches runs of the previous row that end right before or start right after it
+            const std::uint32_t touch_begin = run.Foreground && run.Begin > 0 ? run.Begin - 1 : run.Begin;
+            const std::uint32_t touch_end = run.Foreground ? run.End + 1 : run.End;
+            while (first_previous_run < previous_runs.size() && previous_runs[first_previous_run].End <= touch_begin)
+            {
+                first_previous_run++;
+            }
+
+            std::uint32_t label{ c_NoLabel };
+            for (std::size_t j = first_previous_run; j < previous_runs.size() && previous_runs[j].Begin < touch_end; j++)
+            {
+                const Run& previous_run = previous_runs[j];
+                if (previous_run.Foreground == run.Foreground)
+                {
+                    if (run.Foreground)
+                    {
+                        label = label == c_NoLabel ? FindRoot(components, previous_run.Label) : Unite(components, label, previous_run.Label);
+                    }
+                    else
+                    {
+                        label = label == c_NoLabel ? FindRoot(background_regions, previous_run.Label) : Unite(background_regions, label, previous_run.Label);
+                    }
+                }
+            }
+
+            if (run.Foreground)
+            {
+                if (label == c_NoLabel)
+                {
+                    label = static_cast<std::uint32_t>(components.size());
+                    components.push_back(ForegroundComponent{
+                        .Parent{ label },
+                        .MinX{ run.Begin },
+                        .MinY{ y },
+                        .MaxX{ run.End - 1 },
+                        .MaxY{ y },
+                        .FirstPixel{ static_cast<std::size_t>(y) * width + run.Begin },
+                        .EnclosingBackground{ i > 0 ? runs[i - 1].Label : c_NoLabel },
+                    });
+                }
+                else
+                {
+                    ForegroundComponent& component = components[label];
+                    component.MinX = std::min(component.MinX, run.Begin);
+                    component.MaxX = std::max(component.MaxX, run.End - 1);
+                    component.MaxY = y;
+                }
+            }
+            else
+            {
+                const bool touches_border = y == 0 || y + 1 == height || run.Begin == 0 || run.End == width;
+                if (label == c_NoLabel)
+                {
+                    label = static_cast<std::uint32_t>(background_regions.size());
+                    background_regions.push_back(BackgroundRegion{
+                        .Parent{ label },
+                        .TouchesBorder{ touches_border },
+                    });
+                }
+                else if (touches_border)
+                {
+                    background_regions[label].TouchesBorder = true;
+                }
+            }
+            run.Label = label;
+        }
+        std::swap(runs, previous_runs);
+    }
+
+    std::vector<const ForegroundComponent*> outer_components;
+    for (std::uint32_t i = 0; i < components.size(); i++)
+    {
+        const ForegroundComponent& component = components[i];
+        if (component.Parent == i)
+        {
+            const bool is_outer = component.EnclosingBackground == c_NoLabel || background_regions[FindRoot(background_regions, component.EnclosingBackground)].TouchesBorder;
+            if (is_outer)
+            {
+                outer_components.push_back(&component);
+            }
+        }
+    }
+
+    // findContours lists the contours found last first
+    std::sort(outer_components.begin(), outer_components.end(), [](const ForegroundComponent* lhs, const ForegroundComponent* rhs)
+              { return lhs->FirstPixel > rhs->FirstPixel; });
+
+    std::vector<ImageSubRegion> bounds;
+    bounds.reserve(outer_components.size());
+    for (const ForegroundComponent* component : outer_components)
+    {
+        bounds.push_back(ImageSubRegion{
+            .x{ static_cast<std::int32_t>(component->MinX) },
+            .y{ static_cast<std::int32_t>(component->MinY) },
+            .width{ component->MaxX - component->MinX + 1 },
+            .height{ component->MaxY - component->MinY + 1 },
+        });
+    }
+    return bounds;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "util/image.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Bounding rects of the 8-connected components of non-zero pixels in the mask, skipping components that lie inside holes of other components
+// Gives the same rects in the same order as calling cv::boundingRect on the contours from cv::findContours(mask, cv::RETR_EXTERNAL, ...)
+// Labels runs of pixels in a single pass over the mask, keeping only the runs of the previous row
+std::vector<ImageSubRegion> GetOuterComponentBounds(std::span<const std::uint8_t> mask, std::uint32_t width, std::uint32_t height, std::size_t stride);
@@ -1,12 +1,13 @@
 #include "image.h"
 
 #include "log.h"
-#include "util/algorithms.h"
+#include "util/connected_components.h"
 #include "util/format.h"
+#include "util/pixel_blend.h"
 #include "util/span_util.h"
 
-#include <array>
 #include <fstream>
+#include <unordered_set>
 
 #pragma warning(push)
 #pragma warning(disable : 5054)
@@ -43,19 +44,12 @@ bool Image::Load(const std::filesystem::path& file)
     mImpl->Width = mImpl->Image.cols;
     mImpl->Height = mImpl->Image.rows;
 
-    if (!ConvertToRGBA())
+    if (!ConvertToRGBA(true))
     {
         mImpl = nullptr;
         return false;
     }
 
-    mImpl->Image.forEach<cv::Vec4b>([](cv::Vec4b& pixel, [[maybe_unused]] const int position[])
-                                    {
-                                        float alpha = (float)pixel[3] / 255.0f;
-                                        pixel[0] = (uchar)((float)pixel[0] * alpha);
-                                        pixel[1] = (uchar)((float)pixel[1] * alpha);
-                                        pixel[2] = (uchar)((float)pixel[2] * alpha); });
-
     return true;
 }
 bool Image::Load(const std::span<std::uint8_t>& data)
@@ -75,7 +69,7 @@ bool Image::Load(const std::span<std::uint8_t>& data)
     mImpl->Width = mImpl->Image.cols;
     mImpl->Height = mImpl->Image.rows;
 
-    if (!ConvertToRGBA())
+    if (!ConvertToRGBA(false))
     {
         mImpl = nullptr;
         return false;
@@ -197,40 +191,24 @@ std::vector<std::pair<Image, ImageSubRegion>> Image::GetSprites() const
         return {};
     }
 
-    std::vector<cv::Mat> channels;
-    cv::split(mImpl->Image, channels);
+    cv::Mat alpha;
+    cv::extractChannel(mImpl->Image, alpha, 3);
 
     cv::Mat binary;
-    cv::threshold(channels[3], binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
-
-    std::vector<cv::Mat> contours;
-    cv::findContours(binary, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-
-    if (contours.empty())
-    {
-        return {};
-    }
+    cv::threshold(alpha, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
 
-    std::vector<std::pair<cv::Mat, ImageSubRegion>> contours_and_regions;
-    for (cv::Mat& contour : contours)
-    {
-        cv::Rect rect = cv::boundingRect(contour);
-        const ImageSubRegion sub_region{
-            .x{ rect.x },
-            .y{ rect.y },
-            .width{ static_cast<std::uint32_t>(rect.width) },
-            .height{ static_cast<std::uint32_t>(rect.height) }
-        };
-        contours_and_regions.push_back({ std::move(contour), sub_region });
-    }
-    std::sort(contours_and_regions.begin(), contours_and_regions.end(), [](const auto& lhs, const auto& rhs)
-              { return lhs.second.x * lhs.second.x + lhs.second.y * lhs.second.y < rhs.second.x * rhs.second.x + rhs.second.y * rhs.second.y; });
+    std::vector<ImageSubRegion> sub_regions = GetOuterComponentBounds(
+        std::span{ binary.data, binary.step * binary.rows },
+        static_cast<std::uint32_t>(binary.cols),
+        static_cast<std::uint32_t>(binary.rows),
+        binary.step);
+    std::sort(sub_regions.begin(), sub_regions.end(), [](const auto& lhs, const auto& rhs)
+              { return lhs.x * lhs.x + lhs.y * lhs.y < rhs.x * rhs.x + rhs.y * rhs.y; });
 
     std::vector<std::pair<Image, ImageSubRegion>> images;
-    for (const auto& [contour, sub_region] : contours_and_regions)
+    for (const ImageSubRegion& sub_region : sub_regions)
     {
         Image sub_image = GetSubImage(sub_region);
-        std::vector<ColorRGB8> unique_colors = sub_image.GetUniqueColors();
         if (sub_image.mImpl != nullptr)
         {
             images.push_back({ std::move(sub_image), sub_region });
@@ -264,16 +242,26 @@ std::vector<ColorRGB8> Image::GetUniqueColors(std::size_t max_numbers) const
         return {};
     }
 
+    // Keeps the first distinct colors in scan order, the set only answers whether a color was seen before
     std::vector<ColorRGB8> unique_colors;
-    for (const cv::Vec4b& cv_pixel : cv::Mat_<cv::Vec4b>(mImpl->Image))
+    std::unordered_set<std::uint32_t> seen_colors;
+    for (int y = 0; y < mImpl->Image.rows && unique_colors.size() < max_numbers; y++)
     {
-        const ColorRGB8& pixel = reinterpret_cast<const ColorRGB8&>(cv_pixel);
-        if (cv_pixel[3] == 255 && !algo::contains(unique_colors, pixel))
+        const cv::Vec4b* row = mImpl->Image.ptr<cv::Vec4b>(y);
+        for (int x = 0; x < mImpl->Image.cols; x++)
         {
-            unique_colors.push_back(pixel);
-            if (unique_colors.size() >= max_numbers)
+            const cv::Vec4b& cv_pixel = row[x];
+            if (cv_pixel[3] == 255)
             {
-                break;
+                const std::uint32_t rgb = cv_pixel[0] | (cv_pixel[1] << 8) | (cv_pixel[2] << 16);
+                if (seen_colors.insert(rgb).second)
+                {
+                    unique_colors.push_back(reinterpret_cast<const ColorRGB8&>(cv_pixel));
+                    if (unique_colors.size() >= max_numbers)
+                    {
+                        break;
+                    }
+                }
             }
         }
     }
@@ -438,7 +426,7 @@ void Image::DebugShowWith(const Image& other) const
     }
 }
 
-bool Image::ConvertToRGBA()
+bool Image::ConvertToRGBA(bool premultiply_alpha)
 {
     switch (mImpl->Image.channels())
     {
@@ -449,7 +437,6 @@ bool Image::ConvertToRGBA()
         return false;
     case 3:
     {
-        std::vector<cv::Mat> channels;
         if (mImpl->Image.type() != CV_8UC3)
         {
             double alpha = 1.0;
@@ -482,17 +469,12 @@ bool Image::ConvertToRGBA()
             }
             mImpl->Image.convertTo(mImpl->Image, CV_8UC3, alpha, beta);
         }
-        cv::split(mImpl->Image, channels);
-        std::swap(channels[0], channels[2]);
-        cv::Mat alpha(channels[0].size(), channels[0].type());
-        alpha = cv::Scalar(255);
-        channels.push_back(alpha);
-        cv::merge(channels, mImpl->Image);
+        // Fully opaque, so premultiplying would not change anything
+        cv::cvtColor(mImpl->Image, mImpl->Image, cv::COLOR_BGR2RGBA);
         return true;
     }
     case 4:
     {
-        std::vector<cv::Mat> channels;
         if (mImpl->Image.type() != CV_8UC4)
         {
             double alpha = 1.0;
@@ -525,9 +507,20 @@ bool Image::ConvertToRGBA()
             }
             mImpl->Image.convertTo(mImpl->Image, CV_8UC4, alpha, beta);
         }
-        cv::split(mImpl->Image, channels);
-        std::swap(channels[0], channels[2]);
-        cv::merge(channels, mImpl->Image);
+        if (premultiply_alpha)
+        {
+            cv::Mat& image = mImpl->Image;
+            cv::parallel_for_(cv::Range{ 0, image.rows }, [&](const cv::Range& rows)
+                              {
+                                  for (int row = rows.start; row < rows.end; row++)
+                                  {
+                                      PremultiplyBGRAPixels({ image.ptr<std::uint8_t>(row), static_cast<std::size_t>(image.cols) * 4 });
+                                  } });
+        }
+        else
+        {
+            cv::cvtColor(mImpl->Image, mImpl->Image, cv::COLOR_BGRA2RGBA);
+        }
         return true;
     }
     }
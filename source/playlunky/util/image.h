@@ -116,7 +116,8 @@ class Image
     };
 
   private:
-    bool ConvertToRGBA();
+    // Converts the decoded BGR(A) image to RGBA8 in a single pass over the pixels
+    bool ConvertToRGBA(bool premultiply_alpha);
 
     struct ImageImpl;
     std::unique_ptr<ImageImpl> mImpl;
@@ -0,0 +1,44 @@
+#include "image_cache.h"
+
+#include "util/algorithms.h"
+
+static std::string GetCacheKey(const std::filesystem::path& image_path)
+{
+    std::error_code error_code;
+    const std::filesystem::path absolute_path = std::filesystem::absolute(image_path, error_code);
+    return algo::to_lower(algo::path_string(error_code ? image_path.lexically_normal() : absolute_path.lexically_normal()));
+}
+
+ImageCache::ImageCache(std::size_t budget_bytes)
+    : mImages{ budget_bytes }
+{
+}
+ImageCache::~ImageCache() = default;
+
+std::shared_ptr<const Image> ImageCache::GetImage(const std::filesystem::path& image_path)
+{
+    std::error_code error_code;
+    const auto last_write_time = std::filesystem::last_write_time(image_path, error_code);
+    if (error_code)
+    {
+        mUncachedLoads++;
+        auto image = std::make_shared<Image>();
+        image->Load(image_path);
+        return image;
+    }
+
+    return mImages.Get(GetCacheKey(image_path), last_write_time, [&]()
+                       {
+                           auto image = std::make_shared<Image>();
+                           const bool loaded = image->Load(image_path);
+                           const std::size_t image_size = image->GetData().size();
+                           return LruCache<Image, std::filesystem::file_time_type>::LoadResult{ std::move(image), image_size, loaded }; });
+}
+void ImageCache::Invalidate(const std::filesystem::path& image_path)
+{
+    mImages.Erase(GetCacheKey(image_path));
+}
+void ImageCache::Clear()
+{
+    mImages.Clear();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "util/image.h"
+#include "util/lru_cache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+// Cache of decoded images shared by all image processing, keyed by path and last write time so changed files are decoded again
+class ImageCache
+{
+  public:
+    explicit ImageCache(std::size_t budget_bytes);
+    ImageCache(const ImageCache&) = delete;
+    ImageCache(ImageCache&&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+    ImageCache& operator=(ImageCache&&) = delete;
+    ~ImageCache();
+
+    // Images that fail to load are returned but not cached
+    std::shared_ptr<const Image> GetImage(const std::filesystem::path& image_path);
+    void Invalidate(const std::filesystem::path& image_path);
+    void Clear();
+
+    std::uint64_t GetHits() const
+    {
+        return mImages.GetHits();
+    }
+    std::uint64_t GetMisses() const
+    {
+        return mImages.GetMisses() + mUncachedLoads;
+    }
+
+  private:
+    LruCache<Image, std::filesystem::file_time_type> mImages;
+    std::atomic<std::uint64_t> mUncachedLoads{ 0 }; // Images without a write time, they can't be cached
+};
@@ -0,0 +1,439 @@
+#include "pixel_blend.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <tuple>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define PIXEL_BLEND_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+static std::uint8_t ToChannel(float value)
+{
+    return static_cast<std::uint8_t>(std::clamp(value * 255.0f, 0.0f, 255.0f));
+}
+static void MixPixel(std::uint8_t* pixel, std::tuple<float, float, float> color, std::uint8_t color_alpha)
+{
+    const auto [fr, fg, fb] = color;
+    const auto r = ToChannel(fr);
+    const auto g = ToChannel(fg);
+    const auto b = ToChannel(fb);
+
+    const float alpha = color_alpha / 255.0f;
+    pixel[0] = static_cast<std::uint8_t>(pixel[0] * (1.0f - alpha) + r * alpha);
+    pixel[1] = static_cast<std::uint8_t>(pixel[1] * (1.0f - alpha) + g * alpha);
+    pixel[2] = static_cast<std::uint8_t>(pixel[2] * (1.0f - alpha) + b * alpha);
+}
+static float GetPixelLuminance(const std::uint8_t* pixel)
+{
+    return GetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f);
+}
+static std::tuple<float, float, float> SetPixelLuminance(const std::uint8_t* pixel, float luminance)
+{
+    return SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, luminance);
+}
+
+static std::uint32_t ToRGBMask(ColorRGB8 color)
+{
+    return color.r | (color.g << 8) | (color.b << 16);
+}
+static bool HasColor(const std::uint8_t* pixel, ColorRGB8 color)
+{
+    return pixel[0] == color.r && pixel[1] == color.g && pixel[2] == color.b;
+}
+static void SetColor(std::uint8_t* pixel, ColorRGB8 color)
+{
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+}
+
+#ifdef PIXEL_BLEND_USE_SSE2
+// Four pixels at a time, one pixel per lane, all float math is done in the same order as in the scalar code
+struct ChannelsSSE2
+{
+    __m128 r;
+    __m128 g;
+    __m128 b;
+};
+
+static __m128i LoadPixels(const std::uint8_t* pixels)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+}
+static void StorePixels(std::uint8_t* pixels, __m128i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), value);
+}
+
+template<int Shift>
+static __m128i GetChannel(__m128i pixels)
+{
+    return _mm_and_si128(_mm_srli_epi32(pixels, Shift), _mm_set1_epi32(0xff));
+}
+static __m128 GetNormalizedChannel(__m128i channel)
+{
+    return _mm_div_ps(_mm_cvtepi32_ps(channel), _mm_set1_ps(255.0f));
+}
+static ChannelsSSE2 GetNormalizedChannels(__m128i pixels)
+{
+    return ChannelsSSE2{
+        .r{ GetNormalizedChannel(GetChannel<0>(pixels)) },
+        .g{ GetNormalizedChannel(GetChannel<8>(pixels)) },
+        .b{ GetNormalizedChannel(GetChannel<16>(pixels)) },
+    };
+}
+
+static __m128 Select(__m128 mask, __m128 lhs, __m128 rhs)
+{
+    return _mm_or_ps(_mm_and_ps(mask, lhs), _mm_andnot_ps(mask, rhs));
+}
+static __m128i Select(__m128i mask, __m128i lhs, __m128i rhs)
+{
+    return _mm_or_si128(_mm_and_si128(mask, lhs), _mm_andnot_si128(mask, rhs));
+}
+
+static __m128 GetLuminanceSSE2(const ChannelsSSE2& color)
+{
+    const __m128 r = _mm_mul_ps(_mm_set1_ps(0.3f), color.r);
+    const __m128 g = _mm_mul_ps(_mm_set1_ps(0.59f), color.g);
+    const __m128 b = _mm_mul_ps(_mm_set1_ps(0.11f), color.b);
+    return _mm_add_ps(_mm_add_ps(r, g), b);
+}
+static ChannelsSSE2 SetLuminanceSSE2(ChannelsSSE2 color, __m128 luminance)
+{
+    const __m128 d = _mm_sub_ps(luminance, GetLuminanceSSE2(color));
+    color.r = _mm_add_ps(color.r, d);
+    color.g = _mm_add_ps(color.g, d);
+    color.b = _mm_add_ps(color.b, d);
+
+    const __m128 l = GetLuminanceSSE2(color);
+    const __m128 n = _mm_min_ps(color.r, _mm_min_ps(color.g, color.b));
+    const __m128 x = _mm_max_ps(color.r, _mm_max_ps(color.g, color.b));
+
+    const __m128 n_mask = _mm_cmplt_ps(n, _mm_setzero_ps());
+    const __m128 n_scale = _mm_sub_ps(l, n);
+    const auto clip_min = [&](__m128 c)
+    {
+        const __m128 clipped = _mm_add_ps(l, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(c, l), l), n_scale));
+        return Select(n_mask, clipped, c);
+    };
+    color.r = clip_min(color.r);
+    color.g = clip_min(color.g);
+    color.b = clip_min(color.b);
+
+    const __m128 x_mask = _mm_cmpgt_ps(x, _mm_set1_ps(1.0f));
+    const __m128 x_scale = _mm_sub_ps(x, l);
+    const __m128 one_minus_l = _mm_sub_ps(_mm_set1_ps(1.0f), l);
+    const auto clip_max = [&](__m128 c)
+    {
+        const __m128 clipped = _mm_add_ps(l, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(c, l), one_minus_l), x_scale));
+        return Select(x_mask, clipped, c);
+    };
+    color.r = clip_max(color.r);
+    color.g = clip_max(color.g);
+    color.b = clip_max(color.b);
+
+    return color;
+}
+
+static __m128i ToChannelSSE2(__m128 value)
+{
+    const __m128 scaled = _mm_mul_ps(value, _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+}
+static __m128i ToPixels(__m128i r, __m128i g, __m128i b, __m128i alpha_pixels)
+{
+    const __m128i rgb = _mm_or_si128(r, _mm_or_si128(_mm_slli_epi32(g, 8), _mm_slli_epi32(b, 16)));
+    return _mm_or_si128(rgb, _mm_and_si128(alpha_pixels, _mm_set1_epi32(static_cast<int>(0xff000000))));
+}
+static __m128i MixPixelsSSE2(__m128i pixels, const ChannelsSSE2& color, __m128i color_pixels)
+{
+    const __m128 alpha = GetNormalizedChannel(_mm_srli_epi32(color_pixels, 24));
+    const __m128 one_minus_alpha = _mm_sub_ps(_mm_set1_ps(1.0f), alpha);
+    const auto mix = [&](__m128i channel, __m128 color_channel)
+    {
+        const __m128 color_value = _mm_cvtepi32_ps(ToChannelSSE2(color_channel));
+        const __m128 mixed = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(channel), one_minus_alpha), _mm_mul_ps(color_value, alpha));
+        return _mm_cvttps_epi32(mixed);
+    };
+    return ToPixels(
+        mix(GetChannel<0>(pixels), color.r),
+        mix(GetChannel<8>(pixels), color.g),
+        mix(GetChannel<16>(pixels), color.b),
+        pixels);
+}
+#endif
+
+void AlphaBlendPixels(std::span<const std::uint8_t> source, std::span<std::uint8_t> target)
+{
+    assert(source.size() == target.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    for (; i + 16 <= target.size(); i += 16)
+    {
+        const __m128i source_pixels = LoadPixels(source.data() + i);
+        const __m128i target_pixels = LoadPixels(target.data() + i);
+        const __m128i mask = _mm_cmpgt_epi32(_mm_srli_epi32(source_pixels, 24), _mm_set1_epi32(127));
+        StorePixels(target.data() + i, Select(mask, source_pixels, target_pixels));
+    }
+#endif
+    for (; i + 4 <= target.size(); i += 4)
+    {
+        if (source[i + 3] >= 128)
+        {
+            std::memcpy(target.data() + i, source.data() + i, 4);
+        }
+    }
+}
+
+void ColorBlendPixels(std::span<const std::uint8_t> color, std::span<std::uint8_t> target)
+{
+    assert(color.size() == target.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    for (; i + 16 <= target.size(); i += 16)
+    {
+        const __m128i color_pixels = LoadPixels(color.data() + i);
+        const __m128i target_pixels = LoadPixels(target.data() + i);
+        const __m128 luminance = GetLuminanceSSE2(GetNormalizedChannels(target_pixels));
+        const ChannelsSSE2 blended = SetLuminanceSSE2(GetNormalizedChannels(color_pixels), luminance);
+        StorePixels(target.data() + i, MixPixelsSSE2(target_pixels, blended, color_pixels));
+    }
+#endif
+    for (; i + 4 <= target.size(); i += 4)
+    {
+        const std::uint8_t* color_pixel = color.data() + i;
+        std::uint8_t* pixel = target.data() + i;
+        const float luminance = GetPixelLuminance(pixel);
+        MixPixel(pixel, SetPixelLuminance(color_pixel, luminance), color_pixel[3]);
+    }
+}
+
+void LuminanceBlendPixels(std::span<const std::uint8_t> luminance, std::span<std::uint8_t> target)
+{
+    assert(luminance.size() == target.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    for (; i + 16 <= target.size(); i += 16)
+    {
+        const __m128i luminance_pixels = LoadPixels(luminance.data() + i);
+        const __m128i target_pixels = LoadPixels(target.data() + i);
+        const __m128 new_luminance = GetLuminanceSSE2(GetNormalizedChannels(luminance_pixels));
+        const ChannelsSSE2 blended = SetLuminanceSSE2(GetNormalizedChannels(target_pixels), new_luminance);
+        StorePixels(target.data() + i, MixPixelsSSE2(target_pixels, blended, luminance_pixels));
+    }
+#endif
+    for (; i + 4 <= target.size(); i += 4)
+    {
+        const std::uint8_t* luminance_pixel = luminance.data() + i;
+        std::uint8_t* pixel = target.data() + i;
+        const float new_luminance = GetPixelLuminance(luminance_pixel);
+        MixPixel(pixel, SetPixelLuminance(pixel, new_luminance), luminance_pixel[3]);
+    }
+}
+
+void LuminanceScalePixels(std::span<const std::uint8_t> luminance_scale, std::span<std::uint8_t> target)
+{
+    assert(luminance_scale.size() == target.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    for (; i + 16 <= target.size(); i += 16)
+    {
+        const __m128i luminance_pixels = LoadPixels(luminance_scale.data() + i);
+        const __m128i target_pixels = LoadPixels(target.data() + i);
+        const ChannelsSSE2 target_color = GetNormalizedChannels(target_pixels);
+        const __m128 luminance = GetLuminanceSSE2(GetNormalizedChannels(luminance_pixels));
+        const __m128 cur_lum = GetLuminanceSSE2(target_color);
+        const __m128 new_lum = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), luminance), cur_lum);
+        const __m128 clamped_lum = _mm_min_ps(_mm_max_ps(new_lum, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const ChannelsSSE2 blended = SetLuminanceSSE2(target_color, clamped_lum);
+        StorePixels(target.data() + i, MixPixelsSSE2(target_pixels, blended, luminance_pixels));
+    }
+#endif
+    for (; i + 4 <= target.size(); i += 4)
+    {
+        const std::uint8_t* luminance_pixel = luminance_scale.data() + i;
+        std::uint8_t* pixel = target.data() + i;
+        const float luminance = GetPixelLuminance(luminance_pixel);
+        const float cur_lum = GetPixelLuminance(pixel);
+        const float new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
+        MixPixel(pixel, SetPixelLuminance(pixel, new_lum), luminance_pixel[3]);
+    }
+}
+
+void LuminanceScalePixels(std::span<const std::uint8_t> luminance_scale, std::span<const std::uint8_t> base_luminance, std::span<std::uint8_t> target)
+{
+    assert(luminance_scale.size() == target.size() && base_luminance.size() == target.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    for (; i + 16 <= target.size(); i += 16)
+    {
+        const __m128i luminance_pixels = LoadPixels(luminance_scale.data() + i);
+        const __m128i opaque_mask = _mm_cmpeq_epi32(_mm_srli_epi32(luminance_pixels, 24), _mm_set1_epi32(255));
+        if (_mm_movemask_epi8(opaque_mask) == 0)
+        {
+            continue;
+        }
+
+        const __m128i base_pixels = LoadPixels(base_luminance.data() + i);
+        const __m128i target_pixels = LoadPixels(target.data() + i);
+        const __m128 luminance = GetLuminanceSSE2(GetNormalizedChannels(luminance_pixels));
+        const __m128 cur_lum = GetLuminanceSSE2(GetNormalizedChannels(base_pixels));
+        const __m128 new_lum = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), luminance), cur_lum);
+        const __m128 clamped_lum = _mm_min_ps(_mm_max_ps(new_lum, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const ChannelsSSE2 blended = SetLuminanceSSE2(GetNormalizedChannels(target_pixels), clamped_lum);
+
+        // Blending with full alpha results in exactly the blended color
+        const __m128i blended_pixels = ToPixels(ToChannelSSE2(blended.r), ToChannelSSE2(blended.g), ToChannelSSE2(blended.b), target_pixels);
+        StorePixels(target.data() + i, Select(opaque_mask, blended_pixels, target_pixels));
+    }
+#endif
+    for (; i + 4 <= target.size(); i += 4)
+    {
+        const std::uint8_t* luminance_pixel = luminance_scale.data() + i;
+        if (luminance_pixel[3] == 255)
+        {
+            const std::uint8_t* base_pixel = base_luminance.data() + i;
+            std::uint8_t* pixel = target.data() + i;
+            const float luminance = GetPixelLuminance(luminance_pixel);
+            const float cur_lum = GetPixelLuminance(base_pixel);
+            const float new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
+            MixPixel(pixel, SetPixelLuminance(pixel, new_lum), luminance_pixel[3]);
+        }
+    }
+}
+
+void ReplaceColorPixels(std::span<std::uint8_t> pixels, ColorRGB8 source_color, ColorRGB8 target_color)
+{
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    const __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    const __m128i source_rgb = _mm_set1_epi32(static_cast<int>(ToRGBMask(source_color)));
+    const __m128i target_rgb = _mm_set1_epi32(static_cast<int>(ToRGBMask(target_color)));
+    for (; i + 16 <= pixels.size(); i += 16)
+    {
+        const __m128i input_pixels = LoadPixels(pixels.data() + i);
+        const __m128i matches = _mm_cmpeq_epi32(_mm_and_si128(input_pixels, rgb_mask), source_rgb);
+        StorePixels(pixels.data() + i, _mm_or_si128(_mm_andnot_si128(_mm_and_si128(matches, rgb_mask), input_pixels), _mm_and_si128(matches, target_rgb)));
+    }
+#endif
+    for (; i + 4 <= pixels.size(); i += 4)
+    {
+        std::uint8_t* pixel = pixels.data() + i;
+        if (HasColor(pixel, source_color))
+        {
+            SetColor(pixel, target_color);
+        }
+    }
+}
+
+void ReplaceColorsPixels(std::span<std::uint8_t> pixels, std::span<const ColorRGB8> source_colors, std::span<const ColorRGB8> target_colors)
+{
+    assert(source_colors.size() <= target_colors.size());
+
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    const __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    for (; i + 16 <= pixels.size(); i += 16)
+    {
+        const __m128i input_pixels = LoadPixels(pixels.data() + i);
+        const __m128i input_rgb = _mm_and_si128(input_pixels, rgb_mask);
+        __m128i output_pixels = input_pixels;
+        __m128i unmatched = _mm_set1_epi32(-1);
+        for (std::size_t j = 0; j < source_colors.size(); j++)
+        {
+            const __m128i source_rgb = _mm_set1_epi32(static_cast<int>(ToRGBMask(source_colors[j])));
+            const __m128i matches = _mm_and_si128(_mm_cmpeq_epi32(input_rgb, source_rgb), unmatched);
+            if (_mm_movemask_epi8(matches) != 0)
+            {
+                const __m128i target_rgb = _mm_set1_epi32(static_cast<int>(ToRGBMask(target_colors[j])));
+                const __m128i replaced_pixels = _mm_or_si128(_mm_andnot_si128(rgb_mask, input_pixels), target_rgb);
+                output_pixels = Select(matches, replaced_pixels, output_pixels);
+                unmatched = _mm_andnot_si128(matches, unmatched);
+                if (_mm_movemask_epi8(unmatched) == 0)
+                {
+                    break;
+                }
+            }
+        }
+        StorePixels(pixels.data() + i, output_pixels);
+    }
+#endif
+    for (; i + 4 <= pixels.size(); i += 4)
+    {
+        std::uint8_t* pixel = pixels.data() + i;
+        for (std::size_t j = 0; j < source_colors.size(); j++)
+        {
+            if (HasColor(pixel, source_colors[j]))
+            {
+                SetColor(pixel, target_colors[j]);
+                break;
+            }
+        }
+    }
+}
+
+void ExtractColorPixels(std::span<std::uint8_t> pixels, ColorRGB8 color)
+{
+    std::size_t i = 0;
+#ifdef PIXEL_BLEND_USE_SSE2
+    const __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    const __m128i color_rgb = _mm_set1_epi32(static_cast<int>(ToRGBMask(color)));
+    for (; i + 16 <= pixels.size(); i += 16)
+    {
+        const __m128i input_pixels = LoadPixels(pixels.data() + i);
+        const __m128i matches = _mm_cmpeq_epi32(_mm_and_si128(input_pixels, rgb_mask), color_rgb);
+        StorePixels(pixels.data() + i, _mm_and_si128(input_pixels, matches));
+    }
+#endif
+    for (; i + 4 <= pixels.size(); i += 4)
+    {
+        std::uint8_t* pixel = pixels.data() + i;
+        if (!HasColor(pixel, color))
+        {
+            std::memset(pixel, 0, 4);
+        }
+    }
+}
+
+// Premultiplied channels indexed by [alpha][value]
+static const std::array<std::array<std::uint8_t, 256>, 256>& GetPremultiplyTable()
+{
+    static const auto s_PremultiplyTable = []()
+    {
+        std::array<std::array<std::uint8_t, 256>, 256> table;
+        for (std::size_t alpha = 0; alpha < 256; alpha++)
+        {
+            const float alpha_scale = static_cast<float>(alpha) / 255.0f;
+            for (std::size_t value = 0; value < 256; value++)
+            {
+                table[alpha][value] = static_cast<std::uint8_t>(static_cast<float>(value) * alpha_scale);
+            }
+        }
+        return table;
+    }();
+    return s_PremultiplyTable;
+}
+
+void PremultiplyBGRAPixels(std::span<std::uint8_t> pixels)
+{
+    const auto& premultiply_table = GetPremultiplyTable();
+    for (std::size_t i = 0; i + 4 <= pixels.size(); i += 4)
+    {
+        std::uint8_t* pixel = pixels.data() + i;
+        const auto& premultiplied = premultiply_table[pixel[3]];
+        const std::uint8_t b = pixel[0];
+        pixel[0] = premultiplied[pixel[2]];
+        pixel[1] = premultiplied[pixel[1]];
+        pixel[2] = premultiplied[b];
+    }
+}
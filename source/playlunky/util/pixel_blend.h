@@ -0,0 +1,31 @@
+#pragma once
+
+#include "util/color.h"
+
+#include <cstdint>
+#include <span>
+
+// Per-pixel kernels of the blend functions in image_processing, each processes one tightly packed row of RGBA8 pixels
+// All spans of one call have to be of the same size, only the rgb channels of the target are written unless noted otherwise
+// Vectorized with SSE2 where available, the results are identical to the scalar fallback
+
+// Takes all channels of source pixels with alpha of at least 128, keeps target pixels otherwise
+void AlphaBlendPixels(std::span<const std::uint8_t> source, std::span<std::uint8_t> target);
+// Applies the hue and saturation of the color pixels to the target pixels
+void ColorBlendPixels(std::span<const std::uint8_t> color, std::span<std::uint8_t> target);
+// Applies the luminance of the luminance pixels to the target pixels
+void LuminanceBlendPixels(std::span<const std::uint8_t> luminance, std::span<std::uint8_t> target);
+// Scales the luminance of the target pixels by twice the luminance of the luminance pixels
+void LuminanceScalePixels(std::span<const std::uint8_t> luminance_scale, std::span<std::uint8_t> target);
+// Same as above but scales the luminance of the base pixels, only where the luminance pixels are fully opaque
+void LuminanceScalePixels(std::span<const std::uint8_t> luminance_scale, std::span<const std::uint8_t> base_luminance, std::span<std::uint8_t> target);
+
+// Only compare the rgb channels and keep the alpha channel of replaced pixels
+void ReplaceColorPixels(std::span<std::uint8_t> pixels, ColorRGB8 source_color, ColorRGB8 target_color);
+void ReplaceColorsPixels(std::span<std::uint8_t> pixels, std::span<const ColorRGB8> source_colors, std::span<const ColorRGB8> target_colors);
+// Clears all channels of pixels of other colors
+void ExtractColorPixels(std::span<std::uint8_t> pixels, ColorRGB8 color);
+
+// Swizzles BGRA pixels as decoded by OpenCV to RGBA and premultiplies the rgb channels
+// Looks the premultiplied channels up in a table, truncated the same as value * (alpha / 255.0f)
+void PremultiplyBGRAPixels(std::span<std::uint8_t> pixels);
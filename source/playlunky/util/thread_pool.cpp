@@ -0,0 +1,58 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+{
+    num_threads = std::max(num_threads, std::size_t{ 1 });
+    mThreads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; i++)
+    {
+        mThreads.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{ mTasksMutex };
+        mStopping = true;
+    }
+    mTasksCondition.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock{ mTasksMutex };
+        mTasks.push_back(std::move(task));
+    }
+    mTasksCondition.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{ mTasksMutex };
+            mTasksCondition.wait(lock, [this]()
+                                 { return mStopping || !mTasks.empty(); });
+
+            // Finish all pending tasks before stopping, ForEach relies on submitted tasks being run eventually
+            if (mTasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, destroy it before the dll is unloaded since joining threads there would deadlock
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    std::size_t GetNumThreads() const
+    {
+        return mThreads.size();
+    }
+
+    void Submit(std::function<void()> task);
+
+    // Calls fun for each index in [0, count) and returns when all calls finished, rethrows the first exception thrown by fun
+    // The calling thread helps out, so this can safely be nested inside of other tasks
+    template<class FunT>
+    void ForEach(std::size_t count, FunT&& fun);
+
+  private:
+    void WorkerLoop();
+
+    std::vector<std::thread> mThreads;
+    std::deque<std::function<void()>> mTasks;
+    std::mutex mTasksMutex;
+    std::condition_variable mTasksCondition;
+    bool mStopping{ false };
+};
+
+template<class FunT>
+void ThreadPool::ForEach(std::size_t count, FunT&& fun)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Shared with the helpers, which may start only after this function returned
+    struct ForEachState
+    {
+        std::atomic<std::size_t> NextIndex{ 0 };
+        std::atomic<std::size_t> NumDone{ 0 };
+        std::mutex ExceptionMutex;
+        std::exception_ptr Exception;
+        std::size_t Count;
+        std::function<void(std::size_t)> Fun;
+    };
+    auto state = std::make_shared<ForEachState>();
+    state->Count = count;
+    state->Fun = std::forward<FunT>(fun);
+
+    auto run_items = [](ForEachState& state)
+    {
+        for (std::size_t i = state.NextIndex++; i < state.Count; i = state.NextIndex++)
+        {
+            try
+            {
+                state.Fun(i);
+            }
+            catch (...)
+            {
+                std::lock_guard lock{ state.ExceptionMutex };
+                if (!state.Exception)
+                {
+                    state.Exception = std::current_exception();
+                }
+            }
+
+            if (++state.NumDone == state.Count)
+            {
+                state.NumDone.notify_all();
+            }
+        }
+    };
+
+    const std::size_t num_helpers = std::min(count - 1, GetNumThreads());
+    for (std::size_t i = 0; i < num_helpers; i++)
+    {
+        Submit([state, run_items]()
+               { run_items(*state); });
+    }
+    run_items(*state);
+
+    // All items are claimed at this point, only need to wait for the ones that are still running on helpers
+    for (std::size_t num_done = state->NumDone; num_done != count; num_done = state->NumDone)
+    {
+        state->NumDone.wait(num_done);
+    }
+
+    if (state->Exception)
+    {
+        std::rethrow_exception(state->Exception);
+    }
+}
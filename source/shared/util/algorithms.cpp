@@ -51,7 +51,7 @@ std::string trim(std::string str)
                            { return !std::isspace(ch); })
                   .base(),
               str.end());
-    return std::move(str);
+    return str;
 }
 std::string trim(std::string str, char to_trim)
 {
@@ -61,7 +61,7 @@ std::string trim(std::string str, char to_trim)
                            { return ch != to_trim; })
                   .base(),
               str.end());
-    return std::move(str);
+    return str;
 }
 
 std::string to_lower(std::string str)
@@ -135,12 +135,17 @@ std::basic_string<T> from_utf8(const std::string& source)
     return convertor.from_bytes(source);
 }
 
+// Only MSVC provides codecvt_utf8_utf16 for char8_t
+#ifdef _MSC_VER
 template std::string to_utf8<char8_t>(const std::basic_string<char8_t>&);
+#endif
 template std::string to_utf8<char16_t>(const std::basic_string<char16_t>&);
 template std::string to_utf8<char32_t>(const std::basic_string<char32_t>&);
 template std::string to_utf8<wchar_t>(const std::basic_string<wchar_t>&);
 
+#ifdef _MSC_VER
 template std::basic_string<char8_t> from_utf8(const std::string&);
+#endif
 template std::basic_string<char16_t> from_utf8(const std::string&);
 template std::basic_string<char32_t> from_utf8(const std::string&);
 template std::basic_string<wchar_t> from_utf8(const std::string&);
@@ -0,0 +1,100 @@
+#include "content_hash.h"
+
+#include "util/mapped_file.h"
+
+#include <bit>
+#include <cstring>
+
+static constexpr std::uint64_t s_Prime1{ 11400714785074694791ull };
+static constexpr std::uint64_t s_Prime2{ 14029467366897019727ull };
+static constexpr std::uint64_t s_Prime3{ 1609587929392839161ull };
+static constexpr std::uint64_t s_Prime4{ 9650029242287828579ull };
+static constexpr std::uint64_t s_Prime5{ 2870177450012600261ull };
+
+template<class T>
+static T ReadUnaligned(const std::uint8_t* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+static std::uint64_t HashRound(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * s_Prime2;
+    acc = std::rotl(acc, 31);
+    return acc * s_Prime1;
+}
+static std::uint64_t HashMergeRound(std::uint64_t acc, std::uint64_t value)
+{
+    acc ^= HashRound(0, value);
+    return acc * s_Prime1 + s_Prime4;
+}
+
+std::uint64_t HashContent(std::span<const std::uint8_t> data, std::uint64_t seed)
+{
+    const std::uint8_t* it = data.data();
+    const std::uint8_t* const end = it + data.size();
+
+    std::uint64_t hash;
+    if (data.size() >= 32)
+    {
+        std::uint64_t v1 = seed + s_Prime1 + s_Prime2;
+        std::uint64_t v2 = seed + s_Prime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - s_Prime1;
+
+        for (; end - it >= 32; it += 32)
+        {
+            v1 = HashRound(v1, ReadUnaligned<std::uint64_t>(it));
+            v2 = HashRound(v2, ReadUnaligned<std::uint64_t>(it + 8));
+            v3 = HashRound(v3, ReadUnaligned<std::uint64_t>(it + 16));
+            v4 = HashRound(v4, ReadUnaligned<std::uint64_t>(it + 24));
+        }
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = HashMergeRound(hash, v1);
+        hash = HashMergeRound(hash, v2);
+        hash = HashMergeRound(hash, v3);
+        hash = HashMergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + s_Prime5;
+    }
+
+    hash += static_cast<std::uint64_t>(data.size());
+
+    for (; end - it >= 8; it += 8)
+    {
+        hash ^= HashRound(0, ReadUnaligned<std::uint64_t>(it));
+        hash = std::rotl(hash, 27) * s_Prime1 + s_Prime4;
+    }
+    if (end - it >= 4)
+    {
+        hash ^= static_cast<std::uint64_t>(ReadUnaligned<std::uint32_t>(it)) * s_Prime1;
+        hash = std::rotl(hash, 23) * s_Prime2 + s_Prime3;
+        it += 4;
+    }
+    for (; it != end; it++)
+    {
+        hash ^= static_cast<std::uint64_t>(*it) * s_Prime5;
+        hash = std::rotl(hash, 11) * s_Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= s_Prime2;
+    hash ^= hash >> 29;
+    hash *= s_Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+std::optional<std::uint64_t> HashFileContent(const std::filesystem::path& file_path)
+{
+    const MappedFile file{ file_path };
+    if (!file.IsValid())
+    {
+        return std::nullopt;
+    }
+    return HashContent(file.GetData());
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+// Fast non-cryptographic 64 bit hash, computes the same values as XXH64
+std::uint64_t HashContent(std::span<const std::uint8_t> data, std::uint64_t seed = 0);
+std::optional<std::uint64_t> HashFileContent(const std::filesystem::path& file_path);
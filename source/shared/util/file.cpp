@@ -1,31 +1,35 @@
 #include "file.h"
 
-#include "util/on_scope_exit.h"
-
-#include <functional>
+#include <fstream>
+#include <iterator>
 
 std::string ReadWholeFile(const char* file_path)
 {
-    FILE* file{ nullptr };
-    auto error = fopen_s(&file, file_path, "rb");
-    if (error == 0 && file != nullptr)
+    if (auto file = std::ifstream{ file_path, std::ios::binary })
     {
-        auto close_file = OnScopeExit{ std::bind_front(fclose, file) };
-
-        fseek(file, 0, SEEK_END);
-        const size_t file_size = ftell(file);
-        fseek(file, 0, SEEK_SET);
-
-        std::string code(file_size, '\0');
+        return std::string{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+    return {};
+}
 
-        const auto size_read = fread(code.data(), 1, file_size, file);
-        if (size_read != file_size)
+std::vector<std::string_view> SplitLines(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+    while (true)
+    {
+        const auto newline_pos = text.find('\n');
+        if (newline_pos == std::string_view::npos)
         {
-            code.clear();
-            return code;
+            lines.push_back(text);
+            return lines;
         }
 
-        return code;
+        std::string_view line = text.substr(0, newline_pos);
+        if (line.ends_with('\r'))
+        {
+            line.remove_suffix(1);
+        }
+        lines.push_back(line);
+        text.remove_prefix(newline_pos + 1);
     }
-    return {};
 }
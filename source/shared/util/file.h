@@ -2,5 +2,10 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 std::string ReadWholeFile(const char* file_path);
+
+// Splits text the same way as calling std::getline until eof on a file opened in text mode
+// A trailing newline yields a trailing empty line and carriage returns before a newline are dropped
+std::vector<std::string_view> SplitLines(std::string_view text);
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+// Thread-safe cache of loaded values, keyed by string and a version that reloads the value when it changed, e.g. a write time
+// Least recently used values are evicted when the cache exceeds its byte budget, values still in use stay alive until released
+template<class ValueT, class VersionT = std::monostate>
+class LruCache
+{
+  public:
+    // Values that did not load are returned to the caller but not cached
+    struct LoadResult
+    {
+        std::shared_ptr<const ValueT> Value;
+        std::size_t Size{ 0 };
+        bool Loaded{ false };
+    };
+
+    explicit LruCache(std::size_t budget_bytes)
+        : mBudget{ budget_bytes }
+    {
+    }
+    LruCache(const LruCache&) = delete;
+    LruCache(LruCache&&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+    LruCache& operator=(LruCache&&) = delete;
+    ~LruCache() = default;
+
+    // Concurrent requests for the same key call load only once, load runs outside of the lock so different keys load concurrently
+    template<class LoadFunT>
+    requires std::is_invocable_r_v<LoadResult, LoadFunT>
+    std::shared_ptr<const ValueT> Get(const std::string& key, const VersionT& version, LoadFunT&& load)
+    {
+        return GetOrLoad(key, version, false, std::forward<LoadFunT>(load));
+    }
+
+    // Loads a value that is not cached yet, it counts as least recently used until it is requested
+    // The value is only kept if it fits into the remaining budget, so prefetching never evicts anything
+    template<class LoadFunT>
+    requires std::is_invocable_r_v<LoadResult, LoadFunT>
+    void Prefetch(const std::string& key, const VersionT& version, LoadFunT&& load)
+    {
+        GetOrLoad(key, version, true, std::forward<LoadFunT>(load));
+    }
+
+    bool IsFull()
+    {
+        std::lock_guard lock{ mMutex };
+        return mSize >= mBudget;
+    }
+    std::size_t GetSize()
+    {
+        std::lock_guard lock{ mMutex };
+        return mSize;
+    }
+    bool Contains(const std::string& key)
+    {
+        std::lock_guard lock{ mMutex };
+        return mEntries.contains(key);
+    }
+
+    void Erase(const std::string& key)
+    {
+        std::lock_guard lock{ mMutex };
+        if (auto it = mEntries.find(key); it != mEntries.end())
+        {
+            EraseEntry(it);
+        }
+    }
+    void Clear()
+    {
+        std::lock_guard lock{ mMutex };
+        mEntries.clear();
+        mRecentlyUsed.clear();
+        mSize = 0;
+    }
+
+    std::uint64_t GetHits() const
+    {
+        return mHits;
+    }
+    std::uint64_t GetMisses() const
+    {
+        return mMisses;
+    }
+
+  private:
+    struct CachedValue
+    {
+        VersionT Version;
+        std::once_flag LoadFlag;
+        std::shared_ptr<const ValueT> Value;
+        std::size_t Size{ 0 };
+        bool Prefetched{ false }; // Not requested yet, guarded by mMutex
+    };
+    struct CacheEntry
+    {
+        std::shared_ptr<CachedValue> Cached;
+        typename std::list<std::string>::iterator RecentlyUsedIt;
+    };
+    using CacheMap = std::unordered_map<std::string, CacheEntry>;
+
+    template<class LoadFunT>
+    std::shared_ptr<const ValueT> GetOrLoad(const std::string& key, const VersionT& version, bool prefetch, LoadFunT&& load)
+    {
+        std::shared_ptr<CachedValue> cached_value;
+        {
+            std::lock_guard lock{ mMutex };
+            auto it = mEntries.find(key);
+            if (it != mEntries.end() && it->second.Cached->Version == version)
+            {
+                if (prefetch)
+                {
+                    return nullptr;
+                }
+
+                mHits++;
+                it->second.Cached->Prefetched = false;
+                mRecentlyUsed.splice(mRecentlyUsed.begin(), mRecentlyUsed, it->second.RecentlyUsedIt);
+                cached_value = it->second.Cached;
+            }
+            else
+            {
+                if (!prefetch)
+                {
+                    mMisses++;
+                }
+                if (it != mEntries.end())
+                {
+                    EraseEntry(it);
+                }
+
+                cached_value = std::make_shared<CachedValue>();
+                cached_value->Version = version;
+                cached_value->Prefetched = prefetch;
+                const auto recently_used_it = prefetch
+                                                  ? mRecentlyUsed.insert(mRecentlyUsed.end(), key)
+                                                  : mRecentlyUsed.insert(mRecentlyUsed.begin(), key);
+                mEntries.emplace(key, CacheEntry{ cached_value, recently_used_it });
+            }
+        }
+
+        std::call_once(cached_value->LoadFlag, [&]()
+                       {
+                           LoadResult result = load();
+                           cached_value->Value = std::move(result.Value);
+
+                           std::lock_guard lock{ mMutex };
+                           auto it = mEntries.find(key);
+                           if (it == mEntries.end() || it->second.Cached != cached_value)
+                           {
+                               return;
+                           }
+
+                           if (!result.Loaded || (cached_value->Prefetched && mSize + result.Size > mBudget))
+                           {
+                               EraseEntry(it);
+                               return;
+                           }
+
+                           cached_value->Size = result.Size;
+                           mSize += result.Size;
+                           EvictToBudget(); });
+        return cached_value->Value;
+    }
+
+    void EraseEntry(typename CacheMap::iterator it)
+    {
+        mSize -= it->second.Cached->Size;
+        mRecentlyUsed.erase(it->second.RecentlyUsedIt);
+        mEntries.erase(it);
+    }
+    void EvictToBudget()
+    {
+        // Always keep the most recently used value, even if it alone exceeds the budget
+        while (mSize > mBudget && mRecentlyUsed.size() > 1)
+        {
+            EraseEntry(mEntries.find(mRecentlyUsed.back()));
+        }
+    }
+
+    std::mutex mMutex;
+    CacheMap mEntries;
+    std::list<std::string> mRecentlyUsed; // Most recently used first
+    std::size_t mBudget;
+    std::size_t mSize{ 0 };
+
+    std::atomic<std::uint64_t> mHits{ 0 };
+    std::atomic<std::uint64_t> mMisses{ 0 };
+};
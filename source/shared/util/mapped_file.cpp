@@ -0,0 +1,149 @@
+#include "mapped_file.h"
+
+#include "util/on_scope_exit.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& file_path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    auto close_file = OnScopeExit{ [file]()
+                                   { CloseHandle(file); } };
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        return;
+    }
+
+    // Can't map empty files, but they are still valid files
+    if (file_size.QuadPart == 0)
+    {
+        mValid = true;
+        return;
+    }
+
+    // The view keeps the mapping alive, so no need to hold on to any handles
+    if (HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+    {
+        auto close_mapping = OnScopeExit{ [mapping]()
+                                          { CloseHandle(mapping); } };
+        if (const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0))
+        {
+            mData = data;
+            mSize = static_cast<std::size_t>(file_size.QuadPart);
+            mValid = true;
+        }
+    }
+#else
+    const int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return;
+    }
+    auto close_file = OnScopeExit{ [file]()
+                                   { close(file); } };
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0)
+    {
+        return;
+    }
+
+    if (file_stat.st_size == 0)
+    {
+        mValid = true;
+        return;
+    }
+
+    void* data = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (data != MAP_FAILED)
+    {
+        mData = data;
+        mSize = static_cast<std::size_t>(file_stat.st_size);
+        mValid = true;
+    }
+#endif
+}
+#ifdef _WIN32
+// Can't hold any objects with destructors, those don't mix with structured exception handling
+static bool GuardedCopy(void* destination, const void* source, std::size_t size)
+{
+    __try
+    {
+        std::memcpy(destination, source, size);
+        return true;
+    }
+    __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+    {
+        return false;
+    }
+}
+#endif
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : mData{ std::exchange(rhs.mData, nullptr) }
+    , mSize{ std::exchange(rhs.mSize, 0) }
+    , mValid{ std::exchange(rhs.mValid, false) }
+{
+}
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Unmap();
+        mData = std::exchange(rhs.mData, nullptr);
+        mSize = std::exchange(rhs.mSize, 0);
+        mValid = std::exchange(rhs.mValid, false);
+    }
+    return *this;
+}
+MappedFile::~MappedFile()
+{
+    Unmap();
+}
+
+bool MappedFile::CopyTo(void* destination) const
+{
+    if (mSize == 0)
+    {
+        return mValid;
+    }
+
+#ifdef _WIN32
+    return GuardedCopy(destination, mData, mSize);
+#else
+    std::memcpy(destination, mData, mSize);
+    return true;
+#endif
+}
+
+void MappedFile::Unmap()
+{
+    if (mData != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(mData);
+#else
+        munmap(const_cast<void*>(mData), mSize);
+#endif
+        mData = nullptr;
+        mSize = 0;
+    }
+    mValid = false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// Read-only mapping of a whole file into memory, the view is valid as long as the object is alive
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& file_path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& rhs) noexcept;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    ~MappedFile();
+
+    bool IsValid() const
+    {
+        return mValid;
+    }
+    std::span<const std::uint8_t> GetData() const
+    {
+        return { static_cast<const std::uint8_t*>(mData), mSize };
+    }
+
+    // Copies the whole file, returns false instead of crashing if reading the mapped pages fails
+    // e.g. because the file was truncated or is on removed or network media, only guarded on Windows
+    bool CopyTo(void* destination) const;
+
+  private:
+    void Unmap();
+
+    const void* mData{ nullptr };
+    std::size_t mSize{ 0 };
+    bool mValid{ false };
+};
@@ -0,0 +1,441 @@
+#include "mod_pack.h"
+
+#include "util/algorithms.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <zstd.h>
+
+using namespace std::string_view_literals;
+
+static constexpr std::array<char, 4> s_ModPackMagic{ 'P', 'L', 'P', 'K' };
+static constexpr std::uint32_t s_ModPackVersion{ 1 };
+static constexpr std::uint64_t s_ModPackAlignment{ 16 };
+static constexpr int s_ModPackCompressionLevel{ 9 };
+
+struct ModPackHeader
+{
+    std::array<char, 4> Magic;
+    std::uint32_t Version;
+    std::uint32_t NumEntries;
+    std::uint32_t Reserved;
+    std::uint64_t StringPoolOffset;
+    std::uint64_t StringPoolSize;
+};
+static_assert(sizeof(ModPackHeader) == 32);
+
+enum ModPackEntryFlags : std::uint16_t
+{
+    ModPackEntryFlags_None = 0,
+    ModPackEntryFlags_Compressed = 1 << 0,
+};
+
+struct ModPackTocEntry
+{
+    std::uint64_t Offset;
+    std::uint64_t StoredSize;
+    std::uint64_t Size;
+    std::uint32_t PathOffset;
+    std::uint16_t PathSize;
+    std::uint16_t Flags;
+};
+static_assert(sizeof(ModPackTocEntry) == 32);
+
+// Same as IsSupportedFileType, those are converted to .DDS during preprocessing
+static constexpr std::array s_ModPackImageExtensions{ ".bmp"sv, ".dib"sv, ".jpeg"sv, ".jpg"sv, ".jpe"sv, ".jp2"sv, ".png"sv, ".webp"sv, ".pbm"sv, ".pgm"sv, ".ppm"sv, ".sr"sv, ".ras"sv, ".tiff"sv, ".tif"sv };
+// Sounds are looked up by path when sound banks are loaded, which never sees packs
+static constexpr std::array s_ModPackAudioExtensions{ ".wav"sv, ".ogg"sv, ".mp3"sv, ".wv"sv, ".opus"sv, ".flac"sv, ".mpc"sv, ".mpp"sv };
+// Files the game loads, those have to be inside of Data or next to the exe
+static constexpr std::array s_ModPackGameExtensions{ ".dds"sv, ".lvl"sv, ".tok"sv, ".fnb"sv, ".str"sv, ".hlsl"sv, ".bank"sv };
+static constexpr std::array s_ModPackRootExtensions{ ".str"sv, ".hlsl"sv, ".bank"sv };
+
+// Compares as if path was lower-case and used only forward slashes, pack pathes are stored that way
+static int ComparePackPath(std::string_view pack_path, std::string_view path)
+{
+    auto normalize = [](char c)
+    {
+        return c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    };
+
+    const std::size_t common_size = std::min(pack_path.size(), path.size());
+    for (std::size_t i = 0; i < common_size; i++)
+    {
+        const char lhs = pack_path[i];
+        const char rhs = normalize(path[i]);
+        if (lhs != rhs)
+        {
+            return static_cast<unsigned char>(lhs) < static_cast<unsigned char>(rhs) ? -1 : 1;
+        }
+    }
+
+    if (pack_path.size() == path.size())
+    {
+        return 0;
+    }
+    return pack_path.size() < path.size() ? -1 : 1;
+}
+
+ModPack::ModPack(const std::filesystem::path& pack_file)
+    : mFile{ pack_file }
+{
+    if (!mFile.IsValid())
+    {
+        return;
+    }
+
+    const std::span<const std::uint8_t> pack_data = mFile.GetData();
+    auto invalidate = [this]()
+    {
+        mFile = MappedFile{};
+        mEntries.clear();
+    };
+
+    if (pack_data.size() < sizeof(ModPackHeader))
+    {
+        invalidate();
+        return;
+    }
+
+    ModPackHeader header;
+    std::memcpy(&header, pack_data.data(), sizeof(ModPackHeader));
+    if (header.Magic != s_ModPackMagic || header.Version != s_ModPackVersion)
+    {
+        invalidate();
+        return;
+    }
+
+    const std::uint64_t toc_end = sizeof(ModPackHeader) + static_cast<std::uint64_t>(header.NumEntries) * sizeof(ModPackTocEntry);
+    // Written as subtractions, so crafted offsets and sizes can not wrap around
+    if (toc_end > pack_data.size() || header.StringPoolOffset > pack_data.size() || header.StringPoolSize > pack_data.size() - header.StringPoolOffset)
+    {
+        invalidate();
+        return;
+    }
+
+    const std::string_view string_pool{ reinterpret_cast<const char*>(pack_data.data() + header.StringPoolOffset), header.StringPoolSize };
+
+    mEntries.reserve(header.NumEntries);
+    for (std::uint32_t i = 0; i < header.NumEntries; i++)
+    {
+        ModPackTocEntry toc_entry;
+        std::memcpy(&toc_entry, pack_data.data() + sizeof(ModPackHeader) + i * sizeof(ModPackTocEntry), sizeof(ModPackTocEntry));
+
+        if (static_cast<std::uint64_t>(toc_entry.PathOffset) + toc_entry.PathSize > string_pool.size() ||
+            toc_entry.Offset > pack_data.size() || toc_entry.StoredSize > pack_data.size() - toc_entry.Offset)
+        {
+            invalidate();
+            return;
+        }
+
+        // Uncompressed entries are copied as they are, anything bigger than the game can allocate would be truncated
+        const bool compressed = (toc_entry.Flags & ModPackEntryFlags_Compressed) != 0;
+        if ((!compressed && toc_entry.StoredSize != toc_entry.Size) || toc_entry.Size > s_ModPackMaxEntrySize)
+        {
+            invalidate();
+            return;
+        }
+
+        // FindEntry relies on the toc being sorted, duplicates would never be found either
+        const std::string_view path = string_pool.substr(toc_entry.PathOffset, toc_entry.PathSize);
+        if (!mEntries.empty() && ComparePackPath(mEntries.back().Path, path) >= 0)
+        {
+            invalidate();
+            return;
+        }
+
+        mEntries.push_back(ModPackEntry{
+            .Path = path,
+            .Offset = toc_entry.Offset,
+            .StoredSize = toc_entry.StoredSize,
+            .Size = toc_entry.Size,
+            .Compressed = compressed,
+        });
+    }
+}
+
+const ModPackEntry* ModPack::FindEntry(std::string_view path) const
+{
+    auto it = std::lower_bound(mEntries.begin(), mEntries.end(), path, [](const ModPackEntry& entry, std::string_view path)
+                               { return ComparePackPath(entry.Path, path) < 0; });
+    if (it != mEntries.end() && ComparePackPath(it->Path, path) == 0)
+    {
+        return &*it;
+    }
+    return nullptr;
+}
+
+bool ModPack::ReadEntry(const ModPackEntry& entry, std::span<std::uint8_t> destination) const
+{
+    if (destination.size() != entry.Size)
+    {
+        return false;
+    }
+
+    const std::uint8_t* stored_data = mFile.GetData().data() + entry.Offset;
+    if (entry.Compressed)
+    {
+        const std::size_t decompressed_size = ZSTD_decompress(destination.data(), destination.size(), stored_data, entry.StoredSize);
+        return !ZSTD_isError(decompressed_size) && decompressed_size == entry.Size;
+    }
+
+    std::memcpy(destination.data(), stored_data, entry.Size);
+    return true;
+}
+
+struct ModPackSourceFile
+{
+    std::filesystem::path RelativePath;
+    std::filesystem::path FullPath;
+    std::string PackPath;
+};
+// Returns the reason if the file can not be packed, sets pack_file to nullopt if the file is skipped
+static std::optional<std::string_view> GetModPackSourceFile(const std::filesystem::path& source_folder,
+                                                            const std::filesystem::path& preprocessed_folder,
+                                                            const std::filesystem::path& relative_path,
+                                                            std::optional<ModPackSourceFile>& pack_file)
+{
+    namespace fs = std::filesystem;
+
+    const fs::path full_path = source_folder / relative_path;
+    const std::string file_name = algo::to_lower(relative_path.filename().string());
+    const std::string extension = algo::to_lower(relative_path.extension().string());
+
+    pack_file = std::nullopt;
+
+    if (file_name == "mod_info.json")
+    {
+        return "mod info is only read during preprocessing";
+    }
+    if (extension == ".lua")
+    {
+        return "scripts are loaded from the mod folder";
+    }
+    if (file_name.ends_with("_mod.str"))
+    {
+        return "string mods are merged with other mods during preprocessing";
+    }
+    if (file_name == "shaders_mod.hlsl")
+    {
+        return "shader mods are merged with other mods during preprocessing";
+    }
+    if (algo::contains(s_ModPackAudioExtensions, extension))
+    {
+        return "sounds are loaded from the mod folder";
+    }
+
+    fs::path game_path = relative_path;
+    fs::path game_full_path = full_path;
+    if (algo::contains(s_ModPackImageExtensions, extension))
+    {
+        const std::string stem = algo::to_lower(relative_path.stem().string());
+        if (stem.ends_with("_col") || stem.ends_with("_lumin"))
+        {
+            return "color mods are painted during preprocessing";
+        }
+
+        game_path.replace_extension(".DDS");
+        game_full_path = preprocessed_folder / game_path;
+
+        std::error_code error;
+        const auto converted_write_time = fs::last_write_time(game_full_path, error);
+        if (error)
+        {
+            return "image has no converted .DDS, either the mod was not loaded by Playlunky yet or the image is merged with other mods";
+        }
+        if (converted_write_time < fs::last_write_time(full_path))
+        {
+            return "converted .DDS is outdated, load the mod with Playlunky again";
+        }
+    }
+
+    std::string pack_path = algo::to_lower(algo::path_string(game_path));
+    const std::string game_extension = algo::to_lower(game_path.extension().string());
+    const bool is_in_data = pack_path.starts_with("data/");
+    const bool is_in_root = pack_path.find('/') == std::string::npos;
+    if (!is_in_data && !(is_in_root && algo::contains(s_ModPackRootExtensions, game_extension)))
+    {
+        if (algo::contains(s_ModPackGameExtensions, game_extension))
+        {
+            return "file is not where the game loads it from, load the mod with Playlunky to fix its structure";
+        }
+
+        // Readmes, previews and other files the game never loads
+        return std::nullopt;
+    }
+
+    if (pack_path.size() > std::numeric_limits<std::uint16_t>::max())
+    {
+        return "path is too long";
+    }
+
+    std::error_code error;
+    const auto file_size = fs::file_size(game_full_path, error);
+    if (!error && file_size > s_ModPackMaxEntrySize)
+    {
+        return "file is too large for the game to load";
+    }
+
+    pack_file = ModPackSourceFile{ relative_path, std::move(game_full_path), std::move(pack_path) };
+    return std::nullopt;
+}
+
+bool WriteModPack(const std::filesystem::path& source_folder,
+                  const std::filesystem::path& preprocessed_folder,
+                  const std::filesystem::path& pack_file,
+                  bool compress,
+                  std::vector<ModPackRejectedFile>& rejected_files)
+{
+    namespace fs = std::filesystem;
+
+    if (!fs::exists(source_folder) || !fs::is_directory(source_folder))
+    {
+        return false;
+    }
+
+    std::vector<ModPackSourceFile> source_files;
+    for (const auto& dir_entry : fs::recursive_directory_iterator{ source_folder })
+    {
+        if (dir_entry.is_regular_file())
+        {
+            const fs::path relative_path = dir_entry.path().lexically_relative(source_folder);
+
+            std::optional<ModPackSourceFile> source_file;
+            if (const auto reason = GetModPackSourceFile(source_folder, preprocessed_folder, relative_path, source_file))
+            {
+                rejected_files.push_back(ModPackRejectedFile{ relative_path, reason.value() });
+            }
+            else if (source_file.has_value())
+            {
+                source_files.push_back(std::move(source_file).value());
+            }
+        }
+    }
+
+    // An image and a loose .DDS can map to the same entry, keeping either of them would depend on iteration order
+    algo::sort(source_files, &ModPackSourceFile::PackPath);
+    for (auto it = source_files.begin(); it != source_files.end();)
+    {
+        const auto same_path_end = std::find_if(it, source_files.end(), [&](const ModPackSourceFile& source_file)
+                                                { return source_file.PackPath != it->PackPath; });
+        if (std::next(it) != same_path_end)
+        {
+            for (; it != same_path_end; ++it)
+            {
+                rejected_files.push_back(ModPackRejectedFile{ it->RelativePath, "another file of the mod is packed to the same path, remove one of them" });
+            }
+        }
+        it = same_path_end;
+    }
+    if (!rejected_files.empty())
+    {
+        return false;
+    }
+
+    std::vector<ModPackTocEntry> toc(source_files.size());
+    std::string string_pool;
+    for (std::size_t i = 0; i < source_files.size(); i++)
+    {
+        const std::string& pack_path = source_files[i].PackPath;
+        toc[i].PathOffset = static_cast<std::uint32_t>(string_pool.size());
+        toc[i].PathSize = static_cast<std::uint16_t>(pack_path.size());
+        string_pool += pack_path;
+    }
+    if (string_pool.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        return false;
+    }
+
+    ModPackHeader header{
+        .Magic = s_ModPackMagic,
+        .Version = s_ModPackVersion,
+        .NumEntries = static_cast<std::uint32_t>(source_files.size()),
+        .Reserved = 0,
+        .StringPoolOffset = sizeof(ModPackHeader) + toc.size() * sizeof(ModPackTocEntry),
+        .StringPoolSize = string_pool.size(),
+    };
+
+    // Write to a temporary file first, so a failed write never leaves a truncated pack behind that would be mounted
+    fs::path temp_pack_file = pack_file;
+    temp_pack_file += ".tmp";
+    auto out_file = std::ofstream{ temp_pack_file, std::ios::binary | std::ios::trunc };
+    if (!out_file)
+    {
+        return false;
+    }
+    auto discard_pack = [&]()
+    {
+        out_file.close();
+        std::error_code ec;
+        fs::remove(temp_pack_file, ec);
+        return false;
+    };
+
+    // Write the header and toc once to reserve space, they are rewritten once all offsets are known
+    auto write_header_and_toc = [&]()
+    {
+        out_file.write(reinterpret_cast<const char*>(&header), sizeof(ModPackHeader));
+        out_file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(ModPackTocEntry));
+    };
+    write_header_and_toc();
+    out_file.write(string_pool.data(), string_pool.size());
+
+    std::uint64_t offset = header.StringPoolOffset + header.StringPoolSize;
+    std::vector<std::uint8_t> compressed_data;
+    for (std::size_t i = 0; i < source_files.size(); i++)
+    {
+        const std::uint64_t aligned_offset = (offset + s_ModPackAlignment - 1) & ~(s_ModPackAlignment - 1);
+        for (; offset < aligned_offset; offset++)
+        {
+            out_file.put('\0');
+        }
+
+        const MappedFile source_file{ source_files[i].FullPath };
+        if (!source_file.IsValid())
+        {
+            return discard_pack();
+        }
+
+        std::span<const std::uint8_t> stored_data = source_file.GetData();
+        std::uint16_t flags = ModPackEntryFlags_None;
+        if (compress && !stored_data.empty())
+        {
+            compressed_data.resize(ZSTD_compressBound(stored_data.size()));
+            const std::size_t compressed_size = ZSTD_compress(compressed_data.data(), compressed_data.size(), stored_data.data(), stored_data.size(), s_ModPackCompressionLevel);
+            if (!ZSTD_isError(compressed_size) && compressed_size < stored_data.size())
+            {
+                stored_data = std::span{ compressed_data.data(), compressed_size };
+                flags |= ModPackEntryFlags_Compressed;
+            }
+        }
+
+        toc[i].Offset = offset;
+        toc[i].StoredSize = stored_data.size();
+        toc[i].Size = source_file.GetData().size();
+        toc[i].Flags = flags;
+
+        out_file.write(reinterpret_cast<const char*>(stored_data.data()), stored_data.size());
+        offset += stored_data.size();
+    }
+
+    out_file.seekp(0);
+    write_header_and_toc();
+    out_file.close();
+    if (!out_file)
+    {
+        return discard_pack();
+    }
+
+    std::error_code ec;
+    fs::rename(temp_pack_file, pack_file, ec);
+    if (ec)
+    {
+        return discard_pack();
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "util/mapped_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// A mod packed into a single file, consisting of a header, a table of contents sorted by path,
+// a string pool with all pathes and the aligned file blobs, each of which may be zstd compressed
+// The game stores the size of a file and of its allocation as int, the allocation also holds the game's file info
+static constexpr std::uint64_t s_ModPackMaxFileInfoSize{ 64 };
+static constexpr std::uint64_t s_ModPackMaxEntrySize{ std::numeric_limits<int>::max() - s_ModPackMaxFileInfoSize };
+
+struct ModPackEntry
+{
+    std::string_view Path;
+    std::uint64_t Offset;
+    std::uint64_t StoredSize;
+    std::uint64_t Size;
+    bool Compressed;
+};
+
+class ModPack
+{
+  public:
+    explicit ModPack(const std::filesystem::path& pack_file);
+    ModPack(const ModPack&) = delete;
+    ModPack(ModPack&&) = default;
+    ModPack& operator=(const ModPack&) = delete;
+    ModPack& operator=(ModPack&&) = default;
+    ~ModPack() = default;
+
+    bool IsValid() const
+    {
+        return mFile.IsValid();
+    }
+    std::span<const ModPackEntry> GetEntries() const
+    {
+        return mEntries;
+    }
+
+    // Pathes are matched case-insensitive and with either type of slashes
+    const ModPackEntry* FindEntry(std::string_view path) const;
+
+    // Destination has to be exactly of size entry.Size
+    bool ReadEntry(const ModPackEntry& entry, std::span<std::uint8_t> destination) const;
+
+  private:
+    MappedFile mFile;
+    std::vector<ModPackEntry> mEntries;
+};
+
+struct ModPackRejectedFile
+{
+    std::filesystem::path Path;
+    std::string_view Reason;
+};
+
+// Packs are mounted without preprocessing, so only files that the game can load as they are end up in the pack
+// Images are replaced by their converted .DDS from preprocessed_folder, the mod's folder in .db, which does not have to exist
+// Files that only work after preprocessing or that map to the same pack path fail the packing and are listed in rejected_files, files the game never loads are skipped
+bool WriteModPack(const std::filesystem::path& source_folder,
+                  const std::filesystem::path& preprocessed_folder,
+                  const std::filesystem::path& pack_file,
+                  bool compress,
+                  std::vector<ModPackRejectedFile>& rejected_files);
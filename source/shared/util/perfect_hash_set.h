@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+// Immutable set over a static array of keys that is built at compile time and finds keys with a single probe and a single comparison
+// Built with hash and displace: keys are grouped into small buckets and each bucket is assigned the displacement
+// that moves all of its keys into free slots, starting with the largest buckets
+// The set refers to the keys instead of copying them, so the array has to outlive the set
+// Case insensitive sets compare ascii letters of string keys without case, lookups then need no lower case copy of the key
+template<class KeyT, std::size_t N, bool CaseInsensitive = false>
+class PerfectHashSet
+{
+    static_assert(!CaseInsensitive || !std::is_integral_v<KeyT>, "Only string keys can be case insensitive...");
+
+    using IndexT = std::conditional_t<(N < std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>;
+    static constexpr IndexT c_EmptySlot{ std::numeric_limits<IndexT>::max() };
+    static constexpr std::size_t c_NumSlots{ std::bit_ceil(2 * N) };
+    static constexpr std::size_t c_NumBuckets{ (N + 3) / 4 + 1 };
+    static constexpr std::uint32_t c_MaxDisplacement{ std::numeric_limits<std::uint16_t>::max() };
+
+  public:
+    consteval explicit PerfectHashSet(const KeyT (&keys)[N])
+        : m_Keys{ keys }
+    {
+        m_Slots.fill(c_EmptySlot);
+
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::uint32_t, c_NumBuckets + 1> bucket_starts{};
+        for (std::size_t i = 0; i < N; i++)
+        {
+            hashes[i] = Hash(keys[i]);
+            bucket_starts[GetBucket(hashes[i]) + 1]++;
+        }
+        std::partial_sum(bucket_starts.begin(), bucket_starts.end(), bucket_starts.begin());
+
+        std::array<std::uint32_t, N> bucket_keys{};
+        {
+            std::array<std::uint32_t, c_NumBuckets + 1> bucket_ends{ bucket_starts };
+            for (std::uint32_t i = 0; i < N; i++)
+            {
+                bucket_keys[bucket_ends[GetBucket(hashes[i])]++] = i;
+            }
+        }
+
+        std::array<std::uint32_t, c_NumBuckets> bucket_order{};
+        std::iota(bucket_order.begin(), bucket_order.end(), 0u);
+        std::sort(bucket_order.begin(), bucket_order.end(), [&](std::uint32_t lhs, std::uint32_t rhs)
+                  { return bucket_starts[lhs + 1] - bucket_starts[lhs] > bucket_starts[rhs + 1] - bucket_starts[rhs]; });
+
+        // Copies of a key end up in the same bucket, lookups only need to find the first one
+        std::array<bool, N> is_duplicate{};
+        for (std::uint32_t bucket = 0; bucket < c_NumBuckets; bucket++)
+        {
+            for (std::uint32_t i = bucket_starts[bucket]; i < bucket_starts[bucket + 1]; i++)
+            {
+                for (std::uint32_t j = bucket_starts[bucket]; j < i && !is_duplicate[i]; j++)
+                {
+                    is_duplicate[i] = hashes[bucket_keys[j]] == hashes[bucket_keys[i]] && Equal(keys[bucket_keys[j]], keys[bucket_keys[i]]);
+                }
+            }
+        }
+
+        for (std::uint32_t bucket : bucket_order)
+        {
+            const std::uint32_t begin = bucket_starts[bucket];
+            const std::uint32_t end = bucket_starts[bucket + 1];
+
+            std::uint32_t displacement{ 0 };
+            for (; displacement < c_MaxDisplacement; displacement++)
+            {
+                bool placed_all{ true };
+                for (std::uint32_t i = begin; i < end && placed_all; i++)
+                {
+                    if (!is_duplicate[i])
+                    {
+                        IndexT& slot = m_Slots[GetSlot(hashes[bucket_keys[i]], displacement)];
+                        placed_all = slot == c_EmptySlot;
+                        if (placed_all)
+                        {
+                            slot = static_cast<IndexT>(bucket_keys[i]);
+                        }
+                    }
+                }
+
+                if (placed_all)
+                {
+                    break;
+                }
+
+                for (std::uint32_t i = begin; i < end; i++)
+                {
+                    IndexT& slot = m_Slots[GetSlot(hashes[bucket_keys[i]], displacement)];
+                    if (slot == bucket_keys[i])
+                    {
+                        slot = c_EmptySlot;
+                    }
+                }
+            }
+
+            if (displacement == c_MaxDisplacement)
+            {
+                throw std::logic_error{ "Failed building perfect hash set..." };
+            }
+            m_Displacements[bucket] = static_cast<std::uint16_t>(displacement);
+        }
+    }
+
+    constexpr bool Contains(const KeyT& key) const
+    {
+        const std::uint64_t hash = Hash(key);
+        const IndexT index = m_Slots[GetSlot(hash, m_Displacements[GetBucket(hash)])];
+        return index != c_EmptySlot && Equal(m_Keys[index], key);
+    }
+
+  private:
+    static constexpr std::uint64_t Mix(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+    static constexpr std::uint64_t Hash(const KeyT& key)
+    {
+        if constexpr (std::is_integral_v<KeyT>)
+        {
+            return Mix(static_cast<std::uint64_t>(key));
+        }
+        else
+        {
+            std::uint64_t hash{ 0xcbf29ce484222325ull };
+            for (char c : std::string_view{ key })
+            {
+                hash = (hash ^ static_cast<std::uint8_t>(ToLower(c))) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+    }
+    static constexpr char ToLower(char c)
+    {
+        if constexpr (CaseInsensitive)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        else
+        {
+            return c;
+        }
+    }
+    static constexpr bool Equal(const KeyT& lhs, const KeyT& rhs)
+    {
+        if constexpr (CaseInsensitive)
+        {
+            return std::ranges::equal(std::string_view{ lhs }, std::string_view{ rhs }, {}, &ToLower, &ToLower);
+        }
+        else
+        {
+            return lhs == rhs;
+        }
+    }
+    static constexpr std::size_t GetBucket(std::uint64_t hash)
+    {
+        return static_cast<std::size_t>(Mix(hash) % c_NumBuckets);
+    }
+    static constexpr std::size_t GetSlot(std::uint64_t hash, std::uint32_t displacement)
+    {
+        return static_cast<std::size_t>(Mix(hash + (displacement + 1) * 0x9e3779b97f4a7c15ull) & (c_NumSlots - 1));
+    }
+
+    const KeyT* m_Keys;
+    std::array<IndexT, c_NumSlots> m_Slots{};
+    std::array<std::uint16_t, c_NumBuckets> m_Displacements{};
+};
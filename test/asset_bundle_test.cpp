@@ -0,0 +1,195 @@
+#include "mod/asset_bundle.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct SyntheticAsset
+{
+    std::string FilePath;
+    std::string Data;
+    bool Encrypted;
+};
+
+// Same layout as the bundle in Spel2.exe, names are hashed with the key after walking all assets
+static std::vector<std::uint8_t> MakeBundle(const std::vector<SyntheticAsset>& assets)
+{
+    ChaCha::Key key;
+    for (const SyntheticAsset& asset : assets)
+    {
+        key.update(asset.Data.size() + 1);
+    }
+
+    std::vector<std::uint8_t> bundle;
+    auto append = [&bundle](const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        bundle.insert(bundle.end(), bytes, bytes + size);
+    };
+    for (const SyntheticAsset& asset : assets)
+    {
+        const ChaCha::bytes_t name_hash = ChaCha::hash_filepath(asset.FilePath, key.Current);
+        const auto asset_len = static_cast<std::uint32_t>(asset.Data.size() + 1);
+        const auto asset_name_len = static_cast<std::uint32_t>(name_hash.size());
+        const char encrypted = asset.Encrypted ? '\x01' : '\x00';
+        append(&asset_len, sizeof(asset_len));
+        append(&asset_name_len, sizeof(asset_name_len));
+        append(name_hash.data(), name_hash.size());
+        append(&encrypted, sizeof(encrypted));
+        append(asset.Data.data(), asset.Data.size());
+    }
+    const std::uint64_t terminator{ 0 };
+    append(&terminator, sizeof(terminator));
+    return bundle;
+}
+
+// Lookup as done before the index, walking the bundle and comparing the shorter of both hashes
+static std::optional<std::uint64_t> FindAssetOffsetByWalking(std::span<const std::uint8_t> bundle, std::uint64_t key, std::string_view file_path)
+{
+    const ChaCha::bytes_t hash = ChaCha::hash_filepath(file_path, key);
+
+    std::size_t offset{ 0 };
+    while (true)
+    {
+        std::uint32_t asset_len;
+        std::uint32_t asset_name_len;
+        std::memcpy(&asset_len, bundle.data() + offset, sizeof(asset_len));
+        std::memcpy(&asset_name_len, bundle.data() + offset + 4, sizeof(asset_name_len));
+        if (asset_len == 0 && asset_name_len == 0)
+        {
+            return std::nullopt;
+        }
+
+        const std::uint8_t* name_hash = bundle.data() + offset + 8;
+        const std::size_t data_offset = offset + 8 + asset_name_len + 1;
+        if (std::equal(hash.begin(), hash.begin() + std::min<std::size_t>(hash.size(), asset_name_len), name_hash))
+        {
+            return data_offset;
+        }
+        offset = data_offset + asset_len - 1;
+    }
+}
+
+static const std::vector<SyntheticAsset> s_Assets{
+    { "Data/Textures/char_yellow.DDS", "yellow", true },
+    { "Data/Textures/items.DDS", "items items", true },
+    { "Data/Levels/dwellingarea.lvl", "level", false },
+    { "Data/Levels/dwelling.lvl", "other level", false },
+    { "strings00.str", "", false },
+    { "Data/Textures/char_yellow.DDS", "shadowed duplicate", true },
+};
+
+static std::string_view GetAssetData(std::span<const std::uint8_t> bundle, const AssetBundleEntry& asset)
+{
+    return { reinterpret_cast<const char*>(bundle.data() + asset.Offset), asset.Size };
+}
+
+TEST(AssetBundle, FindAssetMatchesWalking)
+{
+    const std::vector<std::uint8_t> bundle = MakeBundle(s_Assets);
+    const std::optional<AssetBundleIndex> index = AssetBundleIndex::Parse(bundle);
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(index->GetNumAssets(), s_Assets.size());
+
+    for (std::string_view file_path : { "Data/Textures/char_yellow.DDS", "Data/Textures/items.DDS", "Data/Levels/dwellingarea.lvl", "Data/Levels/dwelling.lvl", "strings00.str", "Data/Levels/missing.lvl", "Data" })
+    {
+        const AssetBundleEntry* asset = index->FindAsset(file_path);
+        const std::optional<std::uint64_t> walked_offset = FindAssetOffsetByWalking(bundle, index->GetKey(), file_path);
+        ASSERT_EQ(asset != nullptr, walked_offset.has_value()) << file_path;
+        if (asset != nullptr)
+        {
+            EXPECT_EQ(asset->Offset, walked_offset.value()) << file_path;
+        }
+    }
+
+    const AssetBundleEntry* yellow = index->FindAsset("Data/Textures/char_yellow.DDS");
+    ASSERT_NE(yellow, nullptr);
+    EXPECT_EQ(GetAssetData(bundle, *yellow), "yellow");
+    EXPECT_TRUE(yellow->Encrypted);
+
+    const AssetBundleEntry* level = index->FindAsset("Data/Levels/dwellingarea.lvl");
+    ASSERT_NE(level, nullptr);
+    EXPECT_EQ(GetAssetData(bundle, *level), "level");
+    EXPECT_FALSE(level->Encrypted);
+}
+
+TEST(AssetBundle, RejectsTruncatedBundles)
+{
+    const std::vector<std::uint8_t> bundle = MakeBundle(s_Assets);
+    for (std::size_t size = 0; size < bundle.size(); size++)
+    {
+        EXPECT_FALSE(AssetBundleIndex::Parse(std::span{ bundle }.first(size)).has_value()) << "size " << size;
+    }
+}
+
+TEST(AssetBundle, IndexFileRoundTrip)
+{
+    const fs::path index_path = fs::temp_directory_path() / "playlunky_tests" / "asset_bundle" / "index.bin";
+    fs::remove(index_path);
+
+    const std::vector<std::uint8_t> bundle = MakeBundle(s_Assets);
+    const std::optional<AssetBundleIndex> index = AssetBundleIndex::Parse(bundle);
+    ASSERT_TRUE(index.has_value());
+
+    const AssetBundleSource source{ .FileSize{ 123456 }, .WriteTime{ 789 } };
+    ASSERT_TRUE(index->WriteToFile(index_path, source));
+
+    const std::optional<AssetBundleIndex> read_index = AssetBundleIndex::ReadFromFile(index_path, source, bundle.size());
+    ASSERT_TRUE(read_index.has_value());
+    EXPECT_EQ(read_index->GetKey(), index->GetKey());
+    EXPECT_EQ(read_index->GetNumAssets(), index->GetNumAssets());
+
+    const AssetBundleEntry* items = read_index->FindAsset("Data/Textures/items.DDS");
+    ASSERT_NE(items, nullptr);
+    EXPECT_EQ(GetAssetData(bundle, *items), "items items");
+
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, { .FileSize{ 123457 }, .WriteTime{ 789 } }, bundle.size()).has_value());
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, { .FileSize{ 123456 }, .WriteTime{ 790 } }, bundle.size()).has_value());
+
+    fs::resize_file(index_path, fs::file_size(index_path) - 1);
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+
+    fs::remove_all(index_path.parent_path());
+}
+
+TEST(AssetBundle, IndexFileRejectsAssetsOutsideOfBundle)
+{
+    const fs::path index_path = fs::temp_directory_path() / "playlunky_tests" / "asset_bundle_bounds" / "index.bin";
+    fs::remove(index_path);
+
+    const std::vector<std::uint8_t> bundle = MakeBundle(s_Assets);
+    const AssetBundleSource source{ .FileSize{ 123456 }, .WriteTime{ 789 } };
+
+    // The last asset is followed by the terminating empty entry of 8 bytes, the index is invalid for a bundle that cuts into that asset
+    ASSERT_TRUE(AssetBundleIndex::Parse(bundle)->WriteToFile(index_path, source));
+    EXPECT_TRUE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size() - 8).has_value());
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size() - 9).has_value());
+
+    // Entries whose end overflows must not wrap around into the bundle
+    auto write_index = [&](std::uint64_t offset, std::uint64_t size)
+    {
+        AssetBundleIndex index{ 5, { AssetBundleEntry{ .Offset{ offset }, .Size{ size }, .Encrypted{ false }, .NameHash{ 1, 2, 3, 4 } } } };
+        return index.WriteToFile(index_path, source);
+    };
+    ASSERT_TRUE(write_index(0, bundle.size()));
+    EXPECT_TRUE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+    ASSERT_TRUE(write_index(bundle.size(), 0));
+    EXPECT_TRUE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+    ASSERT_TRUE(write_index(bundle.size() + 1, 0));
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+    ASSERT_TRUE(write_index(1, bundle.size()));
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+    ASSERT_TRUE(write_index(16, ~std::uint64_t{ 0 } - 8));
+    EXPECT_FALSE(AssetBundleIndex::ReadFromFile(index_path, source, bundle.size()).has_value());
+
+    fs::remove_all(index_path.parent_path());
+}
@@ -0,0 +1,119 @@
+#include "mod/dds_format.h"
+#include "util/block_compression.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// A 2048x2048 sheet of 128x128 sprites with gradients, noise and transparent background, the size of the larger game sheets
+static constexpr std::uint32_t c_SheetSize{ 2048 };
+static std::vector<std::uint8_t> MakeSheet()
+{
+    std::mt19937 rng{ 3 };
+    std::vector<std::uint8_t> rgba(static_cast<std::size_t>(c_SheetSize) * c_SheetSize * 4);
+    for (std::uint32_t y = 0; y < c_SheetSize; y++)
+    {
+        for (std::uint32_t x = 0; x < c_SheetSize; x++)
+        {
+            std::uint8_t* pixel = rgba.data() + (static_cast<std::size_t>(y) * c_SheetSize + x) * 4;
+            const std::uint32_t sprite_x = x % 128;
+            const std::uint32_t sprite_y = y % 128;
+            const bool inside = sprite_x > 16 && sprite_x < 112 && sprite_y > 8 && sprite_y < 120;
+            pixel[0] = static_cast<std::uint8_t>(sprite_x * 2 + rng() % 8);
+            pixel[1] = static_cast<std::uint8_t>(sprite_y * 2 + rng() % 8);
+            pixel[2] = static_cast<std::uint8_t>((x / 128 + y / 128) * 16);
+            pixel[3] = inside ? 255 : 0;
+        }
+    }
+    return rgba;
+}
+static const std::vector<std::uint8_t>& GetSheet()
+{
+    static const std::vector<std::uint8_t> sheet = MakeSheet();
+    return sheet;
+}
+
+static fs::path GetDdsPath(bool block_compression)
+{
+    const fs::path folder = fs::temp_directory_path() / "playlunky_benchmarks";
+    fs::create_directories(folder);
+    return folder / (block_compression ? "sheet_bc3.dds" : "sheet_rgba.dds");
+}
+
+// Same as ConvertRBGAToDds
+static void WriteDds(std::span<const std::uint8_t> rgba, bool block_compression, const fs::path& destination)
+{
+    std::vector<std::uint8_t> compressed;
+    if (block_compression)
+    {
+        compressed.resize(GetBC3CompressedSize(c_SheetSize, c_SheetSize));
+        CompressBC3(rgba, c_SheetSize, c_SheetSize, compressed);
+        rgba = compressed;
+    }
+
+    std::ofstream dest_file{ destination, std::ios::trunc | std::ios::binary };
+    const auto header = MakeDdsHeader(c_SheetSize, c_SheetSize, block_compression);
+    dest_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    dest_file.write(reinterpret_cast<const char*>(rgba.data()), rgba.size());
+}
+
+static void BM_WriteDds(benchmark::State& state)
+{
+    const bool block_compression = state.range(0) != 0;
+    const fs::path dds_path = GetDdsPath(block_compression);
+    for (auto _ : state)
+    {
+        WriteDds(GetSheet(), block_compression, dds_path);
+    }
+    state.counters["file_size"] = static_cast<double>(fs::file_size(dds_path));
+}
+BENCHMARK(BM_WriteDds)->ArgName("bc3")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Reading the file is all the game does before uploading it, the compressed data is uploaded as is
+static void BM_LoadDds(benchmark::State& state)
+{
+    const bool block_compression = state.range(0) != 0;
+    const fs::path dds_path = GetDdsPath(block_compression);
+    WriteDds(GetSheet(), block_compression, dds_path);
+
+    const std::string dds_path_string = dds_path.string();
+    const std::size_t file_size = fs::file_size(dds_path);
+    for (auto _ : state)
+    {
+        FILE* file = fopen(dds_path_string.c_str(), "rb");
+        auto data = std::make_unique_for_overwrite<std::uint8_t[]>(file_size);
+        benchmark::DoNotOptimize(fread(data.get(), 1, file_size, file));
+        fclose(file);
+        benchmark::DoNotOptimize(data.get());
+    }
+    state.counters["file_size"] = static_cast<double>(file_size);
+}
+BENCHMARK(BM_LoadDds)->ArgName("bc3")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Decoding back to RGBA, as done when extracting or hot-loading a dds
+static void BM_DecodeDds(benchmark::State& state)
+{
+    const bool block_compression = state.range(0) != 0;
+    const fs::path dds_path = GetDdsPath(block_compression);
+    WriteDds(GetSheet(), block_compression, dds_path);
+
+    std::vector<std::uint8_t> dds(fs::file_size(dds_path));
+    std::ifstream{ dds_path, std::ios::binary }.read(reinterpret_cast<char*>(dds.data()), dds.size());
+
+    std::vector<std::uint8_t> rgba;
+    for (auto _ : state)
+    {
+        std::uint32_t width{ 0 };
+        std::uint32_t height{ 0 };
+        benchmark::DoNotOptimize(DecodeDdsToRBGA(dds, rgba, width, height));
+    }
+}
+BENCHMARK(BM_DecodeDds)->ArgName("bc3")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,52 @@
+#include "mod/chacha.h"
+#include "reference/chacha_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+static constexpr std::string_view c_FilePath{ "Data/Textures/char_yellow.DDS" };
+static constexpr std::uint64_t c_Key{ 0x2F3A9B71C0D4E815 };
+
+static void BM_ChaChaDecrypt(benchmark::State& state)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)), 0x5A);
+    for (auto _ : state)
+    {
+        ChaCha::chacha(c_FilePath, data, data, c_Key);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChaChaDecrypt)->Arg(4 << 10)->Arg(1 << 20)->Arg(32 << 20);
+
+static void BM_ChaChaDecryptReference(benchmark::State& state)
+{
+    const std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)), 0x5A);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ChaChaReference::chacha(c_FilePath, data, c_Key, ChaCha::Version::V2));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChaChaDecryptReference)->Arg(4 << 10)->Arg(1 << 20)->Arg(32 << 20);
+
+static void BM_ChaChaHashFilePath(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ChaCha::hash_filepath(c_FilePath, c_Key));
+    }
+}
+BENCHMARK(BM_ChaChaHashFilePath);
+
+static void BM_ChaChaHashFilePathReference(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ChaChaReference::hash_filepath(c_FilePath, c_Key));
+    }
+}
+BENCHMARK(BM_ChaChaHashFilePathReference);
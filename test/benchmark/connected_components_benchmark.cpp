@@ -0,0 +1,78 @@
+#include "util/connected_components.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifdef PLAYLUNKY_TEST_WITH_OPENCV
+#include <opencv2/imgproc.hpp>
+#endif
+
+// A 2048x2048 sticker sheet, a grid of round sprites that each have a hole with another component inside
+static constexpr std::uint32_t s_SheetSize{ 2048 };
+static constexpr std::uint32_t s_TileSize{ 128 };
+
+static std::vector<std::uint8_t> MakeSheetMask()
+{
+    std::vector<std::uint8_t> mask(std::size_t{ s_SheetSize } * s_SheetSize, 0);
+    auto fill_circle = [&mask](std::int32_t center_x, std::int32_t center_y, std::int32_t radius, std::uint8_t value)
+    {
+        for (std::int32_t y = center_y - radius; y <= center_y + radius; y++)
+        {
+            for (std::int32_t x = center_x - radius; x <= center_x + radius; x++)
+            {
+                if ((x - center_x) * (x - center_x) + (y - center_y) * (y - center_y) <= radius * radius)
+                {
+                    mask[static_cast<std::size_t>(y) * s_SheetSize + x] = value;
+                }
+            }
+        }
+    };
+
+    std::mt19937 rng{ 7 };
+    for (std::uint32_t y = 0; y < s_SheetSize; y += s_TileSize)
+    {
+        for (std::uint32_t x = 0; x < s_SheetSize; x += s_TileSize)
+        {
+            const std::int32_t center_x = static_cast<std::int32_t>(x + s_TileSize / 2);
+            const std::int32_t center_y = static_cast<std::int32_t>(y + s_TileSize / 2);
+            fill_circle(center_x, center_y, static_cast<std::int32_t>(10 + rng() % 50), 255);
+            fill_circle(center_x, center_y, 5, 0);
+            fill_circle(center_x, center_y, 2, 255);
+        }
+    }
+    return mask;
+}
+
+static void BM_GetOuterComponentBounds(benchmark::State& state)
+{
+    const std::vector<std::uint8_t> mask = MakeSheetMask();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(GetOuterComponentBounds(mask, s_SheetSize, s_SheetSize, s_SheetSize));
+    }
+}
+BENCHMARK(BM_GetOuterComponentBounds)->Unit(benchmark::kMillisecond);
+
+#ifdef PLAYLUNKY_TEST_WITH_OPENCV
+static void BM_FindContoursBoundingRects(benchmark::State& state)
+{
+    std::vector<std::uint8_t> mask_data = MakeSheetMask();
+    const cv::Mat mask(static_cast<int>(s_SheetSize), static_cast<int>(s_SheetSize), CV_8UC1, mask_data.data());
+    for (auto _ : state)
+    {
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+        std::vector<cv::Rect> rects;
+        for (const std::vector<cv::Point>& contour : contours)
+        {
+            rects.push_back(cv::boundingRect(contour));
+        }
+        benchmark::DoNotOptimize(rects);
+    }
+}
+BENCHMARK(BM_FindContoursBoundingRects)->Unit(benchmark::kMillisecond);
+#endif
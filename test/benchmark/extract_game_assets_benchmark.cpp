@@ -0,0 +1,177 @@
+#include "mod/asset_bundle.h"
+#include "mod/chacha.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <zstd.h>
+
+namespace fs = std::filesystem;
+
+// The stages of ExtractGameAssets on their own, over a synthetic bundle of 128 textures of 256 KiB
+// Looking up the game's data section and converting dds to png need the game and OpenCV and are left out
+static constexpr std::size_t c_NumAssets{ 128 };
+static constexpr std::size_t c_AssetSize{ 256 * 1024 };
+
+struct ExtractBenchmarkData
+{
+    std::vector<std::string> FilePaths;
+    std::vector<std::vector<std::uint8_t>> CompressedAssets;
+    std::vector<std::uint8_t> Bundle;
+    std::uint64_t Key;
+};
+
+// Same layout as the bundle in Spel2.exe, each asset is zstd compressed
+static ExtractBenchmarkData MakeExtractBenchmarkData()
+{
+    ExtractBenchmarkData data;
+
+    std::mt19937 rng{ 11 };
+    ChaCha::Key key;
+    for (std::size_t i = 0; i < c_NumAssets; i++)
+    {
+        // Runs of pixels with some noise, compresses about as well as the game's textures
+        std::vector<std::uint8_t> asset(c_AssetSize);
+        for (std::size_t j = 0; j < asset.size(); j += 64)
+        {
+            const std::uint8_t value = static_cast<std::uint8_t>(rng());
+            for (std::size_t k = j; k < j + 64; k++)
+            {
+                asset[k] = rng() % 4 == 0 ? static_cast<std::uint8_t>(rng()) : value;
+            }
+        }
+
+        std::vector<std::uint8_t> compressed(ZSTD_compressBound(asset.size()));
+        compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), asset.data(), asset.size(), 9));
+
+        data.FilePaths.push_back("Data/Textures/texture_" + std::to_string(i) + ".DDS");
+        key.update(compressed.size() + 1);
+        data.CompressedAssets.push_back(std::move(compressed));
+    }
+    data.Key = key.Current;
+
+    auto append = [&data](const void* bytes, std::size_t size)
+    {
+        data.Bundle.insert(data.Bundle.end(), static_cast<const std::uint8_t*>(bytes), static_cast<const std::uint8_t*>(bytes) + size);
+    };
+    for (std::size_t i = 0; i < c_NumAssets; i++)
+    {
+        const ChaCha::bytes_t name_hash = ChaCha::hash_filepath(data.FilePaths[i], data.Key);
+        const auto asset_len = static_cast<std::uint32_t>(data.CompressedAssets[i].size() + 1);
+        const auto asset_name_len = static_cast<std::uint32_t>(name_hash.size());
+        const char encrypted{ '\x01' };
+        append(&asset_len, sizeof(asset_len));
+        append(&asset_name_len, sizeof(asset_name_len));
+        append(name_hash.data(), name_hash.size());
+        append(&encrypted, sizeof(encrypted));
+        append(data.CompressedAssets[i].data(), data.CompressedAssets[i].size());
+    }
+    const std::uint64_t terminator{ 0 };
+    append(&terminator, sizeof(terminator));
+
+    return data;
+}
+static const ExtractBenchmarkData& GetExtractBenchmarkData()
+{
+    static const ExtractBenchmarkData data = MakeExtractBenchmarkData();
+    return data;
+}
+
+// Parsing the bundle and looking up every asset, as on the first extraction without a cached index
+static void BM_ExtractIndex(benchmark::State& state)
+{
+    const ExtractBenchmarkData& data = GetExtractBenchmarkData();
+    for (auto _ : state)
+    {
+        const auto index = AssetBundleIndex::Parse(data.Bundle);
+        for (const std::string& file_path : data.FilePaths)
+        {
+            benchmark::DoNotOptimize(index->FindAsset(file_path));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumAssets);
+}
+BENCHMARK(BM_ExtractIndex)->Unit(benchmark::kMillisecond);
+
+// Reading a cached index instead, and looking up every asset
+static void BM_ExtractReadIndex(benchmark::State& state)
+{
+    const ExtractBenchmarkData& data = GetExtractBenchmarkData();
+    const fs::path index_path = fs::temp_directory_path() / "playlunky_benchmarks" / "asset_bundle.idx";
+    const AssetBundleSource source{ .FileSize{ data.Bundle.size() }, .WriteTime{ 0 } };
+    AssetBundleIndex::Parse(data.Bundle)->WriteToFile(index_path, source);
+
+    for (auto _ : state)
+    {
+        const auto index = AssetBundleIndex::ReadFromFile(index_path, source, data.Bundle.size());
+        for (const std::string& file_path : data.FilePaths)
+        {
+            benchmark::DoNotOptimize(index->FindAsset(file_path));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumAssets);
+}
+BENCHMARK(BM_ExtractReadIndex)->Unit(benchmark::kMillisecond);
+
+// Reading the assets out of the bundle, which means decrypting them
+static void BM_ExtractDecrypt(benchmark::State& state)
+{
+    const ExtractBenchmarkData& data = GetExtractBenchmarkData();
+    std::size_t num_bytes{ 0 };
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < c_NumAssets; i++)
+        {
+            const ChaCha::bytes_t decrypted_data = ChaCha::chacha(data.FilePaths[i], data.CompressedAssets[i], data.Key);
+            benchmark::DoNotOptimize(decrypted_data.data());
+            num_bytes += decrypted_data.size();
+        }
+    }
+    state.SetBytesProcessed(num_bytes);
+}
+BENCHMARK(BM_ExtractDecrypt)->Unit(benchmark::kMillisecond);
+
+static void BM_ExtractDecompress(benchmark::State& state)
+{
+    const ExtractBenchmarkData& data = GetExtractBenchmarkData();
+    for (auto _ : state)
+    {
+        for (const std::vector<std::uint8_t>& compressed : data.CompressedAssets)
+        {
+            const std::uint64_t decompressed_size = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+            ChaCha::bytes_t decompressed_data(decompressed_size);
+            benchmark::DoNotOptimize(ZSTD_decompress(decompressed_data.data(), decompressed_data.size(), compressed.data(), compressed.size()));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * c_NumAssets * c_AssetSize);
+}
+BENCHMARK(BM_ExtractDecompress)->Unit(benchmark::kMillisecond);
+
+// Writing the decompressed assets, each into its own file
+static void BM_ExtractWrite(benchmark::State& state)
+{
+    const fs::path destination = fs::temp_directory_path() / "playlunky_benchmarks" / "extracted";
+    const std::vector<std::uint8_t> asset(c_AssetSize, 0x5A);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < c_NumAssets; i++)
+        {
+            const fs::path full_destination = destination / "Data" / "Textures" / ("texture_" + std::to_string(i) + ".DDS");
+
+            std::error_code ec;
+            fs::create_directories(full_destination.parent_path(), ec);
+            if (auto out_file = std::ofstream{ full_destination, std::ios::binary | std::ios::trunc })
+            {
+                out_file.write(reinterpret_cast<const char*>(asset.data()), asset.size());
+            }
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * c_NumAssets * c_AssetSize);
+    fs::remove_all(destination);
+}
+BENCHMARK(BM_ExtractWrite)->Unit(benchmark::kMillisecond);
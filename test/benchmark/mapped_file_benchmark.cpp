@@ -0,0 +1,73 @@
+#include "util/mapped_file.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// File of the given size in the temp folder, it stays in the page cache for the whole benchmark
+// so this measures the cost of getting a cached asset into the games buffer, not the cost of the disk
+static fs::path MakeBenchmarkFile(std::size_t size)
+{
+    const fs::path folder = fs::temp_directory_path() / "playlunky_benchmarks";
+    fs::create_directories(folder);
+
+    const fs::path file_path = folder / ("mapped_file_" + std::to_string(size) + ".bin");
+    if (!fs::exists(file_path) || fs::file_size(file_path) != size)
+    {
+        std::vector<char> content(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            content[i] = static_cast<char>(i * 31);
+        }
+        std::ofstream{ file_path, std::ios::binary }.write(content.data(), content.size());
+    }
+    return file_path;
+}
+
+// Same as the loading of modded files in VfsFolderMount::LoadFile
+static void BM_LoadFileStdio(benchmark::State& state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const std::string file_path = MakeBenchmarkFile(size).string();
+
+    for (auto _ : state)
+    {
+        FILE* file = fopen(file_path.c_str(), "rb");
+        fseek(file, 0, SEEK_END);
+        const std::size_t file_size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        // Not zeroed, same as the game's allocator
+        auto buffer = std::make_unique_for_overwrite<std::uint8_t[]>(file_size);
+        benchmark::DoNotOptimize(fread(buffer.get(), 1, file_size, file));
+        fclose(file);
+        benchmark::DoNotOptimize(buffer.get());
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_LoadFileStdio)->Arg(4 << 10)->Arg(256 << 10)->Arg(4 << 20)->Arg(32 << 20);
+
+// Same as the loading of modded files in VfsFolderMount::LoadFile with memory mapped file loading
+static void BM_LoadFileMapped(benchmark::State& state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const fs::path file_path = MakeBenchmarkFile(size);
+
+    for (auto _ : state)
+    {
+        const MappedFile mapped_file{ file_path };
+        auto buffer = std::make_unique_for_overwrite<std::uint8_t[]>(mapped_file.GetData().size());
+        benchmark::DoNotOptimize(mapped_file.CopyTo(buffer.get()));
+        benchmark::DoNotOptimize(buffer.get());
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_LoadFileMapped)->Arg(4 << 10)->Arg(256 << 10)->Arg(4 << 20)->Arg(32 << 20);
@@ -0,0 +1,108 @@
+#include "mod/mod_database.h"
+#include "util/thread_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// 100 mods with 120 files each spread over a few nested folders, about the size of a large mod setup
+static constexpr std::size_t c_NumMods{ 100 };
+static constexpr std::size_t c_NumFilesPerFolder{ 30 };
+static constexpr const char* c_ModSubFolders[]{ "Data/Textures", "Data/Textures/Entities", "soundbank/ogg", "Data/Levels" };
+
+static fs::path MakeModsFolder()
+{
+    const fs::path mods_folder = fs::temp_directory_path() / "playlunky_benchmarks" / "mod_database" / "Mods" / "Packs";
+    if (fs::exists(mods_folder))
+    {
+        return mods_folder;
+    }
+
+    const std::string content(4096, 'x');
+    for (std::size_t i = 0; i < c_NumMods; i++)
+    {
+        const fs::path mod_folder = mods_folder / ("Mod_" + std::to_string(i));
+        for (const char* sub_folder : c_ModSubFolders)
+        {
+            fs::create_directories(mod_folder / sub_folder);
+            for (std::size_t j = 0; j < c_NumFilesPerFolder; j++)
+            {
+                std::ofstream{ mod_folder / sub_folder / ("file_" + std::to_string(j) + ".png"), std::ios::binary }.write(content.data(), content.size());
+            }
+        }
+    }
+    return mods_folder;
+}
+
+// Same as the scan in ModManager::OnLoad, without a thread pool each mod is scanned after the other
+static void ScanMods(const fs::path& mods_folder, ThreadPool* thread_pool)
+{
+    const fs::path db_folder = mods_folder / ".db";
+    const ModDatabaseFlags flags = static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Recurse | ModDatabaseFlags_ContentHash);
+
+    std::vector<fs::path> mod_folders;
+    for (const fs::directory_entry& dir_entry : fs::directory_iterator{ mods_folder })
+    {
+        if (dir_entry.is_directory() && dir_entry.path() != db_folder)
+        {
+            mod_folders.push_back(dir_entry.path());
+        }
+    }
+
+    auto scan_mod = [&](std::size_t i)
+    {
+        ModDatabase mod_db{ db_folder / "Mods" / mod_folders[i].filename(), mod_folders[i], flags };
+        mod_db.UpdateDatabase(thread_pool);
+        mod_db.WriteDatabase();
+    };
+    if (thread_pool != nullptr)
+    {
+        thread_pool->ForEach(mod_folders.size(), scan_mod);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < mod_folders.size(); i++)
+        {
+            scan_mod(i);
+        }
+    }
+}
+
+// First start, no databases exist so every file is new and gets hashed
+static void BM_ModDatabaseFirstStart(benchmark::State& state)
+{
+    const fs::path mods_folder = MakeModsFolder();
+    std::unique_ptr<ThreadPool> thread_pool = state.range(0) != 0 ? std::make_unique<ThreadPool>() : nullptr;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fs::remove_all(mods_folder / ".db");
+        state.ResumeTiming();
+
+        ScanMods(mods_folder, thread_pool.get());
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumMods);
+}
+BENCHMARK(BM_ModDatabaseFirstStart)->ArgName("thread_pool")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Any later start, all databases exist and nothing changed
+static void BM_ModDatabaseStartup(benchmark::State& state)
+{
+    const fs::path mods_folder = MakeModsFolder();
+    std::unique_ptr<ThreadPool> thread_pool = state.range(0) != 0 ? std::make_unique<ThreadPool>() : nullptr;
+    ScanMods(mods_folder, thread_pool.get());
+
+    for (auto _ : state)
+    {
+        ScanMods(mods_folder, thread_pool.get());
+    }
+    state.SetItemsProcessed(state.iterations() * c_NumMods);
+}
+BENCHMARK(BM_ModDatabaseStartup)->ArgName("thread_pool")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
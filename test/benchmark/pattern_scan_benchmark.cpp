@@ -0,0 +1,74 @@
+#include "detour/pattern_scan.h"
+#include "reference/pattern_scan_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Random bytes with a bias towards the bytes common in x64 code, the signatures are placed near the end so each scan reads almost all data
+struct PatternScanData
+{
+    std::vector<std::uint8_t> Data;
+    std::vector<std::string> Signatures;
+    std::vector<std::string_view> SignatureViews;
+};
+static const PatternScanData& GetPatternScanData(std::size_t num_signatures)
+{
+    static std::map<std::size_t, PatternScanData> s_Data;
+    auto [it, inserted] = s_Data.try_emplace(num_signatures);
+    PatternScanData* data = &it->second;
+    if (inserted)
+    {
+
+        std::mt19937 rng{ 7 };
+        constexpr std::uint8_t common_bytes[]{ 0x00, 0x48, 0x89, 0x8b, 0xe8, 0xff, 0xcc, 0x0f };
+        data->Data.resize(24 << 20);
+        for (std::uint8_t& byte : data->Data)
+        {
+            byte = rng() % 2 == 0 ? common_bytes[rng() % std::size(common_bytes)] : static_cast<std::uint8_t>(rng());
+        }
+
+        for (std::size_t i = 0; i < num_signatures; i++)
+        {
+            const std::size_t offset = data->Data.size() - 4096 * (i + 1);
+            std::string signature(16, '\0');
+            for (std::size_t j = 0; j < signature.size(); j++)
+            {
+                signature[j] = j % 5 == 3 ? '*' : static_cast<char>(data->Data[offset + j]);
+            }
+            data->Signatures.push_back(std::move(signature));
+        }
+        data->SignatureViews.assign(data->Signatures.begin(), data->Signatures.end());
+    }
+    return *data;
+}
+
+static void BM_FindPatternOffsets(benchmark::State& state)
+{
+    const PatternScanData& data = GetPatternScanData(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(SigScan::FindPatternOffsets(data.Data, data.SignatureViews));
+    }
+    state.SetBytesProcessed(state.iterations() * data.Data.size());
+}
+BENCHMARK(BM_FindPatternOffsets)->Arg(1)->Arg(5)->Arg(40)->Unit(benchmark::kMillisecond);
+
+static void BM_FindPatternOffsetsReference(benchmark::State& state)
+{
+    const PatternScanData& data = GetPatternScanData(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (std::string_view signature : data.SignatureViews)
+        {
+            benchmark::DoNotOptimize(PatternScanReference::FindPatternOffset(data.Data, signature));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.Data.size());
+}
+BENCHMARK(BM_FindPatternOffsetsReference)->Arg(1)->Arg(5)->Arg(40)->Unit(benchmark::kMillisecond);
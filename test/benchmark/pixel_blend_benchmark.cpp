@@ -0,0 +1,152 @@
+#include "util/pixel_blend.h"
+#include "reference/pixel_blend_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// A 1024x1024 sheet, blended row by row like image_processing does
+static constexpr std::size_t s_Width{ 1024 };
+static constexpr std::size_t s_Height{ 1024 };
+
+static std::vector<std::uint8_t> MakeSheet(std::uint32_t seed)
+{
+    std::mt19937 rng{ seed };
+    std::vector<std::uint8_t> pixels(s_Width * s_Height * 4);
+    for (std::uint8_t& channel : pixels)
+    {
+        channel = static_cast<std::uint8_t>(rng());
+    }
+    return pixels;
+}
+
+template<class KernelFunT>
+static void BlendRows(benchmark::State& state, KernelFunT&& kernel)
+{
+    const std::vector<std::uint8_t> source = MakeSheet(1);
+    const std::vector<std::uint8_t> original_target = MakeSheet(2);
+    std::vector<std::uint8_t> target = original_target;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        target = original_target;
+        state.ResumeTiming();
+
+        for (std::size_t row = 0; row < s_Height; row++)
+        {
+            const std::size_t offset = row * s_Width * 4;
+            kernel(std::span<const std::uint8_t>{ source.data() + offset, s_Width * 4 }, std::span<std::uint8_t>{ target.data() + offset, s_Width * 4 });
+        }
+        benchmark::DoNotOptimize(target.data());
+    }
+    state.SetItemsProcessed(state.iterations() * s_Width * s_Height);
+}
+
+template<class ReferenceFunT>
+static void BlendPixels(benchmark::State& state, ReferenceFunT&& reference)
+{
+    BlendRows(state, [&](std::span<const std::uint8_t> source, std::span<std::uint8_t> target)
+              {
+                  for (std::size_t i = 0; i < target.size(); i += 4)
+                  {
+                      reference(source.data() + i, target.data() + i);
+                  } });
+}
+
+static void BM_AlphaBlendPixels(benchmark::State& state)
+{
+    BlendRows(state, [](auto source, auto target)
+              { AlphaBlendPixels(source, target); });
+}
+BENCHMARK(BM_AlphaBlendPixels)->Unit(benchmark::kMillisecond);
+
+static void BM_AlphaBlendReference(benchmark::State& state)
+{
+    BlendPixels(state, PixelBlendReference::AlphaBlend);
+}
+BENCHMARK(BM_AlphaBlendReference)->Unit(benchmark::kMillisecond);
+
+static void BM_ColorBlendPixels(benchmark::State& state)
+{
+    BlendRows(state, [](auto source, auto target)
+              { ColorBlendPixels(source, target); });
+}
+BENCHMARK(BM_ColorBlendPixels)->Unit(benchmark::kMillisecond);
+
+static void BM_ColorBlendReference(benchmark::State& state)
+{
+    BlendPixels(state, PixelBlendReference::ColorBlend);
+}
+BENCHMARK(BM_ColorBlendReference)->Unit(benchmark::kMillisecond);
+
+static void BM_LuminanceScalePixels(benchmark::State& state)
+{
+    BlendRows(state, [](auto source, auto target)
+              { LuminanceScalePixels(source, target); });
+}
+BENCHMARK(BM_LuminanceScalePixels)->Unit(benchmark::kMillisecond);
+
+static void BM_LuminanceScaleReference(benchmark::State& state)
+{
+    BlendPixels(state, [](const std::uint8_t* source, std::uint8_t* target)
+                { PixelBlendReference::LuminanceScale(source, target); });
+}
+BENCHMARK(BM_LuminanceScaleReference)->Unit(benchmark::kMillisecond);
+
+// Sixty random 512x512 originals, premultiplied one after the other like Image::Load does while loading a large mod
+static constexpr std::size_t s_NumOriginals{ 60 };
+static constexpr std::size_t s_OriginalSize{ 512 };
+
+static std::vector<std::vector<std::uint8_t>> MakeOriginals()
+{
+    std::mt19937 rng{ 3 };
+    std::vector<std::vector<std::uint8_t>> originals(s_NumOriginals, std::vector<std::uint8_t>(s_OriginalSize * s_OriginalSize * 4));
+    for (std::vector<std::uint8_t>& original : originals)
+    {
+        for (std::uint8_t& channel : original)
+        {
+            channel = static_cast<std::uint8_t>(rng());
+        }
+    }
+    return originals;
+}
+
+template<class KernelFunT>
+static void PremultiplyOriginals(benchmark::State& state, KernelFunT&& kernel)
+{
+    const std::vector<std::vector<std::uint8_t>> decoded_originals = MakeOriginals();
+    std::vector<std::vector<std::uint8_t>> originals = decoded_originals;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        originals = decoded_originals;
+        state.ResumeTiming();
+
+        for (std::vector<std::uint8_t>& original : originals)
+        {
+            kernel(std::span<std::uint8_t>{ original });
+            benchmark::DoNotOptimize(original.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * s_NumOriginals * s_OriginalSize * s_OriginalSize);
+}
+
+static void BM_PremultiplyBGRAPixels(benchmark::State& state)
+{
+    PremultiplyOriginals(state, [](std::span<std::uint8_t> pixels)
+                         { PremultiplyBGRAPixels(pixels); });
+}
+BENCHMARK(BM_PremultiplyBGRAPixels)->Unit(benchmark::kMillisecond);
+
+static void BM_PremultiplyBGRAReference(benchmark::State& state)
+{
+    PremultiplyOriginals(state, [](std::span<std::uint8_t> pixels)
+                         {
+                             for (std::size_t i = 0; i < pixels.size(); i += 4)
+                             {
+                                 PixelBlendReference::PremultiplyBGRA(pixels.data() + i);
+                             } });
+}
+BENCHMARK(BM_PremultiplyBGRAReference)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+#include "mod/shader_source_merge.h"
+#include "reference/shader_merge_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+// A shader with many functions and a mod that replaces every second and extends every third of them
+struct LargeShader
+{
+    std::string Source;
+    std::vector<ShaderMod> Mods;
+};
+static LargeShader MakeLargeShader(int num_functions)
+{
+    LargeShader shader;
+    std::string mod_code;
+    for (int i = 0; i < num_functions; i++)
+    {
+        const std::string name = "func" + std::to_string(i);
+        shader.Source += "float4 " + name + "(float2 uv) {\n    float4 c = float4(uv, 0, 1);\n    for (int j = 0; j < 4; j++) { c *= 0.5; }\n    return c;\n}\n\n";
+        if (i % 2 == 0)
+        {
+            mod_code += "float4 " + name + "(float2 uv) {\n    return float4(1, 1, 1, 1);\n}\n";
+        }
+        if (i % 3 == 0)
+        {
+            mod_code += "#extends\nbool " + name + "(float2 uv, inout float4 return_value) {\n    return false;\n}\n";
+        }
+    }
+    shader.Mods.push_back(ShaderMod{ .Path{ "large_mod" }, .Code{ std::move(mod_code) } });
+    return shader;
+}
+
+static void BM_MergeShaderSource(benchmark::State& state)
+{
+    const LargeShader shader = MakeLargeShader(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(MergeShaderSource(shader.Source, shader.Mods));
+    }
+}
+BENCHMARK(BM_MergeShaderSource)->Arg(100)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+static void BM_MergeShaderSourceReference(benchmark::State& state)
+{
+    const LargeShader shader = MakeLargeShader(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ShaderMergeReference::MergeShaderSource(shader.Source, shader.Mods));
+    }
+}
+BENCHMARK(BM_MergeShaderSourceReference)->Arg(100)->Arg(2000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,99 @@
+#include "mod/string_table_merge.h"
+#include "reference/string_merge_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// A string table with a comment every hundred lines and a translation mod that replaces every line of it
+struct TranslatedStringTable
+{
+    fs::path Folder;
+    fs::path TableFile;
+    fs::path HashFile;
+    std::vector<fs::path> ModFiles;
+
+    explicit TranslatedStringTable(int num_lines)
+    {
+        Folder = fs::temp_directory_path() / "playlunky_benchmarks" / ("string_merge_" + std::to_string(num_lines));
+        fs::remove_all(Folder);
+        fs::create_directories(Folder);
+        TableFile = Folder / "strings00.str";
+        HashFile = Folder / "strings_hashes.hash";
+        ModFiles.push_back(Folder / "strings00_mod.str");
+
+        std::ofstream table{ TableFile, std::ios::binary };
+        std::ofstream hashes{ HashFile, std::ios::binary };
+        std::ofstream mod{ ModFiles.back(), std::ios::binary };
+        for (int i = 0; i < num_lines; i++)
+        {
+            char hash[11];
+            std::snprintf(hash, sizeof(hash), "0x%08x", i % 100 == 0 ? 0xdeadbeef : static_cast<std::uint32_t>(i * 2654435761u));
+            hashes << hash << '\n';
+            if (i % 100 == 0)
+            {
+                table << "# Section " << i << '\n';
+            }
+            else
+            {
+                table << "Original string number " << i << '\n';
+                mod << hash << ": Translated string number " << i << '\n';
+            }
+        }
+    }
+    ~TranslatedStringTable()
+    {
+        fs::remove_all(Folder);
+    }
+};
+
+static void BM_MergeStringTable(benchmark::State& state)
+{
+    const TranslatedStringTable table{ static_cast<int>(state.range(0)) };
+    const fs::path cache_folder = table.Folder / "StringCache";
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fs::remove_all(cache_folder);
+        fs::create_directories(cache_folder);
+        state.ResumeTiming();
+
+        StringHashFile hash_file{ table.HashFile };
+        benchmark::DoNotOptimize(MergeStringTable(hash_file, table.TableFile, table.ModFiles, table.Folder / "merged.str", cache_folder, false));
+    }
+}
+BENCHMARK(BM_MergeStringTable)->Arg(1000)->Arg(12000)->Unit(benchmark::kMillisecond);
+
+static void BM_MergeStringTableCached(benchmark::State& state)
+{
+    const TranslatedStringTable table{ static_cast<int>(state.range(0)) };
+    const fs::path cache_folder = table.Folder / "StringCache";
+    fs::create_directories(cache_folder);
+    {
+        StringHashFile hash_file{ table.HashFile };
+        MergeStringTable(hash_file, table.TableFile, table.ModFiles, table.Folder / "merged.str", cache_folder, false);
+    }
+    for (auto _ : state)
+    {
+        StringHashFile hash_file{ table.HashFile };
+        benchmark::DoNotOptimize(MergeStringTable(hash_file, table.TableFile, table.ModFiles, table.Folder / "merged.str", cache_folder, false));
+    }
+}
+BENCHMARK(BM_MergeStringTableCached)->Arg(1000)->Arg(12000)->Unit(benchmark::kMillisecond);
+
+static void BM_MergeStringTableReference(benchmark::State& state)
+{
+    const TranslatedStringTable table{ static_cast<int>(state.range(0)) };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(StringMergeReference::MergeStringTable(table.TableFile, table.HashFile, table.ModFiles, table.Folder / "merged.str", false));
+    }
+}
+BENCHMARK(BM_MergeStringTableReference)->Arg(1000)->Arg(12000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,94 @@
+#include "mod/vfs_file_index.h"
+#include "reference/vfs_index_reference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+struct BenchmarkMount
+{
+    std::int64_t Priority;
+    std::size_t MountOrder;
+};
+
+// Each mount holds 1000 textures and each texture is in up to four neighbouring mounts, lookups use the case the game uses
+struct VfsBenchmarkData
+{
+    std::vector<BenchmarkMount> Mounts;
+    std::vector<std::string> Lookups;
+};
+static VfsBenchmarkData MakeVfsBenchmarkData(std::size_t num_mounts)
+{
+    VfsBenchmarkData data;
+    for (std::size_t i = 0; i < num_mounts; i++)
+    {
+        data.Mounts.push_back(BenchmarkMount{ static_cast<std::int64_t>(i), i });
+    }
+
+    std::mt19937 rng{ 5 };
+    const std::size_t num_files = num_mounts * 250 + 750;
+    for (std::size_t i = 0; i < 4096; i++)
+    {
+        data.Lookups.push_back("Data/Textures/Mod_Texture_" + std::to_string(rng() % num_files) + ".png");
+    }
+    return data;
+}
+template<class IndexT>
+static void FillIndex(IndexT& index, const VfsBenchmarkData& data)
+{
+    for (std::size_t i = 0; i < data.Mounts.size(); i++)
+    {
+        for (std::size_t j = i * 250; j < i * 250 + 1000; j++)
+        {
+            index.Add(&data.Mounts[i], "data/textures/mod_texture_" + std::to_string(j) + ".png");
+        }
+    }
+}
+
+static void BM_VfsLookup(benchmark::State& state)
+{
+    const VfsBenchmarkData data = MakeVfsBenchmarkData(static_cast<std::size_t>(state.range(0)));
+    VfsFileIndex<BenchmarkMount> index;
+    FillIndex(index, data);
+
+    // Same as collecting a batch of candidates in VirtualFilesystem::LoadFile
+    std::array<VfsFileIndex<BenchmarkMount>::IndexedFile, 8> candidates;
+    std::size_t lookup{ 0 };
+    for (auto _ : state)
+    {
+        const char* path = data.Lookups[lookup++ % data.Lookups.size()].c_str();
+        std::size_t num_candidates{ 0 };
+        for (const auto& indexed_file : index.Find(path))
+        {
+            if (num_candidates == candidates.size())
+            {
+                break;
+            }
+            candidates[num_candidates++].Mount = indexed_file.Mount;
+        }
+        benchmark::DoNotOptimize(candidates.data());
+        benchmark::DoNotOptimize(num_candidates);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VfsLookup)->Arg(1)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_VfsLookupReference(benchmark::State& state)
+{
+    const VfsBenchmarkData data = MakeVfsBenchmarkData(static_cast<std::size_t>(state.range(0)));
+    VfsIndexReference::FileIndex<BenchmarkMount> index;
+    FillIndex(index, data);
+
+    std::size_t lookup{ 0 };
+    for (auto _ : state)
+    {
+        const char* path = data.Lookups[lookup++ % data.Lookups.size()].c_str();
+        benchmark::DoNotOptimize(index.GetCandidates(path));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VfsLookupReference)->Arg(1)->Arg(16)->Arg(64)->Arg(256);
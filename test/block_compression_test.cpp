@@ -0,0 +1,153 @@
+#include "mod/dds_format.h"
+#include "util/block_compression.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Smooth gradients with a soft alpha edge and a few flat areas, similar to sprite art
+static std::vector<std::uint8_t> MakeSprite(std::uint32_t width, std::uint32_t height)
+{
+    std::vector<std::uint8_t> rgba(static_cast<std::size_t>(width) * height * 4);
+    for (std::uint32_t y = 0; y < height; y++)
+    {
+        for (std::uint32_t x = 0; x < width; x++)
+        {
+            std::uint8_t* pixel = rgba.data() + (static_cast<std::size_t>(y) * width + x) * 4;
+            const bool flat = (x / 8 + y / 8) % 3 == 0;
+            pixel[0] = flat ? 200 : static_cast<std::uint8_t>(x * 255 / std::max(width - 1, 1u));
+            pixel[1] = flat ? 40 : static_cast<std::uint8_t>(y * 255 / std::max(height - 1, 1u));
+            pixel[2] = flat ? 90 : static_cast<std::uint8_t>((x + y) * 127 / std::max(width + height - 2, 1u));
+            const double distance = std::hypot(x - width / 2.0, y - height / 2.0) / (std::min(width, height) / 2.0);
+            pixel[3] = static_cast<std::uint8_t>(std::clamp((1.2 - distance) * 255.0, 0.0, 255.0));
+        }
+    }
+    return rgba;
+}
+
+static std::vector<std::uint8_t> MakeDds(std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height)
+{
+    const auto header = MakeDdsHeader(width, height, true);
+    std::vector<std::uint8_t> dds(header.begin(), header.end());
+    dds.resize(header.size() + GetBC3CompressedSize(width, height));
+    CompressBC3(rgba, width, height, std::span{ dds }.subspan(header.size()));
+    return dds;
+}
+
+// Largest difference of any channel, and of the alpha channel
+static std::pair<int, int> GetMaxError(std::span<const std::uint8_t> lhs, std::span<const std::uint8_t> rhs)
+{
+    int max_color_error{ 0 };
+    int max_alpha_error{ 0 };
+    for (std::size_t i = 0; i < lhs.size(); i++)
+    {
+        int& max_error = i % 4 == 3 ? max_alpha_error : max_color_error;
+        max_error = std::max(max_error, std::abs(int{ lhs[i] } - int{ rhs[i] }));
+    }
+    return { max_color_error, max_alpha_error };
+}
+
+TEST(BlockCompressionTest, CompressedSize)
+{
+    EXPECT_EQ(GetBC3CompressedSize(4, 4), 16);
+    EXPECT_EQ(GetBC3CompressedSize(5, 4), 32);
+    EXPECT_EQ(GetBC3CompressedSize(2048, 2048), 2048 * 2048);
+    EXPECT_EQ(GetBC3CompressedSize(13, 7), 4 * 2 * 16);
+}
+
+TEST(BlockCompressionTest, RoundTripThroughDds)
+{
+    // Sizes that are not a multiple of the block size cover the padding at the edges
+    for (const auto& [width, height] : { std::pair{ 64u, 64u }, std::pair{ 67u, 35u }, std::pair{ 1u, 1u }, std::pair{ 130u, 66u }, std::pair{ 256u, 256u } })
+    {
+        const std::vector<std::uint8_t> rgba = MakeSprite(width, height);
+        const std::vector<std::uint8_t> dds = MakeDds(rgba, width, height);
+
+        std::vector<std::uint8_t> decoded;
+        std::uint32_t decoded_width{ 0 };
+        std::uint32_t decoded_height{ 0 };
+        ASSERT_TRUE(DecodeDdsToRBGA(dds, decoded, decoded_width, decoded_height));
+        ASSERT_EQ(decoded_width, width);
+        ASSERT_EQ(decoded_height, height);
+        ASSERT_EQ(decoded.size(), rgba.size());
+
+        // Colors are quantized to 565 endpoints and four interpolated colors per block, alpha to eight values per block
+        const auto [max_color_error, max_alpha_error] = GetMaxError(rgba, decoded);
+        EXPECT_LE(max_color_error, 16) << width << "x" << height;
+        EXPECT_LE(max_alpha_error, 8) << width << "x" << height;
+    }
+}
+
+TEST(BlockCompressionTest, FlatBlocksAreExact)
+{
+    // Colors that are exact in 565 and fully opaque or transparent alpha survive without loss
+    std::vector<std::uint8_t> rgba(16 * 16 * 4);
+    for (std::size_t i = 0; i < rgba.size(); i += 4)
+    {
+        const bool opaque = (i / 4) % 16 < 8;
+        rgba[i + 0] = opaque ? 255 : 0;
+        rgba[i + 1] = opaque ? 130 : 0;
+        rgba[i + 2] = opaque ? 66 : 0;
+        rgba[i + 3] = opaque ? 255 : 0;
+    }
+
+    std::vector<std::uint8_t> blocks(GetBC3CompressedSize(16, 16));
+    CompressBC3(rgba, 16, 16, blocks);
+    std::vector<std::uint8_t> decoded(rgba.size());
+    DecompressBC3(blocks, 16, 16, decoded);
+    EXPECT_EQ(decoded, rgba);
+}
+
+TEST(BlockCompressionTest, UncompressedDds)
+{
+    const std::vector<std::uint8_t> rgba = MakeSprite(9, 5);
+    const auto header = MakeDdsHeader(9, 5, false);
+    std::vector<std::uint8_t> dds(header.begin(), header.end());
+    dds.insert(dds.end(), rgba.begin(), rgba.end());
+
+    std::vector<std::uint8_t> decoded;
+    std::uint32_t width{ 0 };
+    std::uint32_t height{ 0 };
+    ASSERT_TRUE(DecodeDdsToRBGA(dds, decoded, width, height));
+    EXPECT_EQ(width, 9);
+    EXPECT_EQ(height, 5);
+    EXPECT_EQ(decoded, rgba);
+}
+
+TEST(BlockCompressionTest, RejectsTruncatedAndInvalidDds)
+{
+    const std::vector<std::uint8_t> rgba = MakeSprite(32, 32);
+    const std::vector<std::uint8_t> dds = MakeDds(rgba, 32, 32);
+
+    std::vector<std::uint8_t> decoded;
+    std::uint32_t width{ 0 };
+    std::uint32_t height{ 0 };
+
+    // Missing the last byte of the last block
+    EXPECT_FALSE(DecodeDdsToRBGA(std::span{ dds }.first(dds.size() - 1), decoded, width, height));
+    // Only a header, or not even that
+    EXPECT_FALSE(DecodeDdsToRBGA(std::span{ dds }.first(c_DdsHeaderSize), decoded, width, height));
+    EXPECT_FALSE(DecodeDdsToRBGA(std::span{ dds }.first(c_DdsHeaderSize - 1), decoded, width, height));
+    EXPECT_FALSE(DecodeDdsToRBGA({}, decoded, width, height));
+
+    // A header claiming a much larger image than the data holds
+    std::vector<std::uint8_t> oversized = dds;
+    const std::uint32_t huge_width{ 1u << 15 };
+    std::memcpy(oversized.data() + 16, &huge_width, sizeof(huge_width));
+    EXPECT_FALSE(DecodeDdsToRBGA(oversized, decoded, width, height));
+
+    // Another compression than BC3
+    std::vector<std::uint8_t> dxt1 = dds;
+    dxt1[87] = '1';
+    EXPECT_FALSE(DecodeDdsToRBGA(dxt1, decoded, width, height));
+
+    std::vector<std::uint8_t> bad_magic = dds;
+    bad_magic[0] = 'X';
+    EXPECT_FALSE(DecodeDdsToRBGA(bad_magic, decoded, width, height));
+}
@@ -0,0 +1,242 @@
+#include "mod/cache_audio_file.h"
+#include "test_decode_audio_file.h"
+#include "test_temp_folder.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class CacheAudioFileTest : public TempFolderTest
+{
+  protected:
+    fs::path SourceFile() const
+    {
+        return mTestFolder / "Mods" / "Packs" / "TestMod" / "soundbank" / "wav" / "sound.wav";
+    }
+    fs::path OutputFolder() const
+    {
+        return mTestFolder / "Mods" / "Packs" / ".db" / "Mods" / "TestMod";
+    }
+    fs::path CachedFile() const
+    {
+        return OutputFolder() / "raw_audio" / "sound.raw";
+    }
+
+    template<class T>
+    void WriteSource(SoundFormat format, const std::vector<T>& samples)
+    {
+        fs::create_directories(SourceFile().parent_path());
+        WriteTestAudioFile(SourceFile(), 2, 44100, format, std::as_bytes(std::span{ samples }));
+    }
+
+    std::vector<std::uint8_t> ReadCachedFile() const
+    {
+        const std::string content = ReadFile(CachedFile());
+        return { content.begin(), content.end() };
+    }
+    void WriteCachedFile(const std::vector<std::uint8_t>& content) const
+    {
+        WriteFile(CachedFile(), content);
+    }
+};
+
+template<class T>
+static std::vector<T> GetSamples(const DecodedAudioBuffer& buffer)
+{
+    std::vector<T> samples(buffer.DataSize / sizeof(T));
+    std::memcpy(samples.data(), buffer.Data.get() + 16, samples.size() * sizeof(T));
+    return samples;
+}
+
+// Half a second of a tone, some silence and noise, long enough for several chunks that are both compressed and stored
+static std::vector<float> MakeFloatSamples(float amplitude)
+{
+    std::mt19937 rng{ 13 };
+    std::uniform_real_distribution<float> noise{ -amplitude, amplitude };
+
+    std::vector<float> samples(2 * 44100);
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        if (i < samples.size() / 3)
+        {
+            samples[i] = amplitude * std::sin(static_cast<float>(i) * 0.05f);
+        }
+        else if (i < samples.size() * 2 / 3)
+        {
+            samples[i] = 0.0f;
+        }
+        else
+        {
+            samples[i] = noise(rng);
+        }
+    }
+    return samples;
+}
+
+TEST_F(CacheAudioFileTest, RoundTripPcm16)
+{
+    std::mt19937 rng{ 7 };
+    std::vector<std::int16_t> samples(300'000);
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = i < samples.size() / 2 ? std::int16_t{ 0 } : static_cast<std::int16_t>(rng());
+    }
+    WriteSource(SoundFormat::PCM_16, samples);
+
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+    EXPECT_TRUE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+
+    // The silent half compresses, the noise is stored as is
+    EXPECT_LT(fs::file_size(CachedFile()), samples.size() * sizeof(std::int16_t));
+
+    const DecodedAudioBuffer buffer = LoadCachedAudioFile(CachedFile());
+    ASSERT_NE(buffer.Data, nullptr);
+    EXPECT_EQ(buffer.NumChannels, 2);
+    EXPECT_EQ(buffer.Frequency, 44100);
+    EXPECT_EQ(buffer.Format, SoundFormat::PCM_16);
+    EXPECT_EQ(GetSamples<std::int16_t>(buffer), samples);
+}
+
+TEST_F(CacheAudioFileTest, RoundTripFloatWithoutClipping)
+{
+    // Float samples that don't clip are stored as 16 bit
+    const std::vector<float> samples = MakeFloatSamples(1.0f);
+    WriteSource(SoundFormat::PCM_FLOAT, samples);
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+
+    const DecodedAudioBuffer buffer = LoadCachedAudioFile(CachedFile());
+    ASSERT_NE(buffer.Data, nullptr);
+    EXPECT_EQ(buffer.Format, SoundFormat::PCM_16);
+
+    const std::vector<std::int16_t> converted_samples = GetSamples<std::int16_t>(buffer);
+    ASSERT_EQ(converted_samples.size(), samples.size());
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        ASSERT_EQ(converted_samples[i], std::lround(samples[i] * 32767.0f)) << i;
+    }
+}
+
+TEST_F(CacheAudioFileTest, RoundTripFloatWithClipping)
+{
+    // A single clipping sample keeps the whole file as float, so nothing is lost
+    std::vector<float> samples = MakeFloatSamples(0.5f);
+    samples[samples.size() / 2] = 1.5f;
+    WriteSource(SoundFormat::PCM_FLOAT, samples);
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+
+    const DecodedAudioBuffer buffer = LoadCachedAudioFile(CachedFile());
+    ASSERT_NE(buffer.Data, nullptr);
+    EXPECT_EQ(buffer.Format, SoundFormat::PCM_FLOAT);
+    EXPECT_EQ(GetSamples<float>(buffer), samples);
+}
+
+TEST_F(CacheAudioFileTest, RejectsTruncatedAndCorruptFiles)
+{
+    std::vector<std::int16_t> samples(300'000, 0);
+    WriteSource(SoundFormat::PCM_16, samples);
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+
+    const std::vector<std::uint8_t> cached_file = ReadCachedFile();
+    ASSERT_NE(LoadCachedAudioFile(CachedFile()).Data, nullptr);
+
+    // Header of 56 bytes, then the source path and the chunk table
+    std::uint32_t source_path_size;
+    std::memcpy(&source_path_size, cached_file.data() + 48, sizeof(source_path_size));
+    const std::size_t chunks_offset = 56 + source_path_size;
+
+    // Cut off anywhere, in the header, the chunk table or the chunk data
+    for (std::size_t size : { std::size_t{ 0 }, std::size_t{ 20 }, chunks_offset + 8, cached_file.size() - 1 })
+    {
+        WriteCachedFile({ cached_file.begin(), cached_file.begin() + size });
+        EXPECT_EQ(LoadCachedAudioFile(CachedFile()).Data, nullptr) << size;
+    }
+
+    // A chunk claims more stored data than the file has
+    std::vector<std::uint8_t> corrupt_file = cached_file;
+    const std::uint64_t huge_size{ 1ull << 40 };
+    std::memcpy(corrupt_file.data() + chunks_offset, &huge_size, sizeof(huge_size));
+    WriteCachedFile(corrupt_file);
+    EXPECT_EQ(LoadCachedAudioFile(CachedFile()).Data, nullptr);
+
+    // A chunk claims to decompress to more than the total data size
+    corrupt_file = cached_file;
+    std::memcpy(corrupt_file.data() + chunks_offset + 8, &huge_size, sizeof(huge_size));
+    WriteCachedFile(corrupt_file);
+    EXPECT_EQ(LoadCachedAudioFile(CachedFile()).Data, nullptr);
+
+    // Compressed data that is not a zstd frame
+    std::uint32_t num_chunks;
+    std::memcpy(&num_chunks, cached_file.data() + 20, sizeof(num_chunks));
+    corrupt_file = cached_file;
+    corrupt_file[chunks_offset + num_chunks * 16] ^= 0xff;
+    WriteCachedFile(corrupt_file);
+    EXPECT_EQ(LoadCachedAudioFile(CachedFile()).Data, nullptr);
+
+    // Another version
+    corrupt_file = cached_file;
+    corrupt_file[4]++;
+    WriteCachedFile(corrupt_file);
+    EXPECT_EQ(LoadCachedAudioFile(CachedFile()).Data, nullptr);
+    EXPECT_FALSE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+}
+
+TEST_F(CacheAudioFileTest, DetectsStaleSource)
+{
+    std::vector<std::int16_t> samples(1000, 100);
+    WriteSource(SoundFormat::PCM_16, samples);
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+    EXPECT_TRUE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+
+    // Touching the source makes the cache stale
+    fs::last_write_time(SourceFile(), fs::last_write_time(SourceFile()) + std::chrono::seconds{ 10 });
+    EXPECT_FALSE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+    EXPECT_TRUE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+
+    // So does changing its size, even with the old write time
+    const auto write_time = fs::last_write_time(SourceFile());
+    samples.resize(2000, 200);
+    WriteSource(SoundFormat::PCM_16, samples);
+    fs::last_write_time(SourceFile(), write_time);
+    EXPECT_FALSE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+    const DecodedAudioBuffer buffer = LoadCachedAudioFile(CachedFile());
+    ASSERT_NE(buffer.Data, nullptr);
+    EXPECT_EQ(GetSamples<std::int16_t>(buffer), samples);
+
+    // A deleted source leaves nothing to compare against
+    fs::remove(SourceFile());
+    EXPECT_FALSE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+}
+
+TEST_F(CacheAudioFileTest, WritesThroughTemporaryFile)
+{
+    const std::vector<std::int16_t> samples(1000, 42);
+    WriteSource(SoundFormat::PCM_16, samples);
+
+    // Left behind by a write that never finished, never treated as a cache
+    fs::path temp_file = CachedFile();
+    temp_file += ".tmp";
+    WriteFile(temp_file, "partial");
+    EXPECT_FALSE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), false));
+    EXPECT_TRUE(HasCachedAudioFile(SourceFile(), OutputFolder()));
+    EXPECT_FALSE(fs::exists(temp_file));
+    EXPECT_EQ(GetSamples<std::int16_t>(LoadCachedAudioFile(CachedFile())), samples);
+
+    // Forcing replaces the existing cache
+    ASSERT_TRUE(CacheAudioFile(SourceFile(), OutputFolder(), true));
+    EXPECT_FALSE(fs::exists(temp_file));
+    EXPECT_EQ(GetSamples<std::int16_t>(LoadCachedAudioFile(CachedFile())), samples);
+}
@@ -0,0 +1,79 @@
+#include "mod/chacha.h"
+#include "reference/chacha_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Paths are limited to 128 characters, the reference read past the end of longer paths
+static std::string MakeFilePath(std::size_t size)
+{
+    std::string file_path;
+    file_path.reserve(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        file_path.push_back(static_cast<char>('a' + (i * 7) % 26));
+    }
+    return file_path;
+}
+
+static std::vector<std::uint8_t> MakeData(std::size_t size)
+{
+    std::vector<std::uint8_t> data(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+    return data;
+}
+
+TEST(ChaCha, HashFilePathMatchesReference)
+{
+    constexpr std::uint64_t key{ 0xB6A6F71B3E8F5DA3 };
+    for (std::size_t size = 1; size <= 128; size++)
+    {
+        const std::string file_path = MakeFilePath(size);
+        EXPECT_EQ(ChaCha::hash_filepath(file_path, key), ChaChaReference::hash_filepath(file_path, key)) << "path size " << size;
+    }
+}
+
+TEST(ChaCha, DecryptMatchesReference)
+{
+    constexpr std::uint64_t key{ 0x2F3A9B71C0D4E815 };
+    for (ChaCha::Version version : { ChaCha::Version::V1, ChaCha::Version::V2 })
+    {
+        for (std::size_t path_size : { 1, 17, 63, 64, 65, 100, 128 })
+        {
+            const std::string file_path = MakeFilePath(path_size);
+            for (std::size_t data_size = 0; data_size <= 1000; data_size += 13)
+            {
+                const std::vector<std::uint8_t> data = MakeData(data_size);
+                EXPECT_EQ(ChaCha::chacha(file_path, data, key, version), ChaChaReference::chacha(file_path, data, key, version))
+                    << "path size " << path_size << ", data size " << data_size;
+            }
+        }
+    }
+}
+
+TEST(ChaCha, DecryptInPlace)
+{
+    constexpr std::uint64_t key{ 0x2F3A9B71C0D4E815 };
+    const std::string file_path = MakeFilePath(42);
+    std::vector<std::uint8_t> data = MakeData(4099);
+    const ChaCha::bytes_t expected = ChaCha::chacha(file_path, data, key);
+
+    ChaCha::chacha(file_path, data, data, key);
+    EXPECT_EQ(data, expected);
+}
+
+TEST(ChaCha, HashFilePathIntoBuffer)
+{
+    constexpr std::uint64_t key{ 0xB6A6F71B3E8F5DA3 };
+    const std::string file_path = MakeFilePath(200);
+    std::vector<std::uint8_t> hash(file_path.size());
+
+    ChaCha::hash_filepath(file_path, hash, key);
+    EXPECT_EQ(hash, ChaCha::hash_filepath(file_path, key));
+}
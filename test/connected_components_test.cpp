@@ -0,0 +1,161 @@
+#include "util/connected_components.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#ifdef PLAYLUNKY_TEST_WITH_OPENCV
+#include <opencv2/imgproc.hpp>
+#endif
+
+struct Mask
+{
+    std::vector<std::uint8_t> Pixels;
+    std::uint32_t Width;
+    std::uint32_t Height;
+};
+
+// Every '#' is a set pixel
+static Mask MakeMask(std::initializer_list<std::string_view> rows)
+{
+    Mask mask{ .Pixels{}, .Width{ static_cast<std::uint32_t>(rows.begin()->size()) }, .Height{ static_cast<std::uint32_t>(rows.size()) } };
+    for (std::string_view row : rows)
+    {
+        for (char c : row)
+        {
+            mask.Pixels.push_back(c == '#' ? 255 : 0);
+        }
+    }
+    return mask;
+}
+
+using Rect = std::tuple<std::int32_t, std::int32_t, std::uint32_t, std::uint32_t>;
+static std::vector<Rect> GetBounds(const Mask& mask)
+{
+    std::vector<Rect> rects;
+    for (const ImageSubRegion& region : GetOuterComponentBounds(mask.Pixels, mask.Width, mask.Height, mask.Width))
+    {
+        rects.push_back({ region.x, region.y, region.width, region.height });
+    }
+    return rects;
+}
+
+// Expected rects are the bounding rects of cv::findContours(mask, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE), in the same order
+TEST(ConnectedComponents, SeparateComponents)
+{
+    const Mask mask = MakeMask({
+        "##....",
+        "##..##",
+        "....##",
+        "#.....",
+    });
+    EXPECT_EQ(GetBounds(mask), (std::vector<Rect>{ { 0, 3, 1, 1 }, { 4, 1, 2, 2 }, { 0, 0, 2, 2 } }));
+}
+
+TEST(ConnectedComponents, SkipsComponentsInHoles)
+{
+    const Mask mask = MakeMask({
+        "#######",
+        "#.....#",
+        "#.###.#",
+        "#.#.#.#",
+        "#.###.#",
+        "#.....#",
+        "#######",
+        ".......",
+        "..#....",
+    });
+    EXPECT_EQ(GetBounds(mask), (std::vector<Rect>{ { 2, 8, 1, 1 }, { 0, 0, 7, 7 } }));
+}
+
+TEST(ConnectedComponents, DiagonalNeighbours)
+{
+    const Mask mask = MakeMask({
+        "#...",
+        ".#..",
+        "..#.",
+        "...#",
+        "....",
+        "#..#",
+        ".##.",
+    });
+    EXPECT_EQ(GetBounds(mask), (std::vector<Rect>{ { 0, 5, 4, 2 }, { 0, 0, 4, 4 } }));
+}
+
+TEST(ConnectedComponents, MergingBranches)
+{
+    const Mask mask = MakeMask({
+        "#.#.#",
+        "#.#.#",
+        "#.#.#",
+        "#####",
+        ".....",
+        "###..",
+        "..#..",
+        "###..",
+    });
+    EXPECT_EQ(GetBounds(mask), (std::vector<Rect>{ { 0, 5, 3, 3 }, { 0, 0, 5, 4 } }));
+}
+
+TEST(ConnectedComponents, TouchingBorders)
+{
+    const Mask mask = MakeMask({
+        "#..#",
+        "....",
+        "....",
+        "#..#",
+    });
+    EXPECT_EQ(GetBounds(mask), (std::vector<Rect>{ { 3, 3, 1, 1 }, { 0, 3, 1, 1 }, { 3, 0, 1, 1 }, { 0, 0, 1, 1 } }));
+    EXPECT_TRUE(GetBounds(MakeMask({ "....", "...." })).empty());
+}
+
+TEST(ConnectedComponents, IgnoresPaddingOfRows)
+{
+    const Mask mask = MakeMask({
+        "#..#####",
+        "....####",
+        "..######",
+    });
+    const std::vector<ImageSubRegion> bounds = GetOuterComponentBounds(mask.Pixels, 3, mask.Height, mask.Width);
+    ASSERT_EQ(bounds.size(), 2);
+    EXPECT_EQ(std::tie(bounds[0].x, bounds[0].y, bounds[0].width, bounds[0].height), std::make_tuple(2, 2, 1u, 1u));
+    EXPECT_EQ(std::tie(bounds[1].x, bounds[1].y, bounds[1].width, bounds[1].height), std::make_tuple(0, 0, 1u, 1u));
+}
+
+#ifdef PLAYLUNKY_TEST_WITH_OPENCV
+TEST(ConnectedComponents, MatchesFindContours)
+{
+    std::mt19937 rng{ 7 };
+    for (int i = 0; i < 300; i++)
+    {
+        const std::uint32_t width = 1 + rng() % 60;
+        const std::uint32_t height = 1 + rng() % 60;
+        const std::uint32_t density = rng() % 100;
+
+        cv::Mat mask(static_cast<int>(height), static_cast<int>(width), CV_8UC1);
+        for (int y = 0; y < mask.rows; y++)
+        {
+            for (int x = 0; x < mask.cols; x++)
+            {
+                mask.at<std::uint8_t>(y, x) = rng() % 100 < density ? 255 : 0;
+            }
+        }
+
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+        std::vector<Rect> expected;
+        for (const std::vector<cv::Point>& contour : contours)
+        {
+            const cv::Rect rect = cv::boundingRect(contour);
+            expected.push_back({ rect.x, rect.y, static_cast<std::uint32_t>(rect.width), static_cast<std::uint32_t>(rect.height) });
+        }
+
+        const Mask labelled_mask{ .Pixels{ mask.data, mask.data + mask.total() }, .Width{ width }, .Height{ height } };
+        EXPECT_EQ(GetBounds(labelled_mask), expected) << "mask " << i << ", " << width << "x" << height;
+    }
+}
+#endif
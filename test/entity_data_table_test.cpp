@@ -0,0 +1,70 @@
+#include "mod/entity_data_table.h"
+#include "reference/entity_data_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+class EntityDataTableTest : public testing::Test
+{
+  protected:
+    static void SetUpTestSuite()
+    {
+        s_Mappings = EntityDataReference::ParseEntityMappings(
+            EntityDataReference::LoadResource("entities.json"),
+            EntityDataReference::LoadResource("textures.json"));
+    }
+
+    static inline EntityDataReference::EntityMappings s_Mappings;
+};
+
+TEST_F(EntityDataTableTest, MatchesEntitiesJson)
+{
+    ASSERT_FALSE(s_Mappings.Entities.empty());
+    for (const auto& [name, expected] : s_Mappings.Entities)
+    {
+        const EntityData* entity_data = FindEntityData(name);
+        ASSERT_NE(entity_data, nullptr) << name;
+        EXPECT_EQ(entity_data->Name, name);
+        EXPECT_EQ(entity_data->Id, expected.Id) << name;
+        EXPECT_EQ(entity_data->TextureId, expected.TextureId) << name;
+        EXPECT_EQ(entity_data->TileX, expected.TileX) << name;
+        EXPECT_EQ(entity_data->TileY, expected.TileY) << name;
+
+        const auto animations = GetEntityAnimations(*entity_data);
+        ASSERT_EQ(animations.size(), expected.Animations.size()) << name;
+        std::size_t i{ 0 };
+        for (const auto& [id, expected_animation] : expected.Animations)
+        {
+            EXPECT_EQ(animations[i].Id, id) << name;
+            EXPECT_EQ(animations[i].FirstTileIndex, expected_animation.FirstTileIndex) << name;
+            EXPECT_EQ(animations[i].NumTiles, expected_animation.NumTiles) << name;
+            i++;
+        }
+    }
+}
+
+TEST_F(EntityDataTableTest, MatchesTexturesJson)
+{
+    ASSERT_FALSE(s_Mappings.Textures.empty());
+    for (const auto& [id, expected] : s_Mappings.Textures)
+    {
+        const TextureData* texture_data = FindTextureData(id);
+        ASSERT_NE(texture_data, nullptr) << id;
+        EXPECT_EQ(texture_data->Id, id);
+        EXPECT_EQ(texture_data->NumTilesWidth, expected.NumTilesWidth) << id;
+        EXPECT_EQ(texture_data->TileWidth, expected.TileWidth) << id;
+        EXPECT_EQ(texture_data->TileHeight, expected.TileHeight) << id;
+        EXPECT_EQ(texture_data->OffsetWidth, expected.OffsetWidth) << id;
+        EXPECT_EQ(texture_data->OffsetHeight, expected.OffsetHeight) << id;
+    }
+}
+
+TEST_F(EntityDataTableTest, UnknownNamesAndIdsAreNotFound)
+{
+    EXPECT_EQ(FindEntityData(""), nullptr);
+    EXPECT_EQ(FindEntityData("ENT_TYPE_NOT_AN_ENTITY"), nullptr);
+    EXPECT_EQ(FindEntityData("ent_type_mons_pet_dog"), nullptr);
+    EXPECT_EQ(FindTextureData(-1), nullptr);
+    EXPECT_EQ(FindTextureData(1 << 30), nullptr);
+}
@@ -0,0 +1,147 @@
+#include "mod/fsb_parser.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct SyntheticSample
+{
+    std::uint32_t DataOffset;
+    std::optional<std::string> ChunkName;
+};
+
+template<class T>
+static void Append(std::vector<char>& data, T value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+// Builds a FSB5 sound bank, names are either written to the name table or, if table_names is empty, as name chunks of the sample headers
+static std::vector<char> MakeFsb(const std::vector<SyntheticSample>& samples, const std::vector<std::string>& table_names, std::uint32_t version = 1)
+{
+    std::vector<char> sample_headers;
+    for (const SyntheticSample& sample : samples)
+    {
+        Append<std::uint64_t>(sample_headers, (std::uint64_t{ sample.DataOffset >> 5 } << 7) | 1);
+
+        // An unrelated chunk before the name chunk, to test skipping of chunks
+        const std::uint32_t more_chunks = sample.ChunkName.has_value() ? 1 : 0;
+        Append<std::uint32_t>(sample_headers, (0x2u << 24) | (4 << 1) | more_chunks);
+        Append<std::uint32_t>(sample_headers, 44100);
+
+        if (sample.ChunkName.has_value())
+        {
+            const std::string& name = sample.ChunkName.value();
+            const auto chunk_size = static_cast<std::uint32_t>(1 + name.size() + 1);
+            Append<std::uint32_t>(sample_headers, (0x8u << 24) | (chunk_size << 1));
+            sample_headers.push_back(static_cast<char>(name.size()));
+            sample_headers.insert(sample_headers.end(), name.begin(), name.end());
+            sample_headers.push_back('\0');
+        }
+    }
+
+    std::vector<char> sample_names;
+    if (!table_names.empty())
+    {
+        std::uint32_t name_offset = static_cast<std::uint32_t>(table_names.size() * 4);
+        for (const std::string& name : table_names)
+        {
+            Append<std::uint32_t>(sample_names, name_offset);
+            name_offset += static_cast<std::uint32_t>(name.size() + 1);
+        }
+        for (const std::string& name : table_names)
+        {
+            sample_names.insert(sample_names.end(), name.begin(), name.end());
+            sample_names.push_back('\0');
+        }
+    }
+
+    const std::vector<char> sample_datas(256, '\0');
+
+    std::vector<char> fsb;
+    fsb.reserve(60 + sample_headers.size() + sample_names.size() + sample_datas.size());
+    Append(fsb, std::array{ 'F', 'S', 'B', '5' });
+    Append<std::uint32_t>(fsb, version);
+    Append<std::uint32_t>(fsb, static_cast<std::uint32_t>(samples.size()));
+    Append<std::uint32_t>(fsb, static_cast<std::uint32_t>(sample_headers.size()));
+    Append<std::uint32_t>(fsb, static_cast<std::uint32_t>(sample_names.size()));
+    Append<std::uint32_t>(fsb, static_cast<std::uint32_t>(sample_datas.size()));
+    Append<std::uint32_t>(fsb, 0);
+    fsb.insert(fsb.end(), 32, '\0');
+    fsb.insert(fsb.end(), sample_headers.begin(), sample_headers.end());
+    fsb.insert(fsb.end(), sample_names.begin(), sample_names.end());
+    fsb.insert(fsb.end(), sample_datas.begin(), sample_datas.end());
+    return fsb;
+}
+
+TEST(FsbParser, NameTable)
+{
+    std::vector<char> bank(100, 'x');
+    const std::vector<char> fsb = MakeFsb({ { 64, std::nullopt }, { 0, std::nullopt } }, { "alpha", "beta_b" });
+    bank.insert(bank.end(), fsb.begin(), fsb.end());
+
+    const std::vector<FsbHeader> fsb_files = ParseFsbFiles(bank);
+    ASSERT_EQ(fsb_files.size(), 1);
+    EXPECT_EQ(fsb_files[0].Offset, 100);
+
+    // Sorted by offset, which is relative to the start of the fsb
+    const std::uint32_t datas_offset = static_cast<std::uint32_t>(fsb.size() - 256);
+    ASSERT_EQ(fsb_files[0].Samples.size(), 2);
+    EXPECT_EQ(fsb_files[0].Samples[0].Name, "beta_b");
+    EXPECT_EQ(fsb_files[0].Samples[0].Offset, datas_offset);
+    EXPECT_EQ(fsb_files[0].Samples[1].Name, "alpha");
+    EXPECT_EQ(fsb_files[0].Samples[1].Offset, datas_offset + 64);
+}
+
+TEST(FsbParser, NameChunks)
+{
+    const std::vector<char> bank = MakeFsb({ { 0, "chunk_name" }, { 32, std::nullopt } }, {});
+
+    const std::vector<FsbHeader> fsb_files = ParseFsbFiles(bank);
+    ASSERT_EQ(fsb_files.size(), 1);
+    ASSERT_EQ(fsb_files[0].Samples.size(), 2);
+    EXPECT_EQ(fsb_files[0].Samples[0].Name, "chunk_name");
+    EXPECT_EQ(fsb_files[0].Samples[1].Name, "1");
+}
+
+TEST(FsbParser, MultipleFsbFiles)
+{
+    std::vector<char> bank = MakeFsb({ { 0, std::nullopt } }, { "first" });
+    const std::size_t second_offset = bank.size();
+    const std::vector<char> second = MakeFsb({ { 0, std::nullopt }, { 32, std::nullopt } }, { "second", "third" });
+    bank.insert(bank.end(), second.begin(), second.end());
+
+    const std::vector<FsbHeader> fsb_files = ParseFsbFiles(bank);
+    ASSERT_EQ(fsb_files.size(), 2);
+    EXPECT_EQ(fsb_files[0].Offset, 0);
+    ASSERT_EQ(fsb_files[0].Samples.size(), 1);
+    EXPECT_EQ(fsb_files[0].Samples[0].Name, "first");
+    EXPECT_EQ(fsb_files[1].Offset, second_offset);
+    ASSERT_EQ(fsb_files[1].Samples.size(), 2);
+    EXPECT_EQ(fsb_files[1].Samples[1].Name, "third");
+}
+
+TEST(FsbParser, SkipsMalformedFsbFiles)
+{
+    const std::vector<char> fsb = MakeFsb({ { 0, "chunk_name" }, { 64, std::nullopt } }, { "alpha", "beta" });
+
+    // Every truncation before the name strings has to be skipped without reading past the end of the bank
+    const std::size_t name_strings_size = std::string_view{ "alpha" }.size() + std::string_view{ "beta" }.size() + 2;
+    for (std::size_t size = 0; size < fsb.size() - 256 - name_strings_size; size++)
+    {
+        const std::vector<char> truncated{ fsb.begin(), fsb.begin() + size };
+        EXPECT_TRUE(ParseFsbFiles(truncated).empty()) << "size " << size;
+    }
+
+    EXPECT_TRUE(ParseFsbFiles(MakeFsb({ { 0, std::nullopt } }, { "alpha" }, 0)).empty());
+
+    std::vector<char> too_many_samples = MakeFsb({ { 0, std::nullopt } }, { "alpha" });
+    too_many_samples[8] = '\x7f';
+    EXPECT_TRUE(ParseFsbFiles(too_many_samples).empty());
+}
@@ -0,0 +1,190 @@
+#include "util/lru_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using TestCache = LruCache<std::string, int>;
+
+// Loads a value of the given size, counting the calls
+static auto MakeLoad(std::size_t size, int& num_loads)
+{
+    return [size, &num_loads]()
+    {
+        num_loads++;
+        return TestCache::LoadResult{ std::make_shared<const std::string>(size, 'x'), size, true };
+    };
+}
+
+TEST(LruCacheTest, HitsAndMisses)
+{
+    TestCache cache{ 100 };
+    int num_loads{ 0 };
+
+    const auto first = cache.Get("a", 0, MakeLoad(10, num_loads));
+    const auto second = cache.Get("a", 0, MakeLoad(10, num_loads));
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(num_loads, 1);
+    EXPECT_EQ(cache.GetHits(), 1);
+    EXPECT_EQ(cache.GetMisses(), 1);
+    EXPECT_EQ(cache.GetSize(), 10);
+
+    // A new version reloads and replaces the old value
+    const auto third = cache.Get("a", 1, MakeLoad(20, num_loads));
+    EXPECT_NE(first, third);
+    EXPECT_EQ(num_loads, 2);
+    EXPECT_EQ(cache.GetSize(), 20);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+    TestCache cache{ 30 };
+    int num_loads{ 0 };
+
+    cache.Get("a", 0, MakeLoad(10, num_loads));
+    cache.Get("b", 0, MakeLoad(10, num_loads));
+    cache.Get("c", 0, MakeLoad(10, num_loads));
+
+    // Using a makes b the least recently used
+    cache.Get("a", 0, MakeLoad(10, num_loads));
+    cache.Get("d", 0, MakeLoad(10, num_loads));
+    EXPECT_TRUE(cache.Contains("a"));
+    EXPECT_FALSE(cache.Contains("b"));
+    EXPECT_TRUE(cache.Contains("c"));
+    EXPECT_TRUE(cache.Contains("d"));
+
+    cache.Get("e", 0, MakeLoad(10, num_loads));
+    EXPECT_TRUE(cache.Contains("a"));
+    EXPECT_FALSE(cache.Contains("c"));
+    EXPECT_EQ(cache.GetSize(), 30);
+}
+
+TEST(LruCacheTest, StaysInByteBudget)
+{
+    TestCache cache{ 100 };
+    int num_loads{ 0 };
+
+    cache.Get("a", 0, MakeLoad(40, num_loads));
+    cache.Get("b", 0, MakeLoad(40, num_loads));
+    EXPECT_EQ(cache.GetSize(), 80);
+
+    // One large value evicts both others
+    cache.Get("c", 0, MakeLoad(90, num_loads));
+    EXPECT_FALSE(cache.Contains("a"));
+    EXPECT_FALSE(cache.Contains("b"));
+    EXPECT_EQ(cache.GetSize(), 90);
+
+    // The most recently used value is kept even if it alone exceeds the budget
+    const auto huge = cache.Get("d", 0, MakeLoad(500, num_loads));
+    EXPECT_TRUE(cache.Contains("d"));
+    EXPECT_FALSE(cache.Contains("c"));
+    EXPECT_EQ(cache.GetSize(), 500);
+
+    // Evicted values stay alive while in use
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0);
+    EXPECT_EQ(huge->size(), 500);
+}
+
+TEST(LruCacheTest, FailedLoadsAreNotCached)
+{
+    TestCache cache{ 100 };
+    int num_loads{ 0 };
+
+    auto fail = [&num_loads]()
+    {
+        num_loads++;
+        return TestCache::LoadResult{ std::make_shared<const std::string>("failed"), 6, false };
+    };
+    EXPECT_EQ(*cache.Get("a", 0, fail), "failed");
+    EXPECT_FALSE(cache.Contains("a"));
+    EXPECT_EQ(cache.GetSize(), 0);
+
+    cache.Get("a", 0, fail);
+    EXPECT_EQ(num_loads, 2);
+}
+
+TEST(LruCacheTest, PrefetchNeverEvicts)
+{
+    TestCache cache{ 30 };
+    int num_loads{ 0 };
+
+    cache.Get("a", 0, MakeLoad(10, num_loads));
+    cache.Prefetch("b", 0, MakeLoad(10, num_loads));
+    EXPECT_TRUE(cache.Contains("b"));
+
+    // Does not fit into the remaining budget, so it is dropped instead of evicting a
+    cache.Prefetch("c", 0, MakeLoad(20, num_loads));
+    EXPECT_FALSE(cache.Contains("c"));
+    EXPECT_TRUE(cache.Contains("a"));
+
+    // Prefetching something cached does nothing
+    cache.Prefetch("a", 0, MakeLoad(10, num_loads));
+    EXPECT_EQ(num_loads, 3);
+
+    // Prefetched values are least recently used until requested
+    cache.Get("d", 0, MakeLoad(20, num_loads));
+    EXPECT_TRUE(cache.Contains("a"));
+    EXPECT_FALSE(cache.Contains("b"));
+    EXPECT_TRUE(cache.IsFull());
+
+    cache.Erase("a");
+    cache.Prefetch("e", 0, MakeLoad(10, num_loads));
+    cache.Get("e", 0, MakeLoad(10, num_loads));
+    EXPECT_EQ(cache.GetHits(), 1);
+    cache.Get("f", 0, MakeLoad(10, num_loads));
+    EXPECT_TRUE(cache.Contains("e"));
+    EXPECT_FALSE(cache.Contains("d"));
+}
+
+TEST(LruCacheTest, ConcurrentFirstAccessLoadsOnce)
+{
+    static constexpr std::size_t c_NumThreads{ 8 };
+
+    TestCache cache{ 1000 };
+    std::atomic<int> num_loads{ 0 };
+    std::atomic<int> num_other_loads{ 0 };
+    std::barrier start{ c_NumThreads };
+
+    std::vector<std::shared_ptr<const std::string>> values(c_NumThreads);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < c_NumThreads; i++)
+    {
+        threads.emplace_back([&, i]()
+                             {
+                                 start.arrive_and_wait();
+                                 values[i] = cache.Get("shared", 0, [&]()
+                                                       {
+                                                           num_loads++;
+                                                           // Long enough that the other threads arrive while loading
+                                                           std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+                                                           return TestCache::LoadResult{ std::make_shared<const std::string>("shared"), 6, true }; });
+
+                                 // Each thread also loads a key of its own
+                                 cache.Get("other_" + std::to_string(i), 0, [&]()
+                                           {
+                                               num_other_loads++;
+                                               return TestCache::LoadResult{ std::make_shared<const std::string>("other"), 5, true }; }); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(num_loads, 1);
+    EXPECT_EQ(num_other_loads, c_NumThreads);
+    for (const auto& value : values)
+    {
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(value, values[0]);
+    }
+    EXPECT_EQ(cache.GetMisses(), 1 + c_NumThreads);
+    EXPECT_EQ(cache.GetHits(), c_NumThreads - 1);
+    EXPECT_EQ(cache.GetSize(), 6 + 5 * c_NumThreads);
+}
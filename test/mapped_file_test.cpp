@@ -0,0 +1,121 @@
+#include "util/mapped_file.h"
+#include "test_temp_folder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class MappedFileTest : public TempFolderTest
+{
+  protected:
+    fs::path WriteTestFile(std::string_view file_name, const std::vector<std::uint8_t>& content)
+    {
+        const fs::path file_path = mTestFolder / file_name;
+        WriteFile(file_path, content);
+        return file_path;
+    }
+};
+
+static std::vector<std::uint8_t> MakeContent(std::size_t size)
+{
+    std::mt19937 rng{ static_cast<std::uint32_t>(size) };
+    std::vector<std::uint8_t> content(size);
+    for (std::uint8_t& byte : content)
+    {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+    return content;
+}
+
+TEST_F(MappedFileTest, DefaultIsInvalid)
+{
+    const MappedFile mapped_file;
+    EXPECT_FALSE(mapped_file.IsValid());
+    EXPECT_TRUE(mapped_file.GetData().empty());
+}
+
+TEST_F(MappedFileTest, MissingFileIsInvalid)
+{
+    const MappedFile mapped_file{ mTestFolder / "missing.png" };
+    EXPECT_FALSE(mapped_file.IsValid());
+    EXPECT_TRUE(mapped_file.GetData().empty());
+}
+
+TEST_F(MappedFileTest, EmptyFileIsValid)
+{
+    const MappedFile mapped_file{ WriteTestFile("empty.png", {}) };
+    ASSERT_TRUE(mapped_file.IsValid());
+    EXPECT_TRUE(mapped_file.GetData().empty());
+
+    std::uint8_t destination{ 0xab };
+    EXPECT_TRUE(mapped_file.CopyTo(&destination));
+    EXPECT_EQ(destination, 0xab);
+}
+
+TEST_F(MappedFileTest, ExactSizeAndContent)
+{
+    // Sizes around the page size, so partial last pages are covered
+    for (std::size_t size : { 1uz, 4095uz, 4096uz, 4097uz, 1000003uz })
+    {
+        const std::vector<std::uint8_t> content = MakeContent(size);
+        const MappedFile mapped_file{ WriteTestFile("file_" + std::to_string(size) + ".png", content) };
+        ASSERT_TRUE(mapped_file.IsValid()) << size;
+
+        const auto data = mapped_file.GetData();
+        ASSERT_EQ(data.size(), size);
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), content.begin())) << size;
+
+        std::vector<std::uint8_t> copy(size + 1, 0xcd);
+        EXPECT_TRUE(mapped_file.CopyTo(copy.data())) << size;
+        EXPECT_TRUE(std::equal(content.begin(), content.end(), copy.begin())) << size;
+        EXPECT_EQ(copy.back(), 0xcd) << size;
+    }
+}
+
+TEST_F(MappedFileTest, MoveConstruction)
+{
+    const std::vector<std::uint8_t> content = MakeContent(5000);
+    MappedFile source{ WriteTestFile("file.png", content) };
+    ASSERT_TRUE(source.IsValid());
+    const std::uint8_t* source_data = source.GetData().data();
+
+    const MappedFile target{ std::move(source) };
+    EXPECT_FALSE(source.IsValid());
+    EXPECT_TRUE(source.GetData().empty());
+
+    ASSERT_TRUE(target.IsValid());
+    EXPECT_EQ(target.GetData().data(), source_data);
+    ASSERT_EQ(target.GetData().size(), content.size());
+    EXPECT_TRUE(std::equal(content.begin(), content.end(), target.GetData().begin()));
+}
+
+TEST_F(MappedFileTest, MoveAssignment)
+{
+    const std::vector<std::uint8_t> first_content = MakeContent(3000);
+    const std::vector<std::uint8_t> second_content = MakeContent(7000);
+    MappedFile first{ WriteTestFile("first.png", first_content) };
+    MappedFile second{ WriteTestFile("second.png", second_content) };
+    ASSERT_TRUE(first.IsValid());
+    ASSERT_TRUE(second.IsValid());
+
+    // Assigning over a valid mapping releases it and takes over the other one
+    first = std::move(second);
+    EXPECT_FALSE(second.IsValid());
+    EXPECT_TRUE(second.GetData().empty());
+    ASSERT_TRUE(first.IsValid());
+    ASSERT_EQ(first.GetData().size(), second_content.size());
+    EXPECT_TRUE(std::equal(second_content.begin(), second_content.end(), first.GetData().begin()));
+
+    // Assigning an invalid mapping leaves an invalid mapping
+    first = MappedFile{};
+    EXPECT_FALSE(first.IsValid());
+    EXPECT_TRUE(first.GetData().empty());
+}
@@ -0,0 +1,155 @@
+#include "mod/merged_sheet_tiles.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// A merged sheet where every pixel records which version of which source mapping was blitted last, or the base pixel
+// Blitting copies whole tiles, same as Image::Blit, so this behaves like the merger at a target scaling of one
+class MergedSheetTilesTest : public testing::Test
+{
+  protected:
+    static constexpr std::uint32_t c_SheetSize{ 16 };
+
+    struct Source
+    {
+        std::vector<TileMapping> TileMap;
+        std::uint32_t Version{ 0 };
+    };
+
+    void SetUp() override
+    {
+        // Source 1 maps onto the same tile as source 0 and overlaps it, source 2 overlaps only source 1
+        // Source 3 is far away from everything else and source 4 overlaps the second tile of source 0
+        mSources = {
+            Source{ .TileMap{ MakeMapping(0, 0, 4, 4), MakeMapping(8, 0, 10, 2) } },
+            Source{ .TileMap{ MakeMapping(0, 0, 4, 4), MakeMapping(2, 2, 6, 6) } },
+            Source{ .TileMap{ MakeMapping(5, 5, 8, 8) } },
+            Source{ .TileMap{ MakeMapping(12, 12, 16, 16), MakeMapping(12, 8, 14, 10) } },
+            Source{ .TileMap{ MakeMapping(9, 1, 11, 3) } },
+        };
+
+        for (std::size_t i = 0; i < mSources.size(); i++)
+        {
+            for (std::size_t j = 0; j < mSources[i].TileMap.size(); j++)
+            {
+                AddMergedTileSource(mTiles, mSources[i].TileMap[j].TargetTile, MergedTileSource{ .SourceIndex{ i }, .MappingIndex{ j } });
+            }
+        }
+    }
+
+    static TileMapping MakeMapping(std::uint32_t left, std::uint32_t top, std::uint32_t right, std::uint32_t bottom)
+    {
+        const Tile tile{ .Left{ left }, .Top{ top }, .Right{ right }, .Bottom{ bottom } };
+        return TileMapping{ .SourceTile{ tile }, .TargetTile{ tile } };
+    }
+
+    static std::vector<std::uint32_t> MakeBase()
+    {
+        std::vector<std::uint32_t> base(c_SheetSize * c_SheetSize);
+        for (std::uint32_t i = 0; i < base.size(); i++)
+        {
+            base[i] = i;
+        }
+        return base;
+    }
+
+    void Recomposite(std::vector<std::uint32_t>& sheet, const std::vector<bool>& dirty_tiles, std::vector<std::size_t>* blitted_sources = nullptr) const
+    {
+        const std::vector<std::uint32_t> base = MakeBase();
+        auto for_each_pixel = [](const Tile& tile, auto&& fun)
+        {
+            for (std::uint32_t y = tile.Top; y < tile.Bottom; y++)
+            {
+                for (std::uint32_t x = tile.Left; x < tile.Right; x++)
+                {
+                    fun(x, y);
+                }
+            }
+        };
+
+        RecompositeDirtyTiles(
+            mTiles,
+            dirty_tiles,
+            [&](const Tile& target_tile)
+            {
+                for_each_pixel(target_tile, [&](std::uint32_t x, std::uint32_t y)
+                               { sheet[y * c_SheetSize + x] = base[y * c_SheetSize + x]; });
+            },
+            [&](const MergedTileSource& tile_source)
+            {
+                const Source& source = mSources[tile_source.SourceIndex];
+                const Tile& target_tile = source.TileMap[tile_source.MappingIndex].TargetTile;
+                for_each_pixel(target_tile, [&](std::uint32_t x, std::uint32_t y)
+                               { sheet[y * c_SheetSize + x] = 0x10000000 | (static_cast<std::uint32_t>(tile_source.SourceIndex) << 20) | (source.Version << 12) | (y * c_SheetSize + x); });
+                if (blitted_sources != nullptr)
+                {
+                    blitted_sources->push_back(tile_source.SourceIndex);
+                }
+            });
+    }
+
+    std::vector<std::uint32_t> FullRebuild() const
+    {
+        std::vector<std::uint32_t> sheet = MakeBase();
+        Recomposite(sheet, std::vector<bool>(mTiles.size(), true));
+        return sheet;
+    }
+
+    std::vector<Source> mSources;
+    std::vector<MergedTile> mTiles;
+};
+
+TEST_F(MergedSheetTilesTest, GroupsMappingsByTargetTile)
+{
+    ASSERT_EQ(mTiles.size(), 7);
+    ASSERT_EQ(mTiles[0].Sources.size(), 2);
+    EXPECT_EQ(mTiles[0].Sources[0].SourceIndex, 0);
+    EXPECT_EQ(mTiles[0].Sources[1].SourceIndex, 1);
+    EXPECT_EQ(mTiles[0].Sources[1].MappingIndex, 0);
+}
+
+TEST_F(MergedSheetTilesTest, DirtyTilesIncludeOverlaps)
+{
+    std::vector<bool> dirty_sources(mSources.size(), false);
+    dirty_sources[2] = true;
+
+    // Source 2 overlaps source 1, which overlaps source 0 on the shared tile
+    const std::vector<bool> dirty_tiles = FindDirtyTiles(mTiles, dirty_sources);
+    EXPECT_EQ(dirty_tiles, (std::vector<bool>{ true, false, true, true, false, false, false }));
+
+    const std::vector<bool> no_dirty_tiles = FindDirtyTiles(mTiles, std::vector<bool>(mSources.size(), false));
+    EXPECT_EQ(no_dirty_tiles, std::vector<bool>(mTiles.size(), false));
+}
+
+TEST_F(MergedSheetTilesTest, IncrementalMatchesFullRebuild)
+{
+    for (std::size_t changed_source = 0; changed_source < mSources.size(); changed_source++)
+    {
+        std::vector<std::uint32_t> sheet = FullRebuild();
+
+        mSources[changed_source].Version++;
+        std::vector<bool> dirty_sources(mSources.size(), false);
+        dirty_sources[changed_source] = true;
+
+        std::vector<std::size_t> blitted_sources;
+        Recomposite(sheet, FindDirtyTiles(mTiles, dirty_sources), &blitted_sources);
+        EXPECT_EQ(sheet, FullRebuild()) << changed_source;
+
+        // Source 3 is isolated, so changing anything else never reblits it
+        EXPECT_EQ(std::ranges::count(blitted_sources, 3), changed_source == 3 ? 2 : 0) << changed_source;
+    }
+}
+
+TEST_F(MergedSheetTilesTest, IncrementalWithSeveralDirtySources)
+{
+    std::vector<std::uint32_t> sheet = FullRebuild();
+
+    mSources[0].Version++;
+    mSources[3].Version++;
+    mSources[4].Version++;
+    Recomposite(sheet, FindDirtyTiles(mTiles, std::vector<bool>{ true, false, false, true, true }));
+    EXPECT_EQ(sheet, FullRebuild());
+}
@@ -0,0 +1,132 @@
+#include "mod/mod_database.h"
+#include "test_temp_folder.h"
+#include "util/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class ModDatabaseTest : public TempFolderTest
+{
+  protected:
+    void WriteModFile(const fs::path& rel_path, std::string_view content)
+    {
+        WriteFile(ModFolder() / rel_path, content);
+    }
+
+    fs::path ModFolder() const
+    {
+        return mTestFolder / "Mods" / "Packs" / "TestMod";
+    }
+    fs::path DatabaseFolder() const
+    {
+        return mTestFolder / "Mods" / "Packs" / ".db" / "Mods" / "TestMod";
+    }
+};
+
+using FileStates = std::vector<std::tuple<std::string, bool, bool>>;
+static FileStates GetFileStates(ModDatabase& mod_db)
+{
+    FileStates file_states;
+    mod_db.ForEachFile([&](const fs::path& rel_path, bool outdated, bool deleted, std::optional<bool>)
+                       { file_states.emplace_back(rel_path.generic_string(), outdated, deleted); });
+    return file_states;
+}
+
+TEST_F(ModDatabaseTest, ThreadPoolScanMatchesSerialScan)
+{
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        WriteModFile("file_" + std::to_string(i) + ".png", "top");
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            WriteModFile(fs::path{ "Data" } / ("Folder_" + std::to_string(i)) / ("file_" + std::to_string(j) + ".png"), "nested");
+        }
+    }
+
+    const ModDatabaseFlags flags = static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Folders | ModDatabaseFlags_Recurse);
+
+    ModDatabase serial_db{ DatabaseFolder(), ModFolder(), flags };
+    serial_db.UpdateDatabase();
+
+    ThreadPool thread_pool{ 4 };
+    ModDatabase pooled_db{ DatabaseFolder(), ModFolder(), flags };
+    pooled_db.UpdateDatabase(&thread_pool);
+
+    const FileStates serial_states = GetFileStates(serial_db);
+    EXPECT_EQ(serial_states.size(), 72);
+    EXPECT_EQ(serial_states, GetFileStates(pooled_db));
+}
+
+TEST_F(ModDatabaseTest, ReportsNewUnchangedAndDeletedFiles)
+{
+    WriteModFile("kept.png", "kept");
+    WriteModFile("Data/removed.png", "removed");
+
+    const ModDatabaseFlags flags = static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Recurse | ModDatabaseFlags_ContentHash);
+    {
+        ModDatabase mod_db{ DatabaseFolder(), ModFolder(), flags };
+        mod_db.UpdateDatabase();
+
+        FileStates file_states = GetFileStates(mod_db);
+        std::ranges::sort(file_states);
+        EXPECT_EQ(file_states, (FileStates{ { "Data/removed.png", true, false }, { "kept.png", true, false } }));
+        mod_db.WriteDatabase();
+    }
+
+    fs::remove(ModFolder() / "Data" / "removed.png");
+    WriteModFile("added.png", "added");
+    {
+        ModDatabase mod_db{ DatabaseFolder(), ModFolder(), flags };
+        mod_db.UpdateDatabase();
+
+        FileStates file_states = GetFileStates(mod_db);
+        std::ranges::sort(file_states);
+        EXPECT_EQ(file_states, (FileStates{ { "Data/removed.png", false, true }, { "added.png", true, false }, { "kept.png", false, false } }));
+    }
+}
+
+TEST_F(ModDatabaseTest, SeedsContentHashesWhenFilesAreTouched)
+{
+    WriteModFile("touched.png", "touched");
+    WriteModFile("untouched.png", "untouched");
+
+    auto touch = [this](std::chrono::seconds offset)
+    {
+        const fs::path file_path = ModFolder() / "touched.png";
+        fs::last_write_time(file_path, fs::last_write_time(file_path) + offset);
+    };
+    auto update_database = [this](ModDatabaseFlags flags)
+    {
+        ModDatabase mod_db{ DatabaseFolder(), ModFolder(), static_cast<ModDatabaseFlags>(ModDatabaseFlags_Files | ModDatabaseFlags_Recurse | flags) };
+        mod_db.UpdateDatabase();
+        mod_db.WriteDatabase();
+
+        FileStates file_states = GetFileStates(mod_db);
+        std::ranges::sort(file_states);
+        return file_states;
+    };
+
+    // Database without any hashes, as written with content hashing turned off
+    update_database(static_cast<ModDatabaseFlags>(0));
+
+    // Turning content hashing on does not report anything as changed
+    EXPECT_EQ(update_database(ModDatabaseFlags_ContentHash), (FileStates{ { "touched.png", false, false }, { "untouched.png", false, false } }));
+
+    // Without a known hash a touched file counts as changed, but it gets its hash now
+    touch(std::chrono::seconds{ 10 });
+    EXPECT_EQ(update_database(ModDatabaseFlags_ContentHash), (FileStates{ { "touched.png", true, false }, { "untouched.png", false, false } }));
+
+    // With the hash touching the file again is not a change
+    touch(std::chrono::seconds{ 20 });
+    EXPECT_EQ(update_database(ModDatabaseFlags_ContentHash), (FileStates{ { "touched.png", false, false }, { "untouched.png", false, false } }));
+}
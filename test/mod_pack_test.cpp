@@ -0,0 +1,250 @@
+#include "util/mod_pack.h"
+#include "test_temp_folder.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class ModPackTest : public TempFolderTest
+{
+  protected:
+    fs::path SourceFolder() const
+    {
+        return mTestFolder / "Mods" / "Packs" / "TestMod";
+    }
+    fs::path PreprocessedFolder() const
+    {
+        return mTestFolder / "Mods" / "Packs" / ".db" / "Mods" / "TestMod";
+    }
+    fs::path PackFile() const
+    {
+        return mTestFolder / "TestMod.plpack";
+    }
+};
+
+static std::string ReadEntry(const ModPack& mod_pack, const ModPackEntry& entry)
+{
+    std::string content(entry.Size, '\0');
+    if (!mod_pack.ReadEntry(entry, { reinterpret_cast<std::uint8_t*>(content.data()), content.size() }))
+    {
+        return "<failed>";
+    }
+    return content;
+}
+
+TEST_F(ModPackTest, RoundTrip)
+{
+    const std::string level(10000, 'x');
+    const std::string strings{ "Spelunky\nHello World\n" };
+    const std::string texture{ "DDS converted texture" };
+    WriteFile(SourceFolder() / "Data/Levels/dwellingarea.lvl", level);
+    WriteFile(SourceFolder() / "strings00.str", strings);
+    WriteFile(SourceFolder() / "readme.txt", "not packed");
+    WriteFile(SourceFolder() / "Data/Textures/items.png", "png");
+    WriteFile(PreprocessedFolder() / "Data/Textures/items.DDS", texture);
+    fs::last_write_time(PreprocessedFolder() / "Data/Textures/items.DDS", fs::last_write_time(SourceFolder() / "Data/Textures/items.png") + std::chrono::seconds{ 1 });
+
+    for (const bool compress : { false, true })
+    {
+        std::vector<ModPackRejectedFile> rejected_files;
+        ASSERT_TRUE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), compress, rejected_files));
+        EXPECT_TRUE(rejected_files.empty());
+
+        const ModPack mod_pack{ PackFile() };
+        ASSERT_TRUE(mod_pack.IsValid());
+
+        std::vector<std::string_view> paths;
+        for (const ModPackEntry& entry : mod_pack.GetEntries())
+        {
+            paths.push_back(entry.Path);
+        }
+        EXPECT_EQ(paths, (std::vector<std::string_view>{ "data/levels/dwellingarea.lvl", "data/textures/items.dds", "strings00.str" }));
+
+        const ModPackEntry* level_entry = mod_pack.FindEntry("Data\\Levels\\DwellingArea.lvl");
+        ASSERT_NE(level_entry, nullptr);
+        EXPECT_EQ(level_entry->Compressed, compress);
+        EXPECT_EQ(ReadEntry(mod_pack, *level_entry), level);
+
+        const ModPackEntry* texture_entry = mod_pack.FindEntry("Data/Textures/items.DDS");
+        ASSERT_NE(texture_entry, nullptr);
+        EXPECT_EQ(ReadEntry(mod_pack, *texture_entry), texture);
+
+        const ModPackEntry* strings_entry = mod_pack.FindEntry("strings00.str");
+        ASSERT_NE(strings_entry, nullptr);
+        EXPECT_EQ(ReadEntry(mod_pack, *strings_entry), strings);
+
+        EXPECT_EQ(mod_pack.FindEntry("readme.txt"), nullptr);
+        EXPECT_EQ(mod_pack.FindEntry("Data/Textures/items.png"), nullptr);
+
+        std::string wrong_size(level.size() - 1, '\0');
+        EXPECT_FALSE(mod_pack.ReadEntry(*level_entry, { reinterpret_cast<std::uint8_t*>(wrong_size.data()), wrong_size.size() }));
+    }
+}
+
+TEST_F(ModPackTest, RejectsFilesThatNeedPreprocessing)
+{
+    WriteFile(SourceFolder() / "Data/Levels/dwellingarea.lvl", "level");
+    WriteFile(SourceFolder() / "mod_info.json", "{}");
+    WriteFile(SourceFolder() / "main.lua", "");
+    WriteFile(SourceFolder() / "strings00_mod.str", "");
+    WriteFile(SourceFolder() / "soundbank/wav/shotgun_fire.wav", "");
+    WriteFile(SourceFolder() / "Data/Textures/char_yellow_col.png", "");
+    WriteFile(SourceFolder() / "Data/Textures/items.png", "");
+    WriteFile(SourceFolder() / "dwellingarea.lvl", "");
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    EXPECT_FALSE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), true, rejected_files));
+    EXPECT_FALSE(fs::exists(PackFile()));
+
+    std::vector<std::string> rejected_paths;
+    for (const ModPackRejectedFile& rejected_file : rejected_files)
+    {
+        EXPECT_FALSE(rejected_file.Reason.empty());
+        rejected_paths.push_back(rejected_file.Path.generic_string());
+    }
+    std::ranges::sort(rejected_paths);
+    EXPECT_EQ(rejected_paths, (std::vector<std::string>{
+                                  "Data/Textures/char_yellow_col.png",
+                                  "Data/Textures/items.png",
+                                  "dwellingarea.lvl",
+                                  "main.lua",
+                                  "mod_info.json",
+                                  "soundbank/wav/shotgun_fire.wav",
+                                  "strings00_mod.str",
+                              }));
+}
+
+TEST_F(ModPackTest, RejectsOutdatedTextures)
+{
+    WriteFile(PreprocessedFolder() / "Data/Textures/items.DDS", "DDS");
+    WriteFile(SourceFolder() / "Data/Textures/items.png", "png");
+    fs::last_write_time(PreprocessedFolder() / "Data/Textures/items.DDS", fs::last_write_time(SourceFolder() / "Data/Textures/items.png") - std::chrono::seconds{ 1 });
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    EXPECT_FALSE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), true, rejected_files));
+    ASSERT_EQ(rejected_files.size(), 1);
+    EXPECT_EQ(rejected_files[0].Path.generic_string(), "Data/Textures/items.png");
+}
+
+TEST_F(ModPackTest, RejectsFilesPackedToTheSamePath)
+{
+    WriteFile(SourceFolder() / "Data/Levels/dwellingarea.lvl", "level");
+    WriteFile(SourceFolder() / "Data/Textures/items.png", "png");
+    WriteFile(SourceFolder() / "Data/Textures/items.DDS", "loose DDS");
+    WriteFile(PreprocessedFolder() / "Data/Textures/items.DDS", "converted DDS");
+    fs::last_write_time(PreprocessedFolder() / "Data/Textures/items.DDS", fs::last_write_time(SourceFolder() / "Data/Textures/items.png") + std::chrono::seconds{ 1 });
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    EXPECT_FALSE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), true, rejected_files));
+    EXPECT_FALSE(fs::exists(PackFile()));
+
+    std::vector<std::string> rejected_paths;
+    for (const ModPackRejectedFile& rejected_file : rejected_files)
+    {
+        EXPECT_FALSE(rejected_file.Reason.empty());
+        rejected_paths.push_back(rejected_file.Path.generic_string());
+    }
+    std::ranges::sort(rejected_paths);
+    EXPECT_EQ(rejected_paths, (std::vector<std::string>{ "Data/Textures/items.DDS", "Data/Textures/items.png" }));
+}
+
+TEST_F(ModPackTest, InvalidPack)
+{
+    WriteFile(PackFile(), "PLPK but not really a pack");
+    EXPECT_FALSE(ModPack{ PackFile() }.IsValid());
+    EXPECT_FALSE(ModPack{ mTestFolder / "missing.plpack" }.IsValid());
+}
+
+// Offsets into the pack file format, as written by WriteModPack
+static constexpr std::size_t c_StringPoolOffsetPosition{ 16 };
+static constexpr std::size_t c_StringPoolSizePosition{ 24 };
+static constexpr std::size_t c_TocPosition{ 32 };
+static constexpr std::size_t c_TocEntrySize{ 32 };
+
+TEST_F(ModPackTest, RejectsWrappingOffsets)
+{
+    WriteFile(SourceFolder() / "strings00.str", "Spelunky");
+    WriteFile(SourceFolder() / "strings01.str", "Spelunky 2");
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    ASSERT_TRUE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), false, rejected_files));
+    EXPECT_FALSE(fs::exists(fs::path{ PackFile() } += ".tmp"));
+
+    const std::string pack_data = ReadFile(PackFile());
+    ASSERT_TRUE(ModPack{ PackFile() }.IsValid());
+
+    auto expect_invalid_with = [&](std::size_t position, std::uint64_t value)
+    {
+        std::string patched_data = pack_data;
+        std::memcpy(patched_data.data() + position, &value, sizeof(value));
+        WriteFile(PackFile(), patched_data);
+        EXPECT_FALSE(ModPack{ PackFile() }.IsValid()) << position;
+    };
+
+    // Each of these sums wraps around to a small value when computed as offset + size
+    expect_invalid_with(c_StringPoolSizePosition, ~std::uint64_t{ 0 });
+    expect_invalid_with(c_StringPoolOffsetPosition, ~std::uint64_t{ 0 });
+    expect_invalid_with(c_TocPosition + 8, ~std::uint64_t{ 0 });
+    expect_invalid_with(c_TocPosition, ~std::uint64_t{ 0 } - 4);
+}
+
+TEST_F(ModPackTest, RejectsInvalidEntrySizes)
+{
+    WriteFile(SourceFolder() / "strings00.str", "Spelunky");
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    ASSERT_TRUE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), false, rejected_files));
+
+    const std::string pack_data = ReadFile(PackFile());
+
+    auto expect_invalid_with = [&](std::uint64_t size, std::uint16_t flags)
+    {
+        std::string patched_data = pack_data;
+        std::memcpy(patched_data.data() + c_TocPosition + 16, &size, sizeof(size));
+        std::memcpy(patched_data.data() + c_TocPosition + 30, &flags, sizeof(flags));
+        WriteFile(PackFile(), patched_data);
+        EXPECT_FALSE(ModPack{ PackFile() }.IsValid()) << size << " " << flags;
+    };
+
+    // Uncompressed entries would be copied past the end of their blob
+    expect_invalid_with(9, 0);
+    expect_invalid_with(1ull << 40, 0);
+
+    // Compressed entries too large for the game's allocation, sizes of int plus its file info
+    expect_invalid_with(std::numeric_limits<int>::max(), 1);
+    expect_invalid_with(std::numeric_limits<std::uint64_t>::max(), 1);
+}
+
+TEST_F(ModPackTest, RejectsUnsortedToc)
+{
+    WriteFile(SourceFolder() / "strings00.str", "Spelunky");
+    WriteFile(SourceFolder() / "strings01.str", "Spelunky 2");
+
+    std::vector<ModPackRejectedFile> rejected_files;
+    ASSERT_TRUE(WriteModPack(SourceFolder(), PreprocessedFolder(), PackFile(), false, rejected_files));
+
+    const std::string pack_data = ReadFile(PackFile());
+
+    // Duplicate of the first entry
+    std::string duplicated_data = pack_data;
+    std::memcpy(duplicated_data.data() + c_TocPosition + c_TocEntrySize, pack_data.data() + c_TocPosition, c_TocEntrySize);
+    WriteFile(PackFile(), duplicated_data);
+    EXPECT_FALSE(ModPack{ PackFile() }.IsValid());
+
+    // Both entries swapped
+    std::string swapped_data = pack_data;
+    std::memcpy(swapped_data.data() + c_TocPosition, pack_data.data() + c_TocPosition + c_TocEntrySize, c_TocEntrySize);
+    std::memcpy(swapped_data.data() + c_TocPosition + c_TocEntrySize, pack_data.data() + c_TocPosition, c_TocEntrySize);
+    WriteFile(PackFile(), swapped_data);
+    EXPECT_FALSE(ModPack{ PackFile() }.IsValid());
+}
@@ -0,0 +1,141 @@
+#include "detour/pattern_scan.h"
+#include "reference/pattern_scan_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bytes drawn from a small alphabet give many partial matches, so the first of several matches has to be found
+static std::vector<std::uint8_t> MakeData(std::size_t size, std::uint32_t num_distinct_bytes, std::uint32_t seed)
+{
+    std::mt19937 rng{ seed };
+    std::vector<std::uint8_t> data(size);
+    for (std::uint8_t& byte : data)
+    {
+        byte = static_cast<std::uint8_t>(0x40 + rng() % num_distinct_bytes);
+    }
+    return data;
+}
+
+// Signatures cut out of the data with some bytes replaced by wildcards, mixed with signatures that are unlikely to match
+static std::vector<std::string> MakeSignatures(std::span<const std::uint8_t> data, std::size_t num_signatures, std::uint32_t seed)
+{
+    std::mt19937 rng{ seed };
+    std::vector<std::string> signatures;
+    for (std::size_t i = 0; i < num_signatures; i++)
+    {
+        const std::size_t length = 1 + rng() % 12;
+        std::string signature(length, '\0');
+        if (length <= data.size() && rng() % 4 != 0)
+        {
+            const std::size_t offset = rng() % (data.size() - length + 1);
+            for (std::size_t j = 0; j < length; j++)
+            {
+                signature[j] = static_cast<char>(data[offset + j]);
+            }
+        }
+        else
+        {
+            for (char& c : signature)
+            {
+                c = static_cast<char>(rng());
+            }
+        }
+
+        for (char& c : signature)
+        {
+            if (rng() % 4 == 0)
+            {
+                c = '*';
+            }
+        }
+        signatures.push_back(std::move(signature));
+    }
+    return signatures;
+}
+
+static std::span<const std::uint8_t> AsBytes(std::string_view str)
+{
+    return { reinterpret_cast<const std::uint8_t*>(str.data()), str.size() };
+}
+
+// Sizes that cover data shorter than a vector, scalar tails and data with many vectors
+static constexpr std::size_t s_DataSizes[]{ 0, 1, 5, 15, 16, 17, 31, 33, 100, 4096 };
+
+TEST(PatternScanTest, FindPatternOffsetMatchesReference)
+{
+    for (std::uint32_t num_distinct_bytes : { 2u, 4u, 256u })
+    {
+        for (std::size_t data_size : s_DataSizes)
+        {
+            const std::vector<std::uint8_t> data = MakeData(data_size, num_distinct_bytes, static_cast<std::uint32_t>(data_size));
+            for (const std::string& signature : MakeSignatures(data, 200, num_distinct_bytes))
+            {
+                EXPECT_EQ(SigScan::FindPatternOffset(data, signature), PatternScanReference::FindPatternOffset(data, signature))
+                    << "data size " << data_size << ", " << num_distinct_bytes << " distinct bytes, signature " << testing::PrintToString(signature);
+            }
+        }
+    }
+}
+
+TEST(PatternScanTest, FindPatternOffsetsMatchesReference)
+{
+    // Batches up to 16 signatures are scanned one by one, larger batches in a single pass
+    for (std::size_t num_signatures : { 1u, 5u, 16u, 17u, 40u, 200u })
+    {
+        for (std::uint32_t num_distinct_bytes : { 2u, 4u, 256u })
+        {
+            for (std::size_t data_size : s_DataSizes)
+            {
+                const std::vector<std::uint8_t> data = MakeData(data_size, num_distinct_bytes, static_cast<std::uint32_t>(data_size + num_signatures));
+                const std::vector<std::string> signatures = MakeSignatures(data, num_signatures, num_distinct_bytes);
+                const std::vector<std::string_view> signature_views(signatures.begin(), signatures.end());
+
+                const std::vector<std::size_t> offsets = SigScan::FindPatternOffsets(data, signature_views);
+                ASSERT_EQ(offsets.size(), signatures.size());
+                for (std::size_t i = 0; i < signatures.size(); i++)
+                {
+                    EXPECT_EQ(offsets[i], PatternScanReference::FindPatternOffset(data, signatures[i]))
+                        << num_signatures << " signatures, data size " << data_size << ", signature " << testing::PrintToString(signatures[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST(PatternScanTest, EdgeCases)
+{
+    constexpr std::string_view data{ "\x48\x8b\x05\x12\x34\x56\x78\xe8\x00\x00\x00\x00\x90\xc3", 14 };
+
+    // Matches at the very start and the very end of the data
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\x48\x8b", 2 }), 0);
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\x90\xc3", 2 }), 12);
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\xc3", 1 }), 13);
+
+    // Only common bytes, and wildcards between every byte so there is no pair to anchor on
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\xe8\x00\x00", 3 }), 7);
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\x12*\x56*\xe8", 5 }), 3);
+
+    // Only wildcards match at the start, unless the signature is longer than the data
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), "****"), 0);
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string(data.size() + 1, '*')), SigScan::c_PatternNotFound);
+
+    // A match that would end past the data
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\x90\xc3*", 3 }), SigScan::c_PatternNotFound);
+    EXPECT_EQ(SigScan::FindPatternOffset(AsBytes(data), std::string_view{ "\x12\x35", 2 }), SigScan::c_PatternNotFound);
+}
+
+TEST(PatternScanTest, MatchesPattern)
+{
+    constexpr std::string_view data{ "\x48\x8b\x05\x12\x34\x56\x78\xe8", 8 };
+    EXPECT_TRUE(SigScan::MatchesPattern(AsBytes(data), 2, std::string_view{ "\x05*\x34", 3 }));
+    EXPECT_TRUE(SigScan::MatchesPattern(AsBytes(data), 5, std::string_view{ "\x56\x78\xe8", 3 }));
+    EXPECT_FALSE(SigScan::MatchesPattern(AsBytes(data), 1, std::string_view{ "\x05*\x34", 3 }));
+    EXPECT_FALSE(SigScan::MatchesPattern(AsBytes(data), 6, std::string_view{ "\x78\xe8*", 3 }));
+    EXPECT_FALSE(SigScan::MatchesPattern(AsBytes(data), 9, "*"));
+}
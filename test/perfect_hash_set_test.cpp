@@ -0,0 +1,129 @@
+#include "mod/known_files.h"
+#include "util/perfect_hash_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The linear lookups the sets replaced, with the case insensitive comparison of the sets
+static bool LinearContains(std::span<const std::string_view> keys, std::string_view key, bool case_insensitive)
+{
+    return std::ranges::any_of(keys, [&](std::string_view known_key)
+                               { return case_insensitive
+                                            ? std::ranges::equal(known_key, key, {}, ::tolower, ::tolower)
+                                            : known_key == key; });
+}
+
+// Keys that differ from a known key in a single way, plus case variants that only case insensitive sets contain
+static std::vector<std::string> MakeNearMisses(std::string_view key)
+{
+    std::string lower{ key };
+    std::string upper{ key };
+    std::ranges::transform(lower, lower.begin(), ::tolower);
+    std::ranges::transform(upper, upper.begin(), ::toupper);
+
+    std::string prefixed{ "_" };
+    prefixed += key;
+
+    std::vector<std::string> near_misses{
+        lower,
+        upper,
+        prefixed,
+        std::string{ key } + "x",
+        std::string{ key } + ".png",
+    };
+    if (!key.empty())
+    {
+        near_misses.push_back(std::string{ key.substr(0, key.size() - 1) });
+        near_misses.push_back(std::string{ key.substr(1) });
+
+        std::string changed{ key };
+        changed.back() = changed.back() == 'a' ? 'b' : 'a';
+        near_misses.push_back(std::move(changed));
+    }
+    return near_misses;
+}
+
+template<class SetT>
+static void ExpectSameAsLinear(const SetT& set, std::span<const std::string_view> keys, bool case_insensitive)
+{
+    for (std::string_view key : keys)
+    {
+        EXPECT_TRUE(set.Contains(key)) << key;
+        for (const std::string& near_miss : MakeNearMisses(key))
+        {
+            EXPECT_EQ(set.Contains(near_miss), LinearContains(keys, near_miss, case_insensitive)) << near_miss;
+        }
+    }
+    EXPECT_EQ(set.Contains(""), LinearContains(keys, "", case_insensitive));
+}
+
+TEST(PerfectHashSet, KnownFilesMatchLinearLookup)
+{
+    ExpectSameAsLinear(s_ArenaLevelFileSet, s_ArenaLevelFiles, true);
+    ExpectSameAsLinear(s_LevelFileSet, s_LevelFiles, true);
+    ExpectSameAsLinear(s_PetsEntityFileSet, s_PetsEntityFiles, true);
+    ExpectSameAsLinear(s_MountsEntityFileSet, s_MountsEntityFiles, true);
+    ExpectSameAsLinear(s_GhostEntityFileSet, s_GhostEntityFiles, true);
+    ExpectSameAsLinear(s_CrittersEntityFileSet, s_CrittersEntityFiles, true);
+    ExpectSameAsLinear(s_MonstersEntityFileSet, s_MonstersEntityFiles, true);
+    ExpectSameAsLinear(s_BigMonstersEntityFileSet, s_BigMonstersEntityFiles, true);
+    ExpectSameAsLinear(s_PeopleEntityFileSet, s_PeopleEntityFiles, true);
+    ExpectSameAsLinear(s_DecorationsEntityFileSet, s_DecorationsEntityFiles, true);
+    ExpectSameAsLinear(s_KnownCharFileSet, s_KnownCharFiles, true);
+    ExpectSameAsLinear(s_KnownTextureFileSet, s_KnownTextureFiles, true);
+    ExpectSameAsLinear(s_KnownAudioFileSet, s_KnownAudioFiles, true);
+    ExpectSameAsLinear(s_RestKnownFileSet, s_RestKnownFiles, true);
+    ExpectSameAsLinear(s_SpeedrunDbFileSet, s_SpeedrunDbFiles, false);
+}
+
+// Mod files are found by their name in any case, the speedrun filter only blocks the paths of the tables as the game requests them
+TEST(PerfectHashSet, KnownFilesCaseSemantics)
+{
+    EXPECT_TRUE(s_KnownTextureFileSet.Contains("char_yellow"));
+    EXPECT_TRUE(s_KnownTextureFileSet.Contains("Char_Yellow"));
+    EXPECT_TRUE(s_KnownAudioFileSet.Contains("AMB_Beehive"));
+    EXPECT_TRUE(s_KnownAudioFileSet.Contains("amb_beehive"));
+    EXPECT_TRUE(s_RestKnownFileSet.Contains("Strings00_Mod.str"));
+
+    EXPECT_TRUE(s_SpeedrunDbFileSet.Contains("Data/Textures/journal_stickers"));
+    EXPECT_FALSE(s_SpeedrunDbFileSet.Contains("data/textures/journal_stickers"));
+}
+
+TEST(PerfectHashSet, SpeedrunStringHashesMatchLinearLookup)
+{
+    for (std::uint32_t hash : s_SpeedrunStringHashes)
+    {
+        EXPECT_TRUE(s_SpeedrunStringHashSet.Contains(hash)) << hash;
+        for (std::uint32_t near_miss : { hash - 1, hash + 1, hash ^ 0x80000000u })
+        {
+            EXPECT_EQ(s_SpeedrunStringHashSet.Contains(near_miss), std::ranges::find(s_SpeedrunStringHashes, near_miss) != std::ranges::end(s_SpeedrunStringHashes)) << near_miss;
+        }
+    }
+}
+
+static constexpr std::string_view s_Keys[]{ "char_yellow", "Char_Yellow", "AMB_Beehive", "", "soundbank.bank", "soundbank.bank" };
+static constexpr PerfectHashSet<std::string_view, std::size(s_Keys)> s_CaseSensitiveSet{ s_Keys };
+static constexpr PerfectHashSet<std::string_view, std::size(s_Keys), true> s_CaseInsensitiveSet{ s_Keys };
+
+TEST(PerfectHashSet, CaseSensitivity)
+{
+    static_assert(s_CaseSensitiveSet.Contains("Char_Yellow"));
+    static_assert(!s_CaseSensitiveSet.Contains("CHAR_YELLOW"));
+    static_assert(s_CaseInsensitiveSet.Contains("CHAR_YELLOW"));
+
+    ExpectSameAsLinear(s_CaseSensitiveSet, s_Keys, false);
+    ExpectSameAsLinear(s_CaseInsensitiveSet, s_Keys, true);
+
+    // Duplicate keys and the empty key
+    EXPECT_TRUE(s_CaseSensitiveSet.Contains("soundbank.bank"));
+    EXPECT_TRUE(s_CaseSensitiveSet.Contains(""));
+    EXPECT_TRUE(s_CaseInsensitiveSet.Contains("amb_beehive"));
+    EXPECT_FALSE(s_CaseInsensitiveSet.Contains("amb_beehiv"));
+}
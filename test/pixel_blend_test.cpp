@@ -0,0 +1,146 @@
+#include "util/pixel_blend.h"
+#include "reference/pixel_blend_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Random pixels with many fully opaque and fully transparent ones, some of them in the palette colors
+static std::vector<std::uint8_t> MakePixels(std::size_t num_pixels, std::uint32_t seed)
+{
+    std::mt19937 rng{ seed };
+    std::vector<std::uint8_t> pixels(num_pixels * 4);
+    for (std::uint8_t& channel : pixels)
+    {
+        channel = static_cast<std::uint8_t>(rng());
+    }
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        switch (rng() % 6)
+        {
+        case 0:
+            pixels[i + 3] = 255;
+            break;
+        case 1:
+            pixels[i + 3] = 0;
+            break;
+        case 2:
+            pixels[i + 0] = 10;
+            pixels[i + 1] = 20;
+            pixels[i + 2] = 30;
+            break;
+        case 3:
+            pixels[i + 0] = 40;
+            pixels[i + 1] = 50;
+            pixels[i + 2] = 60;
+            break;
+        default:
+            break;
+        }
+    }
+    return pixels;
+}
+
+// Row sizes that cover whole vectors, scalar tails and rows that are only tail
+static constexpr std::size_t s_RowSizes[]{ 1, 3, 4, 7, 8, 15, 16, 17, 1024 };
+
+template<class KernelFunT, class ReferenceFunT>
+static void ExpectSameAsReference(KernelFunT&& kernel, ReferenceFunT&& reference)
+{
+    for (std::size_t row_size : s_RowSizes)
+    {
+        const std::vector<std::uint8_t> source = MakePixels(row_size, 1);
+        const std::vector<std::uint8_t> base = MakePixels(row_size, 2);
+        std::vector<std::uint8_t> expected = MakePixels(row_size, 3);
+        std::vector<std::uint8_t> actual = expected;
+
+        for (std::size_t i = 0; i < expected.size(); i += 4)
+        {
+            reference(source.data() + i, base.data() + i, expected.data() + i);
+        }
+        kernel(std::span<const std::uint8_t>{ source }, std::span<const std::uint8_t>{ base }, std::span<std::uint8_t>{ actual });
+
+        EXPECT_EQ(actual, expected) << "row size " << row_size;
+    }
+}
+
+TEST(PixelBlend, AlphaBlend)
+{
+    ExpectSameAsReference([](auto source, auto, auto target)
+                          { AlphaBlendPixels(source, target); },
+                          [](auto* source, auto*, auto* target)
+                          { PixelBlendReference::AlphaBlend(source, target); });
+}
+
+TEST(PixelBlend, ColorBlend)
+{
+    ExpectSameAsReference([](auto source, auto, auto target)
+                          { ColorBlendPixels(source, target); },
+                          [](auto* source, auto*, auto* target)
+                          { PixelBlendReference::ColorBlend(source, target); });
+}
+
+TEST(PixelBlend, LuminanceBlend)
+{
+    ExpectSameAsReference([](auto source, auto, auto target)
+                          { LuminanceBlendPixels(source, target); },
+                          [](auto* source, auto*, auto* target)
+                          { PixelBlendReference::LuminanceBlend(source, target); });
+}
+
+TEST(PixelBlend, LuminanceScale)
+{
+    ExpectSameAsReference([](auto source, auto, auto target)
+                          { LuminanceScalePixels(source, target); },
+                          [](auto* source, auto*, auto* target)
+                          { PixelBlendReference::LuminanceScale(source, target); });
+    ExpectSameAsReference([](auto source, auto base, auto target)
+                          { LuminanceScalePixels(source, base, target); },
+                          [](auto* source, auto* base, auto* target)
+                          { PixelBlendReference::LuminanceScale(source, base, target); });
+}
+
+TEST(PixelBlend, ReplaceAndExtractColors)
+{
+    const ColorRGB8 source_color{ 10, 20, 30 };
+    const ColorRGB8 target_color{ 1, 2, 3 };
+    const std::vector<ColorRGB8> source_colors{ { 10, 20, 30 }, { 40, 50, 60 }, { 10, 20, 30 } };
+    const std::vector<ColorRGB8> target_colors{ { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+
+    ExpectSameAsReference([&](auto, auto, auto target)
+                          { ReplaceColorPixels(target, source_color, target_color); },
+                          [&](auto*, auto*, auto* target)
+                          { PixelBlendReference::ReplaceColor(target, source_color, target_color); });
+    ExpectSameAsReference([&](auto, auto, auto target)
+                          { ReplaceColorsPixels(target, source_colors, target_colors); },
+                          [&](auto*, auto*, auto* target)
+                          { PixelBlendReference::ReplaceColors(target, source_colors, target_colors); });
+    ExpectSameAsReference([&](auto, auto, auto target)
+                          { ExtractColorPixels(target, source_color); },
+                          [&](auto*, auto*, auto* target)
+                          { PixelBlendReference::ExtractColor(target, source_color); });
+}
+
+TEST(PixelBlend, PremultiplyBGRA)
+{
+    // Every pair of value and alpha in each of the three channels
+    std::vector<std::uint8_t> expected(256 * 256 * 4);
+    for (std::size_t i = 0; i < 256 * 256; i++)
+    {
+        const auto value = static_cast<std::uint8_t>(i);
+        expected[i * 4 + 0] = value;
+        expected[i * 4 + 1] = static_cast<std::uint8_t>(255 - value);
+        expected[i * 4 + 2] = static_cast<std::uint8_t>(value * 7);
+        expected[i * 4 + 3] = static_cast<std::uint8_t>(i >> 8);
+    }
+    std::vector<std::uint8_t> actual = expected;
+
+    for (std::size_t i = 0; i < expected.size(); i += 4)
+    {
+        PixelBlendReference::PremultiplyBGRA(expected.data() + i);
+    }
+    PremultiplyBGRAPixels(actual);
+    EXPECT_EQ(actual, expected);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "mod/chacha.h"
+
+// The implementation of ChaCha before it was optimized, the optimized one has to give the same bytes
+// Version 1 file path hashing is not included, it read past the end of its initial state
+namespace ChaChaReference
+{
+ChaCha::bytes_t hash_filepath(std::string_view filepath, std::uint64_t key);
+ChaCha::bytes_t chacha(std::string_view filepath, std::span<const std::uint8_t> data, std::uint64_t key, ChaCha::Version version);
+} // namespace ChaChaReference
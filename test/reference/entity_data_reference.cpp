@@ -0,0 +1,74 @@
+#include "entity_data_reference.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+using namespace nlohmann;
+
+namespace EntityDataReference
+{
+void from_json(const json& j, AnimationData& anim)
+{
+    anim.FirstTileIndex = j["texture"];
+    anim.NumTiles = j["count"];
+}
+void from_json(const json& j, EntityData& ent)
+{
+    ent.Id = j["id"];
+    std::unordered_map<std::string, AnimationData> animations;
+    j["animations"].get_to(animations);
+    for (auto& [id_str, animation_data] : animations)
+    {
+        std::uint8_t id{ 0 };
+        std::from_chars(id_str.c_str(), id_str.c_str() + id_str.size(), id);
+        ent.Animations[id] = animation_data;
+    }
+    ent.TextureId = j["texture"];
+    if (j.contains("tile_x"))
+    {
+        ent.TileX = j["tile_x"];
+        ent.TileY = j["tile_y"];
+    }
+}
+void from_json(const json& j, TextureData& tex)
+{
+    tex.Path = j["path"];
+    tex.Width = j["width"];
+    tex.Height = j["height"];
+    tex.NumTilesWidth = j["num_tiles"]["width"];
+    tex.NumTilesHeight = j["num_tiles"]["height"];
+    tex.TileWidth = j["tile_width"];
+    tex.TileHeight = j["tile_height"];
+    tex.OffsetWidth = j["offset"]["width"];
+    tex.OffsetHeight = j["offset"]["height"];
+}
+
+EntityMappings ParseEntityMappings(std::string_view entities_json, std::string_view textures_json)
+{
+    EntityMappings mappings;
+    json::parse(entities_json).get_to(mappings.Entities);
+    {
+        std::unordered_map<std::string, TextureData> string_mapped_textures;
+        json::parse(textures_json).get_to(string_mapped_textures);
+        for (auto& [id_str, texture_data] : string_mapped_textures)
+        {
+            std::int32_t id{ 0 };
+            std::from_chars(id_str.c_str(), id_str.c_str() + id_str.size(), id);
+            mappings.Textures[id] = std::move(texture_data);
+        }
+    }
+    return mappings;
+}
+
+std::string LoadResource(std::string_view file_name)
+{
+    std::ifstream file{ std::filesystem::path{ PLAYLUNKY_TEST_RES_DIR } / file_name, std::ios::binary };
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return std::move(contents).str();
+}
+} // namespace EntityDataReference
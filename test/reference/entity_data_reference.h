@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// The entity mappings as PreloadEntityMappings parsed them from res/entities.json and res/textures.json at every start,
+// before they were generated into constexpr tables at build time
+namespace EntityDataReference
+{
+struct AnimationData
+{
+    std::int32_t FirstTileIndex;
+    std::int32_t NumTiles;
+};
+struct EntityData
+{
+    std::uint16_t Id;
+    std::map<std::uint8_t, AnimationData> Animations;
+    std::int32_t TextureId;
+    std::int32_t TileX{ -1 };
+    std::int32_t TileY{ -1 };
+};
+struct TextureData
+{
+    std::string Path;
+    std::uint32_t Width;
+    std::uint32_t Height;
+    std::uint32_t NumTilesWidth;
+    std::uint32_t NumTilesHeight;
+    std::uint32_t TileWidth;
+    std::uint32_t TileHeight;
+    std::uint32_t OffsetWidth;
+    std::uint32_t OffsetHeight;
+};
+
+struct EntityMappings
+{
+    std::unordered_map<std::string, EntityData> Entities;
+    std::unordered_map<std::int32_t, TextureData> Textures;
+};
+EntityMappings ParseEntityMappings(std::string_view entities_json, std::string_view textures_json);
+
+// Contents of a file in res/, as it was embedded into the dll
+std::string LoadResource(std::string_view file_name);
+} // namespace EntityDataReference
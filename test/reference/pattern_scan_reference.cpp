@@ -0,0 +1,29 @@
+#include "pattern_scan_reference.h"
+
+#include "detour/pattern_scan.h"
+
+namespace PatternScanReference
+{
+// The old loop never tested the last position and underflowed for data shorter than the signature, both are fixed here
+std::size_t FindPatternOffset(std::span<const std::uint8_t> data, std::string_view signature)
+{
+    const std::size_t size = data.size();
+    const std::size_t sig_length = signature.size();
+
+    for (std::size_t j = 0; j + sig_length <= size; j++)
+    {
+        bool found = true;
+        for (std::size_t k = 0; k < sig_length && found; k++)
+        {
+            found = signature[k] == '*' || signature[k] == static_cast<char>(data[j + k]);
+        }
+
+        if (found)
+        {
+            return j;
+        }
+    }
+
+    return SigScan::c_PatternNotFound;
+}
+} // namespace PatternScanReference
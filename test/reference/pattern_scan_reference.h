@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// The byte-by-byte signature search before it was vectorized, the scanner has to find the same offsets
+namespace PatternScanReference
+{
+std::size_t FindPatternOffset(std::span<const std::uint8_t> data, std::string_view signature);
+} // namespace PatternScanReference
@@ -0,0 +1,125 @@
+#include "pixel_blend_reference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+namespace PixelBlendReference
+{
+using uchar = std::uint8_t;
+
+// Same as the cv::Mat expression of the old AlphaBlend, the mask is saturate(round(alpha / 255))
+void AlphaBlend(const uchar* source, uchar* target)
+{
+    const int mask = static_cast<int>(std::nearbyint(source[3] * (1.0 / 255.0)));
+    for (int c = 0; c < 4; c++)
+    {
+        target[c] = static_cast<uchar>(std::min(255, target[c] * (1 - mask) + source[c] * mask));
+    }
+}
+
+void ColorBlend(const uchar* color_pixel, uchar* pixel)
+{
+    const float color = GetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f);
+    const auto [fr, fg, fb] = SetLuminance(color_pixel[0] / 255.0f, color_pixel[1] / 255.0f, color_pixel[2] / 255.0f, color);
+    const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
+    const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
+    const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
+    const float color_alpha = color_pixel[3] / 255.0f;
+    pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - color_alpha) + r * color_alpha);
+    pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - color_alpha) + g * color_alpha);
+    pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - color_alpha) + b * color_alpha);
+}
+
+void LuminanceBlend(const uchar* luminance_pixel, uchar* pixel)
+{
+    const float luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
+    const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, luminance);
+    const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
+    const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
+    const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
+    const float luminance_alpha = luminance_pixel[3] / 255.0f;
+    pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
+    pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
+    pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha);
+}
+
+void LuminanceScale(const uchar* luminance_pixel, uchar* pixel)
+{
+    const auto luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
+    const auto cur_lum = GetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f);
+    const auto new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
+    const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, new_lum);
+    const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
+    const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
+    const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
+    const float luminance_alpha = luminance_pixel[3] / 255.0f;
+    pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
+    pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
+    pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha);
+}
+
+void LuminanceScale(const uchar* luminance_pixel, const uchar* base_pixel, uchar* pixel)
+{
+    if (luminance_pixel[3] == 255)
+    {
+        const auto luminance = GetLuminance(luminance_pixel[0] / 255.0f, luminance_pixel[1] / 255.0f, luminance_pixel[2] / 255.0f);
+        const auto cur_lum = GetLuminance(base_pixel[0] / 255.0f, base_pixel[1] / 255.0f, base_pixel[2] / 255.0f);
+        const auto new_lum = std::clamp(2.0f * luminance * cur_lum, 0.0f, 1.0f);
+        const auto [fr, fg, fb] = SetLuminance(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, new_lum);
+        const auto r = static_cast<uchar>(std::clamp(fr * 255.0f, 0.0f, 255.0f));
+        const auto g = static_cast<uchar>(std::clamp(fg * 255.0f, 0.0f, 255.0f));
+        const auto b = static_cast<uchar>(std::clamp(fb * 255.0f, 0.0f, 255.0f));
+        const float luminance_alpha = luminance_pixel[3] / 255.0f;
+        pixel[0] = static_cast<uchar>(pixel[0] * (1.0f - luminance_alpha) + r * luminance_alpha);
+        pixel[1] = static_cast<uchar>(pixel[1] * (1.0f - luminance_alpha) + g * luminance_alpha);
+        pixel[2] = static_cast<uchar>(pixel[2] * (1.0f - luminance_alpha) + b * luminance_alpha);
+    }
+}
+
+void ReplaceColor(uchar* pixel, ColorRGB8 source_color, ColorRGB8 target_color)
+{
+    ColorRGB8 color;
+    std::memcpy(&color, pixel, sizeof(color));
+    if (color == source_color)
+    {
+        std::memcpy(pixel, &target_color, sizeof(target_color));
+    }
+}
+
+void ReplaceColors(uchar* pixel, std::span<const ColorRGB8> source_colors, std::span<const ColorRGB8> target_colors)
+{
+    ColorRGB8 color;
+    std::memcpy(&color, pixel, sizeof(color));
+    for (std::size_t i = 0; i < source_colors.size(); i++)
+    {
+        if (color == source_colors[i])
+        {
+            std::memcpy(pixel, &target_colors[i], sizeof(target_colors[i]));
+            return;
+        }
+    }
+}
+
+void ExtractColor(uchar* pixel, ColorRGB8 color)
+{
+    ColorRGB8 pixel_color;
+    std::memcpy(&pixel_color, pixel, sizeof(pixel_color));
+    if (pixel_color != color)
+    {
+        std::memset(pixel, 0, 4);
+    }
+}
+
+void PremultiplyBGRA(uchar* pixel)
+{
+    std::swap(pixel[0], pixel[2]);
+
+    float alpha = (float)pixel[3] / 255.0f;
+    pixel[0] = (uchar)((float)pixel[0] * alpha);
+    pixel[1] = (uchar)((float)pixel[1] * alpha);
+    pixel[2] = (uchar)((float)pixel[2] * alpha);
+}
+} // namespace PixelBlendReference
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "util/color.h"
+
+#include <cstdint>
+#include <span>
+
+// The per-pixel blend functions of image_processing before they were vectorized, each blends a single RGBA8 pixel
+// The vectorized kernels have to give the same pixels
+namespace PixelBlendReference
+{
+void AlphaBlend(const std::uint8_t* source, std::uint8_t* target);
+void ColorBlend(const std::uint8_t* color, std::uint8_t* target);
+void LuminanceBlend(const std::uint8_t* luminance, std::uint8_t* target);
+void LuminanceScale(const std::uint8_t* luminance_scale, std::uint8_t* target);
+void LuminanceScale(const std::uint8_t* luminance_scale, const std::uint8_t* base_luminance, std::uint8_t* target);
+
+void ReplaceColor(std::uint8_t* pixel, ColorRGB8 source_color, ColorRGB8 target_color);
+void ReplaceColors(std::uint8_t* pixel, std::span<const ColorRGB8> source_colors, std::span<const ColorRGB8> target_colors);
+void ExtractColor(std::uint8_t* pixel, ColorRGB8 color);
+
+// The channel swap of the old ConvertToRGBA followed by the float premultiply that Image::Load ran with cv::Mat::forEach
+void PremultiplyBGRA(std::uint8_t* pixel);
+} // namespace PixelBlendReference
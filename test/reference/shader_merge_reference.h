@@ -0,0 +1,9 @@
+#pragma once
+
+#include "mod/shader_source_merge.h"
+
+// The shader merge before it was built on a block index, the optimized one has to give the same shader
+namespace ShaderMergeReference
+{
+std::string MergeShaderSource(std::string source_shader_code, std::span<const ShaderMod> shader_mods);
+} // namespace ShaderMergeReference
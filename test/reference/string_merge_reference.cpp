@@ -0,0 +1,108 @@
+#include "string_merge_reference.h"
+
+#include "log.h"
+#include "mod/known_files.h"
+#include "util/algorithms.h"
+
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace StringMergeReference
+{
+bool MergeStringTable(const std::filesystem::path& string_table_file,
+                      const std::filesystem::path& hash_file_path,
+                      std::span<const std::filesystem::path> mod_files,
+                      const std::filesystem::path& destination_file,
+                      bool speedrun_mode)
+{
+    if (auto hash_file = std::ifstream{ hash_file_path })
+    {
+        struct ModdedString
+        {
+            std::string Hash;
+            std::string String;
+        };
+        std::vector<ModdedString> modded_strings;
+
+        for (const auto& string_table_source_file : mod_files)
+        {
+            if (auto source_file = std::ifstream{ string_table_source_file })
+            {
+                while (!source_file.eof())
+                {
+                    std::string modded_string;
+                    std::getline(source_file, modded_string);
+                    if (modded_string.size() >= 2 && modded_string[0] == '0' && modded_string[1] == 'x')
+                    {
+                        const auto colon_pos = modded_string.find(':');
+                        if (colon_pos != std::string::npos)
+                        {
+                            std::string_view hash_string = std::string_view{ modded_string }.substr(2, colon_pos - 2);
+                            std::string_view full_hash_string = std::string_view{ modded_string }.substr(0, colon_pos);
+
+                            std::uint32_t hash{ 0 };
+                            auto result = std::from_chars(hash_string.data(), hash_string.data() + hash_string.size(), hash, 16);
+                            if (result.ec == std::errc::invalid_argument)
+                            {
+                                LogError("Failed parsing string hash '0x{}', modded string '{}' will be discarded...", hash_string, modded_string);
+                                return false;
+                            }
+
+                            const bool is_allowed_string = !speedrun_mode || algo::contains(s_SpeedrunStringHashes, hash);
+
+                            if (is_allowed_string && !algo::contains(modded_strings, &ModdedString::Hash, full_hash_string))
+                            {
+                                const std::size_t string_start = 3 + hash_string.size();
+                                std::string_view string = std::string_view{ modded_string }.substr(modded_string.find_first_not_of(' ', string_start));
+                                modded_strings.push_back(ModdedString{
+                                    .Hash{ std::string{ full_hash_string } },
+                                    .String{ std::string{ string } } });
+                            }
+                        }
+                        else
+                        {
+                            LogError("Failed parsing modded string '{}', expected ':' after hash, the string will be discarded...", modded_string);
+                        }
+                    }
+                    else if (modded_string.size() > 0 && modded_string[0] != '#')
+                    {
+                        LogError("Failed parsing modded string '{}', expected hash at beginning of line, the string will be discarded...", modded_string);
+                    }
+                }
+            }
+        }
+
+        auto strings_source_file = std::ifstream{ string_table_file };
+        auto strings_destination_file = std::ofstream{ destination_file, std::ios::trunc };
+
+        if (strings_source_file && strings_destination_file)
+        {
+            while (!strings_source_file.eof() && !hash_file.eof())
+            {
+                std::string source_string;
+                std::getline(strings_source_file, source_string);
+
+                std::string hash_string;
+                std::getline(hash_file, hash_string);
+
+                if (hash_string != "0xdeadbeef")
+                {
+                    if (auto* modded_string = algo::find(modded_strings, &ModdedString::Hash, hash_string))
+                    {
+                        strings_destination_file << modded_string->String << '\n';
+                        continue;
+                    }
+                }
+
+                strings_destination_file << source_string << '\n';
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+} // namespace StringMergeReference
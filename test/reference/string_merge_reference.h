@@ -0,0 +1,15 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+// The string merge before it used a hash map and caches, comparing hash strings linearly for every line
+// The optimized merge has to write the same table for any input this one handles
+namespace StringMergeReference
+{
+bool MergeStringTable(const std::filesystem::path& string_table_file,
+                      const std::filesystem::path& hash_file,
+                      std::span<const std::filesystem::path> mod_files,
+                      const std::filesystem::path& destination_file,
+                      bool speedrun_mode);
+} // namespace StringMergeReference
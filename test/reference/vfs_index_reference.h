@@ -0,0 +1,69 @@
+#pragma once
+
+#include "util/algorithms.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// The file index of the virtual filesystem before lookups hashed the path in place and collected candidates without allocating
+namespace VfsIndexReference
+{
+template<class MountT>
+class FileIndex
+{
+  public:
+    struct IndexedFile
+    {
+        const MountT* Mount;
+        std::filesystem::path FileName;
+    };
+
+    void Add(const MountT* mount, const std::filesystem::path& relative_path)
+    {
+        auto add_to_index = [mount](Index& index, std::string key, std::filesystem::path file_name)
+        {
+            auto& indexed_files = index[std::move(key)];
+            if (algo::contains(indexed_files, &IndexedFile::Mount, mount))
+            {
+                return;
+            }
+
+            auto it = std::upper_bound(indexed_files.begin(), indexed_files.end(), mount, [](const MountT* lhs, const IndexedFile& rhs)
+                                       { return lhs->Priority < rhs.Mount->Priority || (lhs->Priority == rhs.Mount->Priority && lhs->MountOrder < rhs.Mount->MountOrder); });
+            indexed_files.insert(it, IndexedFile{ mount, std::move(file_name) });
+        };
+
+        add_to_index(m_FileIndex, GetIndexKey(relative_path), relative_path.filename());
+        add_to_index(m_StemIndex, GetIndexKey(std::filesystem::path{ relative_path }.replace_extension()), relative_path.filename());
+    }
+
+    // Same as the runtime lookup of the game's loads, which converted the path and copied all candidates
+    std::vector<IndexedFile> GetCandidates(const char* game_path) const
+    {
+        const std::filesystem::path path{ game_path };
+        const bool match_stem = !path.has_extension();
+
+        std::vector<IndexedFile> candidates;
+        const Index& index = match_stem ? m_StemIndex : m_FileIndex;
+        if (auto it = index.find(GetIndexKey(path)); it != index.end())
+        {
+            candidates.assign(it->second.begin(), it->second.end());
+        }
+        return candidates;
+    }
+
+  private:
+    static std::string GetIndexKey(const std::filesystem::path& path)
+    {
+        return algo::to_lower(algo::path_string(path));
+    }
+
+    using Index = std::unordered_map<std::string, std::vector<IndexedFile>>;
+    Index m_FileIndex;
+    Index m_StemIndex;
+};
+} // namespace VfsIndexReference
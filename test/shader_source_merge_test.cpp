@@ -0,0 +1,142 @@
+#include "mod/shader_source_merge.h"
+#include "reference/shader_merge_reference.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+static constexpr std::string_view s_SourceShader{ R"(// base shader
+cbuffer Constants : register(b0) {
+    float4x4 transform;
+};
+Texture2D tex : register(t0);
+struct VSInput {
+    float2 pos : POSITION;
+};
+struct PSInput {
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+float4 sample_color(float2 uv, float alpha) {
+    if (alpha > 0.5) { return float4(uv, 0, alpha); }
+    return float4(0, 0, 0, 0);
+}
+
+PSInput vs_main(VSInput input) {
+    PSInput output;
+    output.pos = mul(transform, float4(input.pos, 0, 1));
+    output.uv = input.pos;
+    return output;
+}
+
+float4 ps_main(PSInput input) : SV_TARGET {
+    return sample_color(input.uv, 1.0);
+}
+
+float4 ps_other(PSInput input) : SV_TARGET {
+    return float4(1, 1, 1, 1);
+}
+)" };
+
+// Replaces a function, adds a helper and has a function that is not in the source
+static constexpr std::string_view s_ReplacingMod{ R"(// a mod
+float helper(float x) {
+    return x * 2;
+}
+
+float4 ps_main(PSInput input) : SV_TARGET {
+    return sample_color(input.uv * helper(0.5), 1.0);
+}
+
+float4 missing_function(float a) {
+    return a;
+}
+)" };
+
+// Extends a function and replaces one that is preceded by a comment containing a brace
+static constexpr std::string_view s_ExtendingMod{ R"(
+#extends
+bool sample_color(float2 uv, float alpha, inout float4 return_value) {
+    return_value = float4(1, 0, 0, 1);
+    return alpha < 0.1;
+}
+
+/* block comment { */
+float4 ps_other(PSInput input) : SV_TARGET {
+    return float4(0, 0, 0, 1);
+}
+)" };
+
+// Adds a struct and extends two functions
+static constexpr std::string_view s_StructMod{ R"(
+struct Extra {
+    float a;
+};
+#extends
+bool sample_color(float2 uv, float alpha, inout float4 return_value) {
+    return false;
+}
+#extends
+bool ps_main(PSInput input, inout float4 return_value) {
+    return true;
+}
+)" };
+
+static ShaderMod MakeShaderMod(std::string_view name, std::string_view code)
+{
+    return ShaderMod{ .Path{ name }, .Code{ std::string{ code } } };
+}
+
+TEST(ShaderSourceMerge, MatchesReference)
+{
+    const ShaderMod replacing_mod = MakeShaderMod("replacing_mod", s_ReplacingMod);
+    const ShaderMod extending_mod = MakeShaderMod("extending_mod", s_ExtendingMod);
+    const ShaderMod struct_mod = MakeShaderMod("struct_mod", s_StructMod);
+
+    const std::vector<std::vector<ShaderMod>> cases{
+        {},
+        { replacing_mod },
+        { extending_mod },
+        { replacing_mod, extending_mod },
+        { replacing_mod, extending_mod, struct_mod },
+        { struct_mod, replacing_mod },
+        { extending_mod, struct_mod, extending_mod },
+    };
+    for (std::size_t i = 0; i < cases.size(); i++)
+    {
+        EXPECT_EQ(MergeShaderSource(s_SourceShader, cases[i]), ShaderMergeReference::MergeShaderSource(std::string{ s_SourceShader }, cases[i])) << "case " << i;
+    }
+}
+
+TEST(ShaderSourceMerge, ReplacesAndExtendsFunctions)
+{
+    const std::vector<ShaderMod> shader_mods{ MakeShaderMod("replacing_mod", s_ReplacingMod), MakeShaderMod("extending_mod", s_ExtendingMod) };
+    const std::string merged = MergeShaderSource(s_SourceShader, shader_mods);
+
+    EXPECT_NE(merged.find("return sample_color(input.uv * helper(0.5), 1.0);"), std::string::npos);
+    EXPECT_EQ(merged.find("return sample_color(input.uv, 1.0);"), std::string::npos);
+    EXPECT_NE(merged.find("float helper(float x)"), std::string::npos);
+    EXPECT_NE(merged.find("bool sample_color_ext0(float2 uv, float alpha, inout float4 return_value)"), std::string::npos);
+    EXPECT_NE(merged.find("if (sample_color_ext0(uv, alpha, return_value))"), std::string::npos);
+    EXPECT_NE(merged.find("return float4(0, 0, 0, 1);"), std::string::npos);
+    EXPECT_EQ(merged.find("missing_function"), std::string::npos);
+}
+
+TEST(ShaderSourceMerge, FunctionIndex)
+{
+    const ShaderFunctionIndex index{ s_SourceShader };
+    EXPECT_EQ(index.GetBlocks().size(), 7);
+
+    const auto ps_main = index.FindDeclaration("float4 ps_main(PSInput input) : SV_TARGET");
+    ASSERT_TRUE(ps_main.has_value());
+    EXPECT_EQ(ps_main->Position, s_SourceShader.find("float4 ps_main"));
+
+    const auto sample_color = index.FindFunction("sample_color");
+    ASSERT_TRUE(sample_color.has_value());
+    EXPECT_EQ(sample_color->Position, s_SourceShader.find("sample_color"));
+
+    EXPECT_FALSE(index.FindDeclaration("float4 missing_function(float a)").has_value());
+    EXPECT_FALSE(index.FindFunction("missing_function").has_value());
+}
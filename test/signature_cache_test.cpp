@@ -0,0 +1,99 @@
+#include "detour/pattern_scan.h"
+#include "detour/signature_cache.h"
+#include "test_temp_folder.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+class SignatureCacheTest : public TempFolderTest
+{
+  protected:
+    void SetUp() override
+    {
+        TempFolderTest::SetUp();
+        fs::create_directories(mTestFolder / "Mods" / "Packs");
+    }
+
+    fs::path CacheFile() const
+    {
+        return mTestFolder / "Mods" / "Packs" / ".db" / "signatures.cache";
+    }
+};
+
+static constexpr SigScan::ModuleIdentity s_Module{
+    .FileSize{ 0x1234000 },
+    .HeaderHash{ 0x9E3779B97F4A7C15 },
+};
+static constexpr SigScan::ModuleIdentity s_OtherModule{
+    .FileSize{ 0x1234000 },
+    .HeaderHash{ 0x0123456789ABCDEF },
+};
+
+TEST_F(SignatureCacheTest, RoundTrip)
+{
+    {
+        SignatureCache cache;
+        cache.Store(s_Module, "\x48\x8b*\x12", 0x100);
+        cache.Store(s_Module, "\x90\xc3", 0x200);
+        ASSERT_TRUE(cache.WriteToFile(CacheFile()));
+    }
+
+    SignatureCache cache = SignatureCache::ReadFromFile(CacheFile());
+    EXPECT_EQ(cache.Find(s_Module, "\x48\x8b*\x12"), 0x100);
+    EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), 0x200);
+    EXPECT_EQ(cache.Find(s_Module, "\x90\xc4"), std::nullopt);
+    EXPECT_EQ(cache.Find(s_OtherModule, "\x90\xc3"), std::nullopt);
+}
+
+TEST_F(SignatureCacheTest, DropsUnusedEntries)
+{
+    {
+        SignatureCache cache;
+        cache.Store(s_Module, "\x48\x8b*\x12", 0x100);
+        cache.Store(s_Module, "\x90\xc3", 0x200);
+        ASSERT_TRUE(cache.WriteToFile(CacheFile()));
+    }
+    {
+        SignatureCache cache = SignatureCache::ReadFromFile(CacheFile());
+        EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), 0x200);
+        ASSERT_TRUE(cache.WriteToFile(CacheFile()));
+    }
+
+    SignatureCache cache = SignatureCache::ReadFromFile(CacheFile());
+    EXPECT_EQ(cache.Find(s_Module, "\x48\x8b*\x12"), std::nullopt);
+    EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), 0x200);
+}
+
+TEST_F(SignatureCacheTest, DoesNotCacheMisses)
+{
+    {
+        SignatureCache cache;
+        cache.Store(s_Module, "\x90\xc3", SigScan::c_PatternNotFound);
+        EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), std::nullopt);
+        ASSERT_TRUE(cache.WriteToFile(CacheFile()));
+    }
+
+    SignatureCache cache = SignatureCache::ReadFromFile(CacheFile());
+    EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), std::nullopt);
+}
+
+TEST_F(SignatureCacheTest, DoesNotCreateModsFolders)
+{
+    fs::remove_all(mTestFolder / "Mods");
+
+    SignatureCache cache;
+    cache.Store(s_Module, "\x90\xc3", 0x200);
+    EXPECT_FALSE(cache.WriteToFile(CacheFile()));
+    EXPECT_FALSE(fs::exists(mTestFolder / "Mods"));
+}
+
+TEST_F(SignatureCacheTest, CorruptFile)
+{
+    WriteFile(CacheFile(), "PLSC but not really");
+
+    SignatureCache cache = SignatureCache::ReadFromFile(CacheFile());
+    EXPECT_EQ(cache.Find(s_Module, "\x90\xc3"), std::nullopt);
+}
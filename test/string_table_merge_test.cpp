@@ -0,0 +1,200 @@
+#include "mod/known_files.h"
+#include "mod/string_table_merge.h"
+#include "reference/string_merge_reference.h"
+#include "test_temp_folder.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class StringTableMergeTest : public TempFolderTest
+{
+  protected:
+    void SetUp() override
+    {
+        TempFolderTest::SetUp();
+        fs::create_directories(CacheFolder());
+
+        // Hashes are written by hand so that one of them is a string that is allowed in speedrun mode
+        WriteFile(TableFile(), "# Header\n"
+                               "Spelunky 2\n"
+                               "Hello World\n"
+                               "\n"
+                               "Speedrun String\n"
+                               "# Items\n"
+                               "Rope\n"
+                               "Bomb\n"
+                               "Same hash as Rope\n");
+        const std::vector<std::string> hashes{
+            "0xdeadbeef",
+            "0x00000001",
+            "0x00000002",
+            "0x00000003",
+            SpeedrunHash(),
+            "0xdeadbeef",
+            "0x00000005",
+            "0x00000006",
+            "0x00000005",
+        };
+        std::string hash_file;
+        for (const std::string& hash : hashes)
+        {
+            hash_file += hash + '\n';
+        }
+        WriteFile(HashFile(), hash_file);
+    }
+
+    // Formatted the same way as in the hash file
+    static std::string SpeedrunHash()
+    {
+        char hash_string[11];
+        std::snprintf(hash_string, sizeof(hash_string), "0x%08x", s_SpeedrunStringHashes[0]);
+        return hash_string;
+    }
+
+    fs::path TableFile() const
+    {
+        return mTestFolder / "strings00.str";
+    }
+    fs::path HashFile() const
+    {
+        return mTestFolder / "strings_hashes.hash";
+    }
+    fs::path CacheFolder() const
+    {
+        return mTestFolder / "StringCache";
+    }
+    fs::path ModFile(std::string_view mod_name) const
+    {
+        return mTestFolder / "Mods" / mod_name / "strings00_mod.str";
+    }
+
+    std::string Merge(const std::vector<fs::path>& mod_files, bool speedrun_mode)
+    {
+        const fs::path destination_file = mTestFolder / "merged.str";
+        StringHashFile hash_file{ HashFile() };
+        EXPECT_TRUE(MergeStringTable(hash_file, TableFile(), mod_files, destination_file, CacheFolder(), speedrun_mode));
+        return ReadFile(destination_file);
+    }
+    std::string MergeReference(const std::vector<fs::path>& mod_files, bool speedrun_mode)
+    {
+        const fs::path destination_file = mTestFolder / "merged_reference.str";
+        EXPECT_TRUE(StringMergeReference::MergeStringTable(TableFile(), HashFile(), mod_files, destination_file, speedrun_mode));
+        return ReadFile(destination_file);
+    }
+};
+
+TEST_F(StringTableMergeTest, MatchesReference)
+{
+    const std::string mod_a = "# Replaces the first line and a speedrun string\n"
+                              "0x00000001: Spelunky 3\n"
+                              "\n" +
+                              SpeedrunHash() + ":   Any%\n" +
+                              "0xdeadbeef: Never replaces comments\n"
+                              "0x00000005 no colon is discarded\n"
+                              "not a hash is discarded\n";
+    WriteFile(ModFile("A"), mod_a);
+    WriteFile(ModFile("B"), "0x00000001: Loses against A\n"
+                            "0x00000002: Goodbye World\n"
+                            "0x00000002: Loses against the line before\n"
+                            "0x00000005: Both lines of this hash\n");
+
+    const std::vector<fs::path> mod_files{ ModFile("A"), ModFile("B") };
+    for (const bool speedrun_mode : { false, true })
+    {
+        const std::string expected = MergeReference(mod_files, speedrun_mode);
+        EXPECT_EQ(Merge(mod_files, speedrun_mode), expected) << speedrun_mode;
+
+        // Second time from the caches of the table and both mods
+        EXPECT_EQ(Merge(mod_files, speedrun_mode), expected) << speedrun_mode;
+    }
+
+    EXPECT_EQ(Merge(mod_files, false), "# Header\n"
+                                       "Spelunky 3\n"
+                                       "Goodbye World\n"
+                                       "\n"
+                                       "Any%\n"
+                                       "# Items\n"
+                                       "Both lines of this hash\n"
+                                       "Bomb\n"
+                                       "Both lines of this hash\n"
+                                       "\n");
+
+    // Only the speedrun string is replaced in speedrun mode
+    EXPECT_EQ(Merge(mod_files, true), "# Header\n"
+                                      "Spelunky 2\n"
+                                      "Hello World\n"
+                                      "\n"
+                                      "Any%\n"
+                                      "# Items\n"
+                                      "Rope\n"
+                                      "Bomb\n"
+                                      "Same hash as Rope\n"
+                                      "\n");
+
+    // Priority follows the order of the mod files
+    const std::vector<fs::path> reversed_mod_files{ ModFile("B"), ModFile("A") };
+    EXPECT_EQ(Merge(reversed_mod_files, false), MergeReference(reversed_mod_files, false));
+}
+
+TEST_F(StringTableMergeTest, ChangedModIsParsedAgain)
+{
+    WriteFile(ModFile("A"), "0x00000001: Spelunky 3\n");
+    const std::vector<fs::path> mod_files{ ModFile("A") };
+    EXPECT_EQ(Merge(mod_files, false), MergeReference(mod_files, false));
+
+    WriteFile(ModFile("A"), "0x00000002: Changed\n0x00000006: Fuse\n");
+    fs::last_write_time(ModFile("A"), fs::last_write_time(ModFile("A")) + std::chrono::seconds{ 1 });
+    const std::string merged = Merge(mod_files, false);
+    EXPECT_EQ(merged, MergeReference(mod_files, false));
+    EXPECT_NE(merged.find("Fuse"), std::string::npos);
+    EXPECT_EQ(merged.find("Spelunky 3"), std::string::npos);
+
+    // Changing the table invalidates its cache too
+    WriteFile(TableFile(), "# Header\nSpelunky HD\n");
+    fs::last_write_time(TableFile(), fs::last_write_time(TableFile()) + std::chrono::seconds{ 1 });
+    EXPECT_EQ(Merge(mod_files, false), MergeReference(mod_files, false));
+}
+
+TEST_F(StringTableMergeTest, EmptyModdedString)
+{
+    // The linear merge threw on these, so they are compared against the expected table instead
+    WriteFile(ModFile("A"), "0x00000001:\n0x00000002:   \n");
+    EXPECT_EQ(Merge({ ModFile("A") }, false), "# Header\n"
+                                              "\n"
+                                              "\n"
+                                              "\n"
+                                              "Speedrun String\n"
+                                              "# Items\n"
+                                              "Rope\n"
+                                              "Bomb\n"
+                                              "Same hash as Rope\n"
+                                              "\n");
+}
+
+TEST_F(StringTableMergeTest, InvalidHashDiscardsModFile)
+{
+    // The hash of the second line does not fit into 32 bits, so none of the strings of A are used
+    WriteFile(ModFile("A"), "0x00000001: Spelunky 3\n"
+                            "0x100000002: Overflows\n");
+    WriteFile(ModFile("B"), "0x00000001: Spelunky 4\n");
+    const std::string merged = Merge({ ModFile("A"), ModFile("B") }, false);
+    EXPECT_EQ(merged, MergeReference({ ModFile("B") }, false));
+    EXPECT_NE(merged.find("Spelunky 4"), std::string::npos);
+}
+
+TEST_F(StringTableMergeTest, MissingHashFile)
+{
+    fs::remove(HashFile());
+    StringHashFile hash_file{ HashFile() };
+    EXPECT_FALSE(hash_file.GetStamp().has_value());
+    EXPECT_FALSE(MergeStringTable(hash_file, TableFile(), {}, mTestFolder / "merged.str", CacheFolder(), false));
+}
@@ -0,0 +1,51 @@
+#include "test_decode_audio_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Sources under test decode audio through this instead of libnyquist, test audio files are a small header followed by the samples
+struct TestAudioFileHeader
+{
+    std::int32_t NumChannels;
+    std::int32_t Frequency;
+    std::int32_t Format;
+};
+
+void WriteTestAudioFile(const std::filesystem::path& file_path, std::int32_t num_channels, std::int32_t frequency, SoundFormat format, std::span<const std::byte> samples)
+{
+    const TestAudioFileHeader header{ num_channels, frequency, static_cast<std::int32_t>(format) };
+    std::ofstream file{ file_path, std::ios::binary };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(samples.data()), samples.size());
+}
+
+bool IsSupportedAudioFile(const std::filesystem::path& file_path)
+{
+    return file_path.extension() == ".wav";
+}
+
+DecodedAudioBuffer DecodeAudioFile(const std::filesystem::path& file_path)
+{
+    std::ifstream file{ file_path, std::ios::binary };
+    const std::vector<char> content{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    if (content.size() < sizeof(TestAudioFileHeader))
+    {
+        return {};
+    }
+
+    TestAudioFileHeader header;
+    std::memcpy(&header, content.data(), sizeof(header));
+
+    const std::size_t data_size = content.size() - sizeof(header);
+    auto data = std::make_unique<std::byte[]>(data_size + 32); // 16 bytes padding front and back
+    std::memcpy(data.get() + 16, content.data() + sizeof(header), data_size);
+    return DecodedAudioBuffer{
+        .NumChannels = header.NumChannels,
+        .Frequency = header.Frequency,
+        .Format = static_cast<SoundFormat>(header.Format),
+        .Data = std::move(data),
+        .DataSize = data_size,
+    };
+}
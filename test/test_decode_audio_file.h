@@ -0,0 +1,10 @@
+#pragma once
+
+#include "mod/decode_audio_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// Writes a file that the DecodeAudioFile of the tests decodes to exactly these samples
+void WriteTestAudioFile(const std::filesystem::path& file_path, std::int32_t num_channels, std::int32_t frequency, SoundFormat format, std::span<const std::byte> samples);
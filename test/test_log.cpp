@@ -0,0 +1,12 @@
+#include "log.h"
+
+#include <cstdio>
+
+// Sources under test log through this instead of the game's console
+void Log(std::string message, LogLevel log_level)
+{
+    if (log_level == LogLevel::Error || log_level == LogLevel::Fatal)
+    {
+        std::fprintf(stderr, "%s\n", message.c_str());
+    }
+}
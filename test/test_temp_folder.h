@@ -0,0 +1,47 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Fixture for tests that work on files, each test gets an empty folder that is removed again after the test
+// The folder is named after suite and test, so tests of different suites can run in parallel
+class TempFolderTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        const auto* test_info = testing::UnitTest::GetInstance()->current_test_info();
+        mTestFolder = std::filesystem::temp_directory_path() / "playlunky_tests" / test_info->test_suite_name() / test_info->name();
+        std::filesystem::remove_all(mTestFolder);
+        std::filesystem::create_directories(mTestFolder);
+    }
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mTestFolder);
+    }
+
+    // Creates missing folders and replaces existing files
+    static void WriteFile(const std::filesystem::path& file_path, std::string_view content)
+    {
+        std::filesystem::create_directories(file_path.parent_path());
+        std::ofstream{ file_path, std::ios::binary | std::ios::trunc }.write(content.data(), content.size());
+    }
+    static void WriteFile(const std::filesystem::path& file_path, std::span<const std::uint8_t> content)
+    {
+        WriteFile(file_path, std::string_view{ reinterpret_cast<const char*>(content.data()), content.size() });
+    }
+    static std::string ReadFile(const std::filesystem::path& file_path)
+    {
+        std::ifstream file{ file_path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+
+    std::filesystem::path mTestFolder;
+};
@@ -0,0 +1,89 @@
+#include "mod/vfs_file_index.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TestMount
+{
+    std::int64_t Priority;
+    std::size_t MountOrder;
+};
+
+static std::vector<const TestMount*> GetMounts(const VfsFileIndex<TestMount>& index, std::string_view path)
+{
+    std::vector<const TestMount*> mounts;
+    for (const auto& indexed_file : index.Find(path))
+    {
+        mounts.push_back(indexed_file.Mount);
+    }
+    return mounts;
+}
+
+TEST(VfsFileIndex, KeysIgnoreCaseAndSlashes)
+{
+    EXPECT_EQ(VfsIndexKeyHash{}("Data/Textures/Char_Yellow.png"), VfsIndexKeyHash{}("data\\textures\\char_yellow.PNG"));
+    EXPECT_TRUE(VfsIndexKeyEqual{}("Data/Textures/Char_Yellow.png", "data\\textures\\char_yellow.PNG"));
+    EXPECT_FALSE(VfsIndexKeyEqual{}("Data/Textures/char_yellow.png", "Data/Textures/char_yellow.pn"));
+    EXPECT_FALSE(VfsIndexKeyEqual{}("Data/Textures/char_yellow.png", "Data/Textures/char_yellow_png"));
+    EXPECT_EQ(GetVfsIndexKey("Data\\Textures/Char_Yellow.PNG"), "data/textures/char_yellow.png");
+}
+
+TEST(VfsFileIndex, HasExtensionMatchesFilesystem)
+{
+    for (std::string_view path : { "Data/Textures/char_yellow.png", "Data/Textures/char_yellow", "Data/Textures/.hidden", "Data/Textures.dir/file", "Data\\Textures.dir\\file.", "..", "file.tar.gz", "", "Data/" })
+    {
+        EXPECT_EQ(VfsPathHasExtension(path), std::filesystem::path{ path }.has_extension()) << path;
+    }
+}
+
+TEST(VfsFileIndex, FindsFilesInLoadOrder)
+{
+    const TestMount low{ 0, 2 };
+    const TestMount high{ 10, 0 };
+    const TestMount high_later{ 10, 1 };
+
+    VfsFileIndex<TestMount> index;
+    index.Add(&high_later, "Data/Textures/char_yellow.png");
+    index.Add(&low, "Data/Textures/Char_Yellow.png");
+    index.Add(&high, "data/textures/char_yellow.DDS");
+    index.Add(&high, "Data/Textures/char_orange.png");
+
+    EXPECT_EQ(GetMounts(index, "DATA\\Textures\\char_yellow.png"), (std::vector<const TestMount*>{ &low, &high_later }));
+    EXPECT_EQ(GetMounts(index, "Data/Textures/char_yellow.dds"), (std::vector<const TestMount*>{ &high }));
+    EXPECT_EQ(GetMounts(index, "Data/Textures/char_yellow"), (std::vector<const TestMount*>{ &low, &high, &high_later }));
+    EXPECT_TRUE(index.Find("Data/Textures/char_yellow.bmp").empty());
+    EXPECT_TRUE(index.Find("Data/Textures/char").empty());
+
+    // Stem lookups give the name of the file in that mount
+    EXPECT_EQ(index.Find("Data/Textures/char_yellow")[1].FileName, "char_yellow.DDS");
+
+    // Only the first file with a given stem is found in a mount
+    index.Add(&high, "Data/Textures/char_yellow.png");
+    EXPECT_EQ(index.Find("Data/Textures/char_yellow")[1].FileName, "char_yellow.DDS");
+}
+
+TEST(VfsFileIndex, RemoveAndListFiles)
+{
+    const TestMount first{ 0, 0 };
+    const TestMount second{ 0, 1 };
+
+    VfsFileIndex<TestMount> index;
+    index.Add(&first, "Data/Textures/char_yellow.png");
+    index.Add(&second, "Data/Textures/char_yellow.png");
+    index.Add(&second, "Data/Textures/Entities/monsters.png");
+    index.Add(&second, "Data/Levels/dwelling.lvl");
+
+    index.Remove(&first, "data/textures/char_yellow.png");
+    EXPECT_EQ(GetMounts(index, "Data/Textures/char_yellow.png"), (std::vector<const TestMount*>{ &second }));
+    EXPECT_EQ(GetMounts(index, "Data/Textures/char_yellow"), (std::vector<const TestMount*>{ &second }));
+
+    index.Remove(&second, "Data/Textures/char_yellow.png");
+    EXPECT_TRUE(index.Find("Data/Textures/char_yellow.png").empty());
+    EXPECT_TRUE(index.Find("Data/Textures/char_yellow").empty());
+
+    std::vector<std::string> file_paths = index.GetFilePaths("Data/Textures");
+    EXPECT_EQ(file_paths, (std::vector<std::string>{ "data/textures/entities/monsters.png" }));
+}